@@ -0,0 +1,84 @@
+// © 2024 NVIDIA Corporation
+
+// Shared code for the benchmarks: they run on the NONE backend (no GPU needed) and use only the public API
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "NRI.h"
+
+#include "Extensions/NRIDeviceCreation.h"
+#include "Extensions/NRIHelper.h"
+#include "Extensions/NRIStreamer.h"
+
+#define BENCHMARK_CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            printf("FAILED: %s (%s:%u)\n", #condition, __FILE__, __LINE__); \
+            exit(1); \
+        } \
+    } while (0)
+
+struct BenchmarkDesc {
+    bool enableValidation;
+    bool enableHostMemory; // copies are executed by the CPU, i.e. data paths are real
+    const nri::NONETimingModel* timingModel;
+    nri::GraphicsAPI graphicsAPI; // NONE, unless a check is run on a real device
+};
+
+// "NONE" (default), "D3D11", "D3D12" or "VK"
+inline nri::GraphicsAPI ParseGraphicsAPI(int argc, char** argv) {
+    const char* names[] = {"NONE", "D3D11", "D3D12", "VK"};
+    for (uint32_t i = 0; argc > 1 && i < (uint32_t)(sizeof(names) / sizeof(names[0])); i++) {
+        if (!strcmp(argv[1], names[i]))
+            return (nri::GraphicsAPI)i;
+    }
+
+    return nri::GraphicsAPI::NONE;
+}
+
+struct BenchmarkDevice {
+    nri::Device* device;
+    nri::CoreInterface core;
+    nri::HelperInterface helper;
+    nri::StreamerInterface streamer;
+};
+
+inline BenchmarkDevice CreateBenchmarkDevice(const BenchmarkDesc& benchmarkDesc) {
+    nri::DeviceCreationDesc deviceCreationDesc = {};
+    deviceCreationDesc.graphicsAPI = benchmarkDesc.graphicsAPI;
+    deviceCreationDesc.enableNRIValidation = benchmarkDesc.enableValidation;
+    deviceCreationDesc.enableNONEHostMemory = benchmarkDesc.enableHostMemory;
+    deviceCreationDesc.noneTimingModel = benchmarkDesc.timingModel;
+
+    BenchmarkDevice benchmarkDevice = {};
+    BENCHMARK_CHECK(nriCreateDevice(deviceCreationDesc, benchmarkDevice.device) == nri::Result::SUCCESS);
+    BENCHMARK_CHECK(nriGetInterface(*benchmarkDevice.device, NRI_INTERFACE(nri::CoreInterface), &benchmarkDevice.core) == nri::Result::SUCCESS);
+    BENCHMARK_CHECK(nriGetInterface(*benchmarkDevice.device, NRI_INTERFACE(nri::HelperInterface), &benchmarkDevice.helper) == nri::Result::SUCCESS);
+    BENCHMARK_CHECK(nriGetInterface(*benchmarkDevice.device, NRI_INTERFACE(nri::StreamerInterface), &benchmarkDevice.streamer) == nri::Result::SUCCESS);
+
+    return benchmarkDevice;
+}
+
+inline double GetElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Best of "repeatNum" runs, in milliseconds
+template <typename F>
+inline double MeasureBestMs(uint32_t repeatNum, F f) {
+    double best = 1e30;
+    for (uint32_t i = 0; i < repeatNum; i++) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, GetElapsedMs(start));
+    }
+
+    return best;
+}
@@ -0,0 +1,92 @@
+// © 2024 NVIDIA Corporation
+
+// "UploadData" throughput for a mixed set of textures with full mip chains (~2.3 GB), with GPU copy time simulated by the NONE timing model.
+// Staging slots are filled by the CPU while the GPU copies from the previous slot, i.e. the copy time should mostly hide behind "memcpy"
+// Usage: NRI_DataUpload [copy time in ns per byte, 0.05 by default]. The serialized baseline is "UPLOAD_SLOT_NUM = 1" in "HelperDataUpload.h"
+
+#include "Benchmark.h"
+
+int main(int argc, char** argv) {
+    nri::NONETimingModel timingModel = {};
+    timingModel.copyByteTime = argc > 1 ? (float)atof(argv[1]) : 0.05f;
+
+    BenchmarkDevice benchmarkDevice = CreateBenchmarkDevice({false, false, &timingModel});
+    nri::Device& device = *benchmarkDevice.device;
+    const nri::CoreInterface& NRI = benchmarkDevice.core;
+
+    nri::CommandQueue* commandQueue = nullptr;
+    BENCHMARK_CHECK(NRI.GetCommandQueue(device, nri::CommandQueueType::GRAPHICS, commandQueue) == nri::Result::SUCCESS);
+
+    struct TextureSet {
+        nri::Format format;
+        uint16_t size;
+        uint32_t num;
+    };
+
+    const TextureSet textureSets[] = {
+        {nri::Format::RGBA8_UNORM, 4096, 16},
+        {nri::Format::BC1_RGBA_UNORM, 2048, 64},
+        {nri::Format::RGBA16_SFLOAT, 1024, 64},
+    };
+
+    std::vector<uint8_t> data(64 << 20, 0x5A); // big enough for the biggest mip
+    std::vector<nri::Texture*> textures;
+    std::vector<std::vector<nri::TextureSubresourceUploadDesc>> subresources;
+    uint64_t totalSize = 0;
+
+    for (const TextureSet& textureSet : textureSets) {
+        const nri::FormatProps& formatProps = nriGetFormatProps(textureSet.format);
+
+        nri::Mip_t mipNum = 0;
+        for (uint32_t size = textureSet.size; size; size >>= 1)
+            mipNum++;
+
+        for (uint32_t i = 0; i < textureSet.num; i++) {
+            nri::TextureDesc textureDesc = {};
+            textureDesc.type = nri::TextureType::TEXTURE_2D;
+            textureDesc.format = textureSet.format;
+            textureDesc.width = textureSet.size;
+            textureDesc.height = textureSet.size;
+            textureDesc.mipNum = mipNum;
+            textureDesc.usage = nri::TextureUsageBits::SHADER_RESOURCE;
+
+            nri::Texture* texture = nullptr;
+            BENCHMARK_CHECK(NRI.CreateTexture(device, textureDesc, texture) == nri::Result::SUCCESS);
+            textures.push_back(texture);
+
+            std::vector<nri::TextureSubresourceUploadDesc>& textureSubresources = subresources.emplace_back();
+            for (nri::Mip_t mip = 0; mip < mipNum; mip++) {
+                uint32_t size = std::max(textureSet.size >> mip, 1);
+                uint32_t blockNum = (size + formatProps.blockWidth - 1) / formatProps.blockWidth;
+                uint32_t rowPitch = blockNum * formatProps.stride;
+                uint32_t slicePitch = rowPitch * blockNum;
+
+                textureSubresources.push_back({data.data(), 1, rowPitch, slicePitch});
+                totalSize += slicePitch;
+            }
+        }
+    }
+
+    std::vector<nri::TextureUploadDesc> textureUploadDescs(textures.size());
+    for (size_t i = 0; i < textures.size(); i++) {
+        textureUploadDescs[i].subresources = subresources[i].data();
+        textureUploadDescs[i].texture = textures[i];
+        textureUploadDescs[i].after = {nri::AccessBits::SHADER_RESOURCE, nri::Layout::SHADER_RESOURCE};
+    }
+
+    // Warm up (staging memory creation), then measure
+    BENCHMARK_CHECK(benchmarkDevice.helper.UploadData(*commandQueue, textureUploadDescs.data(), 1, nullptr, 0) == nri::Result::SUCCESS);
+
+    double ms = MeasureBestMs(3, [&]() {
+        BENCHMARK_CHECK(benchmarkDevice.helper.UploadData(*commandQueue, textureUploadDescs.data(), (uint32_t)textureUploadDescs.size(), nullptr, 0) == nri::Result::SUCCESS);
+    });
+
+    printf("%.2f GB, simulated GPU copy %.3f ns/B: %.0f ms (%.2f GB/s)\n", totalSize / 1e9, timingModel.copyByteTime, ms, totalSize / 1e6 / ms);
+
+    for (nri::Texture* texture : textures)
+        NRI.DestroyTexture(*texture);
+
+    nriDestroyDevice(device);
+
+    return 0;
+}
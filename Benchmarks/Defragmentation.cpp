@@ -0,0 +1,253 @@
+// © 2024 NVIDIA Corporation
+
+// Check: defragmentation of fragmented "ResourceAllocator" memory. Every pass relocates resources (GPU copies into new native objects),
+// views of relocated resources get rebuilt and all data must survive, including mapped host memory. Needs a device supporting
+// defragmentation, i.e. "VK" (Lavapipe is enough). Other APIs either don't support it or ("NONE") have nothing to move
+
+#include "Benchmark.h"
+
+#include "Extensions/NRIResourceAllocator.h"
+
+constexpr uint32_t BUFFER_NUM = 96; // 1 Mb each, i.e. more than one 64 Mb block
+constexpr uint64_t BUFFER_SIZE = 1 << 20;
+constexpr uint32_t TEXTURE_NUM = 16;
+constexpr uint16_t TEXTURE_SIZE = 256;
+constexpr uint32_t HOST_BUFFER_NUM = 8;
+constexpr uint32_t PASS_MAX_NUM = 64;
+
+static uint8_t GetPattern(uint32_t resourceIndex, size_t byteIndex) {
+    return (uint8_t)(byteIndex * 7 + resourceIndex * 31 + 1);
+}
+
+int main(int argc, char** argv) {
+    nri::GraphicsAPI graphicsAPI = ParseGraphicsAPI(argc, argv);
+
+    BenchmarkDevice benchmarkDevice = CreateBenchmarkDevice({true, true, nullptr, graphicsAPI});
+    nri::Device& device = *benchmarkDevice.device;
+    const nri::CoreInterface& NRI = benchmarkDevice.core;
+    const nri::HelperInterface& helper = benchmarkDevice.helper;
+
+    nri::ResourceAllocatorInterface resourceAllocator = {};
+    BENCHMARK_CHECK(nriGetInterface(device, NRI_INTERFACE(nri::ResourceAllocatorInterface), &resourceAllocator) == nri::Result::SUCCESS);
+
+    nri::CommandQueue* commandQueue = nullptr;
+    BENCHMARK_CHECK(NRI.GetCommandQueue(device, nri::CommandQueueType::GRAPHICS, commandQueue) == nri::Result::SUCCESS);
+
+    // Interleaved allocations
+    std::vector<nri::Buffer*> buffers(BUFFER_NUM);
+    for (nri::Buffer*& buffer : buffers) {
+        nri::AllocateBufferDesc allocateBufferDesc = {};
+        allocateBufferDesc.desc.size = BUFFER_SIZE;
+        allocateBufferDesc.desc.usage = nri::BufferUsageBits::SHADER_RESOURCE;
+        allocateBufferDesc.memoryLocation = nri::MemoryLocation::DEVICE;
+
+        BENCHMARK_CHECK(resourceAllocator.AllocateBuffer(device, allocateBufferDesc, buffer) == nri::Result::SUCCESS);
+    }
+
+    std::vector<nri::Texture*> textures(TEXTURE_NUM);
+    for (nri::Texture*& texture : textures) {
+        nri::AllocateTextureDesc allocateTextureDesc = {};
+        allocateTextureDesc.desc.type = nri::TextureType::TEXTURE_2D;
+        allocateTextureDesc.desc.format = nri::Format::RGBA8_UNORM;
+        allocateTextureDesc.desc.width = TEXTURE_SIZE;
+        allocateTextureDesc.desc.height = TEXTURE_SIZE;
+        allocateTextureDesc.desc.usage = nri::TextureUsageBits::SHADER_RESOURCE;
+        allocateTextureDesc.memoryLocation = nri::MemoryLocation::DEVICE;
+
+        BENCHMARK_CHECK(resourceAllocator.AllocateTexture(device, allocateTextureDesc, texture) == nri::Result::SUCCESS);
+    }
+
+    std::vector<nri::Buffer*> hostBuffers(HOST_BUFFER_NUM);
+    for (uint32_t i = 0; i < HOST_BUFFER_NUM; i++) {
+        nri::AllocateBufferDesc allocateBufferDesc = {};
+        allocateBufferDesc.desc.size = BUFFER_SIZE;
+        allocateBufferDesc.desc.usage = nri::BufferUsageBits::SHADER_RESOURCE;
+        allocateBufferDesc.memoryLocation = nri::MemoryLocation::HOST_UPLOAD;
+
+        BENCHMARK_CHECK(resourceAllocator.AllocateBuffer(device, allocateBufferDesc, hostBuffers[i]) == nri::Result::SUCCESS);
+
+        uint8_t* data = (uint8_t*)NRI.MapBuffer(*hostBuffers[i], 0, BUFFER_SIZE);
+        BENCHMARK_CHECK(data);
+        for (size_t j = 0; j < BUFFER_SIZE; j++)
+            data[j] = GetPattern(BUFFER_NUM + TEXTURE_NUM + i, j);
+        NRI.UnmapBuffer(*hostBuffers[i]);
+    }
+
+    // Contents
+    std::vector<std::vector<uint8_t>> contents(BUFFER_NUM + TEXTURE_NUM);
+    for (uint32_t i = 0; i < BUFFER_NUM + TEXTURE_NUM; i++) {
+        contents[i].resize(i < BUFFER_NUM ? BUFFER_SIZE : TEXTURE_SIZE * TEXTURE_SIZE * 4);
+        for (size_t j = 0; j < contents[i].size(); j++)
+            contents[i][j] = GetPattern(i, j);
+    }
+
+    std::vector<nri::BufferUploadDesc> bufferUploadDescs(BUFFER_NUM);
+    for (uint32_t i = 0; i < BUFFER_NUM; i++)
+        bufferUploadDescs[i] = {contents[i].data(), BUFFER_SIZE, buffers[i], 0, {nri::AccessBits::SHADER_RESOURCE}};
+
+    std::vector<nri::TextureSubresourceUploadDesc> subresources(TEXTURE_NUM);
+    std::vector<nri::TextureUploadDesc> textureUploadDescs(TEXTURE_NUM);
+    for (uint32_t i = 0; i < TEXTURE_NUM; i++) {
+        const std::vector<uint8_t>& content = contents[BUFFER_NUM + i];
+        subresources[i] = {content.data(), 1, TEXTURE_SIZE * 4, (uint32_t)content.size()};
+        textureUploadDescs[i] = {&subresources[i], textures[i], {nri::AccessBits::SHADER_RESOURCE, nri::Layout::SHADER_RESOURCE}, nri::PlaneBits::ALL};
+    }
+
+    BENCHMARK_CHECK(helper.UploadData(*commandQueue, textureUploadDescs.data(), TEXTURE_NUM, bufferUploadDescs.data(), BUFFER_NUM) == nri::Result::SUCCESS);
+
+    // Fragment: free every other resource
+    std::vector<nri::Buffer*> survivedBuffers;
+    std::vector<uint32_t> survivedBufferIndices;
+    for (uint32_t i = 0; i < BUFFER_NUM; i++) {
+        if (i % 2) {
+            NRI.DestroyBuffer(*buffers[i]);
+        } else {
+            survivedBuffers.push_back(buffers[i]);
+            survivedBufferIndices.push_back(i);
+        }
+    }
+
+    for (uint32_t i = 0; i < HOST_BUFFER_NUM; i++) {
+        if (i % 2) {
+            NRI.DestroyBuffer(*hostBuffers[i]);
+        } else {
+            survivedBuffers.push_back(hostBuffers[i]);
+            survivedBufferIndices.push_back(BUFFER_NUM + TEXTURE_NUM + i);
+        }
+    }
+
+    std::vector<nri::Texture*> survivedTextures;
+    std::vector<uint32_t> survivedTextureIndices;
+    for (uint32_t i = 0; i < TEXTURE_NUM; i++) {
+        if (i % 2) {
+            NRI.DestroyTexture(*textures[i]);
+        } else {
+            survivedTextures.push_back(textures[i]);
+            survivedTextureIndices.push_back(BUFFER_NUM + i);
+        }
+    }
+
+    // Defragment
+    nri::DefragmentationDesc defragmentationDesc = {};
+    defragmentationDesc.buffers = survivedBuffers.data();
+    defragmentationDesc.bufferNum = (uint32_t)survivedBuffers.size();
+    defragmentationDesc.textures = survivedTextures.data();
+    defragmentationDesc.textureNum = (uint32_t)survivedTextures.size();
+    defragmentationDesc.maxBytesPerPass = 16 * BUFFER_SIZE; // several passes
+
+    nri::Result result = resourceAllocator.BeginDefragmentation(device, defragmentationDesc);
+    if (result == nri::Result::UNSUPPORTED) {
+        BENCHMARK_CHECK(graphicsAPI != nri::GraphicsAPI::VK);
+        printf("SKIPPED: defragmentation is not supported (run with \"VK\")\n");
+    } else {
+        BENCHMARK_CHECK(result == nri::Result::SUCCESS);
+
+        nri::CommandAllocator* commandAllocator = nullptr;
+        BENCHMARK_CHECK(NRI.CreateCommandAllocator(*commandQueue, commandAllocator) == nri::Result::SUCCESS);
+
+        nri::CommandBuffer* commandBuffer = nullptr;
+        BENCHMARK_CHECK(NRI.CreateCommandBuffer(*commandAllocator, commandBuffer) == nri::Result::SUCCESS);
+
+        uint32_t passNum = 0;
+        uint32_t relocatedBufferNum = 0;
+        uint32_t relocatedTextureNum = 0;
+        uint64_t movedSize = 0;
+
+        nri::DefragmentationReport report = {};
+        while (!report.isFinished) {
+            BENCHMARK_CHECK(++passNum <= PASS_MAX_NUM);
+
+            NRI.ResetCommandAllocator(*commandAllocator);
+            BENCHMARK_CHECK(NRI.BeginCommandBuffer(*commandBuffer, nullptr) == nri::Result::SUCCESS);
+            BENCHMARK_CHECK(resourceAllocator.BeginDefragmentationPass(device, *commandBuffer) == nri::Result::SUCCESS);
+            BENCHMARK_CHECK(NRI.EndCommandBuffer(*commandBuffer) == nri::Result::SUCCESS);
+
+            nri::QueueSubmitDesc queueSubmitDesc = {};
+            queueSubmitDesc.commandBuffers = &commandBuffer;
+            queueSubmitDesc.commandBufferNum = 1;
+
+            NRI.QueueSubmit(*commandQueue, queueSubmitDesc);
+            BENCHMARK_CHECK(helper.WaitForIdle(*commandQueue) == nri::Result::SUCCESS);
+
+            BENCHMARK_CHECK(resourceAllocator.EndDefragmentationPass(device, report) == nri::Result::SUCCESS);
+
+            // Rebuild views of relocated resources
+            for (uint32_t i = 0; i < report.relocatedBufferNum; i++) {
+                BENCHMARK_CHECK(report.relocatedBuffers[i] < survivedBuffers.size());
+
+                nri::BufferViewDesc bufferViewDesc = {survivedBuffers[report.relocatedBuffers[i]], nri::BufferViewType::SHADER_RESOURCE, nri::Format::R32_UINT, 0, 256};
+
+                nri::Descriptor* bufferView = nullptr;
+                BENCHMARK_CHECK(NRI.CreateBufferView(bufferViewDesc, bufferView) == nri::Result::SUCCESS);
+                NRI.DestroyDescriptor(*bufferView);
+            }
+
+            for (uint32_t i = 0; i < report.relocatedTextureNum; i++) {
+                BENCHMARK_CHECK(report.relocatedTextures[i] < survivedTextures.size());
+
+                nri::Texture2DViewDesc textureViewDesc = {survivedTextures[report.relocatedTextures[i]], nri::Texture2DViewType::SHADER_RESOURCE_2D, nri::Format::RGBA8_UNORM};
+
+                nri::Descriptor* textureView = nullptr;
+                BENCHMARK_CHECK(NRI.CreateTexture2DView(textureViewDesc, textureView) == nri::Result::SUCCESS);
+                NRI.DestroyDescriptor(*textureView);
+            }
+
+            relocatedBufferNum += report.relocatedBufferNum;
+            relocatedTextureNum += report.relocatedTextureNum;
+            movedSize += report.movedSize;
+        }
+
+        resourceAllocator.EndDefragmentation(device);
+
+        NRI.DestroyCommandBuffer(*commandBuffer);
+        NRI.DestroyCommandAllocator(*commandAllocator);
+
+        // Something must have been moved, otherwise nothing has been checked
+        if (graphicsAPI == nri::GraphicsAPI::VK)
+            BENCHMARK_CHECK(relocatedBufferNum + relocatedTextureNum != 0);
+
+        // Data must survive
+        std::vector<uint8_t> data(BUFFER_SIZE);
+        for (uint32_t i = 0; i < survivedBuffers.size(); i++) {
+            uint32_t index = survivedBufferIndices[i];
+
+            if (index < BUFFER_NUM) {
+                nri::BufferDownloadDesc bufferDownloadDesc = {data.data(), BUFFER_SIZE, survivedBuffers[i], 0, {nri::AccessBits::SHADER_RESOURCE, nri::StageBits::ALL}};
+                BENCHMARK_CHECK(helper.DownloadData(*commandQueue, nullptr, 0, &bufferDownloadDesc, 1) == nri::Result::SUCCESS);
+                BENCHMARK_CHECK(data == contents[index]);
+            } else {
+                const uint8_t* mapped = (uint8_t*)NRI.MapBuffer(*survivedBuffers[i], 0, BUFFER_SIZE);
+                BENCHMARK_CHECK(mapped);
+                for (size_t j = 0; j < BUFFER_SIZE; j++)
+                    BENCHMARK_CHECK(mapped[j] == GetPattern(index, j));
+                NRI.UnmapBuffer(*survivedBuffers[i]);
+            }
+        }
+
+        for (uint32_t i = 0; i < survivedTextures.size(); i++) {
+            const std::vector<uint8_t>& content = contents[survivedTextureIndices[i]];
+            data.resize(content.size());
+
+            nri::TextureDownloadDesc textureDownloadDesc = {};
+            textureDownloadDesc.texture = survivedTextures[i];
+            textureDownloadDesc.data = data.data();
+            textureDownloadDesc.before = {nri::AccessBits::SHADER_RESOURCE, nri::Layout::SHADER_RESOURCE, nri::StageBits::ALL};
+            textureDownloadDesc.planes = nri::PlaneBits::ALL;
+
+            BENCHMARK_CHECK(helper.DownloadData(*commandQueue, &textureDownloadDesc, 1, nullptr, 0) == nri::Result::SUCCESS);
+            BENCHMARK_CHECK(data == content);
+        }
+
+        printf("OK: %u passes, %u buffers and %u textures relocated (%.1f Mb), data intact\n", passNum, relocatedBufferNum, relocatedTextureNum, movedSize / (1024.0 * 1024.0));
+    }
+
+    for (nri::Buffer* buffer : survivedBuffers)
+        NRI.DestroyBuffer(*buffer);
+
+    for (nri::Texture* texture : survivedTextures)
+        NRI.DestroyTexture(*texture);
+
+    nriDestroyDevice(device);
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+// © 2024 NVIDIA Corporation
+
+// "UploadData" and "DownloadData" throughput in the NONE host memory mode, where copies are executed by the CPU (768 MB of textures and buffers)
+
+#include "Benchmark.h"
+
+constexpr uint32_t TEXTURE_NUM = 32;
+constexpr uint16_t TEXTURE_SIZE = 2048;
+constexpr uint32_t BUFFER_NUM = 64;
+constexpr uint64_t BUFFER_SIZE = 4 << 20;
+
+int main() {
+    BenchmarkDevice benchmarkDevice = CreateBenchmarkDevice({false, true, nullptr});
+    nri::Device& device = *benchmarkDevice.device;
+    const nri::CoreInterface& NRI = benchmarkDevice.core;
+    const nri::HelperInterface& helper = benchmarkDevice.helper;
+
+    nri::CommandQueue* commandQueue = nullptr;
+    BENCHMARK_CHECK(NRI.GetCommandQueue(device, nri::CommandQueueType::GRAPHICS, commandQueue) == nri::Result::SUCCESS);
+
+    nri::TextureDesc textureDesc = {};
+    textureDesc.type = nri::TextureType::TEXTURE_2D;
+    textureDesc.format = nri::Format::RGBA8_UNORM;
+    textureDesc.width = TEXTURE_SIZE;
+    textureDesc.height = TEXTURE_SIZE;
+    textureDesc.usage = nri::TextureUsageBits::SHADER_RESOURCE;
+
+    std::vector<nri::Texture*> textures(TEXTURE_NUM);
+    for (nri::Texture*& texture : textures)
+        BENCHMARK_CHECK(NRI.CreateTexture(device, textureDesc, texture) == nri::Result::SUCCESS);
+
+    nri::BufferDesc bufferDesc = {};
+    bufferDesc.size = BUFFER_SIZE;
+    bufferDesc.usage = nri::BufferUsageBits::SHADER_RESOURCE;
+
+    std::vector<nri::Buffer*> buffers(BUFFER_NUM);
+    for (nri::Buffer*& buffer : buffers)
+        BENCHMARK_CHECK(NRI.CreateBuffer(device, bufferDesc, buffer) == nri::Result::SUCCESS);
+
+    nri::ResourceGroupDesc resourceGroupDesc = {};
+    resourceGroupDesc.memoryLocation = nri::MemoryLocation::DEVICE;
+    resourceGroupDesc.textures = textures.data();
+    resourceGroupDesc.textureNum = TEXTURE_NUM;
+    resourceGroupDesc.buffers = buffers.data();
+    resourceGroupDesc.bufferNum = BUFFER_NUM;
+
+    std::vector<nri::Memory*> memories(helper.CalculateAllocationNumber(device, resourceGroupDesc));
+    BENCHMARK_CHECK(helper.AllocateAndBindMemory(device, resourceGroupDesc, memories.data()) == nri::Result::SUCCESS);
+
+    // Data
+    const uint32_t rowPitch = TEXTURE_SIZE * 4;
+    const uint32_t slicePitch = rowPitch * TEXTURE_SIZE;
+    std::vector<uint8_t> src(slicePitch, 0x3C);
+    std::vector<uint8_t> dst(slicePitch);
+
+    nri::TextureSubresourceUploadDesc subresource = {src.data(), 1, rowPitch, slicePitch};
+
+    std::vector<nri::TextureUploadDesc> textureUploadDescs(TEXTURE_NUM);
+    for (uint32_t i = 0; i < TEXTURE_NUM; i++)
+        textureUploadDescs[i] = {&subresource, textures[i], {nri::AccessBits::SHADER_RESOURCE, nri::Layout::SHADER_RESOURCE}, nri::PlaneBits::ALL};
+
+    std::vector<nri::BufferUploadDesc> bufferUploadDescs(BUFFER_NUM);
+    for (uint32_t i = 0; i < BUFFER_NUM; i++)
+        bufferUploadDescs[i] = {src.data(), BUFFER_SIZE, buffers[i], 0, {nri::AccessBits::SHADER_RESOURCE}};
+
+    const uint64_t totalSize = TEXTURE_NUM * (uint64_t)slicePitch + BUFFER_NUM * BUFFER_SIZE;
+
+    // Warm up (staging memory creation), then measure
+    BENCHMARK_CHECK(helper.UploadData(*commandQueue, textureUploadDescs.data(), 1, nullptr, 0) == nri::Result::SUCCESS);
+
+    double uploadMs = MeasureBestMs(5, [&]() {
+        BENCHMARK_CHECK(helper.UploadData(*commandQueue, textureUploadDescs.data(), TEXTURE_NUM, bufferUploadDescs.data(), BUFFER_NUM) == nri::Result::SUCCESS);
+    });
+
+    double downloadMs = MeasureBestMs(5, [&]() {
+        for (uint32_t i = 0; i < TEXTURE_NUM; i++) {
+            nri::TextureDownloadDesc textureDownloadDesc = {};
+            textureDownloadDesc.texture = textures[i];
+            textureDownloadDesc.data = dst.data();
+            textureDownloadDesc.before = {nri::AccessBits::SHADER_RESOURCE, nri::Layout::SHADER_RESOURCE, nri::StageBits::ALL};
+
+            BENCHMARK_CHECK(helper.DownloadData(*commandQueue, &textureDownloadDesc, 1, nullptr, 0) == nri::Result::SUCCESS);
+        }
+
+        for (uint32_t i = 0; i < BUFFER_NUM; i++) {
+            nri::BufferDownloadDesc bufferDownloadDesc = {dst.data(), BUFFER_SIZE, buffers[i], 0, {nri::AccessBits::SHADER_RESOURCE, nri::StageBits::ALL}};
+
+            BENCHMARK_CHECK(helper.DownloadData(*commandQueue, nullptr, 0, &bufferDownloadDesc, 1) == nri::Result::SUCCESS);
+        }
+    });
+
+    // The data must survive the round trip
+    BENCHMARK_CHECK(dst == src);
+
+    printf("%.0f MB: UploadData %.0f ms (%.2f GB/s), DownloadData %.0f ms (%.2f GB/s)\n", totalSize / 1e6, uploadMs, totalSize / 1e6 / uploadMs, downloadMs, totalSize / 1e6 / downloadMs);
+
+    for (nri::Texture* texture : textures)
+        NRI.DestroyTexture(*texture);
+
+    for (nri::Buffer* buffer : buffers)
+        NRI.DestroyBuffer(*buffer);
+
+    for (nri::Memory* memory : memories)
+        NRI.FreeMemory(*memory);
+
+    nriDestroyDevice(device);
+
+    return 0;
+}
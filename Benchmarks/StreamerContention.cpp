@@ -0,0 +1,71 @@
+// © 2024 NVIDIA Corporation
+
+// Many producer threads adding streamer requests concurrently (lock-free queues) vs. the same work serialized by a global mutex (the old model)
+
+#include "Benchmark.h"
+
+#include <mutex>
+#include <thread>
+
+constexpr uint32_t REQUEST_NUM = 1 << 16; // per frame, split across threads
+constexpr uint32_t FRAME_NUM = 20;
+
+int main() {
+    BenchmarkDevice benchmarkDevice = CreateBenchmarkDevice({false, true, nullptr});
+    nri::Device& device = *benchmarkDevice.device;
+    const nri::StreamerInterface& NRI = benchmarkDevice.streamer;
+
+    nri::StreamerDesc streamerDesc = {};
+    streamerDesc.constantBufferMemoryLocation = nri::MemoryLocation::HOST_UPLOAD;
+    streamerDesc.constantBufferSize = 64 << 20;
+    streamerDesc.dynamicBufferMemoryLocation = nri::MemoryLocation::HOST_UPLOAD;
+    streamerDesc.frameInFlightNum = 2;
+
+    nri::Streamer* streamer = nullptr;
+    BENCHMARK_CHECK(NRI.CreateStreamer(device, streamerDesc, streamer) == nri::Result::SUCCESS);
+
+    uint8_t data[256] = {};
+    std::mutex mutex;
+
+    for (bool isLocked : {false, true}) {
+        for (uint32_t threadNum : {1u, 2u, 4u, 8u, 16u, 32u}) {
+            double ms = 1e30;
+            for (uint32_t frame = 0; frame < FRAME_NUM; frame++) {
+                auto start = std::chrono::steady_clock::now();
+
+                std::vector<std::thread> threads;
+                for (uint32_t i = 0; i < threadNum; i++) {
+                    threads.emplace_back([&]() {
+                        nri::BufferUpdateRequestDesc bufferUpdateRequestDesc = {};
+                        bufferUpdateRequestDesc.data = data;
+                        bufferUpdateRequestDesc.dataSize = sizeof(data);
+
+                        for (uint32_t j = 0; j < REQUEST_NUM / threadNum; j++) {
+                            std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+                            if (isLocked)
+                                lock.lock();
+
+                            BENCHMARK_CHECK(NRI.AddStreamerBufferUpdateRequest(*streamer, bufferUpdateRequestDesc) != nri::STREAMER_INVALID_OFFSET);
+                            NRI.UpdateStreamerConstantBuffer(*streamer, data, 64);
+                        }
+                    });
+                }
+
+                for (std::thread& thread : threads)
+                    thread.join();
+
+                ms = std::min(ms, GetElapsedMs(start));
+
+                // Not measured
+                BENCHMARK_CHECK(NRI.CopyStreamerUpdateRequests(*streamer) == nri::Result::SUCCESS);
+            }
+
+            printf("%-12s, %2u threads: %.2f ms per %u request pairs (%.1f M/s)\n", isLocked ? "global mutex" : "lock-free", threadNum, ms, REQUEST_NUM, REQUEST_NUM / ms / 1000.0);
+        }
+    }
+
+    NRI.DestroyStreamer(*streamer);
+    nriDestroyDevice(device);
+
+    return 0;
+}
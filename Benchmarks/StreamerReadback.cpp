@@ -0,0 +1,193 @@
+// © 2024 NVIDIA Corporation
+
+// Check: several texture readbacks (and a buffer readback) in one frame share the readback ring slot, or get dedicated buffers on D3D11,
+// where a texture can be read back only to the beginning of a buffer. All data must arrive intact
+
+#include "Benchmark.h"
+
+constexpr uint32_t FRAME_IN_FLIGHT_NUM = 2;
+
+struct ReadbackCheck {
+    const std::vector<uint8_t>* expected;
+    uint32_t rowSize;
+    uint32_t rowNum;
+    uint32_t deliveredNum;
+};
+
+static void Callback(const void* data, uint64_t dataSize, uint32_t rowPitch, uint32_t, void* userArg) {
+    ReadbackCheck& check = *(ReadbackCheck*)userArg;
+    check.deliveredNum++;
+
+    // Buffers
+    if (!rowPitch) {
+        BENCHMARK_CHECK(dataSize == check.expected->size());
+        BENCHMARK_CHECK(!memcmp(data, check.expected->data(), check.expected->size()));
+
+        return;
+    }
+
+    // Textures: rows are padded
+    for (uint32_t i = 0; i < check.rowNum; i++)
+        BENCHMARK_CHECK(!memcmp((uint8_t*)data + i * rowPitch, check.expected->data() + i * check.rowSize, check.rowSize));
+}
+
+// The D3D11 path can be checked by passing "D3D11" on Windows
+int main(int argc, char** argv) {
+    BenchmarkDevice benchmarkDevice = CreateBenchmarkDevice({true, true, nullptr, ParseGraphicsAPI(argc, argv)});
+    nri::Device& device = *benchmarkDevice.device;
+    const nri::CoreInterface& NRI = benchmarkDevice.core;
+
+    nri::CommandQueue* commandQueue = nullptr;
+    BENCHMARK_CHECK(NRI.GetCommandQueue(device, nri::CommandQueueType::GRAPHICS, commandQueue) == nri::Result::SUCCESS);
+
+    // Resources with distinct contents
+    struct TextureInfo {
+        nri::Format format;
+        uint16_t width;
+        uint16_t height;
+        uint32_t stride;
+    };
+
+    const TextureInfo textureInfos[] = {
+        {nri::Format::RGBA8_UNORM, 61, 17, 4},
+        {nri::Format::R32_SFLOAT, 32, 9, 4},
+        {nri::Format::RG16_UINT, 5, 3, 4},
+    };
+
+    constexpr uint32_t TEXTURE_NUM = (uint32_t)(sizeof(textureInfos) / sizeof(textureInfos[0]));
+    constexpr uint64_t BUFFER_SIZE = 1000;
+
+    nri::Texture* textures[TEXTURE_NUM] = {};
+    std::vector<uint8_t> textureContents[TEXTURE_NUM];
+    for (uint32_t i = 0; i < TEXTURE_NUM; i++) {
+        nri::TextureDesc textureDesc = {};
+        textureDesc.type = nri::TextureType::TEXTURE_2D;
+        textureDesc.format = textureInfos[i].format;
+        textureDesc.width = textureInfos[i].width;
+        textureDesc.height = textureInfos[i].height;
+        textureDesc.usage = nri::TextureUsageBits::SHADER_RESOURCE;
+
+        BENCHMARK_CHECK(NRI.CreateTexture(device, textureDesc, textures[i]) == nri::Result::SUCCESS);
+
+        textureContents[i].resize((size_t)textureInfos[i].width * textureInfos[i].height * textureInfos[i].stride);
+        for (size_t j = 0; j < textureContents[i].size(); j++)
+            textureContents[i][j] = (uint8_t)(j * 7 + i * 31 + 1);
+    }
+
+    nri::BufferDesc bufferDesc = {};
+    bufferDesc.size = BUFFER_SIZE;
+    bufferDesc.usage = nri::BufferUsageBits::SHADER_RESOURCE;
+
+    nri::Buffer* buffer = nullptr;
+    BENCHMARK_CHECK(NRI.CreateBuffer(device, bufferDesc, buffer) == nri::Result::SUCCESS);
+
+    std::vector<uint8_t> bufferContents(BUFFER_SIZE);
+    for (size_t j = 0; j < bufferContents.size(); j++)
+        bufferContents[j] = (uint8_t)(j * 13 + 5);
+
+    nri::ResourceGroupDesc resourceGroupDesc = {};
+    resourceGroupDesc.memoryLocation = nri::MemoryLocation::DEVICE;
+    resourceGroupDesc.textures = textures;
+    resourceGroupDesc.textureNum = TEXTURE_NUM;
+    resourceGroupDesc.buffers = &buffer;
+    resourceGroupDesc.bufferNum = 1;
+
+    std::vector<nri::Memory*> memories(benchmarkDevice.helper.CalculateAllocationNumber(device, resourceGroupDesc));
+    BENCHMARK_CHECK(benchmarkDevice.helper.AllocateAndBindMemory(device, resourceGroupDesc, memories.data()) == nri::Result::SUCCESS);
+
+    nri::TextureSubresourceUploadDesc subresources[TEXTURE_NUM] = {};
+    nri::TextureUploadDesc textureUploadDescs[TEXTURE_NUM] = {};
+    for (uint32_t i = 0; i < TEXTURE_NUM; i++) {
+        subresources[i].slices = textureContents[i].data();
+        subresources[i].sliceNum = 1;
+        subresources[i].rowPitch = textureInfos[i].width * textureInfos[i].stride;
+        subresources[i].slicePitch = (uint32_t)textureContents[i].size();
+
+        textureUploadDescs[i].subresources = &subresources[i];
+        textureUploadDescs[i].texture = textures[i];
+        textureUploadDescs[i].after = {nri::AccessBits::COPY_SOURCE, nri::Layout::COPY_SOURCE};
+    }
+
+    nri::BufferUploadDesc bufferUploadDesc = {};
+    bufferUploadDesc.data = bufferContents.data();
+    bufferUploadDesc.dataSize = BUFFER_SIZE;
+    bufferUploadDesc.buffer = buffer;
+    bufferUploadDesc.after = {nri::AccessBits::COPY_SOURCE};
+
+    BENCHMARK_CHECK(benchmarkDevice.helper.UploadData(*commandQueue, textureUploadDescs, TEXTURE_NUM, &bufferUploadDesc, 1) == nri::Result::SUCCESS);
+
+    // Streamer
+    nri::StreamerDesc streamerDesc = {};
+    streamerDesc.constantBufferMemoryLocation = nri::MemoryLocation::HOST_UPLOAD;
+    streamerDesc.dynamicBufferMemoryLocation = nri::MemoryLocation::HOST_UPLOAD;
+    streamerDesc.frameInFlightNum = FRAME_IN_FLIGHT_NUM;
+
+    nri::Streamer* streamer = nullptr;
+    BENCHMARK_CHECK(benchmarkDevice.streamer.CreateStreamer(device, streamerDesc, streamer) == nri::Result::SUCCESS);
+
+    nri::CommandAllocator* commandAllocator = nullptr;
+    BENCHMARK_CHECK(NRI.CreateCommandAllocator(*commandQueue, commandAllocator) == nri::Result::SUCCESS);
+
+    nri::CommandBuffer* commandBuffer = nullptr;
+    BENCHMARK_CHECK(NRI.CreateCommandBuffer(*commandAllocator, commandBuffer) == nri::Result::SUCCESS);
+
+    // All readbacks are requested in the same frame
+    ReadbackCheck checks[TEXTURE_NUM + 1] = {};
+    for (uint32_t i = 0; i < TEXTURE_NUM; i++) {
+        checks[i] = {&textureContents[i], textureInfos[i].width * textureInfos[i].stride, textureInfos[i].height, 0};
+
+        nri::ReadbackRequestDesc readbackRequestDesc = {};
+        readbackRequestDesc.srcTexture = textures[i];
+        readbackRequestDesc.Callback = Callback;
+        readbackRequestDesc.userArg = &checks[i];
+
+        BENCHMARK_CHECK(benchmarkDevice.streamer.AddStreamerReadbackRequest(*streamer, readbackRequestDesc) == nri::Result::SUCCESS);
+    }
+
+    checks[TEXTURE_NUM] = {&bufferContents, 0, 0, 0};
+
+    nri::ReadbackRequestDesc readbackRequestDesc = {};
+    readbackRequestDesc.srcBuffer = buffer;
+    readbackRequestDesc.dataSize = BUFFER_SIZE;
+    readbackRequestDesc.Callback = Callback;
+    readbackRequestDesc.userArg = &checks[TEXTURE_NUM];
+
+    BENCHMARK_CHECK(benchmarkDevice.streamer.AddStreamerReadbackRequest(*streamer, readbackRequestDesc) == nri::Result::SUCCESS);
+
+    // Data gets delivered "FRAME_IN_FLIGHT_NUM + 1" frames later
+    for (uint32_t frame = 0; frame <= FRAME_IN_FLIGHT_NUM + 1; frame++) {
+        BENCHMARK_CHECK(benchmarkDevice.streamer.CopyStreamerUpdateRequests(*streamer) == nri::Result::SUCCESS);
+
+        NRI.ResetCommandAllocator(*commandAllocator);
+        BENCHMARK_CHECK(NRI.BeginCommandBuffer(*commandBuffer, nullptr) == nri::Result::SUCCESS);
+        benchmarkDevice.streamer.CmdUploadStreamerUpdateRequests(*commandBuffer, *streamer);
+        BENCHMARK_CHECK(NRI.EndCommandBuffer(*commandBuffer) == nri::Result::SUCCESS);
+
+        nri::QueueSubmitDesc queueSubmitDesc = {};
+        queueSubmitDesc.commandBuffers = &commandBuffer;
+        queueSubmitDesc.commandBufferNum = 1;
+
+        NRI.QueueSubmit(*commandQueue, queueSubmitDesc);
+        BENCHMARK_CHECK(benchmarkDevice.helper.WaitForIdle(*commandQueue) == nri::Result::SUCCESS);
+    }
+
+    for (const ReadbackCheck& check : checks)
+        BENCHMARK_CHECK(check.deliveredNum == 1);
+
+    printf("OK: %u texture readbacks and a buffer readback in one frame\n", TEXTURE_NUM);
+
+    NRI.DestroyCommandBuffer(*commandBuffer);
+    NRI.DestroyCommandAllocator(*commandAllocator);
+    benchmarkDevice.streamer.DestroyStreamer(*streamer);
+
+    for (nri::Texture* texture : textures)
+        NRI.DestroyTexture(*texture);
+    NRI.DestroyBuffer(*buffer);
+
+    for (nri::Memory* memory : memories)
+        NRI.FreeMemory(*memory);
+
+    nriDestroyDevice(device);
+
+    return 0;
+}
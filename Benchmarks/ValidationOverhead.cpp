@@ -0,0 +1,136 @@
+// © 2024 NVIDIA Corporation
+
+// Per-command recording cost on the NONE backend, without and with the validation layer on top
+
+#include "Benchmark.h"
+
+constexpr uint32_t COMMAND_NUM = 200000;
+
+struct Commands {
+    double setPipelineLayout;
+    double setPipeline;
+    double dispatch; // "SetPipelineLayout" + "SetPipeline" + "Dispatch"
+    double copyBuffer;
+    double barrier;
+    double setViewports;
+};
+
+// Best of several recordings, in nanoseconds per iteration
+template <typename F>
+static double MeasureCommandNs(const nri::CoreInterface& NRI, nri::CommandBuffer& commandBuffer, F f) {
+    double best = 1e30;
+    for (uint32_t i = 0; i < 7; i++) {
+        NRI.BeginCommandBuffer(commandBuffer, nullptr);
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t j = 0; j < COMMAND_NUM; j++)
+            f();
+        best = std::min(best, GetElapsedMs(start));
+
+        NRI.EndCommandBuffer(commandBuffer);
+    }
+
+    return best * 1e6 / COMMAND_NUM;
+}
+
+static Commands MeasureCommands(bool enableValidation) {
+    BenchmarkDevice benchmarkDevice = CreateBenchmarkDevice({enableValidation, false, nullptr});
+    nri::Device& device = *benchmarkDevice.device;
+    const nri::CoreInterface& NRI = benchmarkDevice.core;
+
+    nri::CommandQueue* commandQueue = nullptr;
+    BENCHMARK_CHECK(NRI.GetCommandQueue(device, nri::CommandQueueType::GRAPHICS, commandQueue) == nri::Result::SUCCESS);
+
+    nri::CommandAllocator* commandAllocator = nullptr;
+    BENCHMARK_CHECK(NRI.CreateCommandAllocator(*commandQueue, commandAllocator) == nri::Result::SUCCESS);
+
+    nri::CommandBuffer* commandBuffer = nullptr;
+    BENCHMARK_CHECK(NRI.CreateCommandBuffer(*commandAllocator, commandBuffer) == nri::Result::SUCCESS);
+
+    // Resources
+    nri::BufferDesc bufferDesc = {};
+    bufferDesc.size = 1 << 16;
+    bufferDesc.usage = nri::BufferUsageBits::SHADER_RESOURCE;
+
+    nri::Buffer* buffers[2] = {};
+    for (nri::Buffer*& buffer : buffers)
+        BENCHMARK_CHECK(NRI.CreateBuffer(device, bufferDesc, buffer) == nri::Result::SUCCESS);
+
+    nri::ResourceGroupDesc resourceGroupDesc = {};
+    resourceGroupDesc.memoryLocation = nri::MemoryLocation::DEVICE;
+    resourceGroupDesc.buffers = buffers;
+    resourceGroupDesc.bufferNum = 2;
+
+    std::vector<nri::Memory*> memories(benchmarkDevice.helper.CalculateAllocationNumber(device, resourceGroupDesc));
+    BENCHMARK_CHECK(benchmarkDevice.helper.AllocateAndBindMemory(device, resourceGroupDesc, memories.data()) == nri::Result::SUCCESS);
+
+    // Pipeline
+    nri::PipelineLayoutDesc pipelineLayoutDesc = {};
+    pipelineLayoutDesc.shaderStages = nri::StageBits::COMPUTE_SHADER;
+
+    nri::PipelineLayout* pipelineLayout = nullptr;
+    BENCHMARK_CHECK(NRI.CreatePipelineLayout(device, pipelineLayoutDesc, pipelineLayout) == nri::Result::SUCCESS);
+
+    uint32_t code[4] = {};
+
+    nri::ComputePipelineDesc computePipelineDesc = {};
+    computePipelineDesc.pipelineLayout = pipelineLayout;
+    computePipelineDesc.shader = {nri::StageBits::COMPUTE_SHADER, code, sizeof(code), "main"};
+
+    nri::Pipeline* pipeline = nullptr;
+    BENCHMARK_CHECK(NRI.CreateComputePipeline(device, computePipelineDesc, pipeline) == nri::Result::SUCCESS);
+
+    // Commands
+    nri::CommandBuffer& cmd = *commandBuffer;
+
+    nri::BufferBarrierDesc bufferBarrier = {};
+    bufferBarrier.buffer = buffers[0];
+    bufferBarrier.before = {nri::AccessBits::COPY_SOURCE};
+    bufferBarrier.after = {nri::AccessBits::SHADER_RESOURCE};
+
+    nri::BarrierGroupDesc barrierGroupDesc = {};
+    barrierGroupDesc.buffers = &bufferBarrier;
+    barrierGroupDesc.bufferNum = 1;
+
+    nri::Viewport viewport = {0.0f, 0.0f, 1920.0f, 1080.0f, 0.0f, 1.0f};
+
+    Commands commands = {};
+    commands.setPipelineLayout = MeasureCommandNs(NRI, cmd, [&]() { NRI.CmdSetPipelineLayout(cmd, *pipelineLayout); });
+    commands.setPipeline = MeasureCommandNs(NRI, cmd, [&]() { NRI.CmdSetPipeline(cmd, *pipeline); });
+    commands.dispatch = MeasureCommandNs(NRI, cmd, [&]() {
+        NRI.CmdSetPipelineLayout(cmd, *pipelineLayout);
+        NRI.CmdSetPipeline(cmd, *pipeline);
+        NRI.CmdDispatch(cmd, {1, 1, 1});
+    });
+    commands.copyBuffer = MeasureCommandNs(NRI, cmd, [&]() { NRI.CmdCopyBuffer(cmd, *buffers[1], 0, *buffers[0], 0, 256); });
+    commands.barrier = MeasureCommandNs(NRI, cmd, [&]() { NRI.CmdBarrier(cmd, barrierGroupDesc); });
+    commands.setViewports = MeasureCommandNs(NRI, cmd, [&]() { NRI.CmdSetViewports(cmd, &viewport, 1); });
+
+    NRI.DestroyPipeline(*pipeline);
+    NRI.DestroyPipelineLayout(*pipelineLayout);
+    NRI.DestroyCommandBuffer(*commandBuffer);
+    NRI.DestroyCommandAllocator(*commandAllocator);
+
+    for (nri::Buffer* buffer : buffers)
+        NRI.DestroyBuffer(*buffer);
+
+    for (nri::Memory* memory : memories)
+        NRI.FreeMemory(*memory);
+
+    nriDestroyDevice(device);
+
+    return commands;
+}
+
+int main() {
+    const char* names[] = {"NONE", "Val + NONE"};
+
+    for (uint32_t i = 0; i < 2; i++) {
+        Commands commands = MeasureCommands(i != 0);
+
+        printf("%-10s: SetPipelineLayout %.1f ns, SetPipeline %.1f ns, SetPipelineLayout + SetPipeline + Dispatch %.1f ns, CopyBuffer %.1f ns, Barrier (1 buffer) %.1f ns, SetViewports %.1f ns\n",
+            names[i], commands.setPipelineLayout, commands.setPipeline, commands.dispatch, commands.copyBuffer, commands.barrier, commands.setViewports);
+    }
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+// © 2024 NVIDIA Corporation
+
+// Creation and destruction cost of small wrapper objects, which the validation layer serves from object pools
+
+#include "Benchmark.h"
+
+#include <thread>
+
+constexpr uint32_t OBJECT_NUM = 100000; // per pass, split across threads
+constexpr uint32_t PASS_NUM = 10;
+
+enum ObjectType : uint32_t {
+    BUFFER_VIEW,
+    BUFFER,
+    TEXTURE,
+    COMMAND_BUFFER,
+
+    MAX_NUM
+};
+
+int main() {
+    BenchmarkDevice benchmarkDevice = CreateBenchmarkDevice({true, false, nullptr});
+    nri::Device& device = *benchmarkDevice.device;
+    const nri::CoreInterface& NRI = benchmarkDevice.core;
+
+    nri::CommandQueue* commandQueue = nullptr;
+    BENCHMARK_CHECK(NRI.GetCommandQueue(device, nri::CommandQueueType::GRAPHICS, commandQueue) == nri::Result::SUCCESS);
+
+    nri::BufferDesc bufferDesc = {};
+    bufferDesc.size = 1 << 16;
+    bufferDesc.usage = nri::BufferUsageBits::SHADER_RESOURCE;
+
+    nri::Buffer* buffer = nullptr;
+    BENCHMARK_CHECK(NRI.CreateBuffer(device, bufferDesc, buffer) == nri::Result::SUCCESS);
+
+    nri::TextureDesc textureDesc = {};
+    textureDesc.type = nri::TextureType::TEXTURE_2D;
+    textureDesc.format = nri::Format::RGBA8_UNORM;
+    textureDesc.width = 256;
+    textureDesc.height = 256;
+    textureDesc.usage = nri::TextureUsageBits::SHADER_RESOURCE;
+
+    const char* names[] = {"BufferView", "Buffer", "Texture", "CommandBuffer"};
+
+    for (uint32_t threadNum : {1u, 4u}) {
+        for (uint32_t type = 0; type < MAX_NUM; type++) {
+            double createMs = 1e30;
+            double destroyMs = 1e30;
+
+            for (uint32_t pass = 0; pass < PASS_NUM; pass++) {
+                const uint32_t objectNum = OBJECT_NUM / threadNum;
+                std::vector<void*> objects(OBJECT_NUM);
+                std::vector<nri::CommandAllocator*> commandAllocators(threadNum);
+
+                for (nri::CommandAllocator*& commandAllocator : commandAllocators)
+                    BENCHMARK_CHECK(NRI.CreateCommandAllocator(*commandQueue, commandAllocator) == nri::Result::SUCCESS);
+
+                // All threads create, then all threads destroy
+                auto run = [&](bool isCreation) {
+                    std::vector<std::thread> threads;
+                    for (uint32_t i = 0; i < threadNum; i++) {
+                        threads.emplace_back([&, i]() {
+                            void** begin = objects.data() + i * objectNum;
+
+                            for (uint32_t j = 0; j < objectNum; j++) {
+                                void*& object = begin[j];
+
+                                if (type == BUFFER_VIEW) {
+                                    if (isCreation) {
+                                        nri::BufferViewDesc bufferViewDesc = {buffer, nri::BufferViewType::SHADER_RESOURCE, nri::Format::R32_UINT, 0, 256};
+                                        BENCHMARK_CHECK(NRI.CreateBufferView(bufferViewDesc, (nri::Descriptor*&)object) == nri::Result::SUCCESS);
+                                    } else
+                                        NRI.DestroyDescriptor(*(nri::Descriptor*)object);
+                                } else if (type == BUFFER) {
+                                    if (isCreation)
+                                        BENCHMARK_CHECK(NRI.CreateBuffer(device, bufferDesc, (nri::Buffer*&)object) == nri::Result::SUCCESS);
+                                    else
+                                        NRI.DestroyBuffer(*(nri::Buffer*)object);
+                                } else if (type == TEXTURE) {
+                                    if (isCreation)
+                                        BENCHMARK_CHECK(NRI.CreateTexture(device, textureDesc, (nri::Texture*&)object) == nri::Result::SUCCESS);
+                                    else
+                                        NRI.DestroyTexture(*(nri::Texture*)object);
+                                } else {
+                                    if (isCreation)
+                                        BENCHMARK_CHECK(NRI.CreateCommandBuffer(*commandAllocators[i], (nri::CommandBuffer*&)object) == nri::Result::SUCCESS);
+                                    else
+                                        NRI.DestroyCommandBuffer(*(nri::CommandBuffer*)object);
+                                }
+                            }
+                        });
+                    }
+
+                    for (std::thread& thread : threads)
+                        thread.join();
+                };
+
+                auto start = std::chrono::steady_clock::now();
+                run(true);
+                createMs = std::min(createMs, GetElapsedMs(start));
+
+                start = std::chrono::steady_clock::now();
+                run(false);
+                destroyMs = std::min(destroyMs, GetElapsedMs(start));
+
+                for (nri::CommandAllocator* commandAllocator : commandAllocators)
+                    NRI.DestroyCommandAllocator(*commandAllocator);
+            }
+
+            printf("%-13s, %u threads: create %.1f ns, destroy %.1f ns\n", names[type], threadNum, createMs * 1e6 / OBJECT_NUM, destroyMs * 1e6 / OBJECT_NUM);
+        }
+    }
+
+    NRI.DestroyBuffer(*buffer);
+    nriDestroyDevice(device);
+
+    return 0;
+}
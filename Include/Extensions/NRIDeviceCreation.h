@@ -38,6 +38,14 @@ NriStruct(VKExtensions) {
     uint32_t deviceExtensionNum;
 };
 
+// NONE only: a simulated GPU executes submissions asynchronously, fences get signaled when the simulated work is done
+NriStruct(NONETimingModel) {
+    uint32_t drawTime;                          // ns per draw (including indirect and mesh tasks)
+    uint32_t dispatchTime;                      // ns per dispatch (including indirect and rays)
+    uint32_t barrierTime;                       // ns per global, buffer or texture barrier
+    float copyByteTime;                         // ns per copied byte
+};
+
 NriStruct(DeviceCreationDesc) {
     NriOptional const NriPtr(AdapterDesc) adapterDesc;
     Nri(CallbackInterface) callbackInterface;
@@ -47,12 +55,19 @@ NriStruct(DeviceCreationDesc) {
     Nri(GraphicsAPI) graphicsAPI;
     uint32_t shaderExtRegister;                 // D3D12/D3D11 only
     uint32_t shaderExtSpace;                    // D3D12 only
+    uint32_t allocationStatisticsDumpPeriod;    // ms, if "enableAllocationTracking", statistics get periodically (checked by "ResetCommandAllocator") reported via "MessageCallback" (0 - never)
+    NriOptional const NriPtr(NONETimingModel) noneTimingModel; // NONE only: if provided, fences follow a simulated GPU timeline
+    NriOptional const char* noneCommandStatisticsPath; // NONE only: if "enableNONECommandProfiling", statistics get written to this JSON file on device destruction
 
     // Switches (disabled by default)
     bool enableNRIValidation;
     bool enableGraphicsAPIValidation;
     bool enableD3D12DrawParametersEmulation;    // not needed for VK, unsupported by D3D11
     bool enableD3D11CommandBufferEmulation;     // enable? but why? (auto-enabled if deferred contexts are not supported)
+    bool enableVKMemorySubAllocation;           // small "AllocateMemory" requests share big "vkAllocateMemory" blocks (see "AllocateMemoryDesc::alignment")
+    bool enableAllocationTracking;              // track host memory used by NRI per category (see "GetAllocationStatistics"), leaks get reported on device destruction
+    bool enableNONEHostMemory;                  // NONE only: device local memory gets real host allocations, copy commands get executed by the CPU on submission (host visible memory is always real)
+    bool enableNONECommandProfiling;            // NONE only: "Cmd*" calls get recorded, statistics get aggregated on submission (see "GetCommandStatistics")
 
     // Switches (enabled by default)
     bool disableVKRayTracing;                   // to save CPU memory in some implementations
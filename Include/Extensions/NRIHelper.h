@@ -4,11 +4,127 @@
 
 NriNamespaceBegin
 
+NriForwardStruct(DataUploader);
+
 NriStruct(VideoMemoryInfo) {
     uint64_t budgetSize;    // the OS-provided video memory budget. If "usageSize" > "budgetSize", the application may incur stuttering or performance penalties
     uint64_t usageSize;     // specifies the application’s current video memory usage
 };
 
+// Temporary host memory used internally by barriers, submits, descriptor updates... Small requests are served by the stack,
+// bigger ones by per-thread arenas, which are trimmed (if needed) by "ResetCommandAllocator"
+NriStruct(ScratchMemoryStatistics) {
+    uint64_t stackAllocationNum; // counted per thread, i.e. includes all devices
+    uint64_t arenaAllocationNum;
+    uint64_t heapAllocationNum; // arena growth, ideally stops after warm-up
+    uint64_t arenaSize;         // all arenas
+    uint32_t arenaNum;          // threads, which needed an arena
+};
+
+// Host memory used by NRI, requires "enableAllocationTracking"
+NriEnum(AllocationCategory, uint8_t,
+    DEVICE,         // everything not listed below (including 3rd party allocations)
+    DESCRIPTOR,     // descriptors, descriptor pools and sets
+    PIPELINE,       // pipelines and pipeline layouts
+    VALIDATION,     // NRI validation layer
+    SCRATCH,        // temporary memory
+    STREAMER        // streamer
+);
+
+NriStruct(AllocationStatistics) {
+    uint64_t liveSize;
+    uint64_t peakSize;
+    uint64_t totalNum;  // all allocations made
+    uint32_t liveNum;
+    uint32_t peakNum;
+};
+
+// Contention of NRI internal locks, aggregated by lock name, requires "NRI_ENABLE_LOCK_STATISTICS"
+NriStruct(LockStatistics) {
+    const char* name;
+    uint64_t acquireNum;
+    uint64_t contendedAcquireNum;   // not acquired immediately
+    uint64_t spinNum;               // spin iterations in contended acquires
+    uint64_t parkedTime;            // ns, time spent by threads parked
+    uint32_t lockNum;               // locks with this name created so far
+};
+
+// Command stream profiling: statistics of submitted command buffers, NONE only, requires "enableNONECommandProfiling"
+NriEnum(CommandType, uint8_t,
+    SET_DESCRIPTOR_POOL,
+    SET_DESCRIPTOR_SET,
+    SET_PIPELINE_LAYOUT,
+    SET_PIPELINE,
+    SET_ROOT_CONSTANTS,
+    SET_ROOT_DESCRIPTOR,
+    BARRIER,
+    SET_INDEX_BUFFER,
+    SET_VERTEX_BUFFERS,
+    SET_VIEWPORTS,
+    SET_SCISSORS,
+    SET_STENCIL_REFERENCE,
+    SET_DEPTH_BOUNDS,
+    SET_BLEND_CONSTANTS,
+    SET_SAMPLE_LOCATIONS,
+    SET_SHADING_RATE,
+    SET_DEPTH_BIAS,
+    BEGIN_RENDERING,
+    CLEAR_ATTACHMENTS,
+    DRAW,
+    DRAW_INDEXED,
+    DRAW_INDIRECT,
+    DRAW_INDEXED_INDIRECT,
+    END_RENDERING,
+    DISPATCH,
+    DISPATCH_INDIRECT,
+    COPY_BUFFER,
+    COPY_TEXTURE,
+    UPLOAD_BUFFER_TO_TEXTURE,
+    READBACK_TEXTURE_TO_BUFFER,
+    CLEAR_STORAGE_BUFFER,
+    CLEAR_STORAGE_TEXTURE,
+    RESOLVE_TEXTURE,
+    RESET_QUERIES,
+    BEGIN_QUERY,
+    END_QUERY,
+    COPY_QUERIES,
+    BEGIN_ANNOTATION,
+    END_ANNOTATION,
+    DRAW_MESH_TASKS,
+    DRAW_MESH_TASKS_INDIRECT,
+    BUILD_TOP_LEVEL_ACCELERATION_STRUCTURE,
+    BUILD_BOTTOM_LEVEL_ACCELERATION_STRUCTURE,
+    UPDATE_TOP_LEVEL_ACCELERATION_STRUCTURE,
+    UPDATE_BOTTOM_LEVEL_ACCELERATION_STRUCTURE,
+    DISPATCH_RAYS,
+    DISPATCH_RAYS_INDIRECT,
+    COPY_ACCELERATION_STRUCTURE,
+    WRITE_ACCELERATION_STRUCTURE_SIZE
+);
+
+NriStruct(CommandStatistics) {
+    uint64_t commandNum[(uint32_t)NriScopedMember(CommandType, MAX_NUM)];
+    uint64_t submitNum;             // "QueueSubmit" calls
+    uint64_t commandBufferNum;      // submitted command buffers
+    uint64_t globalBarrierNum;
+    uint64_t bufferBarrierNum;
+    uint64_t textureBarrierNum;
+    uint64_t copiedSize;            // bytes, copies, uploads and readbacks
+    uint64_t descriptorSetNum;      // bound descriptor sets
+    uint64_t stateChangeNum;        // "CmdSet*" calls
+    uint64_t redundantPipelineNum;  // "CmdSetPipeline" with the already bound pipeline
+    uint64_t drawNum;               // including indirect and mesh tasks
+    uint64_t dispatchNum;           // including indirect and rays
+    uint32_t pipelineNum;           // alive pipelines + destroyed ones (merged by name)
+};
+
+NriStruct(PipelineCommandStatistics) {
+    char name[64];                  // debug name, if set
+    uint64_t bindNum;
+    uint64_t drawNum;
+    uint64_t dispatchNum;
+};
+
 NriStruct(TextureSubresourceUploadDesc) {
     const void* slices;
     uint32_t sliceNum;
@@ -31,6 +147,58 @@ NriStruct(BufferUploadDesc) {
     Nri(AccessStage) after;
 };
 
+NriStruct(TextureDownloadDesc) {
+    NriPtr(Texture) texture;
+    Nri(TextureRegionDesc) region; // a single subresource
+    void* data;
+    NriOptional uint32_t dataRowPitch; // tightly packed if 0
+    NriOptional uint32_t dataSlicePitch; // tightly packed if 0
+    Nri(AccessLayoutStage) before; // the texture is returned to this state
+    Nri(PlaneBits) planes;
+};
+
+NriStruct(BufferDownloadDesc) {
+    void* data;
+    uint64_t dataSize;
+    NriPtr(Buffer) buffer;
+    uint64_t bufferOffset;
+    Nri(AccessStage) before; // the buffer is returned to this state
+};
+
+NriStruct(DataUploaderDesc) {
+    NriOptional uint64_t stagingBufferSize; // per staging slot, 1 Mb if 0 (grows if a texture subresource doesn't fit)
+
+    // Optional parallel filling of staging memory (i.e. a job system hook): call "Job(jobIndex, jobArg)" for each "jobIndex" in [0; jobNum) from any threads and return once all are done
+    NriOptional void (*ParallelFor)(uint32_t jobNum, void (*Job)(uint32_t jobIndex, void* jobArg), void* jobArg, void* userArg);
+    NriOptional void* userArg;
+};
+
+NriStruct(UploadTicket) {
+    NriPtr(Fence) fence;
+    uint64_t value; // the data is on the GPU when "fence" reaches "value"
+};
+
+NriStruct(ResourceLifetime) {
+    uint32_t firstPass;
+    uint32_t lastPass; // inclusive
+};
+
+// A range of an allocation, which a resource takes over from resources not used anymore (an aliasing barrier is needed before its "firstPass")
+NriStruct(AliasingRange) {
+    uint64_t offset;
+    uint64_t size;
+    uint32_t resource; // resources are indexed as "buffers" followed by "textures" (i.e. texture "i" has index "bufferNum + i")
+};
+
+NriStruct(AllocationReport) {
+    uint64_t size;
+    uint64_t unaliasedSize; // "size" if resources with disjoint lifetimes were not aliased
+    uint64_t wastedSize; // alignment and "bufferTextureGranularity" padding
+    uint32_t bufferNum;
+    uint32_t textureNum;
+    uint32_t aliasingRangeNum;
+};
+
 NriStruct(ResourceGroupDesc) {
     Nri(MemoryLocation) memoryLocation;
     NriPtr(Texture) const* textures;
@@ -38,6 +206,13 @@ NriStruct(ResourceGroupDesc) {
     NriPtr(Buffer) const* buffers;
     uint32_t bufferNum;
     uint64_t preferredMemorySize; // desired chunk size (but can be greater if a resource doesn't fit), 256 Mb if 0
+    bool bestFit; // sort resources by memory type, alignment and size and place each into the fullest chunk with room (less padding, but the input order is not preserved)
+    NriOptional NriPtr(AllocationReport) allocationReports; // if provided, gets one report per allocation (must have room for "CalculateAllocationNumber" entries)
+
+    // Transient aliasing: if lifetimes are provided, resources with disjoint lifetimes can share memory (buffers and textures don't alias each other)
+    NriOptional const NriPtr(ResourceLifetime) bufferLifetimes; // "bufferNum" entries
+    NriOptional const NriPtr(ResourceLifetime) textureLifetimes; // "textureNum" entries
+    NriOptional NriPtr(AliasingRange) aliasingRanges; // if provided, gets aliasing ranges of all allocations in allocation order (at most one per resource, i.e. "bufferNum + textureNum" entries are enough)
 };
 
 NriStruct(FormatProps) {
@@ -73,11 +248,34 @@ NriStruct(HelperInterface) {
     Nri(Result) (NRI_CALL *UploadData)                  (NriRef(CommandQueue) commandQueue, const NriPtr(TextureUploadDesc) textureUploadDescs, uint32_t textureUploadDescNum,
                                                             const NriPtr(BufferUploadDesc) bufferUploadDescs, uint32_t bufferUploadDescNum);
 
+    // Read back resources into host memory (not for streaming!). Blocking, alignment padding is removed
+    Nri(Result) (NRI_CALL *DownloadData)                (NriRef(CommandQueue) commandQueue, const NriPtr(TextureDownloadDesc) textureDownloadDescs, uint32_t textureDownloadDescNum,
+                                                            const NriPtr(BufferDownloadDesc) bufferDownloadDescs, uint32_t bufferDownloadDescNum);
+
+    // Persistent uploader, which keeps its staging memory, fence and command buffers alive between calls. "UploadDataAsync" returns right after submission,
+    // source memory can be released on return. Use the ticket to wait (or to submit dependent work) only when the resources are needed. Not thread safe
+    Nri(Result) (NRI_CALL *CreateDataUploader)          (NriRef(CommandQueue) commandQueue, const NriRef(DataUploaderDesc) dataUploaderDesc, NriOut NriRef(DataUploader*) dataUploader);
+    void        (NRI_CALL *DestroyDataUploader)         (NriRef(DataUploader) dataUploader); // waits for pending uploads
+    Nri(Result) (NRI_CALL *UploadDataAsync)             (NriRef(DataUploader) dataUploader, const NriPtr(TextureUploadDesc) textureUploadDescs, uint32_t textureUploadDescNum,
+                                                            const NriPtr(BufferUploadDesc) bufferUploadDescs, uint32_t bufferUploadDescNum, NriOut NriRef(UploadTicket) uploadTicket);
+
     // WFI
     Nri(Result) (NRI_CALL *WaitForIdle)                 (NriRef(CommandQueue) commandQueue);
 
     // Information about video memory
     Nri(Result) (NRI_CALL *QueryVideoMemoryInfo)        (const NriRef(Device) device, Nri(MemoryLocation) memoryLocation, NriOut NriRef(VideoMemoryInfo) videoMemoryInfo);
+
+    // Information about scratch memory usage (all threads). Thread safe
+    void        (NRI_CALL *GetScratchMemoryStatistics)  (const NriRef(Device) device, NriOut NriRef(ScratchMemoryStatistics) scratchMemoryStatistics);
+
+    // Information about host memory used by NRI per category. Returns "UNSUPPORTED" if "enableAllocationTracking" is not set. Thread safe
+    Nri(Result) (NRI_CALL *GetAllocationStatistics)     (const NriRef(Device) device, Nri(AllocationCategory) allocationCategory, NriOut NriRef(AllocationStatistics) allocationStatistics);
+
+    // Command stream statistics. NONE only (requires "enableNONECommandProfiling"), other backends always return "UNSUPPORTED". Thread safe
+    // if "pipelineCommandStatistics == NULL", then "pipelineCommandStatisticsNum" gets set to the number of pipelines (alive, then destroyed merged by name)
+    // else "pipelineCommandStatisticsNum" must be set to number of elements in "pipelineCommandStatistics"
+    Nri(Result) (NRI_CALL *GetCommandStatistics)        (const NriRef(Device) device, NriOut NriRef(CommandStatistics) commandStatistics,
+                                                            NriPtr(PipelineCommandStatistics) pipelineCommandStatistics, NonNriRef(uint32_t) pipelineCommandStatisticsNum);
 };
 
 // Format utilities
@@ -87,6 +285,11 @@ NRI_API uint32_t NRI_CALL nriConvertNRIFormatToDXGI(Nri(Format) format);
 NRI_API uint32_t NRI_CALL nriConvertNRIFormatToVK(Nri(Format) format);
 NRI_API const NriRef(FormatProps) NRI_CALL nriGetFormatProps(Nri(Format) format);
 
+// Lock statistics (thread safe). "lockStatisticsNum" is always 0 if "NRI_ENABLE_LOCK_STATISTICS" is off
+// if "lockStatistics == NULL", then "lockStatisticsNum" gets set to the number of entries
+// else "lockStatisticsNum" must be set to number of elements in "lockStatistics"
+NRI_API void NRI_CALL nriGetLockStatistics(NriPtr(LockStatistics) lockStatistics, NonNriRef(uint32_t) lockStatisticsNum);
+
 // Strings
 NRI_API const char* NRI_CALL nriGetGraphicsAPIString(Nri(GraphicsAPI) graphicsAPI);
 
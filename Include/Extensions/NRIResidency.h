@@ -0,0 +1,62 @@
+// © 2024 NVIDIA Corporation
+
+#pragma once
+
+// Budget-aware residency management, built on top of "QueryVideoMemoryInfo":
+//  - resources get registered with a priority and get marked as used when referenced by a frame
+//  - "UpdateResidency" watches the budget every frame and, if the usage gets close to it, evicts cold resources
+//    (least recently used within the lowest priority first) before the OS starts paging
+//  - evicted resources get reported via the callback: the application is expected to release them (after the GPU
+//    is done with them), unregister their IDs and re-stream (and register again) when they are needed again
+//  - an evicted ID stays reserved until "UnregisterResidencyResource", i.e. a stale ID never aliases a newer resource
+
+NriNamespaceBegin
+
+NriForwardStruct(ResidencyManager);
+
+NriStruct(ResidencyResourceDesc) {
+    // A buffer or a texture, expected to be in "MemoryLocation::DEVICE"
+    NriOptional NriPtr(Buffer) buffer;
+    NriOptional NriPtr(Texture) texture;
+    float priority; // [-1; 1]: low < 0, normal = 0, high > 0 (same as "memoryPriority"), lower priority resources get evicted first
+    NriOptional void* userArg;
+};
+
+NriStruct(ResidencyManagerDesc) {
+    // Required. Called by "UpdateResidency", "resources" and "ids" are valid only during the call
+    void (*Callback)(const NriPtr(ResidencyResourceDesc) resources, const uint32_t* ids, uint32_t resourceNum, void* userArg);
+    NriOptional void* userArg;
+
+    NriOptional float budgetUsage;          // the fraction of the budget to stay under (0.9 if 0)
+    NriOptional uint32_t protectedFrameNum; // resources used in the last "protectedFrameNum" frames are never evicted, evicted memory is expected to be released in this time (3 if 0)
+};
+
+NriStruct(ResidencyStatistics) {
+    uint64_t budgetSize;            // queried by the last "UpdateResidency"
+    uint64_t usageSize;             // queried by the last "UpdateResidency"
+    uint64_t registeredSize;        // all registered resources
+    uint64_t pendingEvictionSize;   // evicted in the last "protectedFrameNum" frames, may be still reported in "usageSize"
+    uint64_t evictedSize;           // by the last "UpdateResidency"
+    uint32_t registeredResourceNum;
+    uint32_t evictedResourceNum;    // by the last "UpdateResidency"
+};
+
+NriStruct(ResidencyInterface) {
+    Nri(Result)     (NRI_CALL *CreateResidencyManager)          (NriRef(Device) device, const NriRef(ResidencyManagerDesc) residencyManagerDesc, NriOut NriRef(ResidencyManager*) residencyManager);
+    void            (NRI_CALL *DestroyResidencyManager)         (NriRef(ResidencyManager) residencyManager);
+
+    // Returns a non-zero ID, used to identify the resource. Must be unregistered even if evicted. Thread safe
+    uint32_t        (NRI_CALL *RegisterResidencyResource)       (NriRef(ResidencyManager) residencyManager, const NriRef(ResidencyResourceDesc) residencyResourceDesc);
+    void            (NRI_CALL *UnregisterResidencyResource)     (NriRef(ResidencyManager) residencyManager, uint32_t id);
+
+    // Mark a resource as used by the current frame (ignored for evicted resources). Thread safe
+    void            (NRI_CALL *MarkResidencyResourceUsed)       (NriRef(ResidencyManager) residencyManager, uint32_t id);
+
+    // Advance the frame, check the budget and evict resources if needed. Must be called once per frame
+    Nri(Result)     (NRI_CALL *UpdateResidency)                 (NriRef(ResidencyManager) residencyManager);
+
+    // Statistics
+    void            (NRI_CALL *GetResidencyStatistics)          (const NriRef(ResidencyManager) residencyManager, NriOut NriRef(ResidencyStatistics) residencyStatistics);
+};
+
+NriNamespaceEnd
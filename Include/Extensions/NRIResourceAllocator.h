@@ -29,10 +29,40 @@ NriStruct(AllocateAccelerationStructureDesc) {
     float memoryPriority;
 };
 
+// Defragmentation (VK only, other APIs return "UNSUPPORTED"):
+//  - only listed resources, allocated via this interface, can be relocated (pass the ones which can be rebuilt on the fly)
+//  - listed textures must be in "Layout::SHADER_RESOURCE", they stay in it after relocation
+//  - a relocated resource keeps its pointer, but gets a new native object: descriptors, device addresses and native handles must be recreated
+//  - listed resources must not be destroyed until "EndDefragmentation"
+NriStruct(DefragmentationDesc) {
+    const NriPtr(Buffer) const* buffers;
+    const NriPtr(Texture) const* textures;
+    uint32_t bufferNum;
+    uint32_t textureNum;
+    uint64_t maxBytesPerPass;       // 0 - unlimited, use it to avoid hitches
+    uint32_t maxAllocationsPerPass; // 0 - unlimited
+};
+
+NriStruct(DefragmentationReport) {
+    const uint32_t* relocatedBuffers;   // indices in "DefragmentationDesc::buffers", valid until the next defragmentation call
+    const uint32_t* relocatedTextures;  // indices in "DefragmentationDesc::textures"
+    uint32_t relocatedBufferNum;
+    uint32_t relocatedTextureNum;
+    uint64_t movedSize;
+    bool isFinished;                    // no more passes needed
+};
+
 NriStruct(ResourceAllocatorInterface) {
     Nri(Result) (NRI_CALL *AllocateBuffer)                  (NriRef(Device) device, const NriRef(AllocateBufferDesc) bufferDesc, NriOut NriRef(Buffer*) buffer);
     Nri(Result) (NRI_CALL *AllocateTexture)                 (NriRef(Device) device, const NriRef(AllocateTextureDesc) textureDesc, NriOut NriRef(Texture*) texture);
     Nri(Result) (NRI_CALL *AllocateAccelerationStructure)   (NriRef(Device) device, const NriRef(AllocateAccelerationStructureDesc) accelerationStructureDesc, NriOut NriRef(AccelerationStructure*) accelerationStructure);
+
+    // Defragmentation: "BeginDefragmentationPass" records copies into "commandBuffer" (expected to be in the recording state),
+    // "EndDefragmentationPass" must be called when its execution and all previous work involving relocated resources are completed
+    Nri(Result) (NRI_CALL *BeginDefragmentation)            (NriRef(Device) device, const NriRef(DefragmentationDesc) defragmentationDesc);
+    Nri(Result) (NRI_CALL *BeginDefragmentationPass)        (NriRef(Device) device, NriRef(CommandBuffer) commandBuffer);
+    Nri(Result) (NRI_CALL *EndDefragmentationPass)          (NriRef(Device) device, NriOut NriRef(DefragmentationReport) defragmentationReport);
+    void        (NRI_CALL *EndDefragmentation)              (NriRef(Device) device);
 };
 
 NriNamespaceEnd
@@ -6,6 +6,8 @@ NriNamespaceBegin
 
 NriForwardStruct(Streamer);
 
+static const uint64_t NriConstant(STREAMER_INVALID_OFFSET) = (uint64_t)(-1); // returned by "Add" calls if out of memory
+
 NriStruct(StreamerDesc) {
     // Statically allocated ring-buffer for dynamic constants
     NriOptional Nri(MemoryLocation) constantBufferMemoryLocation; // UPLOAD or DEVICE_UPLOAD
@@ -15,27 +17,85 @@ NriStruct(StreamerDesc) {
     Nri(MemoryLocation) dynamicBufferMemoryLocation; // UPLOAD or DEVICE_UPLOAD
     Nri(BufferUsageBits) dynamicBufferUsageBits;
     uint32_t frameInFlightNum;
+
+    // Shrink policy for the dynamic buffer (0 - never shrink)
+    NriOptional uint32_t shrinkFrameNum; // the buffer gets shrunk to fit the high-water mark of the last "shrinkFrameNum" frames
+
+    // Per-frame budget (0 - unlimited)
+    // If set, queued requests get scheduled in priority order by "CopyStreamerUpdateRequests" until the budget is exhausted,
+    // the rest is postponed to next frames. At least one request is scheduled per frame. Requests added by "Add" calls are never postponed
+    NriOptional uint64_t frameBudgetSize;
+
+    // Background file reading (0 - files get read synchronously by "CopyStreamerUpdateRequests")
+    NriOptional uint32_t fileReadThreadNum;
 };
 
 NriStruct(BufferUpdateRequestDesc) {
     // Data to upload
-    const void* data; // pointer must be valid until "CopyStreamerUpdateRequests" call
+    const void* data; // pointer must be valid until "CopyStreamerUpdateRequests" call (or until the request is complete, if queued)
     uint64_t dataSize;
 
+    // Data to read from a file (if "data" is NULL)
+    NriOptional const char* filePath; // must be valid until "CopyStreamerUpdateRequests" call (or until the request is complete, if queued)
+    NriOptional uint64_t fileOffset;
+
     // Destination (ignored for constants)
     NriOptional NriPtr(Buffer) dstBuffer;
     NriOptional uint64_t dstBufferOffset;
+
+    // Scheduling (queued requests only)
+    NriOptional uint32_t priority; // higher goes first
 };
 
 NriStruct(TextureUpdateRequestDesc) {
     // Data to upload
-    const void* data; // pointer must be valid until "CopyStreamerUpdateRequests" call
+    const void* data; // pointer must be valid until "CopyStreamerUpdateRequests" call (or until the request is complete, if queued)
     uint32_t dataRowPitch;
     uint32_t dataSlicePitch;
 
+    // Data to read from a file (if "data" is NULL), rows and slices are tightly packed using "dataRowPitch" and "dataSlicePitch"
+    NriOptional const char* filePath; // must be valid until "CopyStreamerUpdateRequests" call (or until the request is complete, if queued)
+    NriOptional uint64_t fileOffset;
+
     // Destination
     NriPtr(Texture) dstTexture;
     Nri(TextureRegionDesc) dstRegionDesc;
+
+    // Scheduling (queued requests only)
+    NriOptional uint32_t priority; // higher goes first
+};
+
+NriStruct(ReadbackRequestDesc) {
+    // Source (a buffer or a texture)
+    NriOptional NriPtr(Buffer) srcBuffer;
+    NriOptional uint64_t srcBufferOffset;
+    NriOptional uint64_t dataSize; // for buffers
+    NriOptional NriPtr(Texture) srcTexture;
+    NriOptional Nri(TextureRegionDesc) srcRegionDesc;
+
+    // Called by "CopyStreamerUpdateRequests" "frameInFlightNum + 1" frames later, when the GPU is known to be done with the copy
+    // "data" is valid only during the call. Texture rows and slices are placed with "rowPitch" and "slicePitch" (padded to "uploadBufferTexture*Alignment")
+    void (*Callback)(const void* data, uint64_t dataSize, uint32_t rowPitch, uint32_t slicePitch, void* userArg);
+    NriOptional void* userArg;
+};
+
+NriStruct(StreamerStatistics) {
+    // Dynamic buffer
+    uint64_t streamedSize;          // by the last "CopyStreamerUpdateRequests"
+    uint64_t peakStreamedSize;      // max "streamedSize"
+    uint64_t dynamicBufferSize;
+    uint32_t growNum;
+    uint32_t shrinkNum;
+    uint32_t garbageInFlightNum;    // previous dynamic buffers, kept alive until they are not in use by the GPU
+    uint32_t pendingRequestNum;     // postponed due to "frameBudgetSize"
+
+    // Readback
+    uint64_t readbackBufferSize;    // total size of all readback ring slots
+    uint32_t readbackRequestNum;    // in flight, waiting for delivery
+
+    // Buffer copies (requests with destinations), gathered by "CopyStreamerUpdateRequests"
+    uint32_t bufferCopyRequestNum;  // before merging
+    uint32_t bufferCopyNum;         // after merging contiguous (in both source and destination) ranges, i.e. the number of "CmdCopyBuffer" calls
 };
 
 NriStruct(StreamerInterface) {
@@ -47,18 +107,38 @@ NriStruct(StreamerInterface) {
     Nri(Buffer*)    (NRI_CALL *GetStreamerDynamicBuffer)        (NriRef(Streamer) streamer);   // Valid only after "CopyStreamerUpdateRequests"
 
     // Add an update request. Return the offset in the ring buffer and don't invoke any work
+    // Thread safe: can be called from multiple threads simultaneously, but not concurrently with "CopyStreamerUpdateRequests"
     uint64_t        (NRI_CALL *AddStreamerBufferUpdateRequest)  (NriRef(Streamer) streamer, const NriRef(BufferUpdateRequestDesc) bufferUpdateRequestDesc);
     uint64_t        (NRI_CALL *AddStreamerTextureUpdateRequest) (NriRef(Streamer) streamer, const NriRef(TextureUpdateRequestDesc) textureUpdateRequestDesc);
 
-    // (HOST) Copy data and get the offset in the dedicated ring buffer (for dynamic constant buffers)
+    // Queue an update request with a destination. It gets scheduled by "CopyStreamerUpdateRequests" in priority order within "frameBudgetSize" (if any),
+    // the ring buffer offset is not exposed. Return a request ID for "IsStreamerRequestComplete". Thread safe (as "Add" calls)
+    Nri(Result)     (NRI_CALL *QueueStreamerBufferUpdateRequest)  (NriRef(Streamer) streamer, const NriRef(BufferUpdateRequestDesc) bufferUpdateRequestDesc, NriOut NriRef(uint64_t) requestId);
+    Nri(Result)     (NRI_CALL *QueueStreamerTextureUpdateRequest) (NriRef(Streamer) streamer, const NriRef(TextureUpdateRequestDesc) textureUpdateRequestDesc, NriOut NriRef(uint64_t) requestId);
+
+    // Add an update request without source data ("data" is ignored). Return a pointer for writing "dataSize" bytes and the offset in the ring buffer (never postponed)
+    // The caller must finish writing before "CopyStreamerUpdateRequests" and must not keep more than "frameInFlightNum" frames in flight (as for any ring buffer data)
+    // The pointer points to the mapped dynamic buffer, or to temporary memory if the buffer is too small or can't stay mapped while in use by the GPU (D3D11). Thread safe
+    void*           (NRI_CALL *ReserveStreamerBufferUpdate)     (NriRef(Streamer) streamer, const NriRef(BufferUpdateRequestDesc) bufferUpdateRequestDesc, NriOut NriRef(uint64_t) offset);
+
+    // Add a readback request. The copy gets recorded by "CmdUploadStreamerUpdateRequests", the data gets delivered via the callback (no waiting). Thread safe
+    Nri(Result)     (NRI_CALL *AddStreamerReadbackRequest)      (NriRef(Streamer) streamer, const NriRef(ReadbackRequestDesc) readbackRequestDesc);
+
+    // A queued request is complete if it has been scheduled by "CopyStreamerUpdateRequests", i.e. its data is copied and the source memory can be released
+    bool            (NRI_CALL *IsStreamerRequestComplete)       (const NriRef(Streamer) streamer, uint64_t requestId);
+
+    // (HOST) Copy data and get the offset in the dedicated ring buffer (for dynamic constant buffers). Thread safe
     uint32_t        (NRI_CALL *UpdateStreamerConstantBuffer)    (NriRef(Streamer) streamer, const void* data, uint32_t dataSize);
 
-    // (HOST) Copy gathered requests to the internal buffer, potentially a new one if the capacity exceeded. Must be called once per frame
+    // (HOST) Copy gathered requests to the internal buffer, potentially a new one if the capacity exceeded. Deliver finished readbacks. Must be called once per frame
     Nri(Result)     (NRI_CALL *CopyStreamerUpdateRequests)      (NriRef(Streamer) streamer);
 
-    // (DEVICE) Copy data to destinations (if any), barriers are externally controlled. Must be called after "CopyStreamerUpdateRequests"
+    // (DEVICE) Copy data to destinations and readback sources to the readback ring (if any), barriers are externally controlled. Must be called after "CopyStreamerUpdateRequests"
     // WARNING: D3D12 can silently promote a resource state to COPY_DESTINATION!
     void            (NRI_CALL *CmdUploadStreamerUpdateRequests) (NriRef(CommandBuffer) commandBuffer, NriRef(Streamer) streamer);
+
+    // Statistics
+    void            (NRI_CALL *GetStreamerStatistics)           (const NriRef(Streamer) streamer, NriOut NriRef(StreamerStatistics) streamerStatistics);
 };
 
 NriNamespaceEnd
\ No newline at end of file
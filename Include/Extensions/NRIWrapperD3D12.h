@@ -26,10 +26,12 @@ NriStruct(DeviceCreationD3D12Desc) {
     NriOptional AGSContext* agsContext;
     Nri(CallbackInterface) callbackInterface;
     Nri(AllocationCallbacks) allocationCallbacks;
+    uint32_t allocationStatisticsDumpPeriod; // ms, see "DeviceCreationDesc"
     bool isNVAPILoaded; // at least NVAPI requires calling "NvAPI_Initialize" in DLL/EXE where the device is created in addition to NRI
 
     // Switches (disabled by default)
     bool enableNRIValidation;
+    bool enableAllocationTracking; // see "DeviceCreationDesc"
     bool enableD3D12DrawParametersEmulation;
 };
 
@@ -24,10 +24,12 @@ NriStruct(DeviceCreationVKDesc) {
     const uint32_t* queueFamilyIndices;
     uint32_t queueFamilyIndexNum;
     const char* libraryPath;
+    uint32_t allocationStatisticsDumpPeriod; // ms, see "DeviceCreationDesc"
     uint8_t minorVersion; // >= 2
 
     // Switches (disabled by default)
     bool enableNRIValidation;
+    bool enableAllocationTracking; // see "DeviceCreationDesc"
 };
 
 NriStruct(CommandQueueVKDesc) {
@@ -1159,6 +1159,7 @@ NriStruct(AllocateMemoryDesc) {
     uint64_t size;
     Nri(MemoryType) type;
     float priority; // [-1; 1]: low < 0, normal = 0, high > 0
+    NriOptional uint32_t alignment; // max "MemoryDesc::alignment" of resources to be bound (used for VK sub-allocations, 64 Kb if 0)
 };
 
 NriStruct(BufferMemoryBindingDesc) {
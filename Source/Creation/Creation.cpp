@@ -57,6 +57,10 @@ NRI_API Result NRI_CALL nriGetInterface(const Device& device, const char* interf
         realInterfaceSize = sizeof(RayTracingInterface);
         if (realInterfaceSize == interfaceSize)
             result = deviceBase.FillFunctionTable(*(RayTracingInterface*)interfacePtr);
+    } else if (hash == Hash(NRI_STRINGIFY(nri::ResidencyInterface)) || hash == Hash(NRI_STRINGIFY(NRI_NAME_C(ResidencyInterface)))) {
+        realInterfaceSize = sizeof(ResidencyInterface);
+        if (realInterfaceSize == interfaceSize)
+            result = deviceBase.FillFunctionTable(*(ResidencyInterface*)interfacePtr);
     } else if (hash == Hash(NRI_STRINGIFY(nri::StreamerInterface)) || hash == Hash(NRI_STRINGIFY(NRI_NAME_C(StreamerInterface)))) {
         realInterfaceSize = sizeof(StreamerInterface);
         if (realInterfaceSize == interfaceSize)
@@ -105,8 +109,15 @@ NRI_API Result NRI_CALL nriGetInterface(const Device& device, const char* interf
 
 template <typename T>
 Result FinalizeDeviceCreation(const T& deviceCreationDesc, DeviceBase& deviceImpl, Device*& device) {
-    if (deviceCreationDesc.enableNRIValidation && deviceCreationDesc.graphicsAPI != GraphicsAPI::NONE) {
-        Device* deviceVal = (Device*)CreateDeviceValidation(deviceCreationDesc, deviceImpl);
+    if (deviceCreationDesc.enableNRIValidation) {
+        // Validation allocations get tracked under their own category
+        T deviceCreationDescVal = deviceCreationDesc;
+
+        AllocationTracker* allocationTracker = GetAllocationTracker(deviceImpl.GetStdAllocator().GetInterface());
+        if (allocationTracker)
+            deviceCreationDescVal.allocationCallbacks = allocationTracker->GetAllocationCallbacks(AllocationCategory::VALIDATION);
+
+        Device* deviceVal = (Device*)CreateDeviceValidation(deviceCreationDescVal, deviceImpl);
         if (!deviceVal) {
             nriDestroyDevice((Device&)deviceImpl);
             return Result::FAILURE;
@@ -127,6 +138,12 @@ NRI_API Result NRI_CALL nriCreateDevice(const DeviceCreationDesc& deviceCreation
     CheckAndSetDefaultCallbacks(modifiedDeviceCreationDesc.callbackInterface);
     CheckAndSetDefaultAllocator(modifiedDeviceCreationDesc.allocationCallbacks);
 
+    if (modifiedDeviceCreationDesc.enableAllocationTracking) {
+        Result trackerResult = CreateAllocationTracker(modifiedDeviceCreationDesc.allocationCallbacks, modifiedDeviceCreationDesc.callbackInterface, modifiedDeviceCreationDesc.allocationStatisticsDumpPeriod);
+        if (trackerResult != Result::SUCCESS)
+            return trackerResult;
+    }
+
 #if NRI_USE_NONE
     if (modifiedDeviceCreationDesc.graphicsAPI == GraphicsAPI::NONE)
         result = CreateDeviceNONE(modifiedDeviceCreationDesc, deviceImpl);
@@ -147,8 +164,10 @@ NRI_API Result NRI_CALL nriCreateDevice(const DeviceCreationDesc& deviceCreation
         result = CreateDeviceVK(modifiedDeviceCreationDesc, deviceImpl);
 #endif
 
-    if (result != Result::SUCCESS)
+    if (result != Result::SUCCESS) {
+        DestroyAllocationTracker(GetAllocationTracker(modifiedDeviceCreationDesc.allocationCallbacks));
         return result;
+    }
 
     return FinalizeDeviceCreation(modifiedDeviceCreationDesc, *deviceImpl, device);
 }
@@ -159,6 +178,7 @@ NRI_API Result NRI_CALL nriCreateDeviceFromD3D11Device(const DeviceCreationD3D11
     deviceCreationDesc.allocationCallbacks = deviceCreationD3D11Desc.allocationCallbacks;
     deviceCreationDesc.graphicsAPI = GraphicsAPI::D3D11;
     deviceCreationDesc.enableNRIValidation = deviceCreationD3D11Desc.enableNRIValidation;
+    deviceCreationDesc.enableAllocationTracking = deviceCreationD3D11Desc.enableAllocationTracking;
 
     CheckAndSetDefaultCallbacks(deviceCreationDesc.callbackInterface);
     CheckAndSetDefaultAllocator(deviceCreationDesc.allocationCallbacks);
@@ -168,6 +188,14 @@ NRI_API Result NRI_CALL nriCreateDeviceFromD3D11Device(const DeviceCreationD3D11
     CheckAndSetDefaultCallbacks(tempDeviceCreationD3D11Desc.callbackInterface);
     CheckAndSetDefaultAllocator(tempDeviceCreationD3D11Desc.allocationCallbacks);
 
+    if (deviceCreationD3D11Desc.enableAllocationTracking) {
+        Result trackerResult = CreateAllocationTracker(tempDeviceCreationD3D11Desc.allocationCallbacks, tempDeviceCreationD3D11Desc.callbackInterface, deviceCreationD3D11Desc.allocationStatisticsDumpPeriod);
+        if (trackerResult != Result::SUCCESS)
+            return trackerResult;
+
+        deviceCreationDesc.allocationCallbacks = tempDeviceCreationD3D11Desc.allocationCallbacks;
+    }
+
     Result result = Result::UNSUPPORTED;
     DeviceBase* deviceImpl = nullptr;
 
@@ -175,8 +203,10 @@ NRI_API Result NRI_CALL nriCreateDeviceFromD3D11Device(const DeviceCreationD3D11
     result = CreateDeviceD3D11(tempDeviceCreationD3D11Desc, deviceImpl);
 #endif
 
-    if (result != Result::SUCCESS)
+    if (result != Result::SUCCESS) {
+        DestroyAllocationTracker(GetAllocationTracker(tempDeviceCreationD3D11Desc.allocationCallbacks));
         return result;
+    }
 
     return FinalizeDeviceCreation(deviceCreationDesc, *deviceImpl, device);
 }
@@ -187,6 +217,7 @@ NRI_API Result NRI_CALL nriCreateDeviceFromD3D12Device(const DeviceCreationD3D12
     deviceCreationDesc.allocationCallbacks = deviceCreationD3D12Desc.allocationCallbacks;
     deviceCreationDesc.graphicsAPI = GraphicsAPI::D3D12;
     deviceCreationDesc.enableNRIValidation = deviceCreationD3D12Desc.enableNRIValidation;
+    deviceCreationDesc.enableAllocationTracking = deviceCreationD3D12Desc.enableAllocationTracking;
 
     CheckAndSetDefaultCallbacks(deviceCreationDesc.callbackInterface);
     CheckAndSetDefaultAllocator(deviceCreationDesc.allocationCallbacks);
@@ -196,6 +227,14 @@ NRI_API Result NRI_CALL nriCreateDeviceFromD3D12Device(const DeviceCreationD3D12
     CheckAndSetDefaultCallbacks(tempDeviceCreationD3D12Desc.callbackInterface);
     CheckAndSetDefaultAllocator(tempDeviceCreationD3D12Desc.allocationCallbacks);
 
+    if (deviceCreationD3D12Desc.enableAllocationTracking) {
+        Result trackerResult = CreateAllocationTracker(tempDeviceCreationD3D12Desc.allocationCallbacks, tempDeviceCreationD3D12Desc.callbackInterface, deviceCreationD3D12Desc.allocationStatisticsDumpPeriod);
+        if (trackerResult != Result::SUCCESS)
+            return trackerResult;
+
+        deviceCreationDesc.allocationCallbacks = tempDeviceCreationD3D12Desc.allocationCallbacks;
+    }
+
     Result result = Result::UNSUPPORTED;
     DeviceBase* deviceImpl = nullptr;
 
@@ -203,8 +242,10 @@ NRI_API Result NRI_CALL nriCreateDeviceFromD3D12Device(const DeviceCreationD3D12
     result = CreateDeviceD3D12(tempDeviceCreationD3D12Desc, deviceImpl);
 #endif
 
-    if (result != Result::SUCCESS)
+    if (result != Result::SUCCESS) {
+        DestroyAllocationTracker(GetAllocationTracker(tempDeviceCreationD3D12Desc.allocationCallbacks));
         return result;
+    }
 
     return FinalizeDeviceCreation(deviceCreationDesc, *deviceImpl, device);
 }
@@ -216,6 +257,7 @@ NRI_API Result NRI_CALL nriCreateDeviceFromVkDevice(const DeviceCreationVKDesc&
     deviceCreationDesc.spirvBindingOffsets = deviceCreationVKDesc.spirvBindingOffsets;
     deviceCreationDesc.graphicsAPI = GraphicsAPI::VK;
     deviceCreationDesc.enableNRIValidation = deviceCreationVKDesc.enableNRIValidation;
+    deviceCreationDesc.enableAllocationTracking = deviceCreationVKDesc.enableAllocationTracking;
 
     CheckAndSetDefaultCallbacks(deviceCreationDesc.callbackInterface);
     CheckAndSetDefaultAllocator(deviceCreationDesc.allocationCallbacks);
@@ -225,6 +267,14 @@ NRI_API Result NRI_CALL nriCreateDeviceFromVkDevice(const DeviceCreationVKDesc&
     CheckAndSetDefaultCallbacks(tempDeviceCreationVKDesc.callbackInterface);
     CheckAndSetDefaultAllocator(tempDeviceCreationVKDesc.allocationCallbacks);
 
+    if (deviceCreationVKDesc.enableAllocationTracking) {
+        Result trackerResult = CreateAllocationTracker(tempDeviceCreationVKDesc.allocationCallbacks, tempDeviceCreationVKDesc.callbackInterface, deviceCreationVKDesc.allocationStatisticsDumpPeriod);
+        if (trackerResult != Result::SUCCESS)
+            return trackerResult;
+
+        deviceCreationDesc.allocationCallbacks = tempDeviceCreationVKDesc.allocationCallbacks;
+    }
+
     Result result = Result::UNSUPPORTED;
     DeviceBase* deviceImpl = nullptr;
 
@@ -232,14 +282,21 @@ NRI_API Result NRI_CALL nriCreateDeviceFromVkDevice(const DeviceCreationVKDesc&
     result = CreateDeviceVK(tempDeviceCreationVKDesc, deviceImpl);
 #endif
 
-    if (result != Result::SUCCESS)
+    if (result != Result::SUCCESS) {
+        DestroyAllocationTracker(GetAllocationTracker(tempDeviceCreationVKDesc.allocationCallbacks));
         return result;
+    }
 
     return FinalizeDeviceCreation(deviceCreationDesc, *deviceImpl, device);
 }
 
 NRI_API void NRI_CALL nriDestroyDevice(Device& device) {
-    ((DeviceBase&)device).Destruct();
+    DeviceBase& deviceBase = (DeviceBase&)device;
+
+    // The tracker must outlive the device, since the device itself is a tracked allocation
+    AllocationTracker* allocationTracker = GetAllocationTracker(deviceBase.GetStdAllocator().GetInterface());
+    deviceBase.Destruct();
+    DestroyAllocationTracker(allocationTracker);
 }
 
 NRI_API Format NRI_CALL nriConvertVKFormatToNRI(uint32_t vkFormat) {
@@ -274,6 +331,10 @@ NRI_API const FormatProps& NRI_CALL nriGetFormatProps(Format format) {
     return GetFormatProps(format);
 }
 
+NRI_API void NRI_CALL nriGetLockStatistics(LockStatistics* lockStatistics, uint32_t& lockStatisticsNum) {
+    GetLockStatistics(lockStatistics, lockStatisticsNum);
+}
+
 NRI_API const char* NRI_CALL nriGetGraphicsAPIString(GraphicsAPI graphicsAPI) {
     switch (graphicsAPI) {
         case GraphicsAPI::NONE:
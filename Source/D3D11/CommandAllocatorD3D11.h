@@ -26,9 +26,7 @@ struct CommandAllocatorD3D11 {
         MaybeUnused(name);
     }
 
-    inline void Reset() {
-    }
-
+    void Reset();
     Result CreateCommandBuffer(CommandBuffer*& commandBuffer);
 
 private:
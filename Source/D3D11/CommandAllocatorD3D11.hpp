@@ -31,3 +31,7 @@ Result CreateCommandBuffer(DeviceD3D11& device, ID3D11DeviceContext* precreatedC
 NRI_INLINE Result CommandAllocatorD3D11::CreateCommandBuffer(CommandBuffer*& commandBuffer) {
     return ::CreateCommandBuffer(m_Device, nullptr, commandBuffer);
 }
+
+NRI_INLINE void CommandAllocatorD3D11::Reset() {
+    m_Device.OnCommandAllocatorReset();
+}
@@ -2,6 +2,8 @@
 
 #pragma once
 
+struct HelperDataUpload;
+
 namespace nri {
 
 struct DeviceD3D11;
@@ -11,8 +13,7 @@ struct CommandQueueD3D11 {
         : m_Device(device) {
     }
 
-    inline ~CommandQueueD3D11() {
-    }
+    ~CommandQueueD3D11();
 
     inline DeviceD3D11& GetDevice() const {
         return m_Device;
@@ -28,10 +29,13 @@ struct CommandQueueD3D11 {
 
     void Submit(const QueueSubmitDesc& queueSubmitDesc);
     Result UploadData(const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum);
+    Result DownloadData(const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDownloadDescNum, const BufferDownloadDesc* bufferDownloadDescs, uint32_t bufferDownloadDescNum);
     Result WaitForIdle();
 
 private:
     DeviceD3D11& m_Device;
+    HelperDataUpload* m_DataUploader = nullptr; // lazily created for the blocking "UploadData"
+    Lock m_DataUploaderLock{"CommandQueueD3D11::DataUploader"};
 };
 
 } // namespace nri
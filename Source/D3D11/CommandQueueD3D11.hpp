@@ -1,5 +1,10 @@
 // © 2021 NVIDIA Corporation
 
+CommandQueueD3D11::~CommandQueueD3D11() {
+    if (m_DataUploader)
+        Destroy(m_Device.GetStdAllocator(), m_DataUploader);
+}
+
 NRI_INLINE void CommandQueueD3D11::Submit(const QueueSubmitDesc& queueSubmitDesc) {
     for (uint32_t i = 0; i < queueSubmitDesc.waitFenceNum; i++) {
         const FenceSubmitDesc& fenceSubmitDesc = queueSubmitDesc.waitFences[i];
@@ -21,9 +26,27 @@ NRI_INLINE void CommandQueueD3D11::Submit(const QueueSubmitDesc& queueSubmitDesc
 
 NRI_INLINE Result CommandQueueD3D11::UploadData(
     const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum) {
-    HelperDataUpload helperDataUpload(m_Device.GetCoreInterface(), (Device&)m_Device, (CommandQueue&)*this);
+    ExclusiveScope lock(m_DataUploaderLock);
+
+    if (!m_DataUploader)
+        m_DataUploader = Allocate<HelperDataUpload>(m_Device.GetStdAllocator(), m_Device.GetCoreInterface(), (Device&)m_Device, (CommandQueue&)*this);
+
+    Result result = m_DataUploader->UploadData(textureUploadDescs, textureUploadDescNum, bufferUploadDescs, bufferUploadDescNum);
+
+    // The uploader state is unknown after a failure, start from scratch next time
+    if (result != Result::SUCCESS) {
+        Destroy(m_Device.GetStdAllocator(), m_DataUploader);
+        m_DataUploader = nullptr;
+    }
+
+    return result;
+}
+
+NRI_INLINE Result CommandQueueD3D11::DownloadData(
+    const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDownloadDescNum, const BufferDownloadDesc* bufferDownloadDescs, uint32_t bufferDownloadDescNum) {
+    HelperDataDownload helperDataDownload(m_Device.GetCoreInterface(), (Device&)m_Device, (CommandQueue&)*this);
 
-    return helperDataUpload.UploadData(textureUploadDescs, textureUploadDescNum, bufferUploadDescs, bufferUploadDescNum);
+    return helperDataDownload.DownloadData(textureDownloadDescs, textureDownloadDescNum, bufferDownloadDescs, bufferDownloadDescNum);
 }
 
 NRI_INLINE Result CommandQueueD3D11::WaitForIdle() {
@@ -31,6 +31,12 @@ DeviceD3D11::DeviceD3D11(const CallbackInterface& callbacks, StdAllocator<uint8_
 }
 
 DeviceD3D11::~DeviceD3D11() {
+    // Queues go first, since they own resources (data uploaders)
+    for (CommandQueueD3D11* commandQueue : m_CommandQueues) {
+        if (commandQueue)
+            Destroy(GetStdAllocator(), commandQueue);
+    }
+
     if (m_ImmediateContext)
         GetExt()->EndUAVOverlap(m_ImmediateContext);
 
@@ -40,11 +46,6 @@ DeviceD3D11::~DeviceD3D11() {
     if (m_Ext.HasAGS() && !m_IsWrapped)
         m_Ext.m_AGS.DestroyDeviceD3D11(m_Ext.m_AGSContext, m_Device, nullptr, m_ImmediateContext, nullptr);
 #endif
-
-    for (CommandQueueD3D11* commandQueue : m_CommandQueues) {
-        if (commandQueue)
-            Destroy(GetStdAllocator(), commandQueue);
-    }
 }
 
 Result DeviceD3D11::Create(const DeviceCreationDesc& deviceCreationDesc, ID3D11Device* device, AGSContext* agsContext, bool isNVAPILoadedInApp) {
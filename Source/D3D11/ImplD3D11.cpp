@@ -19,8 +19,10 @@
 #include "SwapChainD3D11.h"
 #include "TextureD3D11.h"
 
+#include "HelperDataDownload.h"
 #include "HelperDataUpload.h"
 #include "HelperDeviceMemoryAllocator.h"
+#include "ResidencyManager.h"
 #include "HelperWaitIdle.h"
 #include "Streamer.h"
 
@@ -121,6 +123,8 @@ static Result NRI_CALL CreateCommandAllocator(const CommandQueue& commandQueue,
 }
 
 static Result NRI_CALL CreateDescriptorPool(Device& device, const DescriptorPoolDesc& descriptorPoolDesc, DescriptorPool*& descriptorPool) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     return ((DeviceD3D11&)device).CreateImplementation<DescriptorPoolD3D11>(descriptorPool, descriptorPoolDesc);
 }
 
@@ -133,38 +137,54 @@ static Result NRI_CALL CreateTexture(Device& device, const TextureDesc& textureD
 }
 
 static Result NRI_CALL CreateBufferView(const BufferViewDesc& bufferViewDesc, Descriptor*& bufferView) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     DeviceD3D11& device = ((const BufferD3D11*)bufferViewDesc.buffer)->GetDevice();
     return device.CreateImplementation<DescriptorD3D11>(bufferView, bufferViewDesc);
 }
 
 static Result NRI_CALL CreateTexture1DView(const Texture1DViewDesc& textureViewDesc, Descriptor*& textureView) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     DeviceD3D11& device = ((const TextureD3D11*)textureViewDesc.texture)->GetDevice();
     return device.CreateImplementation<DescriptorD3D11>(textureView, textureViewDesc);
 }
 
 static Result NRI_CALL CreateTexture2DView(const Texture2DViewDesc& textureViewDesc, Descriptor*& textureView) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     DeviceD3D11& device = ((const TextureD3D11*)textureViewDesc.texture)->GetDevice();
     return device.CreateImplementation<DescriptorD3D11>(textureView, textureViewDesc);
 }
 
 static Result NRI_CALL CreateTexture3DView(const Texture3DViewDesc& textureViewDesc, Descriptor*& textureView) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     DeviceD3D11& device = ((const TextureD3D11*)textureViewDesc.texture)->GetDevice();
     return device.CreateImplementation<DescriptorD3D11>(textureView, textureViewDesc);
 }
 
 static Result NRI_CALL CreateSampler(Device& device, const SamplerDesc& samplerDesc, Descriptor*& sampler) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     return ((DeviceD3D11&)device).CreateImplementation<DescriptorD3D11>(sampler, samplerDesc);
 }
 
 static Result NRI_CALL CreatePipelineLayout(Device& device, const PipelineLayoutDesc& pipelineLayoutDesc, PipelineLayout*& pipelineLayout) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::PIPELINE);
+
     return ((DeviceD3D11&)device).CreateImplementation<PipelineLayoutD3D11>(pipelineLayout, pipelineLayoutDesc);
 }
 
 static Result NRI_CALL CreateGraphicsPipeline(Device& device, const GraphicsPipelineDesc& graphicsPipelineDesc, Pipeline*& pipeline) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::PIPELINE);
+
     return ((DeviceD3D11&)device).CreateImplementation<PipelineD3D11>(pipeline, graphicsPipelineDesc);
 }
 
 static Result NRI_CALL CreateComputePipeline(Device& device, const ComputePipelineDesc& computePipelineDesc, Pipeline*& pipeline) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::PIPELINE);
+
     return ((DeviceD3D11&)device).CreateImplementation<PipelineD3D11>(pipeline, computePipelineDesc);
 }
 
@@ -664,6 +684,8 @@ static void NRI_CALL SetDescriptorPoolDebugName(DescriptorPool& descriptorPool,
 }
 
 static Result NRI_CALL AllocateDescriptorSets(DescriptorPool& descriptorPool, const PipelineLayout& pipelineLayout, uint32_t setIndex, DescriptorSet** descriptorSets, uint32_t instanceNum, uint32_t variableDescriptorNum) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     return ((DescriptorPoolD3D11&)descriptorPool).AllocateDescriptorSets(pipelineLayout, setIndex, descriptorSets, instanceNum, variableDescriptorNum);
 }
 
@@ -887,6 +909,33 @@ static Result NRI_CALL UploadData(CommandQueue& commandQueue, const TextureUploa
     return ((CommandQueueD3D11&)commandQueue).UploadData(textureUploadDescs, textureUploadDescNum, bufferUploadDescs, bufferUploadDescNum);
 }
 
+static Result NRI_CALL DownloadData(CommandQueue& commandQueue, const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDownloadDescNum, const BufferDownloadDesc* bufferDownloadDescs, uint32_t bufferDownloadDescNum) {
+    return ((CommandQueueD3D11&)commandQueue).DownloadData(textureDownloadDescs, textureDownloadDescNum, bufferDownloadDescs, bufferDownloadDescNum);
+}
+
+static Result NRI_CALL CreateDataUploader(CommandQueue& commandQueue, const DataUploaderDesc& dataUploaderDesc, DataUploader*& dataUploader) {
+    DeviceD3D11& device = ((CommandQueueD3D11&)commandQueue).GetDevice();
+    HelperDataUpload* impl = Allocate<HelperDataUpload>(device.GetStdAllocator(), device.GetCoreInterface(), (Device&)device, commandQueue, dataUploaderDesc);
+    Result result = impl->Create();
+
+    if (result != Result::SUCCESS) {
+        Destroy(device.GetStdAllocator(), impl);
+        dataUploader = nullptr;
+    } else
+        dataUploader = (DataUploader*)impl;
+
+    return result;
+}
+
+static void NRI_CALL DestroyDataUploader(DataUploader& dataUploader) {
+    Destroy(((DeviceBase&)((HelperDataUpload&)dataUploader).GetDevice()).GetStdAllocator(), (HelperDataUpload*)&dataUploader);
+}
+
+static Result NRI_CALL UploadDataAsync(DataUploader& dataUploader, const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs,
+    uint32_t bufferUploadDescNum, UploadTicket& uploadTicket) {
+    return ((HelperDataUpload&)dataUploader).UploadDataAsync(textureUploadDescs, textureUploadDescNum, bufferUploadDescs, bufferUploadDescNum, uploadTicket);
+}
+
 static Result NRI_CALL WaitForIdle(CommandQueue& commandQueue) {
     if (!(&commandQueue))
         return Result::SUCCESS;
@@ -914,12 +963,31 @@ static Result NRI_CALL QueryVideoMemoryInfo(const Device& device, MemoryLocation
     return QueryVideoMemoryInfoDXGI(luid, memoryLocation, videoMemoryInfo);
 }
 
+static void NRI_CALL GetScratchMemoryStatistics(const Device& device, ScratchMemoryStatistics& scratchMemoryStatistics) {
+    ((DeviceD3D11&)device).GetScratchMemoryStatistics(scratchMemoryStatistics);
+}
+
+static Result NRI_CALL GetAllocationStatistics(const Device& device, AllocationCategory allocationCategory, AllocationStatistics& allocationStatistics) {
+    return ((DeviceD3D11&)device).GetAllocationStatistics(allocationCategory, allocationStatistics);
+}
+
+static Result NRI_CALL GetCommandStatistics(const Device&, CommandStatistics&, PipelineCommandStatistics*, uint32_t&) {
+    return Result::UNSUPPORTED;
+}
+
 Result DeviceD3D11::FillFunctionTable(HelperInterface& table) const {
     table.CalculateAllocationNumber = ::CalculateAllocationNumber;
     table.AllocateAndBindMemory = ::AllocateAndBindMemory;
     table.UploadData = ::UploadData;
+    table.DownloadData = ::DownloadData;
+    table.CreateDataUploader = ::CreateDataUploader;
+    table.DestroyDataUploader = ::DestroyDataUploader;
+    table.UploadDataAsync = ::UploadDataAsync;
     table.WaitForIdle = ::WaitForIdle;
     table.QueryVideoMemoryInfo = ::QueryVideoMemoryInfo;
+    table.GetScratchMemoryStatistics = ::GetScratchMemoryStatistics;
+    table.GetAllocationStatistics = ::GetAllocationStatistics;
+    table.GetCommandStatistics = ::GetCommandStatistics;
 
     return Result::SUCCESS;
 }
@@ -966,6 +1034,61 @@ Result DeviceD3D11::FillFunctionTable(LowLatencyInterface& table) const {
 
 #pragma endregion
 
+//============================================================================================================================================================================================
+#pragma region[  Residency  ]
+
+static Result CreateResidencyManager(Device& device, const ResidencyManagerDesc& residencyManagerDesc, ResidencyManager*& residencyManager) {
+    DeviceD3D11& deviceD3D11 = (DeviceD3D11&)device;
+    ResidencyManagerImpl* impl = Allocate<ResidencyManagerImpl>(deviceD3D11.GetStdAllocator(), device);
+    Result result = impl->Create(residencyManagerDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceD3D11.GetStdAllocator(), impl);
+        residencyManager = nullptr;
+    } else
+        residencyManager = (ResidencyManager*)impl;
+
+    return result;
+}
+
+static void DestroyResidencyManager(ResidencyManager& residencyManager) {
+    Destroy(((DeviceBase&)((ResidencyManagerImpl&)residencyManager).GetDevice()).GetStdAllocator(), (ResidencyManagerImpl*)&residencyManager);
+}
+
+static uint32_t RegisterResidencyResource(ResidencyManager& residencyManager, const ResidencyResourceDesc& residencyResourceDesc) {
+    return ((ResidencyManagerImpl&)residencyManager).RegisterResidencyResource(residencyResourceDesc);
+}
+
+static void UnregisterResidencyResource(ResidencyManager& residencyManager, uint32_t id) {
+    ((ResidencyManagerImpl&)residencyManager).UnregisterResidencyResource(id);
+}
+
+static void MarkResidencyResourceUsed(ResidencyManager& residencyManager, uint32_t id) {
+    ((ResidencyManagerImpl&)residencyManager).MarkResidencyResourceUsed(id);
+}
+
+static Result UpdateResidency(ResidencyManager& residencyManager) {
+    return ((ResidencyManagerImpl&)residencyManager).UpdateResidency();
+}
+
+static void GetResidencyStatistics(const ResidencyManager& residencyManager, ResidencyStatistics& residencyStatistics) {
+    ((const ResidencyManagerImpl&)residencyManager).GetResidencyStatistics(residencyStatistics);
+}
+
+Result DeviceD3D11::FillFunctionTable(ResidencyInterface& table) const {
+    table.CreateResidencyManager = ::CreateResidencyManager;
+    table.DestroyResidencyManager = ::DestroyResidencyManager;
+    table.RegisterResidencyResource = ::RegisterResidencyResource;
+    table.UnregisterResidencyResource = ::UnregisterResidencyResource;
+    table.MarkResidencyResourceUsed = ::MarkResidencyResourceUsed;
+    table.UpdateResidency = ::UpdateResidency;
+    table.GetResidencyStatistics = ::GetResidencyStatistics;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
 //============================================================================================================================================================================================
 #pragma region[  ResourceAllocator  ]
 
@@ -1001,10 +1124,32 @@ static Result AllocateAccelerationStructure(Device&, const AllocateAccelerationS
     return Result::UNSUPPORTED;
 }
 
+static Result BeginDefragmentation(Device&, const DefragmentationDesc&) {
+    return Result::UNSUPPORTED;
+}
+
+static Result BeginDefragmentationPass(Device&, CommandBuffer&) {
+    return Result::UNSUPPORTED;
+}
+
+static Result EndDefragmentationPass(Device&, DefragmentationReport& defragmentationReport) {
+    defragmentationReport = {};
+    defragmentationReport.isFinished = true;
+
+    return Result::UNSUPPORTED;
+}
+
+static void EndDefragmentation(Device&) {
+}
+
 Result DeviceD3D11::FillFunctionTable(ResourceAllocatorInterface& table) const {
     table.AllocateBuffer = ::AllocateBuffer;
     table.AllocateTexture = ::AllocateTexture;
     table.AllocateAccelerationStructure = ::AllocateAccelerationStructure;
+    table.BeginDefragmentation = ::BeginDefragmentation;
+    table.BeginDefragmentationPass = ::BeginDefragmentationPass;
+    table.EndDefragmentationPass = ::EndDefragmentationPass;
+    table.EndDefragmentation = ::EndDefragmentation;
 
     return Result::SUCCESS;
 }
@@ -1048,6 +1193,26 @@ static uint64_t AddStreamerTextureUpdateRequest(Streamer& streamer, const Textur
     return ((StreamerImpl&)streamer).AddStreamerTextureUpdateRequest(textureUpdateRequestDesc);
 }
 
+static Result QueueStreamerBufferUpdateRequest(Streamer& streamer, const BufferUpdateRequestDesc& bufferUpdateRequestDesc, uint64_t& requestId) {
+    return ((StreamerImpl&)streamer).QueueStreamerBufferUpdateRequest(bufferUpdateRequestDesc, requestId);
+}
+
+static Result QueueStreamerTextureUpdateRequest(Streamer& streamer, const TextureUpdateRequestDesc& textureUpdateRequestDesc, uint64_t& requestId) {
+    return ((StreamerImpl&)streamer).QueueStreamerTextureUpdateRequest(textureUpdateRequestDesc, requestId);
+}
+
+static void* ReserveStreamerBufferUpdate(Streamer& streamer, const BufferUpdateRequestDesc& bufferUpdateRequestDesc, uint64_t& offset) {
+    return ((StreamerImpl&)streamer).ReserveStreamerBufferUpdate(bufferUpdateRequestDesc, offset);
+}
+
+static Result AddStreamerReadbackRequest(Streamer& streamer, const ReadbackRequestDesc& readbackRequestDesc) {
+    return ((StreamerImpl&)streamer).AddStreamerReadbackRequest(readbackRequestDesc);
+}
+
+static bool IsStreamerRequestComplete(const Streamer& streamer, uint64_t requestId) {
+    return ((StreamerImpl&)streamer).IsStreamerRequestComplete(requestId);
+}
+
 static Result CopyStreamerUpdateRequests(Streamer& streamer) {
     return ((StreamerImpl&)streamer).CopyStreamerUpdateRequests();
 }
@@ -1060,6 +1225,10 @@ static void CmdUploadStreamerUpdateRequests(CommandBuffer& commandBuffer, Stream
     ((StreamerImpl&)streamer).CmdUploadStreamerUpdateRequests(commandBuffer);
 }
 
+static void GetStreamerStatistics(const Streamer& streamer, StreamerStatistics& streamerStatistics) {
+    ((StreamerImpl&)streamer).GetStatistics(streamerStatistics);
+}
+
 Result DeviceD3D11::FillFunctionTable(StreamerInterface& table) const {
     table.CreateStreamer = ::CreateStreamer;
     table.DestroyStreamer = ::DestroyStreamer;
@@ -1067,9 +1236,15 @@ Result DeviceD3D11::FillFunctionTable(StreamerInterface& table) const {
     table.GetStreamerDynamicBuffer = ::GetStreamerDynamicBuffer;
     table.AddStreamerBufferUpdateRequest = ::AddStreamerBufferUpdateRequest;
     table.AddStreamerTextureUpdateRequest = ::AddStreamerTextureUpdateRequest;
+    table.QueueStreamerBufferUpdateRequest = ::QueueStreamerBufferUpdateRequest;
+    table.QueueStreamerTextureUpdateRequest = ::QueueStreamerTextureUpdateRequest;
+    table.ReserveStreamerBufferUpdate = ::ReserveStreamerBufferUpdate;
+    table.AddStreamerReadbackRequest = ::AddStreamerReadbackRequest;
+    table.IsStreamerRequestComplete = ::IsStreamerRequestComplete;
     table.UpdateStreamerConstantBuffer = ::UpdateStreamerConstantBuffer;
     table.CopyStreamerUpdateRequests = ::CopyStreamerUpdateRequests;
     table.CmdUploadStreamerUpdateRequests = ::CmdUploadStreamerUpdateRequests;
+    table.GetStreamerStatistics = ::GetStreamerStatistics;
 
     return Result::SUCCESS;
 }
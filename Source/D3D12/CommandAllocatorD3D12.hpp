@@ -25,4 +25,6 @@ NRI_INLINE Result CommandAllocatorD3D12::CreateCommandBuffer(CommandBuffer*& com
 
 NRI_INLINE void CommandAllocatorD3D12::Reset() {
     m_CommandAllocator->Reset();
+
+    m_Device.OnCommandAllocatorReset();
 }
@@ -2,6 +2,8 @@
 
 #pragma once
 
+struct HelperDataUpload;
+
 struct ID3D12Device;
 struct ID3D12CommandQueue;
 enum D3D12_COMMAND_LIST_TYPE;
@@ -15,8 +17,7 @@ struct CommandQueueD3D12 {
         : m_Device(device) {
     }
 
-    inline ~CommandQueueD3D12() {
-    }
+    ~CommandQueueD3D12();
 
     inline operator ID3D12CommandQueue*() const {
         return m_CommandQueue.GetInterface();
@@ -43,10 +44,13 @@ struct CommandQueueD3D12 {
 
     void Submit(const QueueSubmitDesc& queueSubmitDesc);
     Result UploadData(const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum);
+    Result DownloadData(const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDownloadDescNum, const BufferDownloadDesc* bufferDownloadDescs, uint32_t bufferDownloadDescNum);
     Result WaitForIdle();
 
 private:
     DeviceD3D12& m_Device;
+    HelperDataUpload* m_DataUploader = nullptr; // lazily created for the blocking "UploadData"
+    Lock m_DataUploaderLock{"CommandQueueD3D12::DataUploader"};
     ComPtr<ID3D12CommandQueue> m_CommandQueue;
     D3D12_COMMAND_LIST_TYPE m_CommandListType = D3D12_COMMAND_LIST_TYPE(-1);
 };
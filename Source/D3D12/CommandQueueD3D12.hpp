@@ -1,5 +1,10 @@
 // © 2021 NVIDIA Corporation
 
+CommandQueueD3D12::~CommandQueueD3D12() {
+    if (m_DataUploader)
+        Destroy(m_Device.GetStdAllocator(), m_DataUploader);
+}
+
 Result CommandQueueD3D12::Create(CommandQueueType commandQueueType) {
     D3D12_COMMAND_QUEUE_DESC commandQueueDesc = {};
     commandQueueDesc.Priority = commandQueueType == CommandQueueType::HIGH_PRIORITY_COPY ? D3D12_COMMAND_QUEUE_PRIORITY_HIGH : D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
@@ -48,9 +53,27 @@ NRI_INLINE void CommandQueueD3D12::Submit(const QueueSubmitDesc& queueSubmitDesc
 
 NRI_INLINE Result CommandQueueD3D12::UploadData(
     const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum) {
-    HelperDataUpload helperDataUpload(m_Device.GetCoreInterface(), (Device&)m_Device, (CommandQueue&)*this);
+    ExclusiveScope lock(m_DataUploaderLock);
+
+    if (!m_DataUploader)
+        m_DataUploader = Allocate<HelperDataUpload>(m_Device.GetStdAllocator(), m_Device.GetCoreInterface(), (Device&)m_Device, (CommandQueue&)*this);
+
+    Result result = m_DataUploader->UploadData(textureUploadDescs, textureUploadDescNum, bufferUploadDescs, bufferUploadDescNum);
+
+    // The uploader state is unknown after a failure, start from scratch next time
+    if (result != Result::SUCCESS) {
+        Destroy(m_Device.GetStdAllocator(), m_DataUploader);
+        m_DataUploader = nullptr;
+    }
+
+    return result;
+}
+
+NRI_INLINE Result CommandQueueD3D12::DownloadData(
+    const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDownloadDescNum, const BufferDownloadDesc* bufferDownloadDescs, uint32_t bufferDownloadDescNum) {
+    HelperDataDownload helperDataDownload(m_Device.GetCoreInterface(), (Device&)m_Device, (CommandQueue&)*this);
 
-    return helperDataUpload.UploadData(textureUploadDescs, textureUploadDescNum, bufferUploadDescs, bufferUploadDescNum);
+    return helperDataDownload.DownloadData(textureDownloadDescs, textureDownloadDescNum, bufferDownloadDescs, bufferDownloadDescNum);
 }
 
 NRI_INLINE Result CommandQueueD3D12::WaitForIdle() {
@@ -103,6 +103,7 @@ struct DeviceD3D12 final : public DeviceBase {
     Result FillFunctionTable(LowLatencyInterface& table) const override;
     Result FillFunctionTable(MeshShaderInterface& table) const override;
     Result FillFunctionTable(RayTracingInterface& table) const override;
+    Result FillFunctionTable(ResidencyInterface& table) const override;
     Result FillFunctionTable(StreamerInterface& table) const override;
     Result FillFunctionTable(SwapChainInterface& table) const override;
     Result FillFunctionTable(ResourceAllocatorInterface& table) const override;
@@ -147,8 +148,8 @@ private:
     uint8_t m_Version = 0;
     bool m_IsWrapped = false;
     std::array<Lock, DESCRIPTOR_HEAP_TYPE_NUM> m_FreeDescriptorLocks;
-    Lock m_DescriptorHeapLock;
-    Lock m_QueueLock;
+    Lock m_DescriptorHeapLock{"DeviceD3D12::DescriptorHeap"};
+    Lock m_QueueLock{"DeviceD3D12::Queue"};
 };
 
 } // namespace nri
@@ -18,8 +18,10 @@
 #include "SwapChainD3D12.h"
 #include "TextureD3D12.h"
 
+#include "HelperDataDownload.h"
 #include "HelperDataUpload.h"
 #include "HelperDeviceMemoryAllocator.h"
+#include "ResidencyManager.h"
 #include "HelperWaitIdle.h"
 #include "Streamer.h"
 
@@ -325,6 +327,8 @@ static void NRI_CALL SetDescriptorPoolDebugName(DescriptorPool& descriptorPool,
 }
 
 static Result NRI_CALL AllocateDescriptorSets(DescriptorPool& descriptorPool, const PipelineLayout& pipelineLayout, uint32_t setIndex, DescriptorSet** descriptorSets, uint32_t instanceNum, uint32_t variableDescriptorNum) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     return ((DescriptorPoolD3D12&)descriptorPool).AllocateDescriptorSets(pipelineLayout, setIndex, descriptorSets, instanceNum, variableDescriptorNum);
 }
 
@@ -388,6 +392,8 @@ static Result NRI_CALL CreateCommandAllocator(const CommandQueue& commandQueue,
 }
 
 static Result NRI_CALL CreateDescriptorPool(Device& device, const DescriptorPoolDesc& descriptorPoolDesc, DescriptorPool*& descriptorPool) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     return ((DeviceD3D12&)device).CreateImplementation<DescriptorPoolD3D12>(descriptorPool, descriptorPoolDesc);
 }
 
@@ -400,38 +406,54 @@ static Result NRI_CALL CreateTexture(Device& device, const TextureDesc& textureD
 }
 
 static Result NRI_CALL CreateBufferView(const BufferViewDesc& bufferViewDesc, Descriptor*& bufferView) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     DeviceD3D12& device = ((const BufferD3D12*)bufferViewDesc.buffer)->GetDevice();
     return device.CreateImplementation<DescriptorD3D12>(bufferView, bufferViewDesc);
 }
 
 static Result NRI_CALL CreateTexture1DView(const Texture1DViewDesc& textureViewDesc, Descriptor*& textureView) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     DeviceD3D12& device = ((const TextureD3D12*)textureViewDesc.texture)->GetDevice();
     return device.CreateImplementation<DescriptorD3D12>(textureView, textureViewDesc);
 }
 
 static Result NRI_CALL CreateTexture2DView(const Texture2DViewDesc& textureViewDesc, Descriptor*& textureView) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     DeviceD3D12& device = ((const TextureD3D12*)textureViewDesc.texture)->GetDevice();
     return device.CreateImplementation<DescriptorD3D12>(textureView, textureViewDesc);
 }
 
 static Result NRI_CALL CreateTexture3DView(const Texture3DViewDesc& textureViewDesc, Descriptor*& textureView) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     DeviceD3D12& device = ((const TextureD3D12*)textureViewDesc.texture)->GetDevice();
     return device.CreateImplementation<DescriptorD3D12>(textureView, textureViewDesc);
 }
 
 static Result NRI_CALL CreateSampler(Device& device, const SamplerDesc& samplerDesc, Descriptor*& sampler) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     return ((DeviceD3D12&)device).CreateImplementation<DescriptorD3D12>(sampler, samplerDesc);
 }
 
 static Result NRI_CALL CreatePipelineLayout(Device& device, const PipelineLayoutDesc& pipelineLayoutDesc, PipelineLayout*& pipelineLayout) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::PIPELINE);
+
     return ((DeviceD3D12&)device).CreateImplementation<PipelineLayoutD3D12>(pipelineLayout, pipelineLayoutDesc);
 }
 
 static Result NRI_CALL CreateGraphicsPipeline(Device& device, const GraphicsPipelineDesc& graphicsPipelineDesc, Pipeline*& pipeline) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::PIPELINE);
+
     return ((DeviceD3D12&)device).CreateImplementation<PipelineD3D12>(pipeline, graphicsPipelineDesc);
 }
 
 static Result NRI_CALL CreateComputePipeline(Device& device, const ComputePipelineDesc& computePipelineDesc, Pipeline*& pipeline) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::PIPELINE);
+
     return ((DeviceD3D12&)device).CreateImplementation<PipelineD3D12>(pipeline, computePipelineDesc);
 }
 
@@ -675,6 +697,33 @@ static Result NRI_CALL UploadData(CommandQueue& commandQueue, const TextureUploa
     return ((CommandQueueD3D12&)commandQueue).UploadData(textureUploadDescs, textureUploadDescNum, bufferUploadDescs, bufferUploadDescNum);
 }
 
+static Result NRI_CALL DownloadData(CommandQueue& commandQueue, const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDownloadDescNum, const BufferDownloadDesc* bufferDownloadDescs, uint32_t bufferDownloadDescNum) {
+    return ((CommandQueueD3D12&)commandQueue).DownloadData(textureDownloadDescs, textureDownloadDescNum, bufferDownloadDescs, bufferDownloadDescNum);
+}
+
+static Result NRI_CALL CreateDataUploader(CommandQueue& commandQueue, const DataUploaderDesc& dataUploaderDesc, DataUploader*& dataUploader) {
+    DeviceD3D12& device = ((CommandQueueD3D12&)commandQueue).GetDevice();
+    HelperDataUpload* impl = Allocate<HelperDataUpload>(device.GetStdAllocator(), device.GetCoreInterface(), (Device&)device, commandQueue, dataUploaderDesc);
+    Result result = impl->Create();
+
+    if (result != Result::SUCCESS) {
+        Destroy(device.GetStdAllocator(), impl);
+        dataUploader = nullptr;
+    } else
+        dataUploader = (DataUploader*)impl;
+
+    return result;
+}
+
+static void NRI_CALL DestroyDataUploader(DataUploader& dataUploader) {
+    Destroy(((DeviceBase&)((HelperDataUpload&)dataUploader).GetDevice()).GetStdAllocator(), (HelperDataUpload*)&dataUploader);
+}
+
+static Result NRI_CALL UploadDataAsync(DataUploader& dataUploader, const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs,
+    uint32_t bufferUploadDescNum, UploadTicket& uploadTicket) {
+    return ((HelperDataUpload&)dataUploader).UploadDataAsync(textureUploadDescs, textureUploadDescNum, bufferUploadDescs, bufferUploadDescNum, uploadTicket);
+}
+
 static Result NRI_CALL WaitForIdle(CommandQueue& commandQueue) {
     if (!(&commandQueue))
         return Result::SUCCESS;
@@ -702,12 +751,31 @@ static Result NRI_CALL QueryVideoMemoryInfo(const Device& device, MemoryLocation
     return QueryVideoMemoryInfoDXGI(luid, memoryLocation, videoMemoryInfo);
 }
 
+static void NRI_CALL GetScratchMemoryStatistics(const Device& device, ScratchMemoryStatistics& scratchMemoryStatistics) {
+    ((DeviceD3D12&)device).GetScratchMemoryStatistics(scratchMemoryStatistics);
+}
+
+static Result NRI_CALL GetAllocationStatistics(const Device& device, AllocationCategory allocationCategory, AllocationStatistics& allocationStatistics) {
+    return ((DeviceD3D12&)device).GetAllocationStatistics(allocationCategory, allocationStatistics);
+}
+
+static Result NRI_CALL GetCommandStatistics(const Device&, CommandStatistics&, PipelineCommandStatistics*, uint32_t&) {
+    return Result::UNSUPPORTED;
+}
+
 Result DeviceD3D12::FillFunctionTable(HelperInterface& table) const {
     table.CalculateAllocationNumber = ::CalculateAllocationNumber;
     table.AllocateAndBindMemory = ::AllocateAndBindMemory;
     table.UploadData = ::UploadData;
+    table.DownloadData = ::DownloadData;
+    table.CreateDataUploader = ::CreateDataUploader;
+    table.DestroyDataUploader = ::DestroyDataUploader;
+    table.UploadDataAsync = ::UploadDataAsync;
     table.WaitForIdle = ::WaitForIdle;
     table.QueryVideoMemoryInfo = ::QueryVideoMemoryInfo;
+    table.GetScratchMemoryStatistics = ::GetScratchMemoryStatistics;
+    table.GetAllocationStatistics = ::GetAllocationStatistics;
+    table.GetCommandStatistics = ::GetCommandStatistics;
 
     return Result::SUCCESS;
 }
@@ -779,6 +847,8 @@ Result DeviceD3D12::FillFunctionTable(MeshShaderInterface& table) const {
 #pragma region[  RayTracing  ]
 
 static Result NRI_CALL CreateAccelerationStructureDescriptor(const AccelerationStructure& accelerationStructure, Descriptor*& descriptor) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     return ((AccelerationStructureD3D12&)accelerationStructure).CreateDescriptor(descriptor);
 }
 
@@ -839,6 +909,8 @@ static void NRI_CALL GetAccelerationStructureMemoryDesc(const Device& device, co
 }
 
 static Result NRI_CALL CreateRayTracingPipeline(Device& device, const RayTracingPipelineDesc& rayTracingPipelineDesc, Pipeline*& pipeline) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::PIPELINE);
+
     return ((DeviceD3D12&)device).CreateImplementation<PipelineD3D12>(pipeline, rayTracingPipelineDesc);
 }
 
@@ -888,6 +960,61 @@ Result DeviceD3D12::FillFunctionTable(RayTracingInterface& table) const {
 
 #pragma endregion
 
+//============================================================================================================================================================================================
+#pragma region[  Residency  ]
+
+static Result CreateResidencyManager(Device& device, const ResidencyManagerDesc& residencyManagerDesc, ResidencyManager*& residencyManager) {
+    DeviceD3D12& deviceD3D12 = (DeviceD3D12&)device;
+    ResidencyManagerImpl* impl = Allocate<ResidencyManagerImpl>(deviceD3D12.GetStdAllocator(), device);
+    Result result = impl->Create(residencyManagerDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceD3D12.GetStdAllocator(), impl);
+        residencyManager = nullptr;
+    } else
+        residencyManager = (ResidencyManager*)impl;
+
+    return result;
+}
+
+static void DestroyResidencyManager(ResidencyManager& residencyManager) {
+    Destroy(((DeviceBase&)((ResidencyManagerImpl&)residencyManager).GetDevice()).GetStdAllocator(), (ResidencyManagerImpl*)&residencyManager);
+}
+
+static uint32_t RegisterResidencyResource(ResidencyManager& residencyManager, const ResidencyResourceDesc& residencyResourceDesc) {
+    return ((ResidencyManagerImpl&)residencyManager).RegisterResidencyResource(residencyResourceDesc);
+}
+
+static void UnregisterResidencyResource(ResidencyManager& residencyManager, uint32_t id) {
+    ((ResidencyManagerImpl&)residencyManager).UnregisterResidencyResource(id);
+}
+
+static void MarkResidencyResourceUsed(ResidencyManager& residencyManager, uint32_t id) {
+    ((ResidencyManagerImpl&)residencyManager).MarkResidencyResourceUsed(id);
+}
+
+static Result UpdateResidency(ResidencyManager& residencyManager) {
+    return ((ResidencyManagerImpl&)residencyManager).UpdateResidency();
+}
+
+static void GetResidencyStatistics(const ResidencyManager& residencyManager, ResidencyStatistics& residencyStatistics) {
+    ((const ResidencyManagerImpl&)residencyManager).GetResidencyStatistics(residencyStatistics);
+}
+
+Result DeviceD3D12::FillFunctionTable(ResidencyInterface& table) const {
+    table.CreateResidencyManager = ::CreateResidencyManager;
+    table.DestroyResidencyManager = ::DestroyResidencyManager;
+    table.RegisterResidencyResource = ::RegisterResidencyResource;
+    table.UnregisterResidencyResource = ::UnregisterResidencyResource;
+    table.MarkResidencyResourceUsed = ::MarkResidencyResourceUsed;
+    table.UpdateResidency = ::UpdateResidency;
+    table.GetResidencyStatistics = ::GetResidencyStatistics;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
 //============================================================================================================================================================================================
 #pragma region[  ResourceAllocator  ]
 
@@ -903,10 +1030,32 @@ static Result AllocateAccelerationStructure(Device& device, const AllocateAccele
     return ((DeviceD3D12&)device).CreateImplementation<AccelerationStructureD3D12>(accelerationStructure, accelerationStructureDesc);
 }
 
+static Result BeginDefragmentation(Device&, const DefragmentationDesc&) {
+    return Result::UNSUPPORTED;
+}
+
+static Result BeginDefragmentationPass(Device&, CommandBuffer&) {
+    return Result::UNSUPPORTED;
+}
+
+static Result EndDefragmentationPass(Device&, DefragmentationReport& defragmentationReport) {
+    defragmentationReport = {};
+    defragmentationReport.isFinished = true;
+
+    return Result::UNSUPPORTED;
+}
+
+static void EndDefragmentation(Device&) {
+}
+
 Result DeviceD3D12::FillFunctionTable(ResourceAllocatorInterface& table) const {
     table.AllocateBuffer = ::AllocateBuffer;
     table.AllocateTexture = ::AllocateTexture;
     table.AllocateAccelerationStructure = ::AllocateAccelerationStructure;
+    table.BeginDefragmentation = ::BeginDefragmentation;
+    table.BeginDefragmentationPass = ::BeginDefragmentationPass;
+    table.EndDefragmentationPass = ::EndDefragmentationPass;
+    table.EndDefragmentation = ::EndDefragmentation;
 
     return Result::SUCCESS;
 }
@@ -950,6 +1099,26 @@ static uint64_t AddStreamerTextureUpdateRequest(Streamer& streamer, const Textur
     return ((StreamerImpl&)streamer).AddStreamerTextureUpdateRequest(textureUpdateRequestDesc);
 }
 
+static Result QueueStreamerBufferUpdateRequest(Streamer& streamer, const BufferUpdateRequestDesc& bufferUpdateRequestDesc, uint64_t& requestId) {
+    return ((StreamerImpl&)streamer).QueueStreamerBufferUpdateRequest(bufferUpdateRequestDesc, requestId);
+}
+
+static Result QueueStreamerTextureUpdateRequest(Streamer& streamer, const TextureUpdateRequestDesc& textureUpdateRequestDesc, uint64_t& requestId) {
+    return ((StreamerImpl&)streamer).QueueStreamerTextureUpdateRequest(textureUpdateRequestDesc, requestId);
+}
+
+static void* ReserveStreamerBufferUpdate(Streamer& streamer, const BufferUpdateRequestDesc& bufferUpdateRequestDesc, uint64_t& offset) {
+    return ((StreamerImpl&)streamer).ReserveStreamerBufferUpdate(bufferUpdateRequestDesc, offset);
+}
+
+static Result AddStreamerReadbackRequest(Streamer& streamer, const ReadbackRequestDesc& readbackRequestDesc) {
+    return ((StreamerImpl&)streamer).AddStreamerReadbackRequest(readbackRequestDesc);
+}
+
+static bool IsStreamerRequestComplete(const Streamer& streamer, uint64_t requestId) {
+    return ((StreamerImpl&)streamer).IsStreamerRequestComplete(requestId);
+}
+
 static Result CopyStreamerUpdateRequests(Streamer& streamer) {
     return ((StreamerImpl&)streamer).CopyStreamerUpdateRequests();
 }
@@ -962,6 +1131,10 @@ static void CmdUploadStreamerUpdateRequests(CommandBuffer& commandBuffer, Stream
     ((StreamerImpl&)streamer).CmdUploadStreamerUpdateRequests(commandBuffer);
 }
 
+static void GetStreamerStatistics(const Streamer& streamer, StreamerStatistics& streamerStatistics) {
+    ((StreamerImpl&)streamer).GetStatistics(streamerStatistics);
+}
+
 Result DeviceD3D12::FillFunctionTable(StreamerInterface& table) const {
     table.CreateStreamer = ::CreateStreamer;
     table.DestroyStreamer = ::DestroyStreamer;
@@ -969,9 +1142,15 @@ Result DeviceD3D12::FillFunctionTable(StreamerInterface& table) const {
     table.GetStreamerDynamicBuffer = ::GetStreamerDynamicBuffer;
     table.AddStreamerBufferUpdateRequest = ::AddStreamerBufferUpdateRequest;
     table.AddStreamerTextureUpdateRequest = ::AddStreamerTextureUpdateRequest;
+    table.QueueStreamerBufferUpdateRequest = ::QueueStreamerBufferUpdateRequest;
+    table.QueueStreamerTextureUpdateRequest = ::QueueStreamerTextureUpdateRequest;
+    table.ReserveStreamerBufferUpdate = ::ReserveStreamerBufferUpdate;
+    table.AddStreamerReadbackRequest = ::AddStreamerReadbackRequest;
+    table.IsStreamerRequestComplete = ::IsStreamerRequestComplete;
     table.UpdateStreamerConstantBuffer = ::UpdateStreamerConstantBuffer;
     table.CopyStreamerUpdateRequests = ::CopyStreamerUpdateRequests;
     table.CmdUploadStreamerUpdateRequests = ::CmdUploadStreamerUpdateRequests;
+    table.GetStreamerStatistics = ::GetStreamerStatistics;
 
     return Result::SUCCESS;
 }
@@ -1039,6 +1218,8 @@ static Result NRI_CALL CreateCommandBufferD3D12(Device& device, const CommandBuf
 }
 
 static Result NRI_CALL CreateDescriptorPoolD3D12(Device& device, const DescriptorPoolD3D12Desc& descriptorPoolDesc, DescriptorPool*& descriptorPool) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     return ((DeviceD3D12&)device).CreateImplementation<DescriptorPoolD3D12>(descriptorPool, descriptorPoolDesc);
 }
 
@@ -0,0 +1,53 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+struct DeviceNONE;
+struct MemoryNONE;
+
+struct BufferNONE {
+    inline BufferNONE(DeviceNONE& device)
+        : m_Device(device) {
+    }
+
+    ~BufferNONE();
+
+    inline const BufferDesc& GetDesc() const {
+        return m_Desc;
+    }
+
+    inline DeviceNONE& GetDevice() const {
+        return m_Device;
+    }
+
+    // NULL if not bound or bound to a memory without storage
+    inline uint8_t* GetData() const {
+        return m_Data;
+    }
+
+    Result Create(const BufferDesc& bufferDesc);
+    Result Create(MemoryLocation memoryLocation, float priority);
+    void Bind(const MemoryNONE& memory, uint64_t offset);
+
+    //================================================================================================================
+    // NRI
+    //================================================================================================================
+
+    inline void SetDebugName(const char* name) {
+        MaybeUnused(name);
+    }
+
+    inline void* Map(uint64_t offset) {
+        return m_Data ? m_Data + offset : nullptr;
+    }
+
+private:
+    DeviceNONE& m_Device;
+    MemoryNONE* m_DedicatedMemory = nullptr;
+    uint8_t* m_Data = nullptr;
+    BufferDesc m_Desc = {};
+};
+
+} // namespace nri
@@ -0,0 +1,37 @@
+// © 2021 NVIDIA Corporation
+
+BufferNONE::~BufferNONE() {
+    Destroy(m_DedicatedMemory);
+}
+
+NRI_INLINE Result BufferNONE::Create(const BufferDesc& bufferDesc) {
+    m_Desc = bufferDesc;
+
+    return Result::SUCCESS;
+}
+
+NRI_INLINE Result BufferNONE::Create(MemoryLocation memoryLocation, float priority) {
+    MemoryDesc memoryDesc = {};
+    m_Device.GetMemoryDesc(m_Desc, memoryLocation, memoryDesc);
+
+    AllocateMemoryDesc allocateMemoryDesc = {};
+    allocateMemoryDesc.size = memoryDesc.size;
+    allocateMemoryDesc.type = memoryDesc.type;
+    allocateMemoryDesc.priority = priority;
+    allocateMemoryDesc.alignment = memoryDesc.alignment;
+
+    Memory* memory = nullptr;
+    Result result = m_Device.CreateImplementation<MemoryNONE>(memory, allocateMemoryDesc);
+    if (result != Result::SUCCESS)
+        return result;
+
+    m_DedicatedMemory = (MemoryNONE*)memory;
+    Bind(*m_DedicatedMemory, 0);
+
+    return Result::SUCCESS;
+}
+
+NRI_INLINE void BufferNONE::Bind(const MemoryNONE& memory, uint64_t offset) {
+    uint8_t* data = memory.GetData();
+    m_Data = data ? data + offset : nullptr;
+}
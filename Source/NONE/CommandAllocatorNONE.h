@@ -0,0 +1,42 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+struct DeviceNONE;
+
+struct CommandAllocatorNONE {
+    inline CommandAllocatorNONE(DeviceNONE& device)
+        : m_Device(device) {
+    }
+
+    inline ~CommandAllocatorNONE() {
+    }
+
+    inline DeviceNONE& GetDevice() const {
+        return m_Device;
+    }
+
+    inline Result Create(const CommandQueue& commandQueue) {
+        MaybeUnused(commandQueue);
+
+        return Result::SUCCESS;
+    }
+
+    //================================================================================================================
+    // NRI
+    //================================================================================================================
+
+    inline void SetDebugName(const char* name) {
+        MaybeUnused(name);
+    }
+
+    void Reset();
+    Result CreateCommandBuffer(CommandBuffer*& commandBuffer);
+
+private:
+    DeviceNONE& m_Device;
+};
+
+} // namespace nri
@@ -0,0 +1,9 @@
+// © 2021 NVIDIA Corporation
+
+NRI_INLINE void CommandAllocatorNONE::Reset() {
+    m_Device.OnCommandAllocatorReset();
+}
+
+NRI_INLINE Result CommandAllocatorNONE::CreateCommandBuffer(CommandBuffer*& commandBuffer) {
+    return m_Device.CreateImplementation<CommandBufferNONE>(commandBuffer);
+}
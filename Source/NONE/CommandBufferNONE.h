@@ -0,0 +1,100 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+struct BufferNONE;
+struct DeviceNONE;
+struct TextureNONE;
+
+enum class CopyTypeNONE : uint8_t {
+    BUFFER,
+    TEXTURE,
+    UPLOAD_BUFFER_TO_TEXTURE,
+    READBACK_TEXTURE_TO_BUFFER
+};
+
+// Recorded only if "enableNONEHostMemory", executed by "CommandQueueNONE::Submit"
+struct CopyCommandNONE {
+    TextureRegionDesc region;
+    TextureRegionDesc srcRegion; // "TEXTURE" only
+    TextureDataLayoutDesc layout;
+    BufferNONE* buffer; // "BUFFER" and "READBACK_TEXTURE_TO_BUFFER": destination, "UPLOAD_BUFFER_TO_TEXTURE": source
+    BufferNONE* srcBuffer; // "BUFFER" only
+    TextureNONE* texture; // "TEXTURE": destination
+    TextureNONE* srcTexture; // "TEXTURE" only
+    uint64_t dstOffset;
+    uint64_t srcOffset;
+    uint64_t size;
+    CopyTypeNONE type;
+};
+
+struct CommandBufferNONE {
+    inline CommandBufferNONE(DeviceNONE& device)
+        : m_Device(device)
+        , m_CopyCommands(device.GetStdAllocator())
+        , m_Records(device.GetStdAllocator()) {
+    }
+
+    inline ~CommandBufferNONE() {
+    }
+
+    inline DeviceNONE& GetDevice() const {
+        return m_Device;
+    }
+
+    inline Result Create() {
+        return Result::SUCCESS;
+    }
+
+    inline const Vector<CommandRecordNONE>& GetRecords() const {
+        return m_Records;
+    }
+
+    inline void Record(CommandType type, uint64_t payload = 0, uint32_t num0 = 0, uint32_t num1 = 0) {
+        if (m_Device.IsCommandRecordingEnabled())
+            m_Records.push_back({payload, {num0, num1}, type});
+    }
+
+    // Simulated GPU time, valid after "End" (only if a timing model is provided)
+    inline uint64_t GetDuration() const {
+        return m_Duration;
+    }
+
+    void Execute() const;
+
+    //================================================================================================================
+    // NRI
+    //================================================================================================================
+
+    inline void SetDebugName(const char* name) {
+        MaybeUnused(name);
+    }
+
+    inline Result Begin(const DescriptorPool* descriptorPool) {
+        MaybeUnused(descriptorPool);
+        m_CopyCommands.clear();
+        m_Records.clear();
+        m_Duration = 0;
+
+        return Result::SUCCESS;
+    }
+
+    Result End();
+
+    void SetPipeline(const Pipeline& pipeline);
+    void Barrier(const BarrierGroupDesc& barrierGroupDesc);
+    void CopyBuffer(Buffer& dstBuffer, uint64_t dstOffset, const Buffer& srcBuffer, uint64_t srcOffset, uint64_t size);
+    void CopyTexture(Texture& dstTexture, const TextureRegionDesc* dstRegionDesc, const Texture& srcTexture, const TextureRegionDesc* srcRegionDesc);
+    void UploadBufferToTexture(Texture& dstTexture, const TextureRegionDesc& dstRegionDesc, const Buffer& srcBuffer, const TextureDataLayoutDesc& srcDataLayoutDesc);
+    void ReadbackTextureToBuffer(Buffer& dstBuffer, const TextureDataLayoutDesc& dstDataLayoutDesc, const Texture& srcTexture, const TextureRegionDesc& srcRegionDesc);
+
+private:
+    DeviceNONE& m_Device;
+    Vector<CopyCommandNONE> m_CopyCommands;
+    Vector<CommandRecordNONE> m_Records;
+    uint64_t m_Duration = 0;
+};
+
+} // namespace nri
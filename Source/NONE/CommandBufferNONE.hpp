@@ -0,0 +1,299 @@
+// © 2021 NVIDIA Corporation
+
+static void CopyBufferRegion(BufferNONE& dst, uint64_t dstOffset, const BufferNONE& src, uint64_t srcOffset, uint64_t size) {
+    uint8_t* dstData = dst.GetData();
+    const uint8_t* srcData = src.GetData();
+    if (!dstData || !srcData)
+        return;
+
+    uint64_t dstSize = dst.GetDesc().size;
+    uint64_t srcSize = src.GetDesc().size;
+    if (size == WHOLE_SIZE)
+        size = srcSize;
+
+    if (dstOffset >= dstSize || srcOffset >= srcSize)
+        return;
+
+    size = std::min(size, std::min(dstSize - dstOffset, srcSize - srcOffset));
+    memmove(dstData + dstOffset, srcData + srcOffset, (size_t)size);
+}
+
+// Returns "false" if the region is outside of the texture
+static bool ClampTextureRegion(const TextureDesc& textureDesc, const TextureRegionDesc& regionDesc, SubresourceLayoutNONE& subresource, TextureRegionDesc& clampedRegionDesc) {
+    if (regionDesc.mipOffset >= textureDesc.mipNum || regionDesc.layerOffset >= textureDesc.layerNum)
+        return false;
+
+    subresource = GetSubresourceLayout(textureDesc, regionDesc.layerOffset, regionDesc.mipOffset);
+    if (regionDesc.x >= subresource.width || regionDesc.y >= subresource.height || regionDesc.z >= subresource.depth)
+        return false;
+
+    uint32_t width = regionDesc.width == WHOLE_SIZE ? subresource.width : regionDesc.width;
+    uint32_t height = regionDesc.height == WHOLE_SIZE ? subresource.height : regionDesc.height;
+    uint32_t depth = regionDesc.depth == WHOLE_SIZE ? subresource.depth : regionDesc.depth;
+
+    clampedRegionDesc = regionDesc;
+    clampedRegionDesc.width = (Dim_t)std::min(width, (uint32_t)(subresource.width - regionDesc.x));
+    clampedRegionDesc.height = (Dim_t)std::min(height, (uint32_t)(subresource.height - regionDesc.y));
+    clampedRegionDesc.depth = (Dim_t)std::min(depth, (uint32_t)(subresource.depth - regionDesc.z));
+
+    return true;
+}
+
+// Tightly packed size of a region, "nullptr" means the whole texture
+static uint64_t GetTextureRegionSize(const TextureDesc& textureDesc, const TextureRegionDesc* regionDesc) {
+    if (!regionDesc)
+        return GetTextureSize(textureDesc);
+
+    SubresourceLayoutNONE subresource = {};
+    TextureRegionDesc clampedRegionDesc = {};
+    if (!ClampTextureRegion(textureDesc, *regionDesc, subresource, clampedRegionDesc))
+        return 0;
+
+    const FormatProps& formatProps = GetFormatProps(textureDesc.format);
+    uint64_t rowSize = (clampedRegionDesc.width + formatProps.blockWidth - 1) / formatProps.blockWidth * formatProps.stride;
+    uint64_t rowNum = (clampedRegionDesc.height + formatProps.blockHeight - 1) / formatProps.blockHeight;
+
+    return rowSize * rowNum * clampedRegionDesc.depth * textureDesc.sampleNum;
+}
+
+static void CopyTextureRegion(TextureNONE& texture, const TextureRegionDesc& regionDesc, BufferNONE& buffer, const TextureDataLayoutDesc& dataLayoutDesc, bool isUpload) {
+    uint8_t* textureData = texture.GetData();
+    uint8_t* bufferData = buffer.GetData();
+    if (!textureData || !bufferData)
+        return;
+
+    const TextureDesc& textureDesc = texture.GetDesc();
+    SubresourceLayoutNONE subresource = {};
+    TextureRegionDesc clampedRegionDesc = {};
+    if (!ClampTextureRegion(textureDesc, regionDesc, subresource, clampedRegionDesc))
+        return;
+
+    uint32_t width = clampedRegionDesc.width;
+    uint32_t height = clampedRegionDesc.height;
+    uint32_t depth = clampedRegionDesc.depth;
+
+    // In blocks
+    const FormatProps& formatProps = GetFormatProps(textureDesc.format);
+    uint32_t blockX = regionDesc.x / formatProps.blockWidth;
+    uint32_t blockY = regionDesc.y / formatProps.blockHeight;
+    uint32_t rowSize = (width + formatProps.blockWidth - 1) / formatProps.blockWidth * formatProps.stride;
+    uint32_t rowNum = (height + formatProps.blockHeight - 1) / formatProps.blockHeight;
+
+    uint64_t bufferRegionSize = dataLayoutDesc.offset + (depth - 1) * (uint64_t)dataLayoutDesc.slicePitch + (rowNum - 1) * (uint64_t)dataLayoutDesc.rowPitch + rowSize;
+    if (bufferRegionSize > buffer.GetDesc().size)
+        return;
+
+    for (uint32_t z = 0; z < depth; z++) {
+        for (uint32_t row = 0; row < rowNum; row++) {
+            uint8_t* texels = textureData + subresource.offset + (regionDesc.z + z) * subresource.slicePitch + (blockY + row) * (uint64_t)subresource.rowPitch + blockX * formatProps.stride;
+            uint8_t* bytes = bufferData + dataLayoutDesc.offset + z * (uint64_t)dataLayoutDesc.slicePitch + row * (uint64_t)dataLayoutDesc.rowPitch;
+
+            if (isUpload)
+                memcpy(texels, bytes, rowSize);
+            else
+                memcpy(bytes, texels, rowSize);
+        }
+    }
+}
+
+// "dstRegionDesc" provides the destination offset only, the size comes from "srcRegionDesc"
+static void CopyTextureToTexture(TextureNONE& dst, const TextureRegionDesc& dstRegionDesc, const TextureNONE& src, const TextureRegionDesc& srcRegionDesc) {
+    uint8_t* dstData = dst.GetData();
+    const uint8_t* srcData = src.GetData();
+    if (!dstData || !srcData)
+        return;
+
+    const TextureDesc& srcDesc = src.GetDesc();
+    SubresourceLayoutNONE srcSubresource = {};
+    TextureRegionDesc clampedSrcRegionDesc = {};
+    if (!ClampTextureRegion(srcDesc, srcRegionDesc, srcSubresource, clampedSrcRegionDesc))
+        return;
+
+    TextureRegionDesc dstRegionDescWithSize = dstRegionDesc;
+    dstRegionDescWithSize.width = clampedSrcRegionDesc.width;
+    dstRegionDescWithSize.height = clampedSrcRegionDesc.height;
+    dstRegionDescWithSize.depth = clampedSrcRegionDesc.depth;
+
+    const TextureDesc& dstDesc = dst.GetDesc();
+    SubresourceLayoutNONE dstSubresource = {};
+    TextureRegionDesc clampedDstRegionDesc = {};
+    if (!ClampTextureRegion(dstDesc, dstRegionDescWithSize, dstSubresource, clampedDstRegionDesc))
+        return;
+
+    // Formats must be copy-compatible, i.e. have the same block size
+    const FormatProps& formatProps = GetFormatProps(srcDesc.format);
+    const FormatProps& dstFormatProps = GetFormatProps(dstDesc.format);
+    if (formatProps.stride != dstFormatProps.stride || formatProps.blockWidth != dstFormatProps.blockWidth || formatProps.blockHeight != dstFormatProps.blockHeight)
+        return;
+
+    // In blocks
+    uint32_t srcBlockX = srcRegionDesc.x / formatProps.blockWidth;
+    uint32_t srcBlockY = srcRegionDesc.y / formatProps.blockHeight;
+    uint32_t dstBlockX = dstRegionDesc.x / formatProps.blockWidth;
+    uint32_t dstBlockY = dstRegionDesc.y / formatProps.blockHeight;
+    uint32_t rowSize = (clampedDstRegionDesc.width + formatProps.blockWidth - 1) / formatProps.blockWidth * formatProps.stride;
+    uint32_t rowNum = (clampedDstRegionDesc.height + formatProps.blockHeight - 1) / formatProps.blockHeight;
+
+    for (uint32_t z = 0; z < clampedDstRegionDesc.depth; z++) {
+        for (uint32_t row = 0; row < rowNum; row++) {
+            uint8_t* dstTexels = dstData + dstSubresource.offset + (dstRegionDesc.z + z) * dstSubresource.slicePitch + (dstBlockY + row) * (uint64_t)dstSubresource.rowPitch + dstBlockX * formatProps.stride;
+            const uint8_t* srcTexels = srcData + srcSubresource.offset + (srcRegionDesc.z + z) * srcSubresource.slicePitch + (srcBlockY + row) * (uint64_t)srcSubresource.rowPitch + srcBlockX * formatProps.stride;
+
+            memmove(dstTexels, srcTexels, rowSize); // the same texture is allowed
+        }
+    }
+}
+
+NRI_INLINE void CommandBufferNONE::Execute() const {
+    for (const CopyCommandNONE& copyCommand : m_CopyCommands) {
+        switch (copyCommand.type) {
+            case CopyTypeNONE::BUFFER:
+                CopyBufferRegion(*copyCommand.buffer, copyCommand.dstOffset, *copyCommand.srcBuffer, copyCommand.srcOffset, copyCommand.size);
+                break;
+            case CopyTypeNONE::TEXTURE:
+                CopyTextureToTexture(*copyCommand.texture, copyCommand.region, *copyCommand.srcTexture, copyCommand.srcRegion);
+                break;
+            case CopyTypeNONE::UPLOAD_BUFFER_TO_TEXTURE:
+                CopyTextureRegion(*copyCommand.texture, copyCommand.region, *copyCommand.buffer, copyCommand.layout, true);
+                break;
+            case CopyTypeNONE::READBACK_TEXTURE_TO_BUFFER:
+                CopyTextureRegion(*copyCommand.texture, copyCommand.region, *copyCommand.buffer, copyCommand.layout, false);
+                break;
+        }
+    }
+}
+
+NRI_INLINE Result CommandBufferNONE::End() {
+    const NONETimingModel* timingModel = m_Device.GetTimingModel();
+    if (!timingModel)
+        return Result::SUCCESS;
+
+    double duration = 0.0;
+    for (const CommandRecordNONE& record : m_Records) {
+        switch (record.type) {
+            case CommandType::BARRIER:
+                duration += double(record.payload + record.num[0] + record.num[1]) * timingModel->barrierTime;
+                break;
+            case CommandType::DRAW:
+            case CommandType::DRAW_INDEXED:
+            case CommandType::DRAW_INDIRECT:
+            case CommandType::DRAW_INDEXED_INDIRECT:
+            case CommandType::DRAW_MESH_TASKS:
+            case CommandType::DRAW_MESH_TASKS_INDIRECT:
+                duration += timingModel->drawTime;
+                break;
+            case CommandType::DISPATCH:
+            case CommandType::DISPATCH_INDIRECT:
+            case CommandType::DISPATCH_RAYS:
+            case CommandType::DISPATCH_RAYS_INDIRECT:
+                duration += timingModel->dispatchTime;
+                break;
+            case CommandType::COPY_BUFFER:
+            case CommandType::COPY_TEXTURE:
+            case CommandType::UPLOAD_BUFFER_TO_TEXTURE:
+            case CommandType::READBACK_TEXTURE_TO_BUFFER:
+                duration += double(record.payload) * timingModel->copyByteTime;
+                break;
+            default:
+                break;
+        }
+    }
+
+    m_Duration = (uint64_t)duration;
+
+    return Result::SUCCESS;
+}
+
+NRI_INLINE void CommandBufferNONE::SetPipeline(const Pipeline& pipeline) {
+    Record(CommandType::SET_PIPELINE, ((PipelineNONE&)pipeline).GetIndex());
+}
+
+NRI_INLINE void CommandBufferNONE::Barrier(const BarrierGroupDesc& barrierGroupDesc) {
+    Record(CommandType::BARRIER, barrierGroupDesc.globalNum, barrierGroupDesc.bufferNum, barrierGroupDesc.textureNum);
+}
+
+NRI_INLINE void CommandBufferNONE::CopyBuffer(Buffer& dstBuffer, uint64_t dstOffset, const Buffer& srcBuffer, uint64_t srcOffset, uint64_t size) {
+    if (m_Device.IsCommandRecordingEnabled()) {
+        uint64_t srcSize = ((BufferNONE&)srcBuffer).GetDesc().size;
+        uint64_t copiedSize = size == WHOLE_SIZE ? (srcOffset < srcSize ? srcSize - srcOffset : 0) : size;
+        Record(CommandType::COPY_BUFFER, copiedSize);
+    }
+
+    if (!m_Device.IsHostMemoryEnabled())
+        return;
+
+    CopyCommandNONE& copyCommand = m_CopyCommands.emplace_back();
+    copyCommand = {};
+    copyCommand.type = CopyTypeNONE::BUFFER;
+    copyCommand.buffer = (BufferNONE*)&dstBuffer;
+    copyCommand.srcBuffer = (BufferNONE*)&srcBuffer;
+    copyCommand.dstOffset = dstOffset;
+    copyCommand.srcOffset = srcOffset;
+    copyCommand.size = size;
+}
+
+NRI_INLINE void CommandBufferNONE::CopyTexture(Texture& dstTexture, const TextureRegionDesc* dstRegionDesc, const Texture& srcTexture, const TextureRegionDesc* srcRegionDesc) {
+    const TextureDesc& srcDesc = ((TextureNONE&)srcTexture).GetDesc();
+    if (m_Device.IsCommandRecordingEnabled())
+        Record(CommandType::COPY_TEXTURE, GetTextureRegionSize(srcDesc, srcRegionDesc));
+
+    if (!m_Device.IsHostMemoryEnabled())
+        return;
+
+    if (dstRegionDesc && srcRegionDesc) {
+        CopyCommandNONE& copyCommand = m_CopyCommands.emplace_back();
+        copyCommand = {};
+        copyCommand.type = CopyTypeNONE::TEXTURE;
+        copyCommand.texture = (TextureNONE*)&dstTexture;
+        copyCommand.region = *dstRegionDesc;
+        copyCommand.srcTexture = (TextureNONE*)&srcTexture;
+        copyCommand.srcRegion = *srcRegionDesc;
+
+        return;
+    }
+
+    // Whole resource: a copy per subresource
+    for (Dim_t layer = 0; layer < srcDesc.layerNum; layer++) {
+        for (Mip_t mip = 0; mip < srcDesc.mipNum; mip++) {
+            CopyCommandNONE& copyCommand = m_CopyCommands.emplace_back();
+            copyCommand = {};
+            copyCommand.type = CopyTypeNONE::TEXTURE;
+            copyCommand.texture = (TextureNONE*)&dstTexture;
+            copyCommand.region = {0, 0, 0, WHOLE_SIZE, WHOLE_SIZE, WHOLE_SIZE, mip, layer};
+            copyCommand.srcTexture = (TextureNONE*)&srcTexture;
+            copyCommand.srcRegion = copyCommand.region;
+        }
+    }
+}
+
+NRI_INLINE void CommandBufferNONE::UploadBufferToTexture(Texture& dstTexture, const TextureRegionDesc& dstRegionDesc, const Buffer& srcBuffer, const TextureDataLayoutDesc& srcDataLayoutDesc) {
+    if (m_Device.IsCommandRecordingEnabled())
+        Record(CommandType::UPLOAD_BUFFER_TO_TEXTURE, GetTextureRegionSize(((TextureNONE&)dstTexture).GetDesc(), &dstRegionDesc));
+
+    if (!m_Device.IsHostMemoryEnabled())
+        return;
+
+    CopyCommandNONE& copyCommand = m_CopyCommands.emplace_back();
+    copyCommand = {};
+    copyCommand.type = CopyTypeNONE::UPLOAD_BUFFER_TO_TEXTURE;
+    copyCommand.texture = (TextureNONE*)&dstTexture;
+    copyCommand.region = dstRegionDesc;
+    copyCommand.buffer = (BufferNONE*)&srcBuffer;
+    copyCommand.layout = srcDataLayoutDesc;
+}
+
+NRI_INLINE void CommandBufferNONE::ReadbackTextureToBuffer(Buffer& dstBuffer, const TextureDataLayoutDesc& dstDataLayoutDesc, const Texture& srcTexture, const TextureRegionDesc& srcRegionDesc) {
+    if (m_Device.IsCommandRecordingEnabled())
+        Record(CommandType::READBACK_TEXTURE_TO_BUFFER, GetTextureRegionSize(((TextureNONE&)srcTexture).GetDesc(), &srcRegionDesc));
+
+    if (!m_Device.IsHostMemoryEnabled())
+        return;
+
+    CopyCommandNONE& copyCommand = m_CopyCommands.emplace_back();
+    copyCommand = {};
+    copyCommand.type = CopyTypeNONE::READBACK_TEXTURE_TO_BUFFER;
+    copyCommand.buffer = (BufferNONE*)&dstBuffer;
+    copyCommand.layout = dstDataLayoutDesc;
+    copyCommand.texture = (TextureNONE*)&srcTexture;
+    copyCommand.region = srcRegionDesc;
+}
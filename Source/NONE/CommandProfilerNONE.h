@@ -0,0 +1,44 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+// A recorded "Cmd*" call (only if "enableNONECommandProfiling" or "noneTimingModel")
+struct CommandRecordNONE {
+    uint64_t payload; // "BARRIER": global barriers, "SET_PIPELINE": pipeline index, copies: bytes
+    uint32_t num[2]; // "BARRIER": buffer and texture barriers
+    CommandType type;
+};
+
+struct PipelineSlotNONE {
+    PipelineCommandStatistics statistics;
+    bool isUsed;
+};
+
+// Aggregates recorded command streams at submission. Slots of destroyed pipelines get recycled, their statistics
+// get merged by name into "retired" entries, i.e. recreating a pipeline (hot reload) doesn't grow the list
+struct CommandProfilerNONE {
+    inline CommandProfilerNONE(StdAllocator<uint8_t>& stdAllocator)
+        : m_Pipelines(stdAllocator)
+        , m_FreePipelines(stdAllocator)
+        , m_RetiredPipelines(stdAllocator) {
+    }
+
+    uint32_t RegisterPipeline();
+    void UnregisterPipeline(uint32_t index);
+    void SetPipelineName(uint32_t index, const char* name);
+    void Accumulate(const QueueSubmitDesc& queueSubmitDesc);
+    Result GetStatistics(CommandStatistics& commandStatistics, PipelineCommandStatistics* pipelineCommandStatistics, uint32_t& pipelineCommandStatisticsNum);
+    bool WriteJSON(const char* path);
+
+private:
+    Lock m_Lock{"CommandProfilerNONE"};
+    Vector<PipelineSlotNONE> m_Pipelines;
+    Vector<uint32_t> m_FreePipelines;
+    Vector<PipelineCommandStatistics> m_RetiredPipelines;
+    uint32_t m_PipelineNum = 0; // alive
+    CommandStatistics m_Statistics = {};
+};
+
+} // namespace nri
@@ -0,0 +1,277 @@
+// © 2021 NVIDIA Corporation
+
+constexpr std::array<const char*, (size_t)CommandType::MAX_NUM> COMMAND_TYPE_NAME = {
+    "SET_DESCRIPTOR_POOL",
+    "SET_DESCRIPTOR_SET",
+    "SET_PIPELINE_LAYOUT",
+    "SET_PIPELINE",
+    "SET_ROOT_CONSTANTS",
+    "SET_ROOT_DESCRIPTOR",
+    "BARRIER",
+    "SET_INDEX_BUFFER",
+    "SET_VERTEX_BUFFERS",
+    "SET_VIEWPORTS",
+    "SET_SCISSORS",
+    "SET_STENCIL_REFERENCE",
+    "SET_DEPTH_BOUNDS",
+    "SET_BLEND_CONSTANTS",
+    "SET_SAMPLE_LOCATIONS",
+    "SET_SHADING_RATE",
+    "SET_DEPTH_BIAS",
+    "BEGIN_RENDERING",
+    "CLEAR_ATTACHMENTS",
+    "DRAW",
+    "DRAW_INDEXED",
+    "DRAW_INDIRECT",
+    "DRAW_INDEXED_INDIRECT",
+    "END_RENDERING",
+    "DISPATCH",
+    "DISPATCH_INDIRECT",
+    "COPY_BUFFER",
+    "COPY_TEXTURE",
+    "UPLOAD_BUFFER_TO_TEXTURE",
+    "READBACK_TEXTURE_TO_BUFFER",
+    "CLEAR_STORAGE_BUFFER",
+    "CLEAR_STORAGE_TEXTURE",
+    "RESOLVE_TEXTURE",
+    "RESET_QUERIES",
+    "BEGIN_QUERY",
+    "END_QUERY",
+    "COPY_QUERIES",
+    "BEGIN_ANNOTATION",
+    "END_ANNOTATION",
+    "DRAW_MESH_TASKS",
+    "DRAW_MESH_TASKS_INDIRECT",
+    "BUILD_TOP_LEVEL_ACCELERATION_STRUCTURE",
+    "BUILD_BOTTOM_LEVEL_ACCELERATION_STRUCTURE",
+    "UPDATE_TOP_LEVEL_ACCELERATION_STRUCTURE",
+    "UPDATE_BOTTOM_LEVEL_ACCELERATION_STRUCTURE",
+    "DISPATCH_RAYS",
+    "DISPATCH_RAYS_INDIRECT",
+    "COPY_ACCELERATION_STRUCTURE",
+    "WRITE_ACCELERATION_STRUCTURE_SIZE",
+};
+
+static void WriteJSONString(FILE* file, const char* s) {
+    fputc('"', file);
+
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\')
+            fputc('\\', file);
+
+        if ((uint8_t)*s >= 0x20)
+            fputc(*s, file);
+    }
+
+    fputc('"', file);
+}
+
+NRI_INLINE uint32_t CommandProfilerNONE::RegisterPipeline() {
+    ExclusiveScope lock(m_Lock);
+
+    uint32_t index = 0;
+    if (m_FreePipelines.empty()) {
+        index = (uint32_t)m_Pipelines.size();
+        m_Pipelines.push_back({});
+    } else {
+        index = m_FreePipelines.back();
+        m_FreePipelines.pop_back();
+    }
+
+    m_Pipelines[index] = {};
+    m_Pipelines[index].isUsed = true;
+    m_PipelineNum++;
+
+    return index;
+}
+
+NRI_INLINE void CommandProfilerNONE::UnregisterPipeline(uint32_t index) {
+    ExclusiveScope lock(m_Lock);
+
+    PipelineSlotNONE& slot = m_Pipelines[index];
+    const PipelineCommandStatistics& statistics = slot.statistics;
+
+    // Keep statistics of used pipelines, merged by name
+    if (statistics.bindNum) {
+        PipelineCommandStatistics* retired = nullptr;
+        for (PipelineCommandStatistics& retiredPipeline : m_RetiredPipelines) {
+            if (!strcmp(retiredPipeline.name, statistics.name)) {
+                retired = &retiredPipeline;
+                break;
+            }
+        }
+
+        if (retired) {
+            retired->bindNum += statistics.bindNum;
+            retired->drawNum += statistics.drawNum;
+            retired->dispatchNum += statistics.dispatchNum;
+        } else
+            m_RetiredPipelines.push_back(statistics);
+    }
+
+    slot.isUsed = false;
+    m_FreePipelines.push_back(index);
+    m_PipelineNum--;
+}
+
+NRI_INLINE void CommandProfilerNONE::SetPipelineName(uint32_t index, const char* name) {
+    ExclusiveScope lock(m_Lock);
+
+    PipelineCommandStatistics& pipelineCommandStatistics = m_Pipelines[index].statistics;
+    snprintf(pipelineCommandStatistics.name, sizeof(pipelineCommandStatistics.name), "%s", name ? name : "");
+}
+
+NRI_INLINE void CommandProfilerNONE::Accumulate(const QueueSubmitDesc& queueSubmitDesc) {
+    ExclusiveScope lock(m_Lock);
+
+    m_Statistics.submitNum++;
+    m_Statistics.commandBufferNum += queueSubmitDesc.commandBufferNum;
+
+    for (uint32_t i = 0; i < queueSubmitDesc.commandBufferNum; i++) {
+        const CommandBufferNONE* commandBuffer = (CommandBufferNONE*)queueSubmitDesc.commandBuffers[i];
+
+        // Draws and dispatches get attributed to the pipeline bound in the same command buffer
+        PipelineCommandStatistics* pipeline = nullptr;
+        uint64_t pipelineIndex = uint64_t(-1);
+
+        for (const CommandRecordNONE& record : commandBuffer->GetRecords()) {
+            m_Statistics.commandNum[(size_t)record.type]++;
+
+            switch (record.type) {
+                case CommandType::SET_PIPELINE:
+                    if (record.payload == pipelineIndex)
+                        m_Statistics.redundantPipelineNum++;
+
+                    pipelineIndex = record.payload;
+                    pipeline = &m_Pipelines[(size_t)pipelineIndex].statistics;
+                    pipeline->bindNum++;
+                    m_Statistics.stateChangeNum++;
+                    break;
+                case CommandType::SET_DESCRIPTOR_SET:
+                    m_Statistics.descriptorSetNum++;
+                    m_Statistics.stateChangeNum++;
+                    break;
+                case CommandType::SET_DESCRIPTOR_POOL:
+                case CommandType::SET_PIPELINE_LAYOUT:
+                case CommandType::SET_ROOT_CONSTANTS:
+                case CommandType::SET_ROOT_DESCRIPTOR:
+                case CommandType::SET_INDEX_BUFFER:
+                case CommandType::SET_VERTEX_BUFFERS:
+                case CommandType::SET_VIEWPORTS:
+                case CommandType::SET_SCISSORS:
+                case CommandType::SET_STENCIL_REFERENCE:
+                case CommandType::SET_DEPTH_BOUNDS:
+                case CommandType::SET_BLEND_CONSTANTS:
+                case CommandType::SET_SAMPLE_LOCATIONS:
+                case CommandType::SET_SHADING_RATE:
+                case CommandType::SET_DEPTH_BIAS:
+                    m_Statistics.stateChangeNum++;
+                    break;
+                case CommandType::BARRIER:
+                    m_Statistics.globalBarrierNum += record.payload;
+                    m_Statistics.bufferBarrierNum += record.num[0];
+                    m_Statistics.textureBarrierNum += record.num[1];
+                    break;
+                case CommandType::DRAW:
+                case CommandType::DRAW_INDEXED:
+                case CommandType::DRAW_INDIRECT:
+                case CommandType::DRAW_INDEXED_INDIRECT:
+                case CommandType::DRAW_MESH_TASKS:
+                case CommandType::DRAW_MESH_TASKS_INDIRECT:
+                    m_Statistics.drawNum++;
+                    if (pipeline)
+                        pipeline->drawNum++;
+                    break;
+                case CommandType::DISPATCH:
+                case CommandType::DISPATCH_INDIRECT:
+                case CommandType::DISPATCH_RAYS:
+                case CommandType::DISPATCH_RAYS_INDIRECT:
+                    m_Statistics.dispatchNum++;
+                    if (pipeline)
+                        pipeline->dispatchNum++;
+                    break;
+                case CommandType::COPY_BUFFER:
+                case CommandType::COPY_TEXTURE:
+                case CommandType::UPLOAD_BUFFER_TO_TEXTURE:
+                case CommandType::READBACK_TEXTURE_TO_BUFFER:
+                    m_Statistics.copiedSize += record.payload;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+NRI_INLINE Result CommandProfilerNONE::GetStatistics(CommandStatistics& commandStatistics, PipelineCommandStatistics* pipelineCommandStatistics, uint32_t& pipelineCommandStatisticsNum) {
+    ExclusiveScope lock(m_Lock);
+
+    uint32_t pipelineNum = m_PipelineNum + (uint32_t)m_RetiredPipelines.size();
+
+    commandStatistics = m_Statistics;
+    commandStatistics.pipelineNum = pipelineNum;
+
+    if (!pipelineCommandStatistics) {
+        pipelineCommandStatisticsNum = pipelineNum;
+        return Result::SUCCESS;
+    }
+
+    // Alive pipelines first, then retired ones
+    uint32_t n = 0;
+    for (size_t i = 0; i < m_Pipelines.size() && n < pipelineCommandStatisticsNum; i++) {
+        if (m_Pipelines[i].isUsed)
+            pipelineCommandStatistics[n++] = m_Pipelines[i].statistics;
+    }
+
+    for (size_t i = 0; i < m_RetiredPipelines.size() && n < pipelineCommandStatisticsNum; i++)
+        pipelineCommandStatistics[n++] = m_RetiredPipelines[i];
+
+    pipelineCommandStatisticsNum = n;
+
+    return Result::SUCCESS;
+}
+
+NRI_INLINE bool CommandProfilerNONE::WriteJSON(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file)
+        return false;
+
+    ExclusiveScope lock(m_Lock);
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"submitNum\": %llu,\n", (unsigned long long)m_Statistics.submitNum);
+    fprintf(file, "  \"commandBufferNum\": %llu,\n", (unsigned long long)m_Statistics.commandBufferNum);
+    fprintf(file, "  \"globalBarrierNum\": %llu,\n", (unsigned long long)m_Statistics.globalBarrierNum);
+    fprintf(file, "  \"bufferBarrierNum\": %llu,\n", (unsigned long long)m_Statistics.bufferBarrierNum);
+    fprintf(file, "  \"textureBarrierNum\": %llu,\n", (unsigned long long)m_Statistics.textureBarrierNum);
+    fprintf(file, "  \"copiedSize\": %llu,\n", (unsigned long long)m_Statistics.copiedSize);
+    fprintf(file, "  \"descriptorSetNum\": %llu,\n", (unsigned long long)m_Statistics.descriptorSetNum);
+    fprintf(file, "  \"stateChangeNum\": %llu,\n", (unsigned long long)m_Statistics.stateChangeNum);
+    fprintf(file, "  \"redundantPipelineNum\": %llu,\n", (unsigned long long)m_Statistics.redundantPipelineNum);
+    fprintf(file, "  \"drawNum\": %llu,\n", (unsigned long long)m_Statistics.drawNum);
+    fprintf(file, "  \"dispatchNum\": %llu,\n", (unsigned long long)m_Statistics.dispatchNum);
+
+    fprintf(file, "  \"commandNum\": {");
+    for (size_t i = 0; i < COMMAND_TYPE_NAME.size(); i++)
+        fprintf(file, "%s\n    \"%s\": %llu", i ? "," : "", COMMAND_TYPE_NAME[i], (unsigned long long)m_Statistics.commandNum[i]);
+    fprintf(file, "\n  },\n");
+
+    fprintf(file, "  \"pipelines\": [");
+    uint32_t pipelineNum = 0;
+    for (size_t i = 0; i < m_Pipelines.size() + m_RetiredPipelines.size(); i++) {
+        if (i < m_Pipelines.size() && !m_Pipelines[i].isUsed)
+            continue;
+
+        const PipelineCommandStatistics& pipeline = i < m_Pipelines.size() ? m_Pipelines[i].statistics : m_RetiredPipelines[i - m_Pipelines.size()];
+
+        fprintf(file, "%s\n    {\"name\": ", pipelineNum++ ? "," : "");
+        WriteJSONString(file, pipeline.name);
+        fprintf(file, ", \"bindNum\": %llu, \"drawNum\": %llu, \"dispatchNum\": %llu}",
+            (unsigned long long)pipeline.bindNum, (unsigned long long)pipeline.drawNum, (unsigned long long)pipeline.dispatchNum);
+    }
+    fprintf(file, "%s]\n", pipelineNum ? "\n  " : "");
+
+    fprintf(file, "}\n");
+
+    return fclose(file) == 0;
+}
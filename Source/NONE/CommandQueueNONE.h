@@ -0,0 +1,49 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+struct HelperDataUpload;
+
+namespace nri {
+
+struct DeviceNONE;
+
+struct CommandQueueNONE {
+    inline CommandQueueNONE(DeviceNONE& device)
+        : m_Device(device) {
+    }
+
+    ~CommandQueueNONE();
+
+    inline DeviceNONE& GetDevice() const {
+        return m_Device;
+    }
+
+    inline Result Create(CommandQueueType type) {
+        MaybeUnused(type);
+
+        return Result::SUCCESS;
+    }
+
+    //================================================================================================================
+    // NRI
+    //================================================================================================================
+
+    inline void SetDebugName(const char* name) {
+        MaybeUnused(name);
+    }
+
+    void Submit(const QueueSubmitDesc& queueSubmitDesc);
+    Result UploadData(const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum);
+    Result DownloadData(const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDownloadDescNum, const BufferDownloadDesc* bufferDownloadDescs, uint32_t bufferDownloadDescNum);
+    Result WaitForIdle();
+
+private:
+    DeviceNONE& m_Device;
+    HelperDataUpload* m_DataUploader = nullptr; // lazily created for the blocking "UploadData"
+    Lock m_DataUploaderLock{"CommandQueueNONE::DataUploader"};
+    Lock m_Lock{"CommandQueueNONE"};
+    uint64_t m_IdleTime = 0; // simulated GPU timeline
+};
+
+} // namespace nri
@@ -0,0 +1,75 @@
+// © 2021 NVIDIA Corporation
+
+CommandQueueNONE::~CommandQueueNONE() {
+    if (m_DataUploader)
+        Destroy(m_Device.GetStdAllocator(), m_DataUploader);
+}
+
+NRI_INLINE void CommandQueueNONE::Submit(const QueueSubmitDesc& queueSubmitDesc) {
+    ExclusiveScope lock(m_Lock);
+
+    if (m_Device.IsCommandProfilingEnabled())
+        m_Device.GetCommandProfiler().Accumulate(queueSubmitDesc);
+
+    // Simulated GPU: a submission starts when the queue is idle and all waits are satisfied
+    uint64_t completionTime = 0;
+    if (m_Device.GetTimingModel()) {
+        uint64_t startTime = std::max(GetTimeNs(), m_IdleTime);
+
+        for (uint32_t i = 0; i < queueSubmitDesc.waitFenceNum; i++) {
+            const FenceSubmitDesc& fenceSubmitDesc = queueSubmitDesc.waitFences[i];
+            FenceNONE* fence = (FenceNONE*)fenceSubmitDesc.fence;
+            startTime = std::max(startTime, fence->GetSignalTime(fenceSubmitDesc.value));
+        }
+
+        uint64_t duration = 0;
+        for (uint32_t i = 0; i < queueSubmitDesc.commandBufferNum; i++) {
+            const CommandBufferNONE* commandBuffer = (CommandBufferNONE*)queueSubmitDesc.commandBuffers[i];
+            duration += commandBuffer->GetDuration();
+        }
+
+        m_IdleTime = startTime + duration;
+        completionTime = m_IdleTime;
+    }
+
+    // Copies are executed right away, only fence signals follow the simulated timeline
+    for (uint32_t i = 0; i < queueSubmitDesc.commandBufferNum; i++) {
+        const CommandBufferNONE* commandBuffer = (CommandBufferNONE*)queueSubmitDesc.commandBuffers[i];
+        commandBuffer->Execute();
+    }
+
+    for (uint32_t i = 0; i < queueSubmitDesc.signalFenceNum; i++) {
+        const FenceSubmitDesc& fenceSubmitDesc = queueSubmitDesc.signalFences[i];
+        FenceNONE* fence = (FenceNONE*)fenceSubmitDesc.fence;
+        fence->QueueSignal(fenceSubmitDesc.value, completionTime);
+    }
+}
+
+NRI_INLINE Result CommandQueueNONE::UploadData(
+    const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum) {
+    ExclusiveScope lock(m_DataUploaderLock);
+
+    if (!m_DataUploader)
+        m_DataUploader = Allocate<HelperDataUpload>(m_Device.GetStdAllocator(), m_Device.GetCoreInterface(), (Device&)m_Device, (CommandQueue&)*this);
+
+    Result result = m_DataUploader->UploadData(textureUploadDescs, textureUploadDescNum, bufferUploadDescs, bufferUploadDescNum);
+
+    // The uploader state is unknown after a failure, start from scratch next time
+    if (result != Result::SUCCESS) {
+        Destroy(m_Device.GetStdAllocator(), m_DataUploader);
+        m_DataUploader = nullptr;
+    }
+
+    return result;
+}
+
+NRI_INLINE Result CommandQueueNONE::DownloadData(
+    const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDownloadDescNum, const BufferDownloadDesc* bufferDownloadDescs, uint32_t bufferDownloadDescNum) {
+    HelperDataDownload helperDataDownload(m_Device.GetCoreInterface(), (Device&)m_Device, (CommandQueue&)*this);
+
+    return helperDataDownload.DownloadData(textureDownloadDescs, textureDownloadDescNum, bufferDownloadDescs, bufferDownloadDescNum);
+}
+
+NRI_INLINE Result CommandQueueNONE::WaitForIdle() {
+    return WaitIdle(m_Device.GetCoreInterface(), (Device&)m_Device, (CommandQueue&)*this);
+}
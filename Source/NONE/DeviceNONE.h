@@ -0,0 +1,112 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+struct CommandQueueNONE;
+
+constexpr uint32_t NONE_BUFFER_ALIGNMENT = 16;
+constexpr uint32_t NONE_TEXTURE_ALIGNMENT = 256;
+
+// Simulated GPU timeline clock
+inline uint64_t GetTimeNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct DeviceNONE final : public DeviceBase {
+    DeviceNONE(const CallbackInterface& callbacks, StdAllocator<uint8_t>& stdAllocator);
+    ~DeviceNONE();
+
+    inline const CoreInterface& GetCoreInterface() const {
+        return m_CoreInterface;
+    }
+
+    // Device local memory gets real host allocations and copy commands get executed by the CPU at submission
+    inline bool IsHostMemoryEnabled() const {
+        return m_IsHostMemoryEnabled;
+    }
+
+    // Host visible memory is always real, since it can be mapped
+    inline bool HasStorage(MemoryLocation memoryLocation) const {
+        return m_IsHostMemoryEnabled || memoryLocation != MemoryLocation::DEVICE;
+    }
+
+    // "Cmd*" calls get recorded and aggregated at submission
+    inline bool IsCommandProfilingEnabled() const {
+        return m_IsCommandProfilingEnabled;
+    }
+
+    inline CommandProfilerNONE& GetCommandProfiler() {
+        return m_CommandProfiler;
+    }
+
+    // NULL if submissions complete immediately
+    inline const NONETimingModel* GetTimingModel() const {
+        return m_IsTimingModelEnabled ? &m_TimingModel : nullptr;
+    }
+
+    // Both profiling and the timing model consume recorded "Cmd*" calls
+    inline bool IsCommandRecordingEnabled() const {
+        return m_IsCommandProfilingEnabled || m_IsTimingModelEnabled;
+    }
+
+    template <typename Implementation, typename Interface, typename... Args>
+    inline Result CreateImplementation(Interface*& entity, const Args&... args) {
+        Implementation* impl = Allocate<Implementation>(GetStdAllocator(), *this);
+        Result result = impl->Create(args...);
+
+        if (result != Result::SUCCESS) {
+            Destroy(GetStdAllocator(), impl);
+            entity = nullptr;
+        } else
+            entity = (Interface*)impl;
+
+        return result;
+    }
+
+    Result Create(const DeviceCreationDesc& deviceCreationDesc);
+    void GetMemoryDesc(const BufferDesc& bufferDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) const;
+    void GetMemoryDesc(const TextureDesc& textureDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) const;
+
+    //================================================================================================================
+    // DeviceBase
+    //================================================================================================================
+
+    inline const DeviceDesc& GetDesc() const override {
+        return m_Desc;
+    }
+
+    void Destruct() override;
+    Result FillFunctionTable(CoreInterface& table) const override;
+    Result FillFunctionTable(HelperInterface& table) const override;
+    Result FillFunctionTable(LowLatencyInterface& table) const override;
+    Result FillFunctionTable(MeshShaderInterface& table) const override;
+    Result FillFunctionTable(RayTracingInterface& table) const override;
+    Result FillFunctionTable(ResidencyInterface& table) const override;
+    Result FillFunctionTable(StreamerInterface& table) const override;
+    Result FillFunctionTable(SwapChainInterface& table) const override;
+    Result FillFunctionTable(ResourceAllocatorInterface& table) const override;
+
+    //================================================================================================================
+    // NRI
+    //================================================================================================================
+
+    Result GetCommandQueue(CommandQueueType commandQueueType, CommandQueue*& commandQueue);
+    Result BindBufferMemory(const BufferMemoryBindingDesc* memoryBindingDescs, uint32_t memoryBindingDescNum);
+    Result BindTextureMemory(const TextureMemoryBindingDesc* memoryBindingDescs, uint32_t memoryBindingDescNum);
+    Result GetCommandStatistics(CommandStatistics& commandStatistics, PipelineCommandStatistics* pipelineCommandStatistics, uint32_t& pipelineCommandStatisticsNum);
+
+private:
+    std::array<CommandQueueNONE*, (size_t)CommandQueueType::MAX_NUM> m_CommandQueues = {};
+    CommandProfilerNONE m_CommandProfiler;
+    String m_CommandStatisticsPath;
+    CoreInterface m_CoreInterface = {};
+    DeviceDesc m_Desc = {};
+    NONETimingModel m_TimingModel = {};
+    bool m_IsHostMemoryEnabled = false;
+    bool m_IsCommandProfilingEnabled = false;
+    bool m_IsTimingModelEnabled = false;
+};
+
+} // namespace nri
@@ -0,0 +1,255 @@
+// © 2021 NVIDIA Corporation
+
+DeviceNONE::DeviceNONE(const CallbackInterface& callbacks, StdAllocator<uint8_t>& stdAllocator)
+    : DeviceBase(callbacks, stdAllocator)
+    , m_CommandProfiler(stdAllocator)
+    , m_CommandStatisticsPath(stdAllocator) {
+    m_Desc.graphicsAPI = GraphicsAPI::NONE;
+    m_Desc.nriVersionMajor = NRI_VERSION_MAJOR;
+    m_Desc.nriVersionMinor = NRI_VERSION_MINOR;
+
+    m_Desc.viewportMaxNum = 16;
+    m_Desc.viewportBoundsRange[0] = -32768;
+    m_Desc.viewportBoundsRange[1] = 32767;
+
+    m_Desc.attachmentMaxDim = 16384;
+    m_Desc.attachmentLayerMaxNum = 2048;
+    m_Desc.colorAttachmentMaxNum = 8;
+
+    m_Desc.colorSampleMaxNum = 32;
+    m_Desc.depthSampleMaxNum = 32;
+    m_Desc.stencilSampleMaxNum = 32;
+    m_Desc.zeroAttachmentsSampleMaxNum = 32;
+    m_Desc.textureColorSampleMaxNum = 32;
+    m_Desc.textureIntegerSampleMaxNum = 32;
+    m_Desc.textureDepthSampleMaxNum = 32;
+    m_Desc.textureStencilSampleMaxNum = 32;
+    m_Desc.storageTextureSampleMaxNum = 32;
+
+    m_Desc.texture1DMaxDim = 16384;
+    m_Desc.texture2DMaxDim = 16384;
+    m_Desc.texture3DMaxDim = 16384;
+    m_Desc.textureArrayLayerMaxNum = 16384;
+    m_Desc.typedBufferMaxDim = uint32_t(-1);
+
+    m_Desc.deviceUploadHeapSize = 256 * 1024 * 1024;
+    m_Desc.memoryAllocationMaxNum = uint32_t(-1);
+    m_Desc.samplerAllocationMaxNum = 4096;
+    m_Desc.constantBufferMaxRange = 64 * 1024;
+    m_Desc.storageBufferMaxRange = uint32_t(-1);
+    m_Desc.bufferTextureGranularity = 1;
+    m_Desc.bufferMaxSize = uint32_t(-1);
+
+    m_Desc.uploadBufferTextureRowAlignment = 1;
+    m_Desc.uploadBufferTextureSliceAlignment = 1;
+    m_Desc.bufferShaderResourceOffsetAlignment = 1;
+    m_Desc.constantBufferOffsetAlignment = 1;
+    m_Desc.shaderBindingTableAlignment = 1;
+    m_Desc.scratchBufferOffsetAlignment = 1;
+
+    m_Desc.pipelineLayoutDescriptorSetMaxNum = 64;
+    m_Desc.pipelineLayoutRootConstantMaxSize = 256;
+    m_Desc.pipelineLayoutRootDescriptorMaxNum = 64;
+
+    m_Desc.perStageDescriptorSamplerMaxNum = 1000000;
+    m_Desc.perStageDescriptorConstantBufferMaxNum = 1000000;
+    m_Desc.perStageDescriptorStorageBufferMaxNum = 1000000;
+    m_Desc.perStageDescriptorTextureMaxNum = 1000000;
+    m_Desc.perStageDescriptorStorageTextureMaxNum = 1000000;
+    m_Desc.perStageResourceMaxNum = 1000000;
+
+    m_Desc.descriptorSetSamplerMaxNum = m_Desc.perStageDescriptorSamplerMaxNum;
+    m_Desc.descriptorSetConstantBufferMaxNum = m_Desc.perStageDescriptorConstantBufferMaxNum;
+    m_Desc.descriptorSetStorageBufferMaxNum = m_Desc.perStageDescriptorStorageBufferMaxNum;
+    m_Desc.descriptorSetTextureMaxNum = m_Desc.perStageDescriptorTextureMaxNum;
+    m_Desc.descriptorSetStorageTextureMaxNum = m_Desc.perStageDescriptorStorageTextureMaxNum;
+
+    m_Desc.vertexShaderAttributeMaxNum = 32;
+    m_Desc.vertexShaderStreamMaxNum = 32;
+    m_Desc.vertexShaderOutputComponentMaxNum = 128;
+
+    m_Desc.tessControlShaderGenerationMaxLevel = 64.0f;
+    m_Desc.tessControlShaderPatchPointMaxNum = 32;
+    m_Desc.tessControlShaderPerVertexInputComponentMaxNum = 128;
+    m_Desc.tessControlShaderPerVertexOutputComponentMaxNum = 128;
+    m_Desc.tessControlShaderPerPatchOutputComponentMaxNum = 128;
+    m_Desc.tessControlShaderTotalOutputComponentMaxNum = m_Desc.tessControlShaderPatchPointMaxNum * m_Desc.tessControlShaderPerVertexOutputComponentMaxNum + m_Desc.tessControlShaderPerPatchOutputComponentMaxNum;
+
+    m_Desc.tessEvaluationShaderInputComponentMaxNum = 128;
+    m_Desc.tessEvaluationShaderOutputComponentMaxNum = 128;
+
+    m_Desc.geometryShaderInvocationMaxNum = 32;
+    m_Desc.geometryShaderInputComponentMaxNum = 128;
+    m_Desc.geometryShaderOutputComponentMaxNum = 128;
+    m_Desc.geometryShaderOutputVertexMaxNum = 1024;
+    m_Desc.geometryShaderTotalOutputComponentMaxNum = 1024;
+
+    m_Desc.fragmentShaderInputComponentMaxNum = 128;
+    m_Desc.fragmentShaderOutputAttachmentMaxNum = 8;
+    m_Desc.fragmentShaderDualSourceAttachmentMaxNum = 1;
+
+    m_Desc.computeShaderSharedMemoryMaxSize = 64 * 1024;
+    m_Desc.computeShaderWorkGroupMaxNum[0] = 64 * 1024;
+    m_Desc.computeShaderWorkGroupMaxNum[1] = 64 * 1024;
+    m_Desc.computeShaderWorkGroupMaxNum[2] = 64 * 1024;
+    m_Desc.computeShaderWorkGroupInvocationMaxNum = 64 * 1024;
+    m_Desc.computeShaderWorkGroupMaxDim[0] = 64 * 1024;
+    m_Desc.computeShaderWorkGroupMaxDim[1] = 64 * 1024;
+    m_Desc.computeShaderWorkGroupMaxDim[2] = 64 * 1024;
+
+    m_Desc.rayTracingShaderGroupIdentifierSize = 32;
+    m_Desc.rayTracingShaderTableMaxStride = (uint32_t)(-1);
+    m_Desc.rayTracingShaderRecursionMaxDepth = 31;
+    m_Desc.rayTracingGeometryObjectMaxNum = (uint32_t)(-1);
+
+    m_Desc.meshControlSharedMemoryMaxSize = 64 * 1024;
+    m_Desc.meshControlWorkGroupInvocationMaxNum = 128;
+    m_Desc.meshControlPayloadMaxSize = 64 * 1024;
+    m_Desc.meshEvaluationOutputVerticesMaxNum = 256;
+    m_Desc.meshEvaluationOutputPrimitiveMaxNum = 256;
+    m_Desc.meshEvaluationOutputComponentMaxNum = 128;
+    m_Desc.meshEvaluationSharedMemoryMaxSize = 64 * 1024;
+    m_Desc.meshEvaluationWorkGroupInvocationMaxNum = 128;
+
+    m_Desc.viewportPrecisionBits = 8;
+    m_Desc.subPixelPrecisionBits = 8;
+    m_Desc.subTexelPrecisionBits = 8;
+    m_Desc.mipmapPrecisionBits = 8;
+
+    m_Desc.drawIndirectMaxNum = uint32_t(-1);
+    m_Desc.samplerLodBiasMin = -16.0f;
+    m_Desc.samplerLodBiasMax = 16.0f;
+    m_Desc.samplerAnisotropyMax = 16;
+    m_Desc.texelOffsetMin = -8;
+    m_Desc.texelOffsetMax = 7;
+    m_Desc.texelGatherOffsetMin = -8;
+    m_Desc.texelGatherOffsetMax = 7;
+    m_Desc.clipDistanceMaxNum = 8;
+    m_Desc.cullDistanceMaxNum = 8;
+    m_Desc.combinedClipAndCullDistanceMaxNum = 8;
+    m_Desc.shadingRateAttachmentTileSize = 16;
+    m_Desc.shaderModel = 69;
+
+    m_Desc.conservativeRasterTier = 3;
+    m_Desc.sampleLocationsTier = 2;
+    m_Desc.shadingRateTier = 2;
+    m_Desc.bindlessTier = 2;
+    m_Desc.bindlessTier = 2;
+
+    m_Desc.isComputeQueueSupported = true;
+    m_Desc.isCopyQueueSupported = true;
+    m_Desc.isTextureFilterMinMaxSupported = true;
+    m_Desc.isLogicFuncSupported = true;
+    m_Desc.isDepthBoundsTestSupported = true;
+    m_Desc.isDrawIndirectCountSupported = true;
+    m_Desc.isIndependentFrontAndBackStencilReferenceAndMasksSupported = true;
+    m_Desc.isLineSmoothingSupported = true;
+    m_Desc.isCopyQueueTimestampSupported = true;
+    m_Desc.isMeshShaderPipelineStatsSupported = true;
+    m_Desc.isEnchancedBarrierSupported = true;
+    m_Desc.isMemoryTier2Supported = true;
+    m_Desc.isDynamicDepthBiasSupported = true;
+    m_Desc.isAdditionalShadingRatesSupported = true;
+    m_Desc.isViewportOriginBottomLeftSupported = true;
+    m_Desc.isRegionResolveSupported = true;
+
+    m_Desc.isShaderNativeI16Supported = true;
+    m_Desc.isShaderNativeF16Supported = true;
+    m_Desc.isShaderNativeI32Supported = true;
+    m_Desc.isShaderNativeF32Supported = true;
+    m_Desc.isShaderNativeI64Supported = true;
+    m_Desc.isShaderNativeF64Supported = true;
+    m_Desc.isShaderAtomicsI16Supported = true;
+    m_Desc.isShaderAtomicsF16Supported = true;
+    m_Desc.isShaderAtomicsI32Supported = true;
+    m_Desc.isShaderAtomicsF32Supported = true;
+    m_Desc.isShaderAtomicsI64Supported = true;
+    m_Desc.isShaderAtomicsF64Supported = true;
+
+    m_Desc.isSwapChainSupported = true;
+    m_Desc.isRayTracingSupported = true;
+    m_Desc.isMeshShaderSupported = true;
+    m_Desc.isLowLatencySupported = true;
+}
+
+DeviceNONE::~DeviceNONE() {
+    if (m_IsCommandProfilingEnabled && !m_CommandStatisticsPath.empty()) {
+        if (!m_CommandProfiler.WriteJSON(m_CommandStatisticsPath.c_str()))
+            REPORT_WARNING(this, "Can't write command statistics to '%s'", m_CommandStatisticsPath.c_str());
+    }
+
+    for (CommandQueueNONE* commandQueue : m_CommandQueues)
+        Destroy(m_StdAllocator, commandQueue);
+}
+
+Result DeviceNONE::Create(const DeviceCreationDesc& deviceCreationDesc) {
+    m_IsHostMemoryEnabled = deviceCreationDesc.enableNONEHostMemory;
+    m_IsCommandProfilingEnabled = deviceCreationDesc.enableNONECommandProfiling;
+
+    if (deviceCreationDesc.noneTimingModel) {
+        m_TimingModel = *deviceCreationDesc.noneTimingModel;
+        m_IsTimingModelEnabled = true;
+    }
+
+    if (deviceCreationDesc.noneCommandStatisticsPath)
+        m_CommandStatisticsPath = deviceCreationDesc.noneCommandStatisticsPath;
+
+    for (uint32_t i = 0; i < (uint32_t)CommandQueueType::MAX_NUM; i++) {
+        m_CommandQueues[i] = Allocate<CommandQueueNONE>(m_StdAllocator, *this);
+        if (!m_CommandQueues[i])
+            return Result::OUT_OF_MEMORY;
+
+        m_CommandQueues[i]->Create((CommandQueueType)i);
+    }
+
+    return FillFunctionTable(m_CoreInterface);
+}
+
+void DeviceNONE::Destruct() {
+    Destroy(GetStdAllocator(), this);
+}
+
+NRI_INLINE void DeviceNONE::GetMemoryDesc(const BufferDesc& bufferDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) const {
+    memoryDesc = {};
+    memoryDesc.size = Align(bufferDesc.size, NONE_BUFFER_ALIGNMENT);
+    memoryDesc.alignment = NONE_BUFFER_ALIGNMENT;
+    memoryDesc.type = (MemoryType)memoryLocation;
+}
+
+NRI_INLINE void DeviceNONE::GetMemoryDesc(const TextureDesc& textureDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) const {
+    memoryDesc = {};
+    memoryDesc.size = Align(GetTextureSize(FixTextureDesc(textureDesc)), NONE_TEXTURE_ALIGNMENT);
+    memoryDesc.alignment = NONE_TEXTURE_ALIGNMENT;
+    memoryDesc.type = (MemoryType)memoryLocation;
+}
+
+NRI_INLINE Result DeviceNONE::GetCommandQueue(CommandQueueType commandQueueType, CommandQueue*& commandQueue) {
+    commandQueue = (CommandQueue*)m_CommandQueues[(uint32_t)commandQueueType];
+
+    return Result::SUCCESS;
+}
+
+NRI_INLINE Result DeviceNONE::BindBufferMemory(const BufferMemoryBindingDesc* memoryBindingDescs, uint32_t memoryBindingDescNum) {
+    for (uint32_t i = 0; i < memoryBindingDescNum; i++) {
+        const BufferMemoryBindingDesc& memoryBindingDesc = memoryBindingDescs[i];
+        ((BufferNONE*)memoryBindingDesc.buffer)->Bind(*(MemoryNONE*)memoryBindingDesc.memory, memoryBindingDesc.offset);
+    }
+
+    return Result::SUCCESS;
+}
+
+NRI_INLINE Result DeviceNONE::BindTextureMemory(const TextureMemoryBindingDesc* memoryBindingDescs, uint32_t memoryBindingDescNum) {
+    for (uint32_t i = 0; i < memoryBindingDescNum; i++) {
+        const TextureMemoryBindingDesc& memoryBindingDesc = memoryBindingDescs[i];
+        ((TextureNONE*)memoryBindingDesc.texture)->Bind(*(MemoryNONE*)memoryBindingDesc.memory, memoryBindingDesc.offset);
+    }
+
+    return Result::SUCCESS;
+}
+
+NRI_INLINE Result DeviceNONE::GetCommandStatistics(CommandStatistics& commandStatistics, PipelineCommandStatistics* pipelineCommandStatistics, uint32_t& pipelineCommandStatisticsNum) {
+    if (!m_IsCommandProfilingEnabled)
+        return Result::UNSUPPORTED;
+
+    return m_CommandProfiler.GetStatistics(commandStatistics, pipelineCommandStatistics, pipelineCommandStatisticsNum);
+}
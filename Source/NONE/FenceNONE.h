@@ -0,0 +1,61 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+struct DeviceNONE;
+
+// A signal which completes on the simulated GPU timeline
+struct FenceSignalNONE {
+    uint64_t value;
+    uint64_t time; // ns, "GetTimeNs" clock
+};
+
+// Without a timing model submissions are executed immediately, i.e. a signaled value is reached right away
+struct FenceNONE {
+    inline FenceNONE(DeviceNONE& device)
+        : m_Device(device)
+        , m_PendingSignals(device.GetStdAllocator()) {
+    }
+
+    inline ~FenceNONE() {
+    }
+
+    inline DeviceNONE& GetDevice() const {
+        return m_Device;
+    }
+
+    inline Result Create(uint64_t initialValue) {
+        m_Value.store(initialValue, std::memory_order_relaxed);
+
+        return Result::SUCCESS;
+    }
+
+    // "time = 0" means "complete now"
+    void QueueSignal(uint64_t value, uint64_t time);
+
+    // Returns the time when "value" gets reached, or 0 if already reached or never going to be reached
+    uint64_t GetSignalTime(uint64_t value);
+
+    //================================================================================================================
+    // NRI
+    //================================================================================================================
+
+    inline void SetDebugName(const char* name) {
+        MaybeUnused(name);
+    }
+
+    uint64_t GetFenceValue();
+    void Wait(uint64_t value);
+
+private:
+    void RetireSignals(uint64_t time);
+
+    DeviceNONE& m_Device;
+    Lock m_Lock{"FenceNONE"};
+    Vector<FenceSignalNONE> m_PendingSignals;
+    std::atomic_uint64_t m_Value = 0;
+};
+
+} // namespace nri
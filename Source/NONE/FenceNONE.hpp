@@ -0,0 +1,67 @@
+// © 2021 NVIDIA Corporation
+
+NRI_INLINE void FenceNONE::RetireSignals(uint64_t time) {
+    uint64_t value = m_Value.load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < m_PendingSignals.size();) {
+        const FenceSignalNONE& signal = m_PendingSignals[i];
+
+        if (signal.time <= time) {
+            value = std::max(value, signal.value);
+
+            m_PendingSignals[i] = m_PendingSignals.back();
+            m_PendingSignals.pop_back();
+        } else
+            i++;
+    }
+
+    m_Value.store(value, std::memory_order_release);
+}
+
+NRI_INLINE void FenceNONE::QueueSignal(uint64_t value, uint64_t time) {
+    if (!time) {
+        m_Value.store(value, std::memory_order_release);
+        return;
+    }
+
+    ExclusiveScope lock(m_Lock);
+
+    m_PendingSignals.push_back({value, time});
+}
+
+NRI_INLINE uint64_t FenceNONE::GetSignalTime(uint64_t value) {
+    if (!m_Device.GetTimingModel())
+        return 0;
+
+    ExclusiveScope lock(m_Lock);
+
+    RetireSignals(GetTimeNs());
+
+    if (m_Value.load(std::memory_order_relaxed) >= value)
+        return 0;
+
+    uint64_t time = 0;
+    for (const FenceSignalNONE& signal : m_PendingSignals) {
+        if (signal.value >= value && (!time || signal.time < time))
+            time = signal.time;
+    }
+
+    return time;
+}
+
+NRI_INLINE uint64_t FenceNONE::GetFenceValue() {
+    if (m_Device.GetTimingModel()) {
+        ExclusiveScope lock(m_Lock);
+
+        RetireSignals(GetTimeNs());
+    }
+
+    return m_Value.load(std::memory_order_acquire);
+}
+
+NRI_INLINE void FenceNONE::Wait(uint64_t value) {
+    // A value which is never going to be signaled doesn't hang the CPU
+    uint64_t time = GetSignalTime(value);
+    if (time)
+        std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(time)));
+}
@@ -2,221 +2,60 @@
 
 #include "SharedExternal.h"
 
+#include <chrono>
+#include <thread>
+
+#include "CommandProfilerNONE.h"
+#include "DeviceNONE.h"
+
+#include "BufferNONE.h"
+#include "CommandAllocatorNONE.h"
+#include "CommandBufferNONE.h"
+#include "CommandQueueNONE.h"
+#include "FenceNONE.h"
+#include "MemoryNONE.h"
+#include "PipelineNONE.h"
+#include "QueryPoolNONE.h"
+#include "SwapChainNONE.h"
+#include "TextureNONE.h"
+
+#include "HelperDataDownload.h"
+#include "HelperDataUpload.h"
+#include "HelperDeviceMemoryAllocator.h"
+#include "HelperWaitIdle.h"
+#include "Streamer.h"
+
 using namespace nri;
 
+#include "BufferNONE.hpp"
+#include "CommandAllocatorNONE.hpp"
+#include "CommandBufferNONE.hpp"
+#include "CommandProfilerNONE.hpp"
+#include "CommandQueueNONE.hpp"
+#include "DeviceNONE.hpp"
+#include "FenceNONE.hpp"
+#include "MemoryNONE.hpp"
+#include "PipelineNONE.hpp"
+#include "SwapChainNONE.hpp"
+#include "TextureNONE.hpp"
+
 template <typename T>
 constexpr T* DummyObject() {
     return (T*)(size_t)(1);
 }
 
-struct DeviceNONE final : public DeviceBase {
-    inline DeviceNONE(const CallbackInterface& callbacks, StdAllocator<uint8_t>& stdAllocator)
-        : DeviceBase(callbacks, stdAllocator) {
-        m_Desc.graphicsAPI = GraphicsAPI::NONE;
-        m_Desc.nriVersionMajor = NRI_VERSION_MAJOR;
-        m_Desc.nriVersionMinor = NRI_VERSION_MINOR;
-
-        m_Desc.viewportMaxNum = 16;
-        m_Desc.viewportBoundsRange[0] = -32768;
-        m_Desc.viewportBoundsRange[1] = 32767;
-
-        m_Desc.attachmentMaxDim = 16384;
-        m_Desc.attachmentLayerMaxNum = 2048;
-        m_Desc.colorAttachmentMaxNum = 8;
-
-        m_Desc.colorSampleMaxNum = 32;
-        m_Desc.depthSampleMaxNum = 32;
-        m_Desc.stencilSampleMaxNum = 32;
-        m_Desc.zeroAttachmentsSampleMaxNum = 32;
-        m_Desc.textureColorSampleMaxNum = 32;
-        m_Desc.textureIntegerSampleMaxNum = 32;
-        m_Desc.textureDepthSampleMaxNum = 32;
-        m_Desc.textureStencilSampleMaxNum = 32;
-        m_Desc.storageTextureSampleMaxNum = 32;
-
-        m_Desc.texture1DMaxDim = 16384;
-        m_Desc.texture2DMaxDim = 16384;
-        m_Desc.texture3DMaxDim = 16384;
-        m_Desc.textureArrayLayerMaxNum = 16384;
-        m_Desc.typedBufferMaxDim = uint32_t(-1);
-
-        m_Desc.deviceUploadHeapSize = 256 * 1024 * 1024;
-        m_Desc.memoryAllocationMaxNum = uint32_t(-1);
-        m_Desc.samplerAllocationMaxNum = 4096;
-        m_Desc.constantBufferMaxRange = 64 * 1024;
-        m_Desc.storageBufferMaxRange = uint32_t(-1);
-        m_Desc.bufferTextureGranularity = 1;
-        m_Desc.bufferMaxSize = uint32_t(-1);
-
-        m_Desc.uploadBufferTextureRowAlignment = 1;
-        m_Desc.uploadBufferTextureSliceAlignment = 1;
-        m_Desc.bufferShaderResourceOffsetAlignment = 1;
-        m_Desc.constantBufferOffsetAlignment = 1;
-        m_Desc.shaderBindingTableAlignment = 1;
-        m_Desc.scratchBufferOffsetAlignment = 1;
-
-        m_Desc.pipelineLayoutDescriptorSetMaxNum = 64;
-        m_Desc.pipelineLayoutRootConstantMaxSize = 256;
-        m_Desc.pipelineLayoutRootDescriptorMaxNum = 64;
-
-        m_Desc.perStageDescriptorSamplerMaxNum = 1000000;
-        m_Desc.perStageDescriptorConstantBufferMaxNum = 1000000;
-        m_Desc.perStageDescriptorStorageBufferMaxNum = 1000000;
-        m_Desc.perStageDescriptorTextureMaxNum = 1000000;
-        m_Desc.perStageDescriptorStorageTextureMaxNum = 1000000;
-        m_Desc.perStageResourceMaxNum = 1000000;
-
-        m_Desc.descriptorSetSamplerMaxNum = m_Desc.perStageDescriptorSamplerMaxNum;
-        m_Desc.descriptorSetConstantBufferMaxNum = m_Desc.perStageDescriptorConstantBufferMaxNum;
-        m_Desc.descriptorSetStorageBufferMaxNum = m_Desc.perStageDescriptorStorageBufferMaxNum;
-        m_Desc.descriptorSetTextureMaxNum = m_Desc.perStageDescriptorTextureMaxNum;
-        m_Desc.descriptorSetStorageTextureMaxNum = m_Desc.perStageDescriptorStorageTextureMaxNum;
-
-        m_Desc.vertexShaderAttributeMaxNum = 32;
-        m_Desc.vertexShaderStreamMaxNum = 32;
-        m_Desc.vertexShaderOutputComponentMaxNum = 128;
-
-        m_Desc.tessControlShaderGenerationMaxLevel = 64.0f;
-        m_Desc.tessControlShaderPatchPointMaxNum = 32;
-        m_Desc.tessControlShaderPerVertexInputComponentMaxNum = 128;
-        m_Desc.tessControlShaderPerVertexOutputComponentMaxNum = 128;
-        m_Desc.tessControlShaderPerPatchOutputComponentMaxNum = 128;
-        m_Desc.tessControlShaderTotalOutputComponentMaxNum = m_Desc.tessControlShaderPatchPointMaxNum * m_Desc.tessControlShaderPerVertexOutputComponentMaxNum + m_Desc.tessControlShaderPerPatchOutputComponentMaxNum;
-
-        m_Desc.tessEvaluationShaderInputComponentMaxNum = 128;
-        m_Desc.tessEvaluationShaderOutputComponentMaxNum = 128;
-
-        m_Desc.geometryShaderInvocationMaxNum = 32;
-        m_Desc.geometryShaderInputComponentMaxNum = 128;
-        m_Desc.geometryShaderOutputComponentMaxNum = 128;
-        m_Desc.geometryShaderOutputVertexMaxNum = 1024;
-        m_Desc.geometryShaderTotalOutputComponentMaxNum = 1024;
-
-        m_Desc.fragmentShaderInputComponentMaxNum = 128;
-        m_Desc.fragmentShaderOutputAttachmentMaxNum = 8;
-        m_Desc.fragmentShaderDualSourceAttachmentMaxNum = 1;
-
-        m_Desc.computeShaderSharedMemoryMaxSize = 64 * 1024;
-        m_Desc.computeShaderWorkGroupMaxNum[0] = 64 * 1024;
-        m_Desc.computeShaderWorkGroupMaxNum[1] = 64 * 1024;
-        m_Desc.computeShaderWorkGroupMaxNum[2] = 64 * 1024;
-        m_Desc.computeShaderWorkGroupInvocationMaxNum = 64 * 1024;
-        m_Desc.computeShaderWorkGroupMaxDim[0] = 64 * 1024;
-        m_Desc.computeShaderWorkGroupMaxDim[1] = 64 * 1024;
-        m_Desc.computeShaderWorkGroupMaxDim[2] = 64 * 1024;
-
-        m_Desc.rayTracingShaderGroupIdentifierSize = 32;
-        m_Desc.rayTracingShaderTableMaxStride = (uint32_t)(-1);
-        m_Desc.rayTracingShaderRecursionMaxDepth = 31;
-        m_Desc.rayTracingGeometryObjectMaxNum = (uint32_t)(-1);
-
-        m_Desc.meshControlSharedMemoryMaxSize = 64 * 1024;
-        m_Desc.meshControlWorkGroupInvocationMaxNum = 128;
-        m_Desc.meshControlPayloadMaxSize = 64 * 1024;
-        m_Desc.meshEvaluationOutputVerticesMaxNum = 256;
-        m_Desc.meshEvaluationOutputPrimitiveMaxNum = 256;
-        m_Desc.meshEvaluationOutputComponentMaxNum = 128;
-        m_Desc.meshEvaluationSharedMemoryMaxSize = 64 * 1024;
-        m_Desc.meshEvaluationWorkGroupInvocationMaxNum = 128;
-
-        m_Desc.viewportPrecisionBits = 8;
-        m_Desc.subPixelPrecisionBits = 8;
-        m_Desc.subTexelPrecisionBits = 8;
-        m_Desc.mipmapPrecisionBits = 8;
-
-        m_Desc.drawIndirectMaxNum = uint32_t(-1);
-        m_Desc.samplerLodBiasMin = -16.0f;
-        m_Desc.samplerLodBiasMax = 16.0f;
-        m_Desc.samplerAnisotropyMax = 16;
-        m_Desc.texelOffsetMin = -8;
-        m_Desc.texelOffsetMax = 7;
-        m_Desc.texelGatherOffsetMin = -8;
-        m_Desc.texelGatherOffsetMax = 7;
-        m_Desc.clipDistanceMaxNum = 8;
-        m_Desc.cullDistanceMaxNum = 8;
-        m_Desc.combinedClipAndCullDistanceMaxNum = 8;
-        m_Desc.shadingRateAttachmentTileSize = 16;
-        m_Desc.shaderModel = 69;
-
-        m_Desc.conservativeRasterTier = 3;
-        m_Desc.sampleLocationsTier = 2;
-        m_Desc.shadingRateTier = 2;
-        m_Desc.bindlessTier = 2;
-        m_Desc.bindlessTier = 2;
-
-        m_Desc.isComputeQueueSupported = true;
-        m_Desc.isCopyQueueSupported = true;
-        m_Desc.isTextureFilterMinMaxSupported = true;
-        m_Desc.isLogicFuncSupported = true;
-        m_Desc.isDepthBoundsTestSupported = true;
-        m_Desc.isDrawIndirectCountSupported = true;
-        m_Desc.isIndependentFrontAndBackStencilReferenceAndMasksSupported = true;
-        m_Desc.isLineSmoothingSupported = true;
-        m_Desc.isCopyQueueTimestampSupported = true;
-        m_Desc.isMeshShaderPipelineStatsSupported = true;
-        m_Desc.isEnchancedBarrierSupported = true;
-        m_Desc.isMemoryTier2Supported = true;
-        m_Desc.isDynamicDepthBiasSupported = true;
-        m_Desc.isAdditionalShadingRatesSupported = true;
-        m_Desc.isViewportOriginBottomLeftSupported = true;
-        m_Desc.isRegionResolveSupported = true;
-
-        m_Desc.isShaderNativeI16Supported = true;
-        m_Desc.isShaderNativeF16Supported = true;
-        m_Desc.isShaderNativeI32Supported = true;
-        m_Desc.isShaderNativeF32Supported = true;
-        m_Desc.isShaderNativeI64Supported = true;
-        m_Desc.isShaderNativeF64Supported = true;
-        m_Desc.isShaderAtomicsI16Supported = true;
-        m_Desc.isShaderAtomicsF16Supported = true;
-        m_Desc.isShaderAtomicsI32Supported = true;
-        m_Desc.isShaderAtomicsF32Supported = true;
-        m_Desc.isShaderAtomicsI64Supported = true;
-        m_Desc.isShaderAtomicsF64Supported = true;
-
-        m_Desc.isSwapChainSupported = true;
-        m_Desc.isRayTracingSupported = true;
-        m_Desc.isMeshShaderSupported = true;
-        m_Desc.isLowLatencySupported = true;
-    }
-
-    inline ~DeviceNONE() {
-    }
-
-    inline const DeviceDesc& GetDesc() const {
-        return m_Desc;
-    }
-
-    inline void Destruct() {
-    }
-
-    Result FillFunctionTable(CoreInterface& table) const;
-    Result FillFunctionTable(HelperInterface& table) const;
-    Result FillFunctionTable(LowLatencyInterface& table) const;
-    Result FillFunctionTable(MeshShaderInterface& table) const;
-    Result FillFunctionTable(RayTracingInterface& table) const;
-    Result FillFunctionTable(StreamerInterface& table) const;
-    Result FillFunctionTable(SwapChainInterface& table) const;
-    Result FillFunctionTable(ResourceAllocatorInterface& table) const;
-
-private:
-    DeviceDesc m_Desc = {};
-};
-
 Result CreateDeviceNONE(const DeviceCreationDesc& deviceCreationDesc, DeviceBase*& device) {
     StdAllocator<uint8_t> allocator(deviceCreationDesc.allocationCallbacks);
     DeviceNONE* impl = Allocate<DeviceNONE>(allocator, deviceCreationDesc.callbackInterface, allocator);
+    Result result = impl ? impl->Create(deviceCreationDesc) : Result::OUT_OF_MEMORY;
 
-    if (!impl) {
+    if (result != Result::SUCCESS) {
         Destroy(allocator, impl);
-        device = DummyObject<DeviceBase>();
-
-        return Result::FAILURE;
-    }
+        device = nullptr;
+    } else
+        device = (DeviceBase*)impl;
 
-    device = (DeviceBase*)impl;
-
-    return Result::SUCCESS;
+    return result;
 }
 
 //============================================================================================================================================================================================
@@ -226,50 +65,41 @@ static const DeviceDesc& NRI_CALL GetDeviceDesc(const Device& device) {
     return ((DeviceNONE&)device).GetDesc();
 }
 
-static const BufferDesc& NRI_CALL GetBufferDesc(const Buffer&) {
-    static const BufferDesc bufferDesc = {};
-
-    return bufferDesc;
+static const BufferDesc& NRI_CALL GetBufferDesc(const Buffer& buffer) {
+    return ((const BufferNONE&)buffer).GetDesc();
 }
 
-static const TextureDesc& NRI_CALL GetTextureDesc(const Texture&) {
-    static const TextureDesc textureDesc = {};
-
-    return textureDesc;
+static const TextureDesc& NRI_CALL GetTextureDesc(const Texture& texture) {
+    return ((const TextureNONE&)texture).GetDesc();
 }
 
 static FormatSupportBits NRI_CALL GetFormatSupport(const Device&, Format) {
     return (FormatSupportBits)(-1);
 }
 
-static uint32_t NRI_CALL GetQuerySize(const QueryPool&) {
-    return 0;
+static uint32_t NRI_CALL GetQuerySize(const QueryPool& queryPool) {
+    return ((QueryPoolNONE&)queryPool).GetQuerySize();
 }
 
-static void NRI_CALL GetBufferMemoryDesc(const Device&, const BufferDesc&, MemoryLocation, MemoryDesc& memoryDesc) {
-    memoryDesc = {};
+static void NRI_CALL GetBufferMemoryDesc(const Device& device, const BufferDesc& bufferDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) {
+    ((const DeviceNONE&)device).GetMemoryDesc(bufferDesc, memoryLocation, memoryDesc);
 }
 
-static void NRI_CALL GetTextureMemoryDesc(const Device&, const TextureDesc&, MemoryLocation, MemoryDesc& memoryDesc) {
-    memoryDesc = {};
+static void NRI_CALL GetTextureMemoryDesc(const Device& device, const TextureDesc& textureDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) {
+    ((const DeviceNONE&)device).GetMemoryDesc(textureDesc, memoryLocation, memoryDesc);
 }
 
-static Result NRI_CALL GetCommandQueue(Device&, CommandQueueType, CommandQueue*& commandQueue) {
-    commandQueue = DummyObject<CommandQueue>();
-
-    return Result::SUCCESS;
+static Result NRI_CALL GetCommandQueue(Device& device, CommandQueueType commandQueueType, CommandQueue*& commandQueue) {
+    return ((DeviceNONE&)device).GetCommandQueue(commandQueueType, commandQueue);
 }
 
-static Result NRI_CALL CreateCommandAllocator(const CommandQueue&, CommandAllocator*& commandAllocator) {
-    commandAllocator = DummyObject<CommandAllocator>();
-
-    return Result::SUCCESS;
+static Result NRI_CALL CreateCommandAllocator(const CommandQueue& commandQueue, CommandAllocator*& commandAllocator) {
+    DeviceNONE& device = ((CommandQueueNONE&)commandQueue).GetDevice();
+    return device.CreateImplementation<CommandAllocatorNONE>(commandAllocator, commandQueue);
 }
 
-static Result NRI_CALL CreateCommandBuffer(CommandAllocator&, CommandBuffer*& commandBuffer) {
-    commandBuffer = DummyObject<CommandBuffer>();
-
-    return Result::SUCCESS;
+static Result NRI_CALL CreateCommandBuffer(CommandAllocator& commandAllocator, CommandBuffer*& commandBuffer) {
+    return ((CommandAllocatorNONE&)commandAllocator).CreateCommandBuffer(commandBuffer);
 }
 
 static Result NRI_CALL CreateDescriptorPool(Device&, const DescriptorPoolDesc&, DescriptorPool*& descriptorPool) {
@@ -278,16 +108,12 @@ static Result NRI_CALL CreateDescriptorPool(Device&, const DescriptorPoolDesc&,
     return Result::SUCCESS;
 }
 
-static Result NRI_CALL CreateBuffer(Device&, const BufferDesc&, Buffer*& buffer) {
-    buffer = DummyObject<Buffer>();
-
-    return Result::SUCCESS;
+static Result NRI_CALL CreateBuffer(Device& device, const BufferDesc& bufferDesc, Buffer*& buffer) {
+    return ((DeviceNONE&)device).CreateImplementation<BufferNONE>(buffer, bufferDesc);
 }
 
-static Result NRI_CALL CreateTexture(Device&, const TextureDesc&, Texture*& texture) {
-    texture = DummyObject<Texture>();
-
-    return Result::SUCCESS;
+static Result NRI_CALL CreateTexture(Device& device, const TextureDesc& textureDesc, Texture*& texture) {
+    return ((DeviceNONE&)device).CreateImplementation<TextureNONE>(texture, textureDesc);
 }
 
 static Result NRI_CALL CreateBufferView(const BufferViewDesc&, Descriptor*& bufferView) {
@@ -326,43 +152,39 @@ static Result NRI_CALL CreatePipelineLayout(Device&, const PipelineLayoutDesc&,
     return Result::SUCCESS;
 }
 
-static Result NRI_CALL CreateGraphicsPipeline(Device&, const GraphicsPipelineDesc&, Pipeline*& pipeline) {
-    pipeline = DummyObject<Pipeline>();
-
-    return Result::SUCCESS;
+static Result NRI_CALL CreateGraphicsPipeline(Device& device, const GraphicsPipelineDesc& graphicsPipelineDesc, Pipeline*& pipeline) {
+    return ((DeviceNONE&)device).CreateImplementation<PipelineNONE>(pipeline, graphicsPipelineDesc);
 }
 
-static Result NRI_CALL CreateComputePipeline(Device&, const ComputePipelineDesc&, Pipeline*& pipeline) {
-    pipeline = DummyObject<Pipeline>();
-
-    return Result::SUCCESS;
+static Result NRI_CALL CreateComputePipeline(Device& device, const ComputePipelineDesc& computePipelineDesc, Pipeline*& pipeline) {
+    return ((DeviceNONE&)device).CreateImplementation<PipelineNONE>(pipeline, computePipelineDesc);
 }
 
-static Result NRI_CALL CreateFence(Device&, uint64_t, Fence*& fence) {
-    fence = DummyObject<Fence>();
-
-    return Result::SUCCESS;
+static Result NRI_CALL CreateFence(Device& device, uint64_t initialValue, Fence*& fence) {
+    return ((DeviceNONE&)device).CreateImplementation<FenceNONE>(fence, initialValue);
 }
 
-static Result NRI_CALL CreateQueryPool(Device&, const QueryPoolDesc&, QueryPool*& queryPool) {
-    queryPool = DummyObject<QueryPool>();
-
-    return Result::SUCCESS;
+static Result NRI_CALL CreateQueryPool(Device& device, const QueryPoolDesc& queryPoolDesc, QueryPool*& queryPool) {
+    return ((DeviceNONE&)device).CreateImplementation<QueryPoolNONE>(queryPool, queryPoolDesc);
 }
 
-static void NRI_CALL DestroyCommandBuffer(CommandBuffer&) {
+static void NRI_CALL DestroyCommandBuffer(CommandBuffer& commandBuffer) {
+    Destroy((CommandBufferNONE*)&commandBuffer);
 }
 
-static void NRI_CALL DestroyCommandAllocator(CommandAllocator&) {
+static void NRI_CALL DestroyCommandAllocator(CommandAllocator& commandAllocator) {
+    Destroy((CommandAllocatorNONE*)&commandAllocator);
 }
 
 static void NRI_CALL DestroyDescriptorPool(DescriptorPool&) {
 }
 
-static void NRI_CALL DestroyBuffer(Buffer&) {
+static void NRI_CALL DestroyBuffer(Buffer& buffer) {
+    Destroy((BufferNONE*)&buffer);
 }
 
-static void NRI_CALL DestroyTexture(Texture&) {
+static void NRI_CALL DestroyTexture(Texture& texture) {
+    Destroy((TextureNONE*)&texture);
 }
 
 static void NRI_CALL DestroyDescriptor(Descriptor&) {
@@ -371,165 +193,208 @@ static void NRI_CALL DestroyDescriptor(Descriptor&) {
 static void NRI_CALL DestroyPipelineLayout(PipelineLayout&) {
 }
 
-static void NRI_CALL DestroyPipeline(Pipeline&) {
+static void NRI_CALL DestroyPipeline(Pipeline& pipeline) {
+    Destroy((PipelineNONE*)&pipeline);
 }
 
-static void NRI_CALL DestroyQueryPool(QueryPool&) {
+static void NRI_CALL DestroyQueryPool(QueryPool& queryPool) {
+    Destroy((QueryPoolNONE*)&queryPool);
 }
 
-static void NRI_CALL DestroyFence(Fence&) {
+static void NRI_CALL DestroyFence(Fence& fence) {
+    Destroy((FenceNONE*)&fence);
 }
 
-static Result NRI_CALL AllocateMemory(Device&, const AllocateMemoryDesc&, Memory*& memory) {
-    memory = DummyObject<Memory>();
-
-    return Result::SUCCESS;
+static Result NRI_CALL AllocateMemory(Device& device, const AllocateMemoryDesc& allocateMemoryDesc, Memory*& memory) {
+    return ((DeviceNONE&)device).CreateImplementation<MemoryNONE>(memory, allocateMemoryDesc);
 }
 
-static Result NRI_CALL BindBufferMemory(Device&, const BufferMemoryBindingDesc*, uint32_t) {
-    return Result::SUCCESS;
+static Result NRI_CALL BindBufferMemory(Device& device, const BufferMemoryBindingDesc* memoryBindingDescs, uint32_t memoryBindingDescNum) {
+    return ((DeviceNONE&)device).BindBufferMemory(memoryBindingDescs, memoryBindingDescNum);
 }
 
-static Result NRI_CALL BindTextureMemory(Device&, const TextureMemoryBindingDesc*, uint32_t) {
-    return Result::SUCCESS;
+static Result NRI_CALL BindTextureMemory(Device& device, const TextureMemoryBindingDesc* memoryBindingDescs, uint32_t memoryBindingDescNum) {
+    return ((DeviceNONE&)device).BindTextureMemory(memoryBindingDescs, memoryBindingDescNum);
 }
 
-static void NRI_CALL FreeMemory(Memory&) {
+static void NRI_CALL FreeMemory(Memory& memory) {
+    Destroy((MemoryNONE*)&memory);
 }
 
-static Result NRI_CALL BeginCommandBuffer(CommandBuffer&, const DescriptorPool*) {
-    return Result::SUCCESS;
+static Result NRI_CALL BeginCommandBuffer(CommandBuffer& commandBuffer, const DescriptorPool* descriptorPool) {
+    return ((CommandBufferNONE&)commandBuffer).Begin(descriptorPool);
 }
 
-static void NRI_CALL CmdSetDescriptorPool(CommandBuffer&, const DescriptorPool&) {
+static void NRI_CALL CmdSetDescriptorPool(CommandBuffer& commandBuffer, const DescriptorPool&) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::SET_DESCRIPTOR_POOL);
 }
 
-static void NRI_CALL CmdSetDescriptorSet(CommandBuffer&, uint32_t, const DescriptorSet&, const uint32_t*) {
+static void NRI_CALL CmdSetDescriptorSet(CommandBuffer& commandBuffer, uint32_t, const DescriptorSet&, const uint32_t*) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::SET_DESCRIPTOR_SET);
 }
 
-static void NRI_CALL CmdSetPipelineLayout(CommandBuffer&, const PipelineLayout&) {
+static void NRI_CALL CmdSetPipelineLayout(CommandBuffer& commandBuffer, const PipelineLayout&) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::SET_PIPELINE_LAYOUT);
 }
 
-static void NRI_CALL CmdSetPipeline(CommandBuffer&, const Pipeline&) {
+static void NRI_CALL CmdSetPipeline(CommandBuffer& commandBuffer, const Pipeline& pipeline) {
+    ((CommandBufferNONE&)commandBuffer).SetPipeline(pipeline);
 }
 
-static void NRI_CALL CmdSetRootConstants(CommandBuffer&, uint32_t, const void*, uint32_t) {
+static void NRI_CALL CmdSetRootConstants(CommandBuffer& commandBuffer, uint32_t, const void*, uint32_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::SET_ROOT_CONSTANTS);
 }
 
-static void NRI_CALL CmdSetRootDescriptor(CommandBuffer&, uint32_t, Descriptor&) {
+static void NRI_CALL CmdSetRootDescriptor(CommandBuffer& commandBuffer, uint32_t, Descriptor&) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::SET_ROOT_DESCRIPTOR);
 }
 
-static void NRI_CALL CmdBarrier(CommandBuffer&, const BarrierGroupDesc&) {
+static void NRI_CALL CmdBarrier(CommandBuffer& commandBuffer, const BarrierGroupDesc& barrierGroupDesc) {
+    ((CommandBufferNONE&)commandBuffer).Barrier(barrierGroupDesc);
 }
 
-static void NRI_CALL CmdSetIndexBuffer(CommandBuffer&, const Buffer&, uint64_t, IndexType) {
+static void NRI_CALL CmdSetIndexBuffer(CommandBuffer& commandBuffer, const Buffer&, uint64_t, IndexType) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::SET_INDEX_BUFFER);
 }
 
-static void NRI_CALL CmdSetVertexBuffers(CommandBuffer&, uint32_t, uint32_t, const Buffer* const*, const uint64_t*) {
+static void NRI_CALL CmdSetVertexBuffers(CommandBuffer& commandBuffer, uint32_t, uint32_t, const Buffer* const*, const uint64_t*) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::SET_VERTEX_BUFFERS);
 }
 
-static void NRI_CALL CmdSetViewports(CommandBuffer&, const Viewport*, uint32_t) {
+static void NRI_CALL CmdSetViewports(CommandBuffer& commandBuffer, const Viewport*, uint32_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::SET_VIEWPORTS);
 }
 
-static void NRI_CALL CmdSetScissors(CommandBuffer&, const Rect*, uint32_t) {
+static void NRI_CALL CmdSetScissors(CommandBuffer& commandBuffer, const Rect*, uint32_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::SET_SCISSORS);
 }
 
-static void NRI_CALL CmdSetStencilReference(CommandBuffer&, uint8_t, uint8_t) {
+static void NRI_CALL CmdSetStencilReference(CommandBuffer& commandBuffer, uint8_t, uint8_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::SET_STENCIL_REFERENCE);
 }
 
-static void NRI_CALL CmdSetDepthBounds(CommandBuffer&, float, float) {
+static void NRI_CALL CmdSetDepthBounds(CommandBuffer& commandBuffer, float, float) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::SET_DEPTH_BOUNDS);
 }
 
-static void NRI_CALL CmdSetBlendConstants(CommandBuffer&, const Color32f&) {
+static void NRI_CALL CmdSetBlendConstants(CommandBuffer& commandBuffer, const Color32f&) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::SET_BLEND_CONSTANTS);
 }
 
-static void NRI_CALL CmdSetSampleLocations(CommandBuffer&, const SampleLocation*, Sample_t, Sample_t) {
+static void NRI_CALL CmdSetSampleLocations(CommandBuffer& commandBuffer, const SampleLocation*, Sample_t, Sample_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::SET_SAMPLE_LOCATIONS);
 }
 
-static void NRI_CALL CmdSetShadingRate(CommandBuffer&, const ShadingRateDesc&) {
+static void NRI_CALL CmdSetShadingRate(CommandBuffer& commandBuffer, const ShadingRateDesc&) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::SET_SHADING_RATE);
 }
 
-static void NRI_CALL CmdSetDepthBias(CommandBuffer&, const DepthBiasDesc&) {
+static void NRI_CALL CmdSetDepthBias(CommandBuffer& commandBuffer, const DepthBiasDesc&) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::SET_DEPTH_BIAS);
 }
 
-static void NRI_CALL CmdBeginRendering(CommandBuffer&, const AttachmentsDesc&) {
+static void NRI_CALL CmdBeginRendering(CommandBuffer& commandBuffer, const AttachmentsDesc&) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::BEGIN_RENDERING);
 }
 
-static void NRI_CALL CmdClearAttachments(CommandBuffer&, const ClearDesc*, uint32_t, const Rect*, uint32_t) {
+static void NRI_CALL CmdClearAttachments(CommandBuffer& commandBuffer, const ClearDesc*, uint32_t, const Rect*, uint32_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::CLEAR_ATTACHMENTS);
 }
 
-static void NRI_CALL CmdDraw(CommandBuffer&, const DrawDesc&) {
+static void NRI_CALL CmdDraw(CommandBuffer& commandBuffer, const DrawDesc&) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::DRAW);
 }
 
-static void NRI_CALL CmdDrawIndexed(CommandBuffer&, const DrawIndexedDesc&) {
+static void NRI_CALL CmdDrawIndexed(CommandBuffer& commandBuffer, const DrawIndexedDesc&) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::DRAW_INDEXED);
 }
 
-static void NRI_CALL CmdDrawIndirect(CommandBuffer&, const Buffer&, uint64_t, uint32_t, uint32_t, const Buffer*, uint64_t) {
+static void NRI_CALL CmdDrawIndirect(CommandBuffer& commandBuffer, const Buffer&, uint64_t, uint32_t, uint32_t, const Buffer*, uint64_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::DRAW_INDIRECT);
 }
 
-static void NRI_CALL CmdDrawIndexedIndirect(CommandBuffer&, const Buffer&, uint64_t, uint32_t, uint32_t, const Buffer*, uint64_t) {
+static void NRI_CALL CmdDrawIndexedIndirect(CommandBuffer& commandBuffer, const Buffer&, uint64_t, uint32_t, uint32_t, const Buffer*, uint64_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::DRAW_INDEXED_INDIRECT);
 }
 
-static void NRI_CALL CmdEndRendering(CommandBuffer&) {
+static void NRI_CALL CmdEndRendering(CommandBuffer& commandBuffer) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::END_RENDERING);
 }
 
-static void NRI_CALL CmdDispatch(CommandBuffer&, const DispatchDesc&) {
+static void NRI_CALL CmdDispatch(CommandBuffer& commandBuffer, const DispatchDesc&) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::DISPATCH);
 }
 
-static void NRI_CALL CmdDispatchIndirect(CommandBuffer&, const Buffer&, uint64_t) {
+static void NRI_CALL CmdDispatchIndirect(CommandBuffer& commandBuffer, const Buffer&, uint64_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::DISPATCH_INDIRECT);
 }
 
-static void NRI_CALL CmdCopyBuffer(CommandBuffer&, Buffer&, uint64_t, const Buffer&, uint64_t, uint64_t) {
+static void NRI_CALL CmdCopyBuffer(CommandBuffer& commandBuffer, Buffer& dstBuffer, uint64_t dstOffset, const Buffer& srcBuffer, uint64_t srcOffset, uint64_t size) {
+    ((CommandBufferNONE&)commandBuffer).CopyBuffer(dstBuffer, dstOffset, srcBuffer, srcOffset, size);
 }
 
-static void NRI_CALL CmdCopyTexture(CommandBuffer&, Texture&, const TextureRegionDesc*, const Texture&, const TextureRegionDesc*) {
+static void NRI_CALL CmdCopyTexture(CommandBuffer& commandBuffer, Texture& dstTexture, const TextureRegionDesc* dstRegionDesc, const Texture& srcTexture, const TextureRegionDesc* srcRegionDesc) {
+    ((CommandBufferNONE&)commandBuffer).CopyTexture(dstTexture, dstRegionDesc, srcTexture, srcRegionDesc);
 }
 
-static void NRI_CALL CmdUploadBufferToTexture(CommandBuffer&, Texture&, const TextureRegionDesc&, const Buffer&, const TextureDataLayoutDesc&) {
+static void NRI_CALL CmdUploadBufferToTexture(CommandBuffer& commandBuffer, Texture& dstTexture, const TextureRegionDesc& dstRegionDesc, const Buffer& srcBuffer, const TextureDataLayoutDesc& srcDataLayoutDesc) {
+    ((CommandBufferNONE&)commandBuffer).UploadBufferToTexture(dstTexture, dstRegionDesc, srcBuffer, srcDataLayoutDesc);
 }
 
-static void NRI_CALL CmdReadbackTextureToBuffer(CommandBuffer&, Buffer&, const TextureDataLayoutDesc&, const Texture&, const TextureRegionDesc&) {
+static void NRI_CALL CmdReadbackTextureToBuffer(CommandBuffer& commandBuffer, Buffer& dstBuffer, const TextureDataLayoutDesc& dstDataLayoutDesc, const Texture& srcTexture, const TextureRegionDesc& srcRegionDesc) {
+    ((CommandBufferNONE&)commandBuffer).ReadbackTextureToBuffer(dstBuffer, dstDataLayoutDesc, srcTexture, srcRegionDesc);
 }
 
-static void NRI_CALL CmdClearStorageBuffer(CommandBuffer&, const ClearStorageBufferDesc&) {
+static void NRI_CALL CmdClearStorageBuffer(CommandBuffer& commandBuffer, const ClearStorageBufferDesc&) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::CLEAR_STORAGE_BUFFER);
 }
 
-static void NRI_CALL CmdClearStorageTexture(CommandBuffer&, const ClearStorageTextureDesc&) {
+static void NRI_CALL CmdClearStorageTexture(CommandBuffer& commandBuffer, const ClearStorageTextureDesc&) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::CLEAR_STORAGE_TEXTURE);
 }
 
-static void NRI_CALL CmdResolveTexture(CommandBuffer&, Texture&, const TextureRegionDesc*, const Texture&, const TextureRegionDesc*) {
+static void NRI_CALL CmdResolveTexture(CommandBuffer& commandBuffer, Texture&, const TextureRegionDesc*, const Texture&, const TextureRegionDesc*) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::RESOLVE_TEXTURE);
 }
 
-static void NRI_CALL CmdResetQueries(CommandBuffer&, const QueryPool&, uint32_t, uint32_t) {
+static void NRI_CALL CmdResetQueries(CommandBuffer& commandBuffer, const QueryPool&, uint32_t, uint32_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::RESET_QUERIES);
 }
 
-static void NRI_CALL CmdBeginQuery(CommandBuffer&, const QueryPool&, uint32_t) {
+static void NRI_CALL CmdBeginQuery(CommandBuffer& commandBuffer, const QueryPool&, uint32_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::BEGIN_QUERY);
 }
 
-static void NRI_CALL CmdEndQuery(CommandBuffer&, const QueryPool&, uint32_t) {
+static void NRI_CALL CmdEndQuery(CommandBuffer& commandBuffer, const QueryPool&, uint32_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::END_QUERY);
 }
 
-static void NRI_CALL CmdCopyQueries(CommandBuffer&, const QueryPool&, uint32_t, uint32_t, Buffer&, uint64_t) {
+static void NRI_CALL CmdCopyQueries(CommandBuffer& commandBuffer, const QueryPool&, uint32_t, uint32_t, Buffer&, uint64_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::COPY_QUERIES);
 }
 
-static void NRI_CALL CmdBeginAnnotation(CommandBuffer&, const char*) {
+static void NRI_CALL CmdBeginAnnotation(CommandBuffer& commandBuffer, const char*) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::BEGIN_ANNOTATION);
 }
 
-static void NRI_CALL CmdEndAnnotation(CommandBuffer&) {
+static void NRI_CALL CmdEndAnnotation(CommandBuffer& commandBuffer) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::END_ANNOTATION);
 }
 
-static Result NRI_CALL EndCommandBuffer(CommandBuffer&) {
-    return Result::SUCCESS;
+static Result NRI_CALL EndCommandBuffer(CommandBuffer& commandBuffer) {
+    return ((CommandBufferNONE&)commandBuffer).End();
 }
 
-static void NRI_CALL QueueSubmit(CommandQueue&, const QueueSubmitDesc&) {
+static void NRI_CALL QueueSubmit(CommandQueue& commandQueue, const QueueSubmitDesc& queueSubmitDesc) {
+    ((CommandQueueNONE&)commandQueue).Submit(queueSubmitDesc);
 }
 
-static void NRI_CALL Wait(Fence&, uint64_t) {
+static void NRI_CALL Wait(Fence& fence, uint64_t value) {
+    ((FenceNONE&)fence).Wait(value);
 }
 
-static uint64_t NRI_CALL GetFenceValue(Fence&) {
-    return 0;
+static uint64_t NRI_CALL GetFenceValue(Fence& fence) {
+    return ((FenceNONE&)fence).GetFenceValue();
 }
 
 static void NRI_CALL UpdateDescriptorRanges(DescriptorSet&, uint32_t, uint32_t, const DescriptorRangeUpdateDesc*) {
@@ -541,18 +406,23 @@ static void NRI_CALL UpdateDynamicConstantBuffers(DescriptorSet&, uint32_t, uint
 static void NRI_CALL CopyDescriptorSet(DescriptorSet&, const DescriptorSetCopyDesc&) {
 }
 
-static Result NRI_CALL AllocateDescriptorSets(DescriptorPool&, const PipelineLayout&, uint32_t, DescriptorSet**, uint32_t, uint32_t) {
+static Result NRI_CALL AllocateDescriptorSets(DescriptorPool&, const PipelineLayout&, uint32_t, DescriptorSet** descriptorSets, uint32_t instanceNum, uint32_t) {
+    for (uint32_t i = 0; i < instanceNum; i++)
+        descriptorSets[i] = DummyObject<DescriptorSet>();
+
     return Result::SUCCESS;
 }
 
 static void NRI_CALL ResetDescriptorPool(DescriptorPool&) {
 }
 
-static void NRI_CALL ResetCommandAllocator(CommandAllocator&) {
+static void NRI_CALL ResetCommandAllocator(CommandAllocator& commandAllocator) {
+    ((CommandAllocatorNONE&)commandAllocator).Reset();
 }
 
-static void* NRI_CALL MapBuffer(Buffer&, uint64_t, uint64_t) {
-    return nullptr;
+static void* NRI_CALL MapBuffer(Buffer& buffer, uint64_t offset, uint64_t size) {
+    MaybeUnused(size);
+    return ((BufferNONE&)buffer).Map(offset);
 }
 
 static void NRI_CALL UnmapBuffer(Buffer&) {
@@ -567,7 +437,8 @@ static void NRI_CALL SetFenceDebugName(Fence&, const char*) {
 static void NRI_CALL SetDescriptorDebugName(Descriptor&, const char*) {
 }
 
-static void NRI_CALL SetPipelineDebugName(Pipeline&, const char*) {
+static void NRI_CALL SetPipelineDebugName(Pipeline& pipeline, const char* name) {
+    ((PipelineNONE&)pipeline).SetDebugName(name);
 }
 
 static void NRI_CALL SetCommandBufferDebugName(CommandBuffer&, const char*) {
@@ -738,20 +609,56 @@ Result DeviceNONE::FillFunctionTable(CoreInterface& table) const {
 //============================================================================================================================================================================================
 #pragma region[  Helper  ]
 
-static uint32_t NRI_CALL CalculateAllocationNumber(const Device&, const ResourceGroupDesc&) {
-    return 0;
+static uint32_t NRI_CALL CalculateAllocationNumber(const Device& device, const ResourceGroupDesc& resourceGroupDesc) {
+    DeviceNONE& deviceNONE = (DeviceNONE&)device;
+    HelperDeviceMemoryAllocator allocator(deviceNONE.GetCoreInterface(), (Device&)device);
+
+    return allocator.CalculateAllocationNumber(resourceGroupDesc);
 }
 
-static Result NRI_CALL AllocateAndBindMemory(Device&, const ResourceGroupDesc&, Memory**) {
-    return Result::SUCCESS;
+static Result NRI_CALL AllocateAndBindMemory(Device& device, const ResourceGroupDesc& resourceGroupDesc, Memory** allocations) {
+    DeviceNONE& deviceNONE = (DeviceNONE&)device;
+    HelperDeviceMemoryAllocator allocator(deviceNONE.GetCoreInterface(), device);
+
+    return allocator.AllocateAndBindMemory(resourceGroupDesc, allocations);
 }
 
-static Result NRI_CALL UploadData(CommandQueue&, const TextureUploadDesc*, uint32_t, const BufferUploadDesc*, uint32_t) {
-    return Result::SUCCESS;
+static Result NRI_CALL UploadData(CommandQueue& commandQueue, const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum) {
+    return ((CommandQueueNONE&)commandQueue).UploadData(textureUploadDescs, textureUploadDescNum, bufferUploadDescs, bufferUploadDescNum);
 }
 
-static Result NRI_CALL WaitForIdle(CommandQueue&) {
-    return Result::SUCCESS;
+static Result NRI_CALL DownloadData(CommandQueue& commandQueue, const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDownloadDescNum, const BufferDownloadDesc* bufferDownloadDescs, uint32_t bufferDownloadDescNum) {
+    return ((CommandQueueNONE&)commandQueue).DownloadData(textureDownloadDescs, textureDownloadDescNum, bufferDownloadDescs, bufferDownloadDescNum);
+}
+
+static Result NRI_CALL CreateDataUploader(CommandQueue& commandQueue, const DataUploaderDesc& dataUploaderDesc, DataUploader*& dataUploader) {
+    DeviceNONE& device = ((CommandQueueNONE&)commandQueue).GetDevice();
+    HelperDataUpload* impl = Allocate<HelperDataUpload>(device.GetStdAllocator(), device.GetCoreInterface(), (Device&)device, commandQueue, dataUploaderDesc);
+    Result result = impl->Create();
+
+    if (result != Result::SUCCESS) {
+        Destroy(device.GetStdAllocator(), impl);
+        dataUploader = nullptr;
+    } else
+        dataUploader = (DataUploader*)impl;
+
+    return result;
+}
+
+static void NRI_CALL DestroyDataUploader(DataUploader& dataUploader) {
+    Destroy(((DeviceBase&)((HelperDataUpload&)dataUploader).GetDevice()).GetStdAllocator(), (HelperDataUpload*)&dataUploader);
+}
+
+static Result NRI_CALL UploadDataAsync(DataUploader& dataUploader, const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs,
+    uint32_t bufferUploadDescNum, UploadTicket& uploadTicket) {
+    return ((HelperDataUpload&)dataUploader).UploadDataAsync(textureUploadDescs, textureUploadDescNum, bufferUploadDescs, bufferUploadDescNum, uploadTicket);
+}
+
+static Result NRI_CALL WaitForIdle(CommandQueue& commandQueue) {
+    if (!(&commandQueue))
+        return Result::SUCCESS;
+
+    return ((CommandQueueNONE&)commandQueue).WaitForIdle();
 }
 
 static Result NRI_CALL QueryVideoMemoryInfo(const Device&, MemoryLocation, VideoMemoryInfo& videoMemoryInfo) {
@@ -760,12 +667,31 @@ static Result NRI_CALL QueryVideoMemoryInfo(const Device&, MemoryLocation, Video
     return Result::SUCCESS;
 }
 
+static void NRI_CALL GetScratchMemoryStatistics(const Device& device, ScratchMemoryStatistics& scratchMemoryStatistics) {
+    ((DeviceNONE&)device).GetScratchMemoryStatistics(scratchMemoryStatistics);
+}
+
+static Result NRI_CALL GetAllocationStatistics(const Device& device, AllocationCategory allocationCategory, AllocationStatistics& allocationStatistics) {
+    return ((DeviceNONE&)device).GetAllocationStatistics(allocationCategory, allocationStatistics);
+}
+
+static Result NRI_CALL GetCommandStatistics(const Device& device, CommandStatistics& commandStatistics, PipelineCommandStatistics* pipelineCommandStatistics, uint32_t& pipelineCommandStatisticsNum) {
+    return ((DeviceNONE&)device).GetCommandStatistics(commandStatistics, pipelineCommandStatistics, pipelineCommandStatisticsNum);
+}
+
 Result DeviceNONE::FillFunctionTable(HelperInterface& table) const {
     table.CalculateAllocationNumber = ::CalculateAllocationNumber;
     table.AllocateAndBindMemory = ::AllocateAndBindMemory;
     table.UploadData = ::UploadData;
+    table.DownloadData = ::DownloadData;
+    table.CreateDataUploader = ::CreateDataUploader;
+    table.DestroyDataUploader = ::DestroyDataUploader;
+    table.UploadDataAsync = ::UploadDataAsync;
     table.WaitForIdle = ::WaitForIdle;
     table.QueryVideoMemoryInfo = ::QueryVideoMemoryInfo;
+    table.GetScratchMemoryStatistics = ::GetScratchMemoryStatistics;
+    table.GetAllocationStatistics = ::GetAllocationStatistics;
+    table.GetCommandStatistics = ::GetCommandStatistics;
 
     return Result::SUCCESS;
 }
@@ -791,7 +717,8 @@ static Result GetLatencyReport(const SwapChain&, LatencyReport&) {
     return Result::SUCCESS;
 }
 
-static void NRI_CALL QueueSubmitTrackable(CommandQueue&, const QueueSubmitDesc&, const SwapChain&) {
+static void NRI_CALL QueueSubmitTrackable(CommandQueue& commandQueue, const QueueSubmitDesc& queueSubmitDesc, const SwapChain&) {
+    ((CommandQueueNONE&)commandQueue).Submit(queueSubmitDesc);
 }
 
 Result DeviceNONE::FillFunctionTable(LowLatencyInterface& table) const {
@@ -809,10 +736,12 @@ Result DeviceNONE::FillFunctionTable(LowLatencyInterface& table) const {
 //============================================================================================================================================================================================
 #pragma region[  MeshShader  ]
 
-static void NRI_CALL CmdDrawMeshTasks(CommandBuffer&, const DrawMeshTasksDesc&) {
+static void NRI_CALL CmdDrawMeshTasks(CommandBuffer& commandBuffer, const DrawMeshTasksDesc&) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::DRAW_MESH_TASKS);
 }
 
-static void NRI_CALL CmdDrawMeshTasksIndirect(CommandBuffer&, const Buffer&, uint64_t, uint32_t, uint32_t, const Buffer*, uint64_t) {
+static void NRI_CALL CmdDrawMeshTasksIndirect(CommandBuffer& commandBuffer, const Buffer&, uint64_t, uint32_t, uint32_t, const Buffer*, uint64_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::DRAW_MESH_TASKS_INDIRECT);
 }
 
 Result DeviceNONE::FillFunctionTable(MeshShaderInterface& table) const {
@@ -827,7 +756,12 @@ Result DeviceNONE::FillFunctionTable(MeshShaderInterface& table) const {
 //============================================================================================================================================================================================
 #pragma region[  RayTracing  ]
 
-static void NRI_CALL GetAccelerationStructureMemoryDesc(const Device&, const AccelerationStructureDesc&, MemoryLocation, MemoryDesc&) {
+static void NRI_CALL GetAccelerationStructureMemoryDesc(const Device&, const AccelerationStructureDesc& accelerationStructureDesc, MemoryLocation memoryLocation, MemoryDesc& memoryDesc) {
+    // Acceleration structures have no storage, the size only needs to be non-zero
+    memoryDesc = {};
+    memoryDesc.size = Align(std::max(accelerationStructureDesc.instanceOrGeometryObjectNum, 1u) * 64ull, NONE_BUFFER_ALIGNMENT);
+    memoryDesc.alignment = NONE_BUFFER_ALIGNMENT;
+    memoryDesc.type = (MemoryType)memoryLocation;
 }
 
 static uint64_t NRI_CALL GetAccelerationStructureUpdateScratchBufferSize(const AccelerationStructure&) {
@@ -842,10 +776,8 @@ static uint64_t NRI_CALL GetAccelerationStructureHandle(const AccelerationStruct
     return 0;
 }
 
-static Result NRI_CALL CreateRayTracingPipeline(Device&, const RayTracingPipelineDesc&, Pipeline*& pipeline) {
-    pipeline = DummyObject<Pipeline>();
-
-    return Result::SUCCESS;
+static Result NRI_CALL CreateRayTracingPipeline(Device& device, const RayTracingPipelineDesc& rayTracingPipelineDesc, Pipeline*& pipeline) {
+    return ((DeviceNONE&)device).CreateImplementation<PipelineNONE>(pipeline, rayTracingPipelineDesc);
 }
 
 static Result NRI_CALL CreateAccelerationStructure(Device&, const AccelerationStructureDesc&, AccelerationStructure*& accelerationStructure) {
@@ -871,28 +803,36 @@ static Result NRI_CALL WriteShaderGroupIdentifiers(const Pipeline&, uint32_t, ui
     return Result::SUCCESS;
 }
 
-static void NRI_CALL CmdBuildTopLevelAccelerationStructure(CommandBuffer&, uint32_t, const Buffer&, uint64_t, AccelerationStructureBuildBits, AccelerationStructure&, Buffer&, uint64_t) {
+static void NRI_CALL CmdBuildTopLevelAccelerationStructure(CommandBuffer& commandBuffer, uint32_t, const Buffer&, uint64_t, AccelerationStructureBuildBits, AccelerationStructure&, Buffer&, uint64_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::BUILD_TOP_LEVEL_ACCELERATION_STRUCTURE);
 }
 
-static void NRI_CALL CmdBuildBottomLevelAccelerationStructure(CommandBuffer&, uint32_t, const GeometryObject*, AccelerationStructureBuildBits, AccelerationStructure&, Buffer&, uint64_t) {
+static void NRI_CALL CmdBuildBottomLevelAccelerationStructure(CommandBuffer& commandBuffer, uint32_t, const GeometryObject*, AccelerationStructureBuildBits, AccelerationStructure&, Buffer&, uint64_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::BUILD_BOTTOM_LEVEL_ACCELERATION_STRUCTURE);
 }
 
-static void NRI_CALL CmdUpdateTopLevelAccelerationStructure(CommandBuffer&, uint32_t, const Buffer&, uint64_t, AccelerationStructureBuildBits, AccelerationStructure&, const AccelerationStructure&, Buffer&, uint64_t) {
+static void NRI_CALL CmdUpdateTopLevelAccelerationStructure(CommandBuffer& commandBuffer, uint32_t, const Buffer&, uint64_t, AccelerationStructureBuildBits, AccelerationStructure&, const AccelerationStructure&, Buffer&, uint64_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::UPDATE_TOP_LEVEL_ACCELERATION_STRUCTURE);
 }
 
-static void NRI_CALL CmdUpdateBottomLevelAccelerationStructure(CommandBuffer&, uint32_t, const GeometryObject*, AccelerationStructureBuildBits, AccelerationStructure&, const AccelerationStructure&, Buffer&, uint64_t) {
+static void NRI_CALL CmdUpdateBottomLevelAccelerationStructure(CommandBuffer& commandBuffer, uint32_t, const GeometryObject*, AccelerationStructureBuildBits, AccelerationStructure&, const AccelerationStructure&, Buffer&, uint64_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::UPDATE_BOTTOM_LEVEL_ACCELERATION_STRUCTURE);
 }
 
-static void NRI_CALL CmdDispatchRays(CommandBuffer&, const DispatchRaysDesc&) {
+static void NRI_CALL CmdDispatchRays(CommandBuffer& commandBuffer, const DispatchRaysDesc&) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::DISPATCH_RAYS);
 }
 
-static void NRI_CALL CmdDispatchRaysIndirect(CommandBuffer&, const Buffer&, uint64_t) {
+static void NRI_CALL CmdDispatchRaysIndirect(CommandBuffer& commandBuffer, const Buffer&, uint64_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::DISPATCH_RAYS_INDIRECT);
 }
 
-static void NRI_CALL CmdCopyAccelerationStructure(CommandBuffer&, AccelerationStructure&, const AccelerationStructure&, CopyMode) {
+static void NRI_CALL CmdCopyAccelerationStructure(CommandBuffer& commandBuffer, AccelerationStructure&, const AccelerationStructure&, CopyMode) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::COPY_ACCELERATION_STRUCTURE);
 }
 
-static void NRI_CALL CmdWriteAccelerationStructureSize(CommandBuffer&, const AccelerationStructure* const*, uint32_t, QueryPool&, uint32_t) {
+static void NRI_CALL CmdWriteAccelerationStructureSize(CommandBuffer& commandBuffer, const AccelerationStructure* const*, uint32_t, QueryPool&, uint32_t) {
+    ((CommandBufferNONE&)commandBuffer).Record(CommandType::WRITE_ACCELERATION_STRUCTURE_SIZE);
 }
 
 static void NRI_CALL SetAccelerationStructureDebugName(AccelerationStructure&, const char*) {
@@ -930,30 +870,110 @@ Result DeviceNONE::FillFunctionTable(RayTracingInterface& table) const {
 #pragma endregion
 
 //============================================================================================================================================================================================
-#pragma region[  ResourceAllocator  ]
+#pragma region[  Residency  ]
+
+static Result CreateResidencyManager(Device&, const ResidencyManagerDesc&, ResidencyManager*& residencyManager) {
+    residencyManager = DummyObject<ResidencyManager>();
 
-static Result AllocateBuffer(Device&, const AllocateBufferDesc&, Buffer*& buffer) {
-    buffer = DummyObject<Buffer>();
+    return Result::SUCCESS;
+}
+
+static void DestroyResidencyManager(ResidencyManager&) {
+}
+
+static uint32_t RegisterResidencyResource(ResidencyManager&, const ResidencyResourceDesc&) {
+    return 1;
+}
+
+static void UnregisterResidencyResource(ResidencyManager&, uint32_t) {
+}
+
+static void MarkResidencyResourceUsed(ResidencyManager&, uint32_t) {
+}
 
+static Result UpdateResidency(ResidencyManager&) {
     return Result::SUCCESS;
 }
 
-static Result AllocateTexture(Device&, const AllocateTextureDesc&, Texture*& texture) {
-    texture = DummyObject<Texture>();
+static void GetResidencyStatistics(const ResidencyManager&, ResidencyStatistics& residencyStatistics) {
+    residencyStatistics = {};
+}
+
+Result DeviceNONE::FillFunctionTable(ResidencyInterface& table) const {
+    table.CreateResidencyManager = ::CreateResidencyManager;
+    table.DestroyResidencyManager = ::DestroyResidencyManager;
+    table.RegisterResidencyResource = ::RegisterResidencyResource;
+    table.UnregisterResidencyResource = ::UnregisterResidencyResource;
+    table.MarkResidencyResourceUsed = ::MarkResidencyResourceUsed;
+    table.UpdateResidency = ::UpdateResidency;
+    table.GetResidencyStatistics = ::GetResidencyStatistics;
 
     return Result::SUCCESS;
 }
 
+#pragma endregion
+
+//============================================================================================================================================================================================
+#pragma region[  ResourceAllocator  ]
+
+static Result AllocateBuffer(Device& device, const AllocateBufferDesc& bufferDesc, Buffer*& buffer) {
+    Result result = ((DeviceNONE&)device).CreateImplementation<BufferNONE>(buffer, bufferDesc.desc);
+    if (result == Result::SUCCESS) {
+        result = ((BufferNONE*)buffer)->Create(bufferDesc.memoryLocation, bufferDesc.memoryPriority);
+        if (result != Result::SUCCESS) {
+            Destroy(((DeviceNONE&)device).GetStdAllocator(), (BufferNONE*)buffer);
+            buffer = nullptr;
+        }
+    }
+
+    return result;
+}
+
+static Result AllocateTexture(Device& device, const AllocateTextureDesc& textureDesc, Texture*& texture) {
+    Result result = ((DeviceNONE&)device).CreateImplementation<TextureNONE>(texture, textureDesc.desc);
+    if (result == Result::SUCCESS) {
+        result = ((TextureNONE*)texture)->Create(textureDesc.memoryLocation, textureDesc.memoryPriority);
+        if (result != Result::SUCCESS) {
+            Destroy(((DeviceNONE&)device).GetStdAllocator(), (TextureNONE*)texture);
+            texture = nullptr;
+        }
+    }
+
+    return result;
+}
+
 static Result AllocateAccelerationStructure(Device&, const AllocateAccelerationStructureDesc&, AccelerationStructure*& accelerationStructure) {
     accelerationStructure = DummyObject<AccelerationStructure>();
 
     return Result::SUCCESS;
 }
 
+static Result BeginDefragmentation(Device&, const DefragmentationDesc&) {
+    return Result::SUCCESS;
+}
+
+static Result BeginDefragmentationPass(Device&, CommandBuffer&) {
+    return Result::SUCCESS;
+}
+
+static Result EndDefragmentationPass(Device&, DefragmentationReport& defragmentationReport) {
+    defragmentationReport = {};
+    defragmentationReport.isFinished = true;
+
+    return Result::SUCCESS;
+}
+
+static void EndDefragmentation(Device&) {
+}
+
 Result DeviceNONE::FillFunctionTable(ResourceAllocatorInterface& table) const {
     table.AllocateBuffer = ::AllocateBuffer;
     table.AllocateTexture = ::AllocateTexture;
     table.AllocateAccelerationStructure = ::AllocateAccelerationStructure;
+    table.BeginDefragmentation = ::BeginDefragmentation;
+    table.BeginDefragmentationPass = ::BeginDefragmentationPass;
+    table.EndDefragmentationPass = ::EndDefragmentationPass;
+    table.EndDefragmentation = ::EndDefragmentation;
 
     return Result::SUCCESS;
 }
@@ -963,40 +983,74 @@ Result DeviceNONE::FillFunctionTable(ResourceAllocatorInterface& table) const {
 //============================================================================================================================================================================================
 #pragma region[  Streamer  ]
 
-static Result CreateStreamer(Device&, const StreamerDesc&, Streamer*& streamer) {
-    streamer = DummyObject<Streamer>();
+static Result CreateStreamer(Device& device, const StreamerDesc& streamerDesc, Streamer*& streamer) {
+    DeviceNONE& deviceNONE = (DeviceNONE&)device;
+    StreamerImpl* impl = Allocate<StreamerImpl>(deviceNONE.GetStdAllocator(), device, deviceNONE.GetCoreInterface());
+    Result result = impl->Create(streamerDesc);
 
-    return Result::SUCCESS;
+    if (result != Result::SUCCESS) {
+        Destroy(deviceNONE.GetStdAllocator(), impl);
+        streamer = nullptr;
+    } else
+        streamer = (Streamer*)impl;
+
+    return result;
 }
 
-static void DestroyStreamer(Streamer&) {
+static void DestroyStreamer(Streamer& streamer) {
+    Destroy((StreamerImpl*)&streamer);
 }
 
-static Buffer* GetStreamerConstantBuffer(Streamer&) {
-    return nullptr;
+static Buffer* GetStreamerConstantBuffer(Streamer& streamer) {
+    return ((StreamerImpl&)streamer).GetConstantBuffer();
 }
 
-static uint32_t UpdateStreamerConstantBuffer(Streamer&, const void*, uint32_t) {
-    return 0;
+static uint32_t UpdateStreamerConstantBuffer(Streamer& streamer, const void* data, uint32_t dataSize) {
+    return ((StreamerImpl&)streamer).UpdateStreamerConstantBuffer(data, dataSize);
 }
 
-static uint64_t AddStreamerBufferUpdateRequest(Streamer&, const BufferUpdateRequestDesc&) {
-    return 0;
+static uint64_t AddStreamerBufferUpdateRequest(Streamer& streamer, const BufferUpdateRequestDesc& bufferUpdateRequestDesc) {
+    return ((StreamerImpl&)streamer).AddStreamerBufferUpdateRequest(bufferUpdateRequestDesc);
 }
 
-static uint64_t AddStreamerTextureUpdateRequest(Streamer&, const TextureUpdateRequestDesc&) {
-    return 0;
+static uint64_t AddStreamerTextureUpdateRequest(Streamer& streamer, const TextureUpdateRequestDesc& textureUpdateRequestDesc) {
+    return ((StreamerImpl&)streamer).AddStreamerTextureUpdateRequest(textureUpdateRequestDesc);
 }
 
-static Result CopyStreamerUpdateRequests(Streamer&) {
-    return Result::SUCCESS;
+static Result QueueStreamerBufferUpdateRequest(Streamer& streamer, const BufferUpdateRequestDesc& bufferUpdateRequestDesc, uint64_t& requestId) {
+    return ((StreamerImpl&)streamer).QueueStreamerBufferUpdateRequest(bufferUpdateRequestDesc, requestId);
 }
 
-static Buffer* GetStreamerDynamicBuffer(Streamer&) {
-    return nullptr;
+static Result QueueStreamerTextureUpdateRequest(Streamer& streamer, const TextureUpdateRequestDesc& textureUpdateRequestDesc, uint64_t& requestId) {
+    return ((StreamerImpl&)streamer).QueueStreamerTextureUpdateRequest(textureUpdateRequestDesc, requestId);
+}
+
+static void* ReserveStreamerBufferUpdate(Streamer& streamer, const BufferUpdateRequestDesc& bufferUpdateRequestDesc, uint64_t& offset) {
+    return ((StreamerImpl&)streamer).ReserveStreamerBufferUpdate(bufferUpdateRequestDesc, offset);
+}
+
+static Result AddStreamerReadbackRequest(Streamer& streamer, const ReadbackRequestDesc& readbackRequestDesc) {
+    return ((StreamerImpl&)streamer).AddStreamerReadbackRequest(readbackRequestDesc);
+}
+
+static bool IsStreamerRequestComplete(const Streamer& streamer, uint64_t requestId) {
+    return ((StreamerImpl&)streamer).IsStreamerRequestComplete(requestId);
+}
+
+static Result CopyStreamerUpdateRequests(Streamer& streamer) {
+    return ((StreamerImpl&)streamer).CopyStreamerUpdateRequests();
 }
 
-static void CmdUploadStreamerUpdateRequests(CommandBuffer&, Streamer&) {
+static Buffer* GetStreamerDynamicBuffer(Streamer& streamer) {
+    return ((StreamerImpl&)streamer).GetDynamicBuffer();
+}
+
+static void CmdUploadStreamerUpdateRequests(CommandBuffer& commandBuffer, Streamer& streamer) {
+    ((StreamerImpl&)streamer).CmdUploadStreamerUpdateRequests(commandBuffer);
+}
+
+static void GetStreamerStatistics(const Streamer& streamer, StreamerStatistics& streamerStatistics) {
+    ((StreamerImpl&)streamer).GetStatistics(streamerStatistics);
 }
 
 Result DeviceNONE::FillFunctionTable(StreamerInterface& table) const {
@@ -1006,9 +1060,15 @@ Result DeviceNONE::FillFunctionTable(StreamerInterface& table) const {
     table.GetStreamerDynamicBuffer = ::GetStreamerDynamicBuffer;
     table.AddStreamerBufferUpdateRequest = ::AddStreamerBufferUpdateRequest;
     table.AddStreamerTextureUpdateRequest = ::AddStreamerTextureUpdateRequest;
+    table.QueueStreamerBufferUpdateRequest = ::QueueStreamerBufferUpdateRequest;
+    table.QueueStreamerTextureUpdateRequest = ::QueueStreamerTextureUpdateRequest;
+    table.ReserveStreamerBufferUpdate = ::ReserveStreamerBufferUpdate;
+    table.AddStreamerReadbackRequest = ::AddStreamerReadbackRequest;
+    table.IsStreamerRequestComplete = ::IsStreamerRequestComplete;
     table.UpdateStreamerConstantBuffer = ::UpdateStreamerConstantBuffer;
     table.CopyStreamerUpdateRequests = ::CopyStreamerUpdateRequests;
     table.CmdUploadStreamerUpdateRequests = ::CmdUploadStreamerUpdateRequests;
+    table.GetStreamerStatistics = ::GetStreamerStatistics;
 
     return Result::SUCCESS;
 }
@@ -1018,27 +1078,23 @@ Result DeviceNONE::FillFunctionTable(StreamerInterface& table) const {
 //============================================================================================================================================================================================
 #pragma region[  SwapChain  ]
 
-static Result NRI_CALL CreateSwapChain(Device&, const SwapChainDesc&, SwapChain*& swapChain) {
-    swapChain = DummyObject<SwapChain>();
-
-    return Result::SUCCESS;
+static Result NRI_CALL CreateSwapChain(Device& device, const SwapChainDesc& swapChainDesc, SwapChain*& swapChain) {
+    return ((DeviceNONE&)device).CreateImplementation<SwapChainNONE>(swapChain, swapChainDesc);
 }
 
-static void NRI_CALL DestroySwapChain(SwapChain&) {
+static void NRI_CALL DestroySwapChain(SwapChain& swapChain) {
+    Destroy((SwapChainNONE*)&swapChain);
 }
 
 static void NRI_CALL SetSwapChainDebugName(SwapChain&, const char*) {
 }
 
-static Texture* const* NRI_CALL GetSwapChainTextures(const SwapChain&, uint32_t& textureNum) {
-    static void* textures[1] = {};
-    textureNum = 1;
-
-    return (Texture**)textures;
+static Texture* const* NRI_CALL GetSwapChainTextures(const SwapChain& swapChain, uint32_t& textureNum) {
+    return ((SwapChainNONE&)swapChain).GetTextures(textureNum);
 }
 
-static uint32_t NRI_CALL AcquireNextSwapChainTexture(SwapChain&) {
-    return 0;
+static uint32_t NRI_CALL AcquireNextSwapChainTexture(SwapChain& swapChain) {
+    return ((SwapChainNONE&)swapChain).AcquireNextTexture();
 }
 
 static Result NRI_CALL WaitForPresent(SwapChain&) {
@@ -0,0 +1,50 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+struct DeviceNONE;
+
+struct MemoryNONE {
+    inline MemoryNONE(DeviceNONE& device)
+        : m_Device(device) {
+    }
+
+    ~MemoryNONE();
+
+    inline DeviceNONE& GetDevice() const {
+        return m_Device;
+    }
+
+    inline MemoryLocation GetLocation() const {
+        return m_Location;
+    }
+
+    inline uint64_t GetSize() const {
+        return m_Size;
+    }
+
+    // NULL if the memory is not backed by a host allocation (device local memory without "enableNONEHostMemory")
+    inline uint8_t* GetData() const {
+        return m_Data;
+    }
+
+    Result Create(const AllocateMemoryDesc& allocateMemoryDesc);
+
+    //================================================================================================================
+    // NRI
+    //================================================================================================================
+
+    inline void SetDebugName(const char* name) {
+        MaybeUnused(name);
+    }
+
+private:
+    DeviceNONE& m_Device;
+    uint8_t* m_Data = nullptr;
+    uint64_t m_Size = 0;
+    MemoryLocation m_Location = MemoryLocation::DEVICE;
+};
+
+} // namespace nri
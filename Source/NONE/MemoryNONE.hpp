@@ -0,0 +1,24 @@
+// © 2021 NVIDIA Corporation
+
+MemoryNONE::~MemoryNONE() {
+    const AllocationCallbacks& allocationCallbacks = m_Device.GetStdAllocator().GetInterface();
+    if (m_Data)
+        allocationCallbacks.Free(allocationCallbacks.userArg, m_Data);
+}
+
+Result MemoryNONE::Create(const AllocateMemoryDesc& allocateMemoryDesc) {
+    m_Location = (MemoryLocation)allocateMemoryDesc.type;
+    m_Size = allocateMemoryDesc.size;
+
+    if (m_Device.HasStorage(m_Location) && m_Size) {
+        const AllocationCallbacks& allocationCallbacks = m_Device.GetStdAllocator().GetInterface();
+        m_Data = (uint8_t*)allocationCallbacks.Allocate(allocationCallbacks.userArg, (size_t)m_Size, NONE_TEXTURE_ALIGNMENT);
+        if (!m_Data)
+            return Result::OUT_OF_MEMORY;
+
+        // Deterministic initial contents
+        memset(m_Data, 0, (size_t)m_Size);
+    }
+
+    return Result::SUCCESS;
+}
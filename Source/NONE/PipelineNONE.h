@@ -0,0 +1,40 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+struct DeviceNONE;
+
+// Has no state, but gets a stable index for per-pipeline command statistics
+struct PipelineNONE {
+    inline PipelineNONE(DeviceNONE& device)
+        : m_Device(device) {
+    }
+
+    ~PipelineNONE();
+
+    inline DeviceNONE& GetDevice() const {
+        return m_Device;
+    }
+
+    inline uint32_t GetIndex() const {
+        return m_Index;
+    }
+
+    Result Create(const GraphicsPipelineDesc& graphicsPipelineDesc);
+    Result Create(const ComputePipelineDesc& computePipelineDesc);
+    Result Create(const RayTracingPipelineDesc& rayTracingPipelineDesc);
+
+    //================================================================================================================
+    // NRI
+    //================================================================================================================
+
+    void SetDebugName(const char* name);
+
+private:
+    DeviceNONE& m_Device;
+    uint32_t m_Index = 0;
+};
+
+} // namespace nri
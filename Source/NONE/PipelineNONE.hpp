@@ -0,0 +1,38 @@
+// © 2021 NVIDIA Corporation
+
+PipelineNONE::~PipelineNONE() {
+    if (m_Device.IsCommandProfilingEnabled())
+        m_Device.GetCommandProfiler().UnregisterPipeline(m_Index);
+}
+
+NRI_INLINE Result PipelineNONE::Create(const GraphicsPipelineDesc& graphicsPipelineDesc) {
+    MaybeUnused(graphicsPipelineDesc);
+
+    if (m_Device.IsCommandProfilingEnabled())
+        m_Index = m_Device.GetCommandProfiler().RegisterPipeline();
+
+    return Result::SUCCESS;
+}
+
+NRI_INLINE Result PipelineNONE::Create(const ComputePipelineDesc& computePipelineDesc) {
+    MaybeUnused(computePipelineDesc);
+
+    if (m_Device.IsCommandProfilingEnabled())
+        m_Index = m_Device.GetCommandProfiler().RegisterPipeline();
+
+    return Result::SUCCESS;
+}
+
+NRI_INLINE Result PipelineNONE::Create(const RayTracingPipelineDesc& rayTracingPipelineDesc) {
+    MaybeUnused(rayTracingPipelineDesc);
+
+    if (m_Device.IsCommandProfilingEnabled())
+        m_Index = m_Device.GetCommandProfiler().RegisterPipeline();
+
+    return Result::SUCCESS;
+}
+
+NRI_INLINE void PipelineNONE::SetDebugName(const char* name) {
+    if (m_Device.IsCommandProfilingEnabled())
+        m_Device.GetCommandProfiler().SetPipelineName(m_Index, name);
+}
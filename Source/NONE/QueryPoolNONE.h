@@ -0,0 +1,45 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+struct DeviceNONE;
+
+// Queries are never written, only the layout is known
+struct QueryPoolNONE {
+    inline QueryPoolNONE(DeviceNONE& device)
+        : m_Device(device) {
+    }
+
+    inline ~QueryPoolNONE() {
+    }
+
+    inline DeviceNONE& GetDevice() const {
+        return m_Device;
+    }
+
+    inline Result Create(const QueryPoolDesc& queryPoolDesc) {
+        m_Desc = queryPoolDesc;
+
+        return Result::SUCCESS;
+    }
+
+    //================================================================================================================
+    // NRI
+    //================================================================================================================
+
+    inline void SetDebugName(const char* name) {
+        MaybeUnused(name);
+    }
+
+    inline uint32_t GetQuerySize() const {
+        return m_Desc.queryType == QueryType::PIPELINE_STATISTICS ? sizeof(PipelineStatisticsDesc) : sizeof(uint64_t);
+    }
+
+private:
+    DeviceNONE& m_Device;
+    QueryPoolDesc m_Desc = {};
+};
+
+} // namespace nri
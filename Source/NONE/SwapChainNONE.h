@@ -0,0 +1,52 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+struct DeviceNONE;
+struct TextureNONE;
+
+// Textures have descs, but no storage
+struct SwapChainNONE {
+    inline SwapChainNONE(DeviceNONE& device)
+        : m_Device(device)
+        , m_Textures(device.GetStdAllocator()) {
+    }
+
+    ~SwapChainNONE();
+
+    inline DeviceNONE& GetDevice() const {
+        return m_Device;
+    }
+
+    Result Create(const SwapChainDesc& swapChainDesc);
+
+    //================================================================================================================
+    // NRI
+    //================================================================================================================
+
+    inline void SetDebugName(const char* name) {
+        MaybeUnused(name);
+    }
+
+    inline Texture* const* GetTextures(uint32_t& textureNum) const {
+        textureNum = (uint32_t)m_Textures.size();
+
+        return (Texture**)m_Textures.data();
+    }
+
+    inline uint32_t AcquireNextTexture() {
+        uint32_t textureIndex = m_TextureIndex;
+        m_TextureIndex = (m_TextureIndex + 1) % (uint32_t)m_Textures.size();
+
+        return textureIndex;
+    }
+
+private:
+    DeviceNONE& m_Device;
+    Vector<TextureNONE*> m_Textures;
+    uint32_t m_TextureIndex = 0;
+};
+
+} // namespace nri
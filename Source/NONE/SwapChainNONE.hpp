@@ -0,0 +1,39 @@
+// © 2021 NVIDIA Corporation
+
+constexpr std::array<Format, (size_t)SwapChainFormat::MAX_NUM> g_swapChainFormat = {
+    Format::RGBA16_SFLOAT,        // BT709_G10_16BIT
+    Format::RGBA8_UNORM,          // BT709_G22_8BIT
+    Format::R10_G10_B10_A2_UNORM, // BT709_G22_10BIT
+    Format::R10_G10_B10_A2_UNORM, // BT2020_G2084_10BIT
+};
+
+SwapChainNONE::~SwapChainNONE() {
+    for (TextureNONE* texture : m_Textures)
+        Destroy(m_Device.GetStdAllocator(), texture);
+}
+
+NRI_INLINE Result SwapChainNONE::Create(const SwapChainDesc& swapChainDesc) {
+    TextureDesc textureDesc = {};
+    textureDesc.type = TextureType::TEXTURE_2D;
+    textureDesc.usage = TextureUsageBits::SHADER_RESOURCE | TextureUsageBits::COLOR_ATTACHMENT;
+    textureDesc.format = g_swapChainFormat[(size_t)swapChainDesc.format];
+    textureDesc.width = swapChainDesc.width;
+    textureDesc.height = swapChainDesc.height;
+
+    uint32_t textureNum = std::max(swapChainDesc.textureNum, (uint8_t)1);
+    m_Textures.reserve(textureNum);
+
+    for (uint32_t i = 0; i < textureNum; i++) {
+        TextureNONE* texture = Allocate<TextureNONE>(m_Device.GetStdAllocator(), m_Device);
+        if (!texture)
+            return Result::OUT_OF_MEMORY;
+
+        m_Textures.push_back(texture);
+
+        Result result = texture->Create(textureDesc);
+        if (result != Result::SUCCESS)
+            return result;
+    }
+
+    return Result::SUCCESS;
+}
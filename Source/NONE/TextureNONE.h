@@ -0,0 +1,63 @@
+// © 2021 NVIDIA Corporation
+
+#pragma once
+
+namespace nri {
+
+struct DeviceNONE;
+struct MemoryNONE;
+
+// Subresources are tightly packed: layers, mips, slices, rows of blocks
+struct SubresourceLayoutNONE {
+    uint64_t offset; // from the texture start
+    uint64_t slicePitch;
+    uint32_t rowPitch;
+    uint32_t rowNum; // rows of blocks
+    Dim_t width;
+    Dim_t height;
+    Dim_t depth;
+};
+
+struct TextureNONE {
+    inline TextureNONE(DeviceNONE& device)
+        : m_Device(device) {
+    }
+
+    ~TextureNONE();
+
+    inline const TextureDesc& GetDesc() const {
+        return m_Desc;
+    }
+
+    inline DeviceNONE& GetDevice() const {
+        return m_Device;
+    }
+
+    // NULL if not bound or bound to a memory without storage
+    inline uint8_t* GetData() const {
+        return m_Data;
+    }
+
+    Result Create(const TextureDesc& textureDesc);
+    Result Create(MemoryLocation memoryLocation, float priority);
+    void Bind(const MemoryNONE& memory, uint64_t offset);
+
+    //================================================================================================================
+    // NRI
+    //================================================================================================================
+
+    inline void SetDebugName(const char* name) {
+        MaybeUnused(name);
+    }
+
+private:
+    DeviceNONE& m_Device;
+    MemoryNONE* m_DedicatedMemory = nullptr;
+    uint8_t* m_Data = nullptr;
+    TextureDesc m_Desc = {};
+};
+
+} // namespace nri
+
+nri::SubresourceLayoutNONE GetSubresourceLayout(const nri::TextureDesc& textureDesc, nri::Dim_t layer, nri::Mip_t mip); // "textureDesc" must be fixed
+uint64_t GetTextureSize(const nri::TextureDesc& textureDesc);
@@ -0,0 +1,78 @@
+// © 2021 NVIDIA Corporation
+
+static inline uint64_t GetMipSize(const TextureDesc& textureDesc, Mip_t mip, SubresourceLayoutNONE& layout) {
+    const FormatProps& formatProps = GetFormatProps(textureDesc.format);
+
+    layout.width = (Dim_t)std::max(textureDesc.width >> mip, 1);
+    layout.height = (Dim_t)std::max(textureDesc.height >> mip, 1);
+    layout.depth = (Dim_t)std::max(textureDesc.depth >> mip, 1);
+    layout.rowPitch = (uint32_t)((layout.width + formatProps.blockWidth - 1) / formatProps.blockWidth) * formatProps.stride;
+    layout.rowNum = (uint32_t)((layout.height + formatProps.blockHeight - 1) / formatProps.blockHeight);
+    layout.slicePitch = (uint64_t)layout.rowPitch * layout.rowNum;
+
+    return layout.slicePitch * layout.depth * textureDesc.sampleNum;
+}
+
+SubresourceLayoutNONE GetSubresourceLayout(const TextureDesc& textureDesc, Dim_t layer, Mip_t mip) {
+    SubresourceLayoutNONE layout = {};
+
+    uint64_t layerSize = 0;
+    uint64_t mipOffset = 0;
+    for (Mip_t i = 0; i < textureDesc.mipNum; i++) {
+        if (i == mip)
+            mipOffset = layerSize;
+
+        layerSize += GetMipSize(textureDesc, i, layout);
+    }
+
+    GetMipSize(textureDesc, mip, layout);
+    layout.offset = layer * layerSize + mipOffset;
+
+    return layout;
+}
+
+uint64_t GetTextureSize(const TextureDesc& textureDesc) {
+    SubresourceLayoutNONE layout = {};
+
+    uint64_t layerSize = 0;
+    for (Mip_t i = 0; i < textureDesc.mipNum; i++)
+        layerSize += GetMipSize(textureDesc, i, layout);
+
+    return layerSize * textureDesc.layerNum;
+}
+
+TextureNONE::~TextureNONE() {
+    Destroy(m_DedicatedMemory);
+}
+
+NRI_INLINE Result TextureNONE::Create(const TextureDesc& textureDesc) {
+    m_Desc = FixTextureDesc(textureDesc);
+
+    return Result::SUCCESS;
+}
+
+NRI_INLINE Result TextureNONE::Create(MemoryLocation memoryLocation, float priority) {
+    MemoryDesc memoryDesc = {};
+    m_Device.GetMemoryDesc(m_Desc, memoryLocation, memoryDesc);
+
+    AllocateMemoryDesc allocateMemoryDesc = {};
+    allocateMemoryDesc.size = memoryDesc.size;
+    allocateMemoryDesc.type = memoryDesc.type;
+    allocateMemoryDesc.priority = priority;
+    allocateMemoryDesc.alignment = memoryDesc.alignment;
+
+    Memory* memory = nullptr;
+    Result result = m_Device.CreateImplementation<MemoryNONE>(memory, allocateMemoryDesc);
+    if (result != Result::SUCCESS)
+        return result;
+
+    m_DedicatedMemory = (MemoryNONE*)memory;
+    Bind(*m_DedicatedMemory, 0);
+
+    return Result::SUCCESS;
+}
+
+NRI_INLINE void TextureNONE::Bind(const MemoryNONE& memory, uint64_t offset) {
+    uint8_t* data = memory.GetData();
+    m_Data = data ? data + offset : nullptr;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+// Opt-in ("enableAllocationTracking") host memory tracking, implemented as "AllocationCallbacks" wrapping
+// the application (or default) ones. Each allocation gets a small header, storing its size and category
+
+constexpr nri::AllocationCategory ALLOCATION_CATEGORY_UNSET = nri::AllocationCategory::MAX_NUM;
+
+struct AllocationTracker;
+
+// Allocations made by the current thread in the scope get the specified category
+extern thread_local nri::AllocationCategory g_AllocationCategory;
+
+struct AllocationCategoryScope {
+    inline AllocationCategoryScope(nri::AllocationCategory category)
+        : m_PrevCategory(g_AllocationCategory) {
+        g_AllocationCategory = category;
+    }
+
+    inline ~AllocationCategoryScope() {
+        g_AllocationCategory = m_PrevCategory;
+    }
+
+private:
+    nri::AllocationCategory m_PrevCategory;
+};
+
+// "userArg" of the tracking callbacks: the category is used if not overridden by a scope
+struct AllocationTrackerView {
+    AllocationTracker* tracker;
+    nri::AllocationCategory category;
+};
+
+struct AllocationCounters {
+    std::atomic_uint64_t liveSize;
+    std::atomic_uint64_t peakSize;
+    std::atomic_uint64_t totalNum;
+    std::atomic_uint32_t liveNum;
+    std::atomic_uint32_t peakNum;
+};
+
+struct AllocationTracker {
+    AllocationTracker(const AllocationCallbacks& allocationCallbacks, const nri::CallbackInterface& callbackInterface, uint32_t dumpPeriod);
+
+    inline const AllocationCallbacks& GetParentAllocationCallbacks() const {
+        return m_AllocationCallbacks;
+    }
+
+    AllocationCallbacks GetAllocationCallbacks(nri::AllocationCategory defaultCategory);
+    void GetStatistics(nri::AllocationCategory category, nri::AllocationStatistics& allocationStatistics) const;
+    void Dump(nri::Message messageType, const char* title) const;
+    void MaybeDump(); // periodic, driven by frame boundaries to keep the allocation path cheap
+
+    void* Allocate(nri::AllocationCategory category, size_t size, size_t alignment);
+    void* Reallocate(nri::AllocationCategory category, void* memory, size_t size, size_t alignment);
+    void Free(void* memory);
+
+private:
+    AllocationCallbacks m_AllocationCallbacks = {};
+    nri::CallbackInterface m_CallbackInterface = {};
+    std::array<AllocationTrackerView, (size_t)nri::AllocationCategory::MAX_NUM> m_Views = {};
+    std::array<AllocationCounters, (size_t)nri::AllocationCategory::MAX_NUM> m_Counters = {};
+    std::atomic_uint64_t m_NextDumpTime = 0;
+    uint32_t m_DumpPeriod = 0; // ms
+};
+
+// Replaces "allocationCallbacks" with the tracking ones
+nri::Result CreateAllocationTracker(AllocationCallbacks& allocationCallbacks, const nri::CallbackInterface& callbackInterface, uint32_t dumpPeriod);
+
+// Reports leaks, if any
+void DestroyAllocationTracker(AllocationTracker* allocationTracker);
+
+// NULL if "allocationCallbacks" are not the tracking ones
+AllocationTracker* GetAllocationTracker(const AllocationCallbacks& allocationCallbacks);
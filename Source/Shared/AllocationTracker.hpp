@@ -0,0 +1,213 @@
+#include <chrono>
+
+constexpr std::array<const char*, (size_t)AllocationCategory::MAX_NUM> ALLOCATION_CATEGORY_NAME = {
+    "DEVICE",
+    "DESCRIPTOR",
+    "PIPELINE",
+    "VALIDATION",
+    "SCRATCH",
+    "STREAMER",
+};
+
+// Precedes each tracked allocation
+struct AllocationHeader {
+    uint64_t size;
+    uint32_t offset; // from the parent allocation
+    AllocationCategory category;
+};
+
+thread_local AllocationCategory g_AllocationCategory = ALLOCATION_CATEGORY_UNSET;
+
+static void* TrackedAllocate(void* userArg, size_t size, size_t alignment) {
+    AllocationTrackerView& view = *(AllocationTrackerView*)userArg;
+    AllocationCategory category = g_AllocationCategory == ALLOCATION_CATEGORY_UNSET ? view.category : g_AllocationCategory;
+
+    return view.tracker->Allocate(category, size, alignment);
+}
+
+static void* TrackedReallocate(void* userArg, void* memory, size_t size, size_t alignment) {
+    AllocationTrackerView& view = *(AllocationTrackerView*)userArg;
+    AllocationCategory category = g_AllocationCategory == ALLOCATION_CATEGORY_UNSET ? view.category : g_AllocationCategory;
+
+    return view.tracker->Reallocate(category, memory, size, alignment);
+}
+
+static void TrackedFree(void* userArg, void* memory) {
+    AllocationTrackerView& view = *(AllocationTrackerView*)userArg;
+
+    view.tracker->Free(memory);
+}
+
+static inline uint64_t GetTimeMs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template <typename T>
+static inline void UpdatePeak(std::atomic<T>& peak, T value) {
+    T prev = peak.load(std::memory_order_relaxed);
+    while (prev < value && !peak.compare_exchange_weak(prev, value, std::memory_order_relaxed))
+        ;
+}
+
+AllocationTracker::AllocationTracker(const AllocationCallbacks& allocationCallbacks, const CallbackInterface& callbackInterface, uint32_t dumpPeriod)
+    : m_AllocationCallbacks(allocationCallbacks)
+    , m_CallbackInterface(callbackInterface)
+    , m_DumpPeriod(dumpPeriod) {
+    for (size_t i = 0; i < m_Views.size(); i++)
+        m_Views[i] = {this, (AllocationCategory)i};
+
+    if (m_DumpPeriod)
+        m_NextDumpTime.store(GetTimeMs() + m_DumpPeriod, std::memory_order_relaxed);
+}
+
+AllocationCallbacks AllocationTracker::GetAllocationCallbacks(AllocationCategory defaultCategory) {
+    AllocationCallbacks allocationCallbacks = {};
+    allocationCallbacks.Allocate = TrackedAllocate;
+    allocationCallbacks.Reallocate = TrackedReallocate;
+    allocationCallbacks.Free = TrackedFree;
+    allocationCallbacks.userArg = &m_Views[(size_t)defaultCategory];
+
+    return allocationCallbacks;
+}
+
+void AllocationTracker::GetStatistics(AllocationCategory category, AllocationStatistics& allocationStatistics) const {
+    const AllocationCounters& counters = m_Counters[(size_t)category];
+
+    allocationStatistics = {};
+    allocationStatistics.liveSize = counters.liveSize.load(std::memory_order_relaxed);
+    allocationStatistics.peakSize = counters.peakSize.load(std::memory_order_relaxed);
+    allocationStatistics.totalNum = counters.totalNum.load(std::memory_order_relaxed);
+    allocationStatistics.liveNum = counters.liveNum.load(std::memory_order_relaxed);
+    allocationStatistics.peakNum = counters.peakNum.load(std::memory_order_relaxed);
+}
+
+void AllocationTracker::Dump(Message messageType, const char* title) const {
+    if (!m_CallbackInterface.MessageCallback)
+        return;
+
+    char buf[MAX_MESSAGE_LENGTH];
+    int32_t written = snprintf(buf, sizeof(buf), "%s", title);
+
+    for (size_t i = 0; i < m_Counters.size() && written < (int32_t)sizeof(buf); i++) {
+        AllocationStatistics allocationStatistics = {};
+        GetStatistics((AllocationCategory)i, allocationStatistics);
+
+        written += snprintf(buf + written, sizeof(buf) - written, "\n  %-10s live: %llu bytes (%u), peak: %llu bytes (%u), total: %llu",
+            ALLOCATION_CATEGORY_NAME[i], (unsigned long long)allocationStatistics.liveSize, allocationStatistics.liveNum,
+            (unsigned long long)allocationStatistics.peakSize, allocationStatistics.peakNum, (unsigned long long)allocationStatistics.totalNum);
+    }
+
+    m_CallbackInterface.MessageCallback(messageType, __FILE__, __LINE__, buf, m_CallbackInterface.userArg);
+}
+
+void* AllocationTracker::Allocate(AllocationCategory category, size_t size, size_t alignment) {
+    alignment = std::max(alignment, alignof(AllocationHeader));
+    size_t offset = Align(sizeof(AllocationHeader), alignment);
+
+    uint8_t* memory = (uint8_t*)m_AllocationCallbacks.Allocate(m_AllocationCallbacks.userArg, size + offset, alignment);
+    if (!memory)
+        return nullptr;
+
+    memory += offset;
+
+    AllocationHeader* header = (AllocationHeader*)memory - 1;
+    header->size = size;
+    header->offset = (uint32_t)offset;
+    header->category = category;
+
+    AllocationCounters& counters = m_Counters[(size_t)category];
+    uint64_t liveSize = counters.liveSize.fetch_add(size, std::memory_order_relaxed) + size;
+    uint32_t liveNum = counters.liveNum.fetch_add(1, std::memory_order_relaxed) + 1;
+    counters.totalNum.fetch_add(1, std::memory_order_relaxed);
+
+    UpdatePeak(counters.peakSize, liveSize);
+    UpdatePeak(counters.peakNum, liveNum);
+
+    return memory;
+}
+
+void* AllocationTracker::Reallocate(AllocationCategory category, void* memory, size_t size, size_t alignment) {
+    if (!memory)
+        return Allocate(category, size, alignment);
+
+    if (!size) {
+        Free(memory);
+        return nullptr;
+    }
+
+    // The parent allocation can't be reallocated "as is", since the header offset depends on the alignment
+    void* newMemory = Allocate(category, size, alignment);
+    if (!newMemory)
+        return nullptr;
+
+    const AllocationHeader* header = (AllocationHeader*)memory - 1;
+    memcpy(newMemory, memory, (size_t)std::min(header->size, (uint64_t)size));
+
+    Free(memory);
+
+    return newMemory;
+}
+
+void AllocationTracker::Free(void* memory) {
+    if (!memory)
+        return;
+
+    const AllocationHeader* header = (AllocationHeader*)memory - 1;
+
+    AllocationCounters& counters = m_Counters[(size_t)header->category];
+    counters.liveSize.fetch_sub(header->size, std::memory_order_relaxed);
+    counters.liveNum.fetch_sub(1, std::memory_order_relaxed);
+
+    m_AllocationCallbacks.Free(m_AllocationCallbacks.userArg, (uint8_t*)memory - header->offset);
+}
+
+void AllocationTracker::MaybeDump() {
+    if (!m_DumpPeriod)
+        return;
+
+    uint64_t time = GetTimeMs();
+    uint64_t nextDumpTime = m_NextDumpTime.load(std::memory_order_relaxed);
+
+    // Only one thread wins
+    if (time >= nextDumpTime && m_NextDumpTime.compare_exchange_strong(nextDumpTime, time + m_DumpPeriod, std::memory_order_relaxed))
+        Dump(Message::INFO, "NRI host memory:");
+}
+
+Result CreateAllocationTracker(AllocationCallbacks& allocationCallbacks, const CallbackInterface& callbackInterface, uint32_t dumpPeriod) {
+    AllocationTracker* allocationTracker = (AllocationTracker*)allocationCallbacks.Allocate(allocationCallbacks.userArg, sizeof(AllocationTracker), alignof(AllocationTracker));
+    if (!allocationTracker)
+        return Result::OUT_OF_MEMORY;
+
+    new (allocationTracker) AllocationTracker(allocationCallbacks, callbackInterface, dumpPeriod);
+
+    allocationCallbacks = allocationTracker->GetAllocationCallbacks(AllocationCategory::DEVICE);
+
+    return Result::SUCCESS;
+}
+
+void DestroyAllocationTracker(AllocationTracker* allocationTracker) {
+    if (!allocationTracker)
+        return;
+
+    uint32_t liveNum = 0;
+    for (uint32_t i = 0; i < (uint32_t)AllocationCategory::MAX_NUM; i++) {
+        AllocationStatistics allocationStatistics = {};
+        allocationTracker->GetStatistics((AllocationCategory)i, allocationStatistics);
+
+        liveNum += allocationStatistics.liveNum;
+    }
+
+    if (liveNum)
+        allocationTracker->Dump(Message::WARNING, "NRI host memory leaks (live allocations after device destruction):");
+
+    AllocationCallbacks allocationCallbacks = allocationTracker->GetParentAllocationCallbacks();
+    allocationTracker->~AllocationTracker();
+    allocationCallbacks.Free(allocationCallbacks.userArg, allocationTracker);
+}
+
+AllocationTracker* GetAllocationTracker(const AllocationCallbacks& allocationCallbacks) {
+    if (allocationCallbacks.Allocate != TrackedAllocate)
+        return nullptr;
+
+    return ((AllocationTrackerView*)allocationCallbacks.userArg)->tracker;
+}
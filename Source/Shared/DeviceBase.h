@@ -3,21 +3,60 @@
 #pragma once
 
 namespace nri {
+
+constexpr uint32_t SCRATCH_ARENA_CACHE_SIZE = 4; // devices per thread
+
+struct ScratchArenaCacheEntry {
+    uint64_t deviceId;
+    ScratchArena* arena;
+};
+
+// Per-thread "device -> arena" cache, makes "GetScratchArena" lock-free
+extern thread_local ScratchArenaCacheEntry g_ScratchArenaCache[SCRATCH_ARENA_CACHE_SIZE];
+
+uint64_t GetDeviceId();
+
 struct DeviceBase {
     inline DeviceBase(const CallbackInterface& callbacks, const StdAllocator<uint8_t>& stdAllocator)
         : m_CallbackInterface(callbacks)
-        , m_StdAllocator(stdAllocator) {
+        , m_StdAllocator(stdAllocator)
+        , m_ScratchArenas(stdAllocator)
+        , m_Id(GetDeviceId()) {
     }
 
     inline StdAllocator<uint8_t>& GetStdAllocator() {
         return m_StdAllocator;
     }
 
-    void ReportMessage(Message messageType, const char* file, uint32_t line, const char* format, ...) const;
+    // The arena of the calling thread
+    inline ScratchArena& GetScratchArena() {
+        for (const ScratchArenaCacheEntry& entry : g_ScratchArenaCache) {
+            if (entry.deviceId == m_Id)
+                return *entry.arena;
+        }
+
+        return *FindScratchArena(true);
+    }
+
+    // Frame boundary work, called by "ResetCommandAllocator": releases excessive memory of the calling thread arena
+    // and, if it's time, reports allocation statistics
+    void OnCommandAllocatorReset();
+    void GetScratchMemoryStatistics(ScratchMemoryStatistics& scratchMemoryStatistics) const;
 
-    virtual ~DeviceBase() {
+    inline Result GetAllocationStatistics(AllocationCategory allocationCategory, AllocationStatistics& allocationStatistics) const {
+        const AllocationTracker* allocationTracker = GetAllocationTracker(m_StdAllocator.GetInterface());
+        if (!allocationTracker)
+            return Result::UNSUPPORTED;
+
+        allocationTracker->GetStatistics(allocationCategory, allocationStatistics);
+
+        return Result::SUCCESS;
     }
 
+    void ReportMessage(Message messageType, const char* file, uint32_t line, const char* format, ...) const;
+
+    virtual ~DeviceBase();
+
     virtual const DeviceDesc& GetDesc() const = 0;
     virtual void Destruct() = 0;
 
@@ -41,6 +80,10 @@ struct DeviceBase {
         return Result::UNSUPPORTED;
     }
 
+    virtual Result FillFunctionTable(ResidencyInterface&) const {
+        return Result::UNSUPPORTED;
+    }
+
     virtual Result FillFunctionTable(StreamerInterface&) const {
         return Result::UNSUPPORTED;
     }
@@ -68,5 +111,13 @@ struct DeviceBase {
 protected:
     CallbackInterface m_CallbackInterface = {};
     StdAllocator<uint8_t> m_StdAllocator;
+
+private:
+    ScratchArena* FindScratchArena(bool create);
+
+private:
+    Vector<ScratchArena*> m_ScratchArenas;
+    uint64_t m_Id = 0;
+    mutable Lock m_ScratchArenaLock{"DeviceBase::ScratchArena"};
 };
 } // namespace nri
@@ -0,0 +1,57 @@
+#pragma once
+
+constexpr uint64_t BASE_DOWNLOAD_BUFFER_SIZE = 4 * 1024 * 1024;
+constexpr uint32_t DOWNLOAD_SLOT_NUM = 2; // the next slot gets recorded while the previous one is copied by the GPU
+constexpr uint32_t DOWNLOAD_BARRIERS_PER_PASS = 256;
+constexpr uint64_t DOWNLOAD_COPY_ALIGNMENT = 16;
+
+// A block of rows (or a buffer chunk) to copy from a slot into the destination memory
+struct DownloadPiece {
+    uint8_t* dst;
+    uint64_t srcOffset; // in the slot
+    uint64_t rowSize;
+    uint32_t srcRowPitch;
+    uint32_t dstRowPitch;
+    uint32_t rowNum;
+    uint32_t slotIndex;
+};
+
+struct HelperDataDownload {
+    inline HelperDataDownload(const nri::CoreInterface& NRI, nri::Device& device, nri::CommandQueue& commandQueue)
+        : NRI(NRI)
+        , m_Device(device)
+        , m_CommandQueue(commandQueue)
+        , m_Pieces(((nri::DeviceBase&)device).GetStdAllocator()) {
+    }
+
+    ~HelperDataDownload();
+
+    nri::Result DownloadData(const nri::TextureDownloadDesc* textureDataDescs, uint32_t textureDataDescNum, const nri::BufferDownloadDesc* bufferDataDescs, uint32_t bufferDataDescNum);
+
+private:
+    nri::Result Create(const nri::TextureDownloadDesc* textureDataDescs, uint32_t textureDataDescNum);
+    nri::Result DownloadTextures(const nri::TextureDownloadDesc* textureDataDescs, uint32_t textureDataDescNum);
+    nri::Result DownloadBuffers(const nri::BufferDownloadDesc* bufferDataDescs, uint32_t bufferDataDescNum);
+    nri::Result BeginCommandBuffer();
+    nri::Result EndCommandBuffersAndSubmit();
+    nri::Result ReadSlot(uint32_t slotIndex);
+    bool CopyTextureContent(const nri::TextureDownloadDesc& textureDataDesc, uint32_t& sliceOffset, uint32_t& rowOffset);
+    bool CopyBufferContent(const nri::BufferDownloadDesc& bufferDataDesc, uint64_t& bufferContentOffset);
+
+    const nri::CoreInterface& NRI;
+    nri::Device& m_Device;
+    nri::CommandQueue& m_CommandQueue;
+    Vector<DownloadPiece> m_Pieces; // pending until the slot gets reused or the download finishes
+    nri::CommandBuffer* m_CommandBuffer = nullptr; // current
+    nri::Fence* m_Fence = nullptr;
+    nri::CommandAllocator* m_CommandAllocators[DOWNLOAD_SLOT_NUM] = {};
+    nri::CommandBuffer* m_CommandBuffers[DOWNLOAD_SLOT_NUM] = {};
+    uint64_t m_SlotFenceValues[DOWNLOAD_SLOT_NUM] = {}; // the slot can be read when the fence reaches this value
+    nri::Buffer* m_ReadbackBuffers[DOWNLOAD_SLOT_NUM] = {}; // a buffer per slot, since D3D11 reads back a texture only to offset 0
+    nri::Memory* m_ReadbackBufferMemories[DOWNLOAD_SLOT_NUM] = {};
+    uint64_t m_ReadbackBufferSize = BASE_DOWNLOAD_BUFFER_SIZE; // per slot
+    uint64_t m_ReadbackBufferOffset = 0; // in the current slot
+    uint64_t m_FenceValue = 1;
+    uint32_t m_SlotIndex = 0;
+    bool m_IsRecording = false;
+};
@@ -0,0 +1,414 @@
+static void DoTransition(const CoreInterface& NRI, CommandBuffer* commandBuffer, bool isInitial, const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDataDescNum) {
+    TextureBarrierDesc textureBarriers[DOWNLOAD_BARRIERS_PER_PASS];
+
+    const AccessLayoutStage state = {AccessBits::COPY_SOURCE, Layout::COPY_SOURCE, StageBits::COPY};
+
+    for (uint32_t i = 0; i < textureDataDescNum;) {
+        const uint32_t passBegin = i;
+        const uint32_t passEnd = std::min(i + DOWNLOAD_BARRIERS_PER_PASS, textureDataDescNum);
+
+        for (; i < passEnd; i++) {
+            const TextureDownloadDesc& textureDownloadDesc = textureDownloadDescs[i];
+
+            TextureBarrierDesc& barrier = textureBarriers[i - passBegin];
+            barrier = {};
+            barrier.texture = textureDownloadDesc.texture;
+            barrier.mipOffset = textureDownloadDesc.region.mipOffset;
+            barrier.mipNum = 1;
+            barrier.layerOffset = textureDownloadDesc.region.layerOffset;
+            barrier.layerNum = 1;
+            barrier.before = isInitial ? textureDownloadDesc.before : state;
+            barrier.after = isInitial ? state : textureDownloadDesc.before;
+            barrier.planes = textureDownloadDesc.planes;
+        }
+
+        BarrierGroupDesc barrierGroup = {};
+        barrierGroup.textures = textureBarriers;
+        barrierGroup.textureNum = uint16_t(passEnd - passBegin);
+
+        NRI.CmdBarrier(*commandBuffer, barrierGroup);
+    }
+}
+
+static void DoTransition(const CoreInterface& NRI, CommandBuffer* commandBuffer, bool isInitial, const BufferDownloadDesc* bufferDownloadDescs, uint32_t bufferDownloadDescNum) {
+    BufferBarrierDesc bufferBarriers[DOWNLOAD_BARRIERS_PER_PASS];
+
+    const AccessStage state = {AccessBits::COPY_SOURCE, StageBits::COPY};
+
+    for (uint32_t i = 0; i < bufferDownloadDescNum;) {
+        const uint32_t passBegin = i;
+        const uint32_t passEnd = std::min(i + DOWNLOAD_BARRIERS_PER_PASS, bufferDownloadDescNum);
+
+        for (; i < passEnd; i++) {
+            const BufferDownloadDesc& bufferDownloadDesc = bufferDownloadDescs[i];
+
+            BufferBarrierDesc& barrier = bufferBarriers[i - passBegin];
+            barrier = {};
+            barrier.buffer = bufferDownloadDesc.buffer;
+            barrier.before = isInitial ? bufferDownloadDesc.before : state;
+            barrier.after = isInitial ? state : bufferDownloadDesc.before;
+        }
+
+        BarrierGroupDesc barrierGroup = {};
+        barrierGroup.buffers = bufferBarriers;
+        barrierGroup.bufferNum = uint16_t(passEnd - passBegin);
+
+        NRI.CmdBarrier(*commandBuffer, barrierGroup);
+    }
+}
+
+// "WHOLE_SIZE" gets replaced with the remaining size of the subresource
+static TextureRegionDesc GetResolvedRegion(GraphicsAPI api, const TextureDesc& textureDesc, const TextureRegionDesc& region) {
+    TextureRegionDesc resolvedRegion = region;
+
+    if (region.width == WHOLE_SIZE)
+        resolvedRegion.width = GetDimension(api, textureDesc, 0, region.mipOffset) - region.x;
+
+    if (region.height == WHOLE_SIZE)
+        resolvedRegion.height = GetDimension(api, textureDesc, 1, region.mipOffset) - region.y;
+
+    if (region.depth == WHOLE_SIZE)
+        resolvedRegion.depth = GetDimension(api, textureDesc, 2, region.mipOffset) - region.z;
+
+    return resolvedRegion;
+}
+
+HelperDataDownload::~HelperDataDownload() {
+    // Wait for pending copies
+    if (m_Fence)
+        NRI.Wait(*m_Fence, m_FenceValue - 1);
+
+    for (uint32_t i = 0; i < DOWNLOAD_SLOT_NUM; i++) {
+        NRI.DestroyCommandBuffer(*m_CommandBuffers[i]);
+        NRI.DestroyCommandAllocator(*m_CommandAllocators[i]);
+        NRI.DestroyBuffer(*m_ReadbackBuffers[i]);
+        NRI.FreeMemory(*m_ReadbackBufferMemories[i]);
+    }
+
+    NRI.DestroyFence(*m_Fence);
+}
+
+Result HelperDataDownload::DownloadData(const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDownloadDescNum, const BufferDownloadDesc* bufferDownloadDescs, uint32_t bufferDownloadDescNum) {
+    Result result = Create(textureDownloadDescs, textureDownloadDescNum);
+    if (result != Result::SUCCESS)
+        return result;
+
+    result = DownloadTextures(textureDownloadDescs, textureDownloadDescNum);
+    if (result == Result::SUCCESS)
+        result = DownloadBuffers(bufferDownloadDescs, bufferDownloadDescNum);
+
+    if (m_IsRecording) {
+        NRI.EndCommandBuffer(*m_CommandBuffer);
+        m_IsRecording = false;
+    }
+
+    // Wait for everything submitted, even on failure
+    NRI.Wait(*m_Fence, m_FenceValue - 1);
+
+    // Read the remaining slots, starting from the oldest one
+    for (uint32_t i = 0; i < DOWNLOAD_SLOT_NUM && result == Result::SUCCESS; i++)
+        result = ReadSlot((m_SlotIndex + i) % DOWNLOAD_SLOT_NUM);
+
+    m_Pieces.clear();
+
+    return result;
+}
+
+Result HelperDataDownload::Create(const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDownloadDescNum) {
+    Result result = NRI.CreateFence(m_Device, 0, m_Fence);
+    if (result != Result::SUCCESS)
+        return result;
+
+    // A row block of any texture must fit into a slot
+    const DeviceDesc& deviceDesc = NRI.GetDeviceDesc(m_Device);
+
+    for (uint32_t i = 0; i < textureDownloadDescNum; i++) {
+        const TextureDownloadDesc& textureDownloadDesc = textureDownloadDescs[i];
+        const TextureDesc& textureDesc = NRI.GetTextureDesc(*textureDownloadDesc.texture);
+        const FormatProps& formatProps = GetFormatProps(textureDesc.format);
+        const TextureRegionDesc region = GetResolvedRegion(deviceDesc.graphicsAPI, textureDesc, textureDownloadDesc.region);
+
+        uint64_t rowSize = uint64_t((region.width + formatProps.blockWidth - 1) / formatProps.blockWidth) * formatProps.stride;
+        uint64_t alignedRowPitch = Align(rowSize, deviceDesc.uploadBufferTextureRowAlignment);
+        uint64_t alignedSlicePitch = Align(alignedRowPitch, deviceDesc.uploadBufferTextureSliceAlignment);
+
+        m_ReadbackBufferSize = std::max(m_ReadbackBufferSize, alignedSlicePitch);
+    }
+
+    m_ReadbackBufferSize = Align(m_ReadbackBufferSize, std::max(DOWNLOAD_COPY_ALIGNMENT, (uint64_t)deviceDesc.uploadBufferTextureSliceAlignment));
+
+    for (uint32_t i = 0; i < DOWNLOAD_SLOT_NUM; i++) {
+        result = NRI.CreateCommandAllocator(m_CommandQueue, m_CommandAllocators[i]);
+        if (result != Result::SUCCESS)
+            return result;
+
+        result = NRI.CreateCommandBuffer(*m_CommandAllocators[i], m_CommandBuffers[i]);
+        if (result != Result::SUCCESS)
+            return result;
+
+        BufferDesc bufferDesc = {};
+        bufferDesc.size = m_ReadbackBufferSize;
+
+        result = NRI.CreateBuffer(m_Device, bufferDesc, m_ReadbackBuffers[i]);
+        if (result != Result::SUCCESS)
+            return result;
+
+        MemoryDesc memoryDesc = {};
+        NRI.GetBufferMemoryDesc(m_Device, bufferDesc, MemoryLocation::HOST_READBACK, memoryDesc);
+
+        AllocateMemoryDesc allocateMemoryDesc = {};
+        allocateMemoryDesc.type = memoryDesc.type;
+        allocateMemoryDesc.size = memoryDesc.size;
+        allocateMemoryDesc.alignment = memoryDesc.alignment;
+
+        result = NRI.AllocateMemory(m_Device, allocateMemoryDesc, m_ReadbackBufferMemories[i]);
+        if (result != Result::SUCCESS)
+            return result;
+
+        const BufferMemoryBindingDesc bufferMemoryBindingDesc = {m_ReadbackBufferMemories[i], m_ReadbackBuffers[i], 0};
+
+        result = NRI.BindBufferMemory(m_Device, &bufferMemoryBindingDesc, 1);
+        if (result != Result::SUCCESS)
+            return result;
+    }
+
+    return result;
+}
+
+Result HelperDataDownload::DownloadTextures(const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDataDescNum) {
+    if (!textureDataDescNum)
+        return Result::SUCCESS;
+
+    bool isInitial = true;
+    uint32_t i = 0;
+    uint32_t sliceOffset = 0;
+    uint32_t rowOffset = 0;
+
+    while (i < textureDataDescNum) {
+        if (!isInitial) {
+            Result result = EndCommandBuffersAndSubmit();
+            if (result != Result::SUCCESS)
+                return result;
+        }
+
+        Result result = BeginCommandBuffer();
+        if (result != Result::SUCCESS)
+            return result;
+
+        if (isInitial) {
+            DoTransition(NRI, m_CommandBuffer, true, textureDownloadDescs, textureDataDescNum);
+            isInitial = false;
+        }
+
+        for (; i < textureDataDescNum && CopyTextureContent(textureDownloadDescs[i], sliceOffset, rowOffset); i++)
+            ;
+    }
+
+    DoTransition(NRI, m_CommandBuffer, false, textureDownloadDescs, textureDataDescNum);
+
+    return EndCommandBuffersAndSubmit();
+}
+
+Result HelperDataDownload::DownloadBuffers(const BufferDownloadDesc* bufferDownloadDescs, uint32_t bufferDownloadDescNum) {
+    if (!bufferDownloadDescNum)
+        return Result::SUCCESS;
+
+    bool isInitial = true;
+    uint32_t i = 0;
+    uint64_t bufferContentOffset = 0;
+
+    while (i < bufferDownloadDescNum) {
+        if (!isInitial) {
+            Result result = EndCommandBuffersAndSubmit();
+            if (result != Result::SUCCESS)
+                return result;
+        }
+
+        Result result = BeginCommandBuffer();
+        if (result != Result::SUCCESS)
+            return result;
+
+        if (isInitial) {
+            DoTransition(NRI, m_CommandBuffer, true, bufferDownloadDescs, bufferDownloadDescNum);
+            isInitial = false;
+        }
+
+        for (; i < bufferDownloadDescNum && CopyBufferContent(bufferDownloadDescs[i], bufferContentOffset); i++)
+            ;
+    }
+
+    DoTransition(NRI, m_CommandBuffer, false, bufferDownloadDescs, bufferDownloadDescNum);
+
+    return EndCommandBuffersAndSubmit();
+}
+
+Result HelperDataDownload::BeginCommandBuffer() {
+    // Wait for the GPU to finish copying into the slot submitted "DOWNLOAD_SLOT_NUM" submissions ago and read it
+    NRI.Wait(*m_Fence, m_SlotFenceValues[m_SlotIndex]);
+
+    Result result = ReadSlot(m_SlotIndex);
+    if (result != Result::SUCCESS)
+        return result;
+
+    NRI.ResetCommandAllocator(*m_CommandAllocators[m_SlotIndex]);
+
+    m_CommandBuffer = m_CommandBuffers[m_SlotIndex];
+    m_ReadbackBufferOffset = 0;
+
+    result = NRI.BeginCommandBuffer(*m_CommandBuffer, nullptr);
+    m_IsRecording = result == Result::SUCCESS;
+
+    return result;
+}
+
+Result HelperDataDownload::EndCommandBuffersAndSubmit() {
+    m_IsRecording = false;
+
+    Result result = NRI.EndCommandBuffer(*m_CommandBuffer);
+    if (result != Result::SUCCESS)
+        return result;
+
+    FenceSubmitDesc fenceSubmitDesc = {};
+    fenceSubmitDesc.fence = m_Fence;
+    fenceSubmitDesc.value = m_FenceValue;
+
+    QueueSubmitDesc queueSubmitDesc = {};
+    queueSubmitDesc.commandBufferNum = 1;
+    queueSubmitDesc.commandBuffers = &m_CommandBuffer;
+    queueSubmitDesc.signalFences = &fenceSubmitDesc;
+    queueSubmitDesc.signalFenceNum = 1;
+
+    NRI.QueueSubmit(m_CommandQueue, queueSubmitDesc);
+
+    // Don't wait, switch to the next slot
+    m_SlotFenceValues[m_SlotIndex] = m_FenceValue++;
+    m_SlotIndex = (m_SlotIndex + 1) % DOWNLOAD_SLOT_NUM;
+
+    return Result::SUCCESS;
+}
+
+Result HelperDataDownload::ReadSlot(uint32_t slotIndex) {
+    const uint8_t* mappedMemory = nullptr;
+    size_t pendingPieceNum = 0;
+
+    for (size_t i = 0; i < m_Pieces.size(); i++) {
+        const DownloadPiece& piece = m_Pieces[i];
+
+        // Keep pieces of other slots
+        if (piece.slotIndex != slotIndex) {
+            m_Pieces[pendingPieceNum++] = piece;
+            continue;
+        }
+
+        if (!mappedMemory) {
+            mappedMemory = (uint8_t*)NRI.MapBuffer(*m_ReadbackBuffers[slotIndex], 0, m_ReadbackBufferSize);
+            if (!mappedMemory)
+                return Result::FAILURE;
+        }
+
+        // Readback memory is cached, a plain "memcpy" per row (or per piece, if rows are tightly packed on both sides) is the fastest option
+        const uint8_t* src = mappedMemory + piece.srcOffset;
+
+        if (piece.rowNum == 1 || (piece.srcRowPitch == piece.rowSize && piece.dstRowPitch == piece.rowSize))
+            memcpy(piece.dst, src, (size_t)(piece.rowSize * piece.rowNum));
+        else {
+            for (uint32_t j = 0; j < piece.rowNum; j++)
+                memcpy(piece.dst + j * piece.dstRowPitch, src + j * piece.srcRowPitch, (size_t)piece.rowSize);
+        }
+    }
+
+    if (mappedMemory)
+        NRI.UnmapBuffer(*m_ReadbackBuffers[slotIndex]);
+
+    m_Pieces.resize(pendingPieceNum);
+
+    return Result::SUCCESS;
+}
+
+bool HelperDataDownload::CopyTextureContent(const TextureDownloadDesc& textureDownloadDesc, uint32_t& sliceOffset, uint32_t& rowOffset) {
+    const DeviceDesc& deviceDesc = NRI.GetDeviceDesc(m_Device);
+    const TextureDesc& textureDesc = NRI.GetTextureDesc(*textureDownloadDesc.texture);
+    const FormatProps& formatProps = GetFormatProps(textureDesc.format);
+    const TextureRegionDesc region = GetResolvedRegion(deviceDesc.graphicsAPI, textureDesc, textureDownloadDesc.region);
+
+    const uint32_t rowNum = (region.height + formatProps.blockHeight - 1) / formatProps.blockHeight;
+    const uint32_t rowSize = (region.width + formatProps.blockWidth - 1) / formatProps.blockWidth * formatProps.stride;
+    const uint32_t alignedRowPitch = Align(rowSize, deviceDesc.uploadBufferTextureRowAlignment);
+    const uint32_t dstRowPitch = textureDownloadDesc.dataRowPitch ? textureDownloadDesc.dataRowPitch : rowSize;
+    const uint64_t dstSlicePitch = textureDownloadDesc.dataSlicePitch ? textureDownloadDesc.dataSlicePitch : uint64_t(dstRowPitch) * rowNum;
+
+    for (; sliceOffset < region.depth; sliceOffset++) {
+        while (rowOffset < rowNum) {
+            // D3D11 reads back a texture only to the beginning of a buffer
+            if (deviceDesc.graphicsAPI == GraphicsAPI::D3D11 && m_ReadbackBufferOffset)
+                return false;
+
+            uint64_t offset = Align(m_ReadbackBufferOffset, deviceDesc.uploadBufferTextureSliceAlignment);
+            uint64_t freeSpace = offset < m_ReadbackBufferSize ? m_ReadbackBufferSize - offset : 0;
+            uint32_t pieceRowNum = (uint32_t)std::min(freeSpace / alignedRowPitch, uint64_t(rowNum - rowOffset));
+
+            if (!pieceRowNum)
+                return false;
+
+            TextureRegionDesc srcRegion = region;
+            srcRegion.y = uint16_t(region.y + rowOffset * formatProps.blockHeight);
+            srcRegion.z = uint16_t(region.z + sliceOffset);
+            srcRegion.height = (Dim_t)std::min(pieceRowNum * formatProps.blockHeight, region.height - rowOffset * formatProps.blockHeight);
+            srcRegion.depth = 1;
+
+            TextureDataLayoutDesc dstDataLayout = {};
+            dstDataLayout.offset = offset;
+            dstDataLayout.rowPitch = alignedRowPitch;
+            dstDataLayout.slicePitch = Align(pieceRowNum * alignedRowPitch, deviceDesc.uploadBufferTextureSliceAlignment);
+
+            NRI.CmdReadbackTextureToBuffer(*m_CommandBuffer, *m_ReadbackBuffers[m_SlotIndex], dstDataLayout, *textureDownloadDesc.texture, srcRegion);
+
+            DownloadPiece& piece = m_Pieces.emplace_back();
+            piece.dst = (uint8_t*)textureDownloadDesc.data + sliceOffset * dstSlicePitch + uint64_t(rowOffset) * dstRowPitch;
+            piece.srcOffset = offset;
+            piece.rowSize = rowSize;
+            piece.srcRowPitch = alignedRowPitch;
+            piece.dstRowPitch = dstRowPitch;
+            piece.rowNum = pieceRowNum;
+            piece.slotIndex = m_SlotIndex;
+
+            m_ReadbackBufferOffset = offset + uint64_t(pieceRowNum) * alignedRowPitch;
+            rowOffset += pieceRowNum;
+        }
+        rowOffset = 0;
+    }
+    sliceOffset = 0;
+
+    return true;
+}
+
+bool HelperDataDownload::CopyBufferContent(const BufferDownloadDesc& bufferDownloadDesc, uint64_t& bufferContentOffset) {
+    if (!bufferDownloadDesc.dataSize)
+        return true;
+
+    const uint64_t offset = Align(m_ReadbackBufferOffset, DOWNLOAD_COPY_ALIGNMENT);
+    const uint64_t freeSpace = offset < m_ReadbackBufferSize ? m_ReadbackBufferSize - offset : 0;
+    const uint64_t copySize = std::min(bufferDownloadDesc.dataSize - bufferContentOffset, freeSpace);
+
+    if (freeSpace == 0)
+        return false;
+
+    NRI.CmdCopyBuffer(*m_CommandBuffer, *m_ReadbackBuffers[m_SlotIndex], offset, *bufferDownloadDesc.buffer, bufferDownloadDesc.bufferOffset + bufferContentOffset, copySize);
+
+    DownloadPiece& piece = m_Pieces.emplace_back();
+    piece.dst = (uint8_t*)bufferDownloadDesc.data + bufferContentOffset;
+    piece.srcOffset = offset;
+    piece.rowSize = copySize;
+    piece.rowNum = 1;
+    piece.slotIndex = m_SlotIndex;
+
+    bufferContentOffset += copySize;
+    m_ReadbackBufferOffset = offset + copySize;
+
+    if (bufferContentOffset != bufferDownloadDesc.dataSize)
+        return false;
+
+    bufferContentOffset = 0;
+
+    return true;
+}
@@ -1,36 +1,70 @@
 #pragma once
 
 constexpr size_t BASE_UPLOAD_BUFFER_SIZE = 1 * 1024 * 1024;
+constexpr uint32_t UPLOAD_SLOT_NUM = 2; // the next slot gets filled while the previous one is copied by the GPU
+
+constexpr uint64_t COPY_JOB_SIZE = 256 * 1024; // big subresources and buffers are split into row blocks (chunks) of this size
+constexpr uint64_t NON_TEMPORAL_COPY_MIN_SIZE = 4 * 1024; // smaller rows are copied with "memcpy", since the "sfence" per row is not amortized
+
+// A block of rows (or a buffer chunk) to copy into the current slot
+struct CopyJob {
+    const uint8_t* src;
+    uint64_t dstOffset; // in the current slot
+    uint64_t rowSize;
+    uint32_t srcRowPitch;
+    uint32_t dstRowPitch;
+    uint32_t rowNum;
+};
 
 struct HelperDataUpload {
-    inline HelperDataUpload(const nri::CoreInterface& NRI, nri::Device& device, nri::CommandQueue& commandQueue)
+    inline HelperDataUpload(const nri::CoreInterface& NRI, nri::Device& device, nri::CommandQueue& commandQueue, const nri::DataUploaderDesc& dataUploaderDesc = {})
         : NRI(NRI)
         , m_Device(device)
         , m_CommandQueue(commandQueue)
-        , m_UploadBufferSize(BASE_UPLOAD_BUFFER_SIZE) {
+        , m_Desc(dataUploaderDesc)
+        , m_CopyJobs(((nri::DeviceBase&)device).GetStdAllocator())
+        , m_UploadBufferSize(dataUploaderDesc.stagingBufferSize ? dataUploaderDesc.stagingBufferSize : BASE_UPLOAD_BUFFER_SIZE) {
     }
 
+    ~HelperDataUpload();
+
+    inline nri::Device& GetDevice() {
+        return m_Device;
+    }
+
+    nri::Result Create();
     nri::Result UploadData(const nri::TextureUploadDesc* textureDataDescs, uint32_t textureDataDescNum, const nri::BufferUploadDesc* bufferDataDescs, uint32_t bufferDataDescNum);
+    nri::Result UploadDataAsync(const nri::TextureUploadDesc* textureDataDescs, uint32_t textureDataDescNum, const nri::BufferUploadDesc* bufferDataDescs, uint32_t bufferDataDescNum, nri::UploadTicket& uploadTicket);
 
 private:
-    nri::Result Create();
+    nri::Result CreateUploadBuffer(uint64_t size);
     nri::Result UploadTextures(const nri::TextureUploadDesc* textureDataDescs, uint32_t textureDataDescNum);
     nri::Result UploadBuffers(const nri::BufferUploadDesc* bufferDataDescs, uint32_t bufferDataDescNum);
+    nri::Result BeginCommandBuffer();
     nri::Result EndCommandBuffersAndSubmit();
+    nri::Result ExecuteCopyJobs();
+    static void ExecuteCopyJob(uint32_t jobIndex, void* jobArg);
     bool CopyTextureContent(const nri::TextureUploadDesc& textureDataDesc, nri::Dim_t& layerOffset, nri::Mip_t& mipOffset, bool& isCapacityInsufficient);
-    void CopyTextureSubresourceContent(const nri::TextureSubresourceUploadDesc& subresource, uint64_t alignedRowPitch, uint64_t alignedSlicePitch);
+    void CopyTextureSubresourceContent(const nri::TextureSubresourceUploadDesc& subresource, uint32_t alignedRowPitch, uint32_t alignedSlicePitch);
     bool CopyBufferContent(const nri::BufferUploadDesc& bufferDataDesc, uint64_t& bufferContentOffset);
 
     const nri::CoreInterface& NRI;
     nri::Device& m_Device;
     nri::CommandQueue& m_CommandQueue;
-    nri::CommandBuffer* m_CommandBuffer = nullptr;
+    nri::DataUploaderDesc m_Desc = {};
+    Vector<CopyJob> m_CopyJobs; // deferred until the end of the current command buffer
+    nri::CommandBuffer* m_CommandBuffer = nullptr; // current
     nri::Fence* m_Fence = nullptr;
-    nri::CommandAllocator* m_CommandAllocators = nullptr;
-    nri::Buffer* m_UploadBuffer = nullptr;
+    nri::CommandAllocator* m_CommandAllocators[UPLOAD_SLOT_NUM] = {};
+    nri::CommandBuffer* m_CommandBuffers[UPLOAD_SLOT_NUM] = {};
+    uint64_t m_SlotFenceValues[UPLOAD_SLOT_NUM] = {}; // the slot can be reused when the fence reaches this value
+    nri::Buffer* m_UploadBuffer = nullptr; // "UPLOAD_SLOT_NUM" slots of "m_UploadBufferSize" bytes
     nri::Memory* m_UploadBufferMemory = nullptr;
     uint8_t* m_MappedMemory = nullptr;
-    uint64_t m_UploadBufferSize = 0;
-    uint64_t m_UploadBufferOffset = 0;
+    uint64_t m_UploadBufferSize = 0; // per slot (desired, if not created yet)
+    uint64_t m_UploadBufferBase = 0; // current slot offset
+    uint64_t m_UploadBufferOffset = 0; // in the current slot
     uint64_t m_FenceValue = 1;
+    uint32_t m_SlotIndex = 0;
+    bool m_IsRecording = false;
 };
\ No newline at end of file
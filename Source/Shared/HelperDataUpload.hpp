@@ -61,8 +61,62 @@ static void DoTransition(const CoreInterface& NRI, CommandBuffer* commandBuffer,
     }
 }
 
+HelperDataUpload::~HelperDataUpload() {
+    // Wait for pending uploads
+    if (m_Fence)
+        NRI.Wait(*m_Fence, m_FenceValue - 1);
+
+    for (uint32_t i = 0; i < UPLOAD_SLOT_NUM; i++) {
+        NRI.DestroyCommandBuffer(*m_CommandBuffers[i]);
+        NRI.DestroyCommandAllocator(*m_CommandAllocators[i]);
+    }
+
+    NRI.DestroyFence(*m_Fence);
+    NRI.DestroyBuffer(*m_UploadBuffer);
+    NRI.FreeMemory(*m_UploadBufferMemory);
+}
+
+Result HelperDataUpload::Create() {
+    Result result = NRI.CreateFence(m_Device, 0, m_Fence);
+    if (result != Result::SUCCESS)
+        return result;
+
+    for (uint32_t i = 0; i < UPLOAD_SLOT_NUM; i++) {
+        result = NRI.CreateCommandAllocator(m_CommandQueue, m_CommandAllocators[i]);
+        if (result != Result::SUCCESS)
+            return result;
+
+        result = NRI.CreateCommandBuffer(*m_CommandAllocators[i], m_CommandBuffers[i]);
+        if (result != Result::SUCCESS)
+            return result;
+    }
+
+    return result;
+}
+
 Result HelperDataUpload::UploadData(const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum) {
+    UploadTicket uploadTicket = {};
+    Result result = UploadDataAsync(textureUploadDescs, textureUploadDescNum, bufferUploadDescs, bufferUploadDescNum, uploadTicket);
+
+    // Wait for everything submitted, even on failure
+    if (m_Fence)
+        NRI.Wait(*m_Fence, m_FenceValue - 1);
+
+    return result;
+}
+
+Result HelperDataUpload::UploadDataAsync(const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum, UploadTicket& uploadTicket) {
+    uploadTicket = {};
+
+    if (!m_Fence) {
+        Result result = Create();
+        if (result != Result::SUCCESS)
+            return result;
+    }
+
+    // A texture subresource must fit into a slot
     const DeviceDesc& deviceDesc = NRI.GetDeviceDesc(m_Device);
+    uint64_t uploadBufferSize = m_UploadBufferSize;
 
     for (uint32_t i = 0; i < textureUploadDescNum; i++) {
         if (!textureUploadDescs[i].subresources)
@@ -75,30 +129,52 @@ Result HelperDataUpload::UploadData(const TextureUploadDesc* textureUploadDescs,
         uint64_t alignedSlicePitch = Align(sliceRowNum * alignedRowPitch, deviceDesc.uploadBufferTextureSliceAlignment);
         uint64_t contentSize = alignedSlicePitch * std::max(subresource.sliceNum, 1u);
 
-        m_UploadBufferSize = std::max(m_UploadBufferSize, contentSize);
+        uploadBufferSize = std::max(uploadBufferSize, contentSize);
     }
 
-    m_UploadBufferSize = Align(m_UploadBufferSize, COPY_ALIGNMENT);
+    // Slots must start at offsets suitable for texture copies
+    uploadBufferSize = Align(uploadBufferSize, std::max(COPY_ALIGNMENT, (uint64_t)deviceDesc.uploadBufferTextureSliceAlignment));
 
-    Result result = Create();
-    if (result == Result::SUCCESS) {
-        result = UploadTextures(textureUploadDescs, textureUploadDescNum);
-        if (result == Result::SUCCESS)
-            result = UploadBuffers(bufferUploadDescs, bufferUploadDescNum);
+    if (!m_UploadBuffer || uploadBufferSize > m_UploadBufferSize) {
+        Result result = CreateUploadBuffer(uploadBufferSize);
+        if (result != Result::SUCCESS)
+            return result;
     }
 
-    NRI.DestroyCommandBuffer(*m_CommandBuffer);
-    NRI.DestroyCommandAllocator(*m_CommandAllocators);
-    NRI.DestroyFence(*m_Fence);
-    NRI.DestroyBuffer(*m_UploadBuffer);
-    NRI.FreeMemory(*m_UploadBufferMemory);
+    Result result = UploadTextures(textureUploadDescs, textureUploadDescNum);
+    if (result == Result::SUCCESS)
+        result = UploadBuffers(bufferUploadDescs, bufferUploadDescNum);
+
+    // Keep the object reusable after a failure
+    if (m_IsRecording) {
+        NRI.EndCommandBuffer(*m_CommandBuffer);
+        m_IsRecording = false;
+    }
+
+    m_CopyJobs.clear();
+
+    uploadTicket.fence = m_Fence;
+    uploadTicket.value = m_FenceValue - 1;
 
     return result;
 }
 
-Result HelperDataUpload::Create() {
+Result HelperDataUpload::CreateUploadBuffer(uint64_t size) {
+    // The old buffer can be in use by the GPU
+    if (m_UploadBuffer) {
+        NRI.Wait(*m_Fence, m_FenceValue - 1);
+
+        NRI.DestroyBuffer(*m_UploadBuffer);
+        NRI.FreeMemory(*m_UploadBufferMemory);
+
+        m_UploadBuffer = nullptr;
+        m_UploadBufferMemory = nullptr;
+    }
+
+    m_UploadBufferSize = size;
+
     BufferDesc bufferDesc = {};
-    bufferDesc.size = m_UploadBufferSize;
+    bufferDesc.size = m_UploadBufferSize * UPLOAD_SLOT_NUM;
 
     Result result = NRI.CreateBuffer(m_Device, bufferDesc, m_UploadBuffer);
     if (result != Result::SUCCESS)
@@ -110,29 +186,15 @@ Result HelperDataUpload::Create() {
     AllocateMemoryDesc allocateMemoryDesc = {};
     allocateMemoryDesc.type = memoryDesc.type;
     allocateMemoryDesc.size = memoryDesc.size;
+    allocateMemoryDesc.alignment = memoryDesc.alignment;
 
     result = NRI.AllocateMemory(m_Device, allocateMemoryDesc, m_UploadBufferMemory);
     if (result != Result::SUCCESS)
         return result;
 
     const BufferMemoryBindingDesc bufferMemoryBindingDesc = {m_UploadBufferMemory, m_UploadBuffer, 0};
-    result = NRI.BindBufferMemory(m_Device, &bufferMemoryBindingDesc, 1);
-    if (result != Result::SUCCESS)
-        return result;
-
-    result = NRI.CreateFence(m_Device, 0, m_Fence);
-    if (result != Result::SUCCESS)
-        return result;
-
-    result = NRI.CreateCommandAllocator(m_CommandQueue, m_CommandAllocators);
-    if (result != Result::SUCCESS)
-        return result;
-
-    result = NRI.CreateCommandBuffer(*m_CommandAllocators, m_CommandBuffer);
-    if (result != Result::SUCCESS)
-        return result;
 
-    return result;
+    return NRI.BindBufferMemory(m_Device, &bufferMemoryBindingDesc, 1);
 }
 
 Result HelperDataUpload::UploadTextures(const TextureUploadDesc* textureUploadDescs, uint32_t textureDataDescNum) {
@@ -151,7 +213,7 @@ Result HelperDataUpload::UploadTextures(const TextureUploadDesc* textureUploadDe
                 return result;
         }
 
-        Result result = NRI.BeginCommandBuffer(*m_CommandBuffer, nullptr);
+        Result result = BeginCommandBuffer();
         if (result != Result::SUCCESS)
             return result;
 
@@ -160,7 +222,6 @@ Result HelperDataUpload::UploadTextures(const TextureUploadDesc* textureUploadDe
             isInitial = false;
         }
 
-        m_UploadBufferOffset = 0;
         bool isCapacityInsufficient = false;
 
         for (; i < textureDataDescNum && CopyTextureContent(textureUploadDescs[i], layerOffset, mipOffset, isCapacityInsufficient); i++)
@@ -190,7 +251,7 @@ Result HelperDataUpload::UploadBuffers(const BufferUploadDesc* bufferUploadDescs
                 return result;
         }
 
-        Result result = NRI.BeginCommandBuffer(*m_CommandBuffer, nullptr);
+        Result result = BeginCommandBuffer();
         if (result != Result::SUCCESS)
             return result;
 
@@ -199,13 +260,8 @@ Result HelperDataUpload::UploadBuffers(const BufferUploadDesc* bufferUploadDescs
             isInitial = false;
         }
 
-        m_UploadBufferOffset = 0;
-        m_MappedMemory = (uint8_t*)NRI.MapBuffer(*m_UploadBuffer, 0, m_UploadBufferSize);
-
         for (; i < bufferUploadDescNum && CopyBufferContent(bufferUploadDescs[i], bufferContentOffset); i++)
             ;
-
-        NRI.UnmapBuffer(*m_UploadBuffer);
     }
 
     DoTransition(NRI, m_CommandBuffer, false, bufferUploadDescs, bufferUploadDescNum);
@@ -213,8 +269,74 @@ Result HelperDataUpload::UploadBuffers(const BufferUploadDesc* bufferUploadDescs
     return EndCommandBuffersAndSubmit();
 }
 
+Result HelperDataUpload::BeginCommandBuffer() {
+    // Wait for the GPU to finish copying from the slot submitted "UPLOAD_SLOT_NUM" submissions ago
+    NRI.Wait(*m_Fence, m_SlotFenceValues[m_SlotIndex]);
+    NRI.ResetCommandAllocator(*m_CommandAllocators[m_SlotIndex]);
+
+    m_CommandBuffer = m_CommandBuffers[m_SlotIndex];
+    m_UploadBufferBase = m_SlotIndex * m_UploadBufferSize;
+    m_UploadBufferOffset = 0;
+
+    Result result = NRI.BeginCommandBuffer(*m_CommandBuffer, nullptr);
+    m_IsRecording = result == Result::SUCCESS;
+
+    return result;
+}
+
+void HelperDataUpload::ExecuteCopyJob(uint32_t jobIndex, void* jobArg) {
+    const HelperDataUpload& helperDataUpload = *(HelperDataUpload*)jobArg;
+    const CopyJob& copyJob = helperDataUpload.m_CopyJobs[jobIndex];
+
+    for (uint32_t i = 0; i < copyJob.rowNum; i++) {
+        uint8_t* dst = helperDataUpload.m_MappedMemory + copyJob.dstOffset + i * copyJob.dstRowPitch;
+        const uint8_t* src = copyJob.src + i * copyJob.srcRowPitch;
+
+        if (copyJob.rowSize >= NON_TEMPORAL_COPY_MIN_SIZE)
+            CopyNonTemporal(dst, src, (size_t)copyJob.rowSize);
+        else
+            memcpy(dst, src, (size_t)copyJob.rowSize);
+    }
+}
+
+Result HelperDataUpload::ExecuteCopyJobs() {
+    if (m_CopyJobs.empty())
+        return Result::SUCCESS;
+
+    // All copies to the slot are deferred to here, since D3D11 doesn't allow to record copies from a mapped buffer
+    m_MappedMemory = (uint8_t*)NRI.MapBuffer(*m_UploadBuffer, m_UploadBufferBase, m_UploadBufferSize);
+    if (!m_MappedMemory) {
+        m_CopyJobs.clear();
+        return Result::FAILURE;
+    }
+
+    uint32_t jobNum = (uint32_t)m_CopyJobs.size();
+
+    if (m_Desc.ParallelFor && jobNum > 1)
+        m_Desc.ParallelFor(jobNum, ExecuteCopyJob, this, m_Desc.userArg);
+    else {
+        for (uint32_t i = 0; i < jobNum; i++)
+            ExecuteCopyJob(i, this);
+    }
+
+    NRI.UnmapBuffer(*m_UploadBuffer);
+
+    m_MappedMemory = nullptr;
+    m_CopyJobs.clear();
+
+    return Result::SUCCESS;
+}
+
 Result HelperDataUpload::EndCommandBuffersAndSubmit() {
-    const Result result = NRI.EndCommandBuffer(*m_CommandBuffer);
+    m_IsRecording = false;
+
+    Result result = ExecuteCopyJobs();
+    if (result != Result::SUCCESS) {
+        NRI.EndCommandBuffer(*m_CommandBuffer);
+        return result;
+    }
+
+    result = NRI.EndCommandBuffer(*m_CommandBuffer);
     if (result != Result::SUCCESS)
         return result;
 
@@ -229,11 +351,10 @@ Result HelperDataUpload::EndCommandBuffersAndSubmit() {
     queueSubmitDesc.signalFenceNum = 1;
 
     NRI.QueueSubmit(m_CommandQueue, queueSubmitDesc);
-    NRI.Wait(*m_Fence, m_FenceValue);
 
-    m_FenceValue++;
-
-    NRI.ResetCommandAllocator(*m_CommandAllocators);
+    // Don't wait, switch to the next slot
+    m_SlotFenceValues[m_SlotIndex] = m_FenceValue++;
+    m_SlotIndex = (m_SlotIndex + 1) % UPLOAD_SLOT_NUM;
 
     return Result::SUCCESS;
 }
@@ -263,7 +384,7 @@ bool HelperDataUpload::CopyTextureContent(const TextureUploadDesc& textureUpload
             CopyTextureSubresourceContent(subresource, alignedRowPitch, alignedSlicePitch);
 
             TextureDataLayoutDesc srcDataLayout = {};
-            srcDataLayout.offset = m_UploadBufferOffset;
+            srcDataLayout.offset = m_UploadBufferBase + m_UploadBufferOffset;
             srcDataLayout.rowPitch = alignedRowPitch;
             srcDataLayout.slicePitch = alignedSlicePitch;
 
@@ -284,22 +405,21 @@ bool HelperDataUpload::CopyTextureContent(const TextureUploadDesc& textureUpload
     return true;
 }
 
-void HelperDataUpload::CopyTextureSubresourceContent(const TextureSubresourceUploadDesc& subresource, uint64_t alignedRowPitch, uint64_t alignedSlicePitch) {
+void HelperDataUpload::CopyTextureSubresourceContent(const TextureSubresourceUploadDesc& subresource, uint32_t alignedRowPitch, uint32_t alignedSlicePitch) {
     const uint32_t sliceRowNum = subresource.slicePitch / subresource.rowPitch;
+    const uint32_t jobRowNum = std::max((uint32_t)(COPY_JOB_SIZE / alignedRowPitch), 1u);
 
-    // TODO: D3D11 does not allow to call CmdUploadBufferToTexture() while the upload buffer is mapped
-    m_MappedMemory = (uint8_t*)NRI.MapBuffer(*m_UploadBuffer, m_UploadBufferOffset, subresource.sliceNum * alignedSlicePitch);
-
-    uint8_t* slices = m_MappedMemory;
     for (uint32_t k = 0; k < subresource.sliceNum; k++) {
-        for (uint32_t l = 0; l < sliceRowNum; l++) {
-            uint8_t* dstRow = slices + k * alignedSlicePitch + l * alignedRowPitch;
-            uint8_t* srcRow = (uint8_t*)subresource.slices + k * subresource.slicePitch + l * subresource.rowPitch;
-            memcpy(dstRow, srcRow, subresource.rowPitch);
+        for (uint32_t l = 0; l < sliceRowNum; l += jobRowNum) {
+            CopyJob& copyJob = m_CopyJobs.emplace_back();
+            copyJob.src = (uint8_t*)subresource.slices + k * subresource.slicePitch + l * subresource.rowPitch;
+            copyJob.dstOffset = m_UploadBufferOffset + k * alignedSlicePitch + l * alignedRowPitch;
+            copyJob.rowSize = subresource.rowPitch;
+            copyJob.srcRowPitch = subresource.rowPitch;
+            copyJob.dstRowPitch = alignedRowPitch;
+            copyJob.rowNum = std::min(jobRowNum, sliceRowNum - l);
         }
     }
-
-    NRI.UnmapBuffer(*m_UploadBuffer);
 }
 
 bool HelperDataUpload::CopyBufferContent(const BufferUploadDesc& bufferUploadDesc, uint64_t& bufferContentOffset) {
@@ -312,9 +432,15 @@ bool HelperDataUpload::CopyBufferContent(const BufferUploadDesc& bufferUploadDes
     if (freeSpace == 0)
         return false;
 
-    memcpy(m_MappedMemory + m_UploadBufferOffset, (uint8_t*)bufferUploadDesc.data + bufferContentOffset, (size_t)copySize);
+    for (uint64_t offset = 0; offset < copySize; offset += COPY_JOB_SIZE) {
+        CopyJob& copyJob = m_CopyJobs.emplace_back();
+        copyJob.src = (uint8_t*)bufferUploadDesc.data + bufferContentOffset + offset;
+        copyJob.dstOffset = m_UploadBufferOffset + offset;
+        copyJob.rowSize = std::min(copySize - offset, COPY_JOB_SIZE);
+        copyJob.rowNum = 1;
+    }
 
-    NRI.CmdCopyBuffer(*m_CommandBuffer, *bufferUploadDesc.buffer, bufferUploadDesc.bufferOffset + bufferContentOffset, *m_UploadBuffer, m_UploadBufferOffset, copySize);
+    NRI.CmdCopyBuffer(*m_CommandBuffer, *bufferUploadDesc.buffer, bufferUploadDesc.bufferOffset + bufferContentOffset, *m_UploadBuffer, m_UploadBufferBase + m_UploadBufferOffset, copySize);
 
     bufferContentOffset += copySize;
     m_UploadBufferOffset += copySize;
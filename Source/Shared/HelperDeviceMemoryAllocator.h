@@ -1,8 +1,31 @@
 #pragma once
 
+#include <tuple>
+
 template <typename U, typename T>
 using Map = std::map<U, T, std::less<U>, StdAllocator<std::pair<const U, T>>>;
 
+template <typename U, typename T>
+using Multimap = std::multimap<U, T, std::less<U>, StdAllocator<std::pair<const U, T>>>;
+
+// Resources with identical descs have identical memory requirements. Fields are compared one by one, since padding bytes are undefined
+inline auto GetMemoryDescCacheFields(const nri::BufferDesc& bufferDesc) {
+    return std::tie(bufferDesc.size, bufferDesc.structureStride, bufferDesc.usage);
+}
+
+inline auto GetMemoryDescCacheFields(const nri::TextureDesc& textureDesc) {
+    return std::tie(textureDesc.type, textureDesc.usage, textureDesc.format, textureDesc.width, textureDesc.height, textureDesc.depth, textureDesc.mipNum, textureDesc.layerNum, textureDesc.sampleNum);
+}
+
+template <typename T>
+struct MemoryDescCacheKey {
+    T desc;
+
+    inline bool operator<(const MemoryDescCacheKey<T>& other) const {
+        return GetMemoryDescCacheFields(desc) < GetMemoryDescCacheFields(other.desc);
+    }
+};
+
 struct HelperDeviceMemoryAllocator {
     HelperDeviceMemoryAllocator(const nri::CoreInterface& NRI, nri::Device& device);
 
@@ -17,14 +40,44 @@ private:
         Vector<uint64_t> bufferOffsets;
         Vector<nri::Texture*> textures;
         Vector<uint64_t> textureOffsets;
+        Vector<nri::AliasingRange> aliasingRanges;
         uint64_t size;
+        uint64_t unaliasedSize;
+        uint64_t wastedSize;
         nri::MemoryType type;
+        uint32_t alignment; // max of placed resources
+    };
+
+    struct Resource {
+        nri::MemoryDesc memoryDesc;
+        nri::Buffer* buffer;
+        nri::Texture* texture;
+        uint64_t offset; // transient only
+        uint32_t index; // buffers first, then textures
+        uint32_t firstPass; // transient only
+        uint32_t lastPass; // transient only
+    };
+
+    // Heaps of a memory type
+    struct HeapIndex {
+        HeapIndex(const StdAllocator<uint8_t>& stdAllocator);
+
+        Multimap<uint64_t, uint32_t> heapsByFreeSpace; // free space to heap index (first and best fit)
     };
 
     nri::Result TryToAllocateAndBindMemory(const nri::ResourceGroupDesc& resourceGroupDesc, nri::Memory** allocations, size_t& allocationNum);
     nri::Result ProcessDedicatedResources(nri::MemoryLocation memoryLocation, nri::Memory** allocations, size_t& allocationNum);
-    MemoryHeap& FindOrCreateHeap(nri::MemoryDesc& memoryDesc, uint64_t preferredMemorySize);
+    MemoryHeap& FindOrCreateHeap(const Resource& resource);
+    MemoryHeap& FindBestFitOrCreateHeap(const Resource& resource);
+    MemoryHeap& CreateHeap(HeapIndex& heapIndex, nri::MemoryType memoryType);
+    HeapIndex& GetHeapIndex(nri::MemoryType memoryType);
+    const nri::MemoryDesc& GetBufferMemoryDesc(const nri::BufferDesc& bufferDesc, nri::MemoryLocation memoryLocation);
+    const nri::MemoryDesc& GetTextureMemoryDesc(const nri::TextureDesc& textureDesc, nri::MemoryLocation memoryLocation);
+    uint64_t GetPlacementOffset(const MemoryHeap& heap, const nri::MemoryDesc& memoryDesc, bool isTexture) const;
+    void PlaceResource(MemoryHeap& heap, const Resource& resource);
+    void PlaceTransientResources(Resource* resources, size_t resourceNum);
     void GroupByMemoryType(nri::MemoryLocation memoryLocation, const nri::ResourceGroupDesc& resourceGroupDesc);
+    void FillReports(const nri::ResourceGroupDesc& resourceGroupDesc);
     void FillMemoryBindingDescs(nri::Buffer* const* buffers, const uint64_t* bufferOffsets, uint32_t bufferNum, nri::Memory& memory);
     void FillMemoryBindingDescs(nri::Texture* const* texture, const uint64_t* textureOffsets, uint32_t textureNum, nri::Memory& memory);
 
@@ -32,8 +85,14 @@ private:
     nri::Device& m_Device;
 
     Vector<MemoryHeap> m_Heaps;
+    Vector<Resource> m_Resources; // pending placement ("bestFit" only)
+    Vector<Resource> m_TransientResources; // pending placement (with lifetimes)
+    Map<nri::MemoryType, HeapIndex> m_HeapIndices;
+    Map<MemoryDescCacheKey<nri::BufferDesc>, nri::MemoryDesc> m_BufferMemoryDescs;
+    Map<MemoryDescCacheKey<nri::TextureDesc>, nri::MemoryDesc> m_TextureMemoryDescs;
     Vector<nri::Buffer*> m_DedicatedBuffers;
     Vector<nri::Texture*> m_DedicatedTextures;
     Vector<nri::BufferMemoryBindingDesc> m_BufferBindingDescs;
     Vector<nri::TextureMemoryBindingDesc> m_TextureBindingDescs;
+    uint64_t m_PreferredMemorySize = 0;
 };
@@ -1,16 +1,31 @@
+#include <algorithm>
+
 HelperDeviceMemoryAllocator::MemoryHeap::MemoryHeap(MemoryType memoryType, const StdAllocator<uint8_t>& stdAllocator)
     : buffers(stdAllocator)
     , bufferOffsets(stdAllocator)
     , textures(stdAllocator)
     , textureOffsets(stdAllocator)
+    , aliasingRanges(stdAllocator)
     , size(0)
-    , type(memoryType) {
+    , unaliasedSize(0)
+    , wastedSize(0)
+    , type(memoryType)
+    , alignment(1) {
+}
+
+HelperDeviceMemoryAllocator::HeapIndex::HeapIndex(const StdAllocator<uint8_t>& stdAllocator)
+    : heapsByFreeSpace(stdAllocator) {
 }
 
 HelperDeviceMemoryAllocator::HelperDeviceMemoryAllocator(const CoreInterface& NRI, Device& device)
     : m_NRI(NRI)
     , m_Device(device)
     , m_Heaps(((DeviceBase&)device).GetStdAllocator())
+    , m_Resources(((DeviceBase&)device).GetStdAllocator())
+    , m_TransientResources(((DeviceBase&)device).GetStdAllocator())
+    , m_HeapIndices(((DeviceBase&)device).GetStdAllocator())
+    , m_BufferMemoryDescs(((DeviceBase&)device).GetStdAllocator())
+    , m_TextureMemoryDescs(((DeviceBase&)device).GetStdAllocator())
     , m_DedicatedBuffers(((DeviceBase&)device).GetStdAllocator())
     , m_DedicatedTextures(((DeviceBase&)device).GetStdAllocator())
     , m_BufferBindingDescs(((DeviceBase&)device).GetStdAllocator())
@@ -20,6 +35,8 @@ HelperDeviceMemoryAllocator::HelperDeviceMemoryAllocator(const CoreInterface& NR
 uint32_t HelperDeviceMemoryAllocator::CalculateAllocationNumber(const ResourceGroupDesc& resourceGroupDesc) {
     GroupByMemoryType(resourceGroupDesc.memoryLocation, resourceGroupDesc);
 
+    FillReports(resourceGroupDesc);
+
     size_t allocationNum = m_Heaps.size() + m_DedicatedBuffers.size() + m_DedicatedTextures.size();
 
     return (uint32_t)allocationNum;
@@ -42,12 +59,18 @@ Result HelperDeviceMemoryAllocator::AllocateAndBindMemory(const ResourceGroupDes
 Result HelperDeviceMemoryAllocator::TryToAllocateAndBindMemory(const ResourceGroupDesc& resourceGroupDesc, Memory** allocations, size_t& allocationNum) {
     GroupByMemoryType(resourceGroupDesc.memoryLocation, resourceGroupDesc);
 
+    FillReports(resourceGroupDesc);
+
+    m_BufferBindingDescs.reserve(resourceGroupDesc.bufferNum);
+    m_TextureBindingDescs.reserve(resourceGroupDesc.textureNum);
+
     for (MemoryHeap& heap : m_Heaps) {
         Memory*& memory = allocations[allocationNum];
 
         AllocateMemoryDesc allocateMemoryDesc = {};
         allocateMemoryDesc.type = heap.type;
         allocateMemoryDesc.size = heap.size;
+        allocateMemoryDesc.alignment = heap.alignment;
 
         Result result = m_NRI.AllocateMemory(m_Device, allocateMemoryDesc, memory);
         if (result != Result::SUCCESS)
@@ -74,17 +97,17 @@ Result HelperDeviceMemoryAllocator::TryToAllocateAndBindMemory(const ResourceGro
 
 Result HelperDeviceMemoryAllocator::ProcessDedicatedResources(MemoryLocation memoryLocation, Memory** allocations, size_t& allocationNum) {
     constexpr uint64_t zeroOffset = 0;
-    MemoryDesc memoryDesc = {};
 
     for (size_t i = 0; i < m_DedicatedBuffers.size(); i++) {
         const BufferDesc& bufferDesc = m_NRI.GetBufferDesc(*m_DedicatedBuffers[i]);
-        m_NRI.GetBufferMemoryDesc(m_Device, bufferDesc, memoryLocation, memoryDesc);
+        const MemoryDesc& memoryDesc = GetBufferMemoryDesc(bufferDesc, memoryLocation);
 
         Memory*& memory = allocations[allocationNum];
 
         AllocateMemoryDesc allocateMemoryDesc = {};
         allocateMemoryDesc.type = memoryDesc.type;
         allocateMemoryDesc.size = memoryDesc.size;
+        allocateMemoryDesc.alignment = memoryDesc.alignment;
 
         Result result = m_NRI.AllocateMemory(m_Device, allocateMemoryDesc, memory);
         if (result != Result::SUCCESS)
@@ -97,13 +120,14 @@ Result HelperDeviceMemoryAllocator::ProcessDedicatedResources(MemoryLocation mem
 
     for (size_t i = 0; i < m_DedicatedTextures.size(); i++) {
         const TextureDesc& textureDesc = m_NRI.GetTextureDesc(*m_DedicatedTextures[i]);
-        m_NRI.GetTextureMemoryDesc(m_Device, textureDesc, memoryLocation, memoryDesc);
+        const MemoryDesc& memoryDesc = GetTextureMemoryDesc(textureDesc, memoryLocation);
 
         Memory*& memory = allocations[allocationNum];
 
         AllocateMemoryDesc allocateMemoryDesc = {};
         allocateMemoryDesc.type = memoryDesc.type;
         allocateMemoryDesc.size = memoryDesc.size;
+        allocateMemoryDesc.alignment = memoryDesc.alignment;
 
         Result result = m_NRI.AllocateMemory(m_Device, allocateMemoryDesc, memory);
         if (result != Result::SUCCESS)
@@ -117,71 +141,381 @@ Result HelperDeviceMemoryAllocator::ProcessDedicatedResources(MemoryLocation mem
     return Result::SUCCESS;
 }
 
-HelperDeviceMemoryAllocator::MemoryHeap& HelperDeviceMemoryAllocator::FindOrCreateHeap(nri::MemoryDesc& memoryDesc, uint64_t preferredMemorySize) {
-    if (preferredMemorySize == 0)
-        preferredMemorySize = 256 * 1024 * 1024;
+HelperDeviceMemoryAllocator::MemoryHeap& HelperDeviceMemoryAllocator::FindOrCreateHeap(const Resource& resource) {
+    HeapIndex& heapIndex = GetHeapIndex(resource.memoryDesc.type);
+
+    // The oldest heap with room wins. Only heaps with enough free space are visited (heap indices follow creation order)
+    MemoryHeap* firstFit = nullptr;
+    for (auto it = heapIndex.heapsByFreeSpace.lower_bound(resource.memoryDesc.size); it != heapIndex.heapsByFreeSpace.end(); it++) {
+        MemoryHeap& heap = m_Heaps[it->second];
+        if (firstFit && &heap > firstFit)
+            continue;
 
-    size_t j = 0;
-    for (; j < m_Heaps.size(); j++) {
-        const MemoryHeap& heap = m_Heaps[j];
+        uint64_t newSize = GetPlacementOffset(heap, resource.memoryDesc, resource.texture != nullptr) + resource.memoryDesc.size;
+        if (newSize <= m_PreferredMemorySize)
+            firstFit = &heap;
+    }
 
-        uint64_t offset = Align(heap.size, memoryDesc.alignment);
-        uint64_t newSize = offset + memoryDesc.size;
+    if (firstFit)
+        return *firstFit;
 
-        if (heap.type == memoryDesc.type && newSize <= preferredMemorySize)
-            break;
+    return CreateHeap(heapIndex, resource.memoryDesc.type);
+}
+
+HelperDeviceMemoryAllocator::MemoryHeap& HelperDeviceMemoryAllocator::FindBestFitOrCreateHeap(const Resource& resource) {
+    HeapIndex& heapIndex = GetHeapIndex(resource.memoryDesc.type);
+
+    // The fullest heap with room wins (padding can make a heap with slightly more free space the first one, which fits)
+    for (auto it = heapIndex.heapsByFreeSpace.lower_bound(resource.memoryDesc.size); it != heapIndex.heapsByFreeSpace.end(); it++) {
+        MemoryHeap& heap = m_Heaps[it->second];
+
+        uint64_t newSize = GetPlacementOffset(heap, resource.memoryDesc, resource.texture != nullptr) + resource.memoryDesc.size;
+        if (newSize <= m_PreferredMemorySize)
+            return heap;
     }
 
-    if (j == m_Heaps.size())
-        m_Heaps.push_back(MemoryHeap(memoryDesc.type, ((DeviceBase&)m_Device).GetStdAllocator()));
+    return CreateHeap(heapIndex, resource.memoryDesc.type);
+}
+
+HelperDeviceMemoryAllocator::MemoryHeap& HelperDeviceMemoryAllocator::CreateHeap(HeapIndex& heapIndex, MemoryType memoryType) {
+    uint32_t heapIndexInArray = (uint32_t)m_Heaps.size();
+    m_Heaps.push_back(MemoryHeap(memoryType, ((DeviceBase&)m_Device).GetStdAllocator()));
+
+    heapIndex.heapsByFreeSpace.insert({m_PreferredMemorySize, heapIndexInArray});
 
-    return m_Heaps[j];
+    return m_Heaps.back();
 }
 
-void HelperDeviceMemoryAllocator::GroupByMemoryType(MemoryLocation memoryLocation, const nri::ResourceGroupDesc& resourceGroupDesc) {
-    for (uint32_t i = 0; i < resourceGroupDesc.bufferNum; i++) {
-        Buffer* buffer = resourceGroupDesc.buffers[i];
-        const BufferDesc& bufferDesc = m_NRI.GetBufferDesc(*buffer);
+HelperDeviceMemoryAllocator::HeapIndex& HelperDeviceMemoryAllocator::GetHeapIndex(MemoryType memoryType) {
+    auto it = m_HeapIndices.find(memoryType);
+    if (it == m_HeapIndices.end())
+        it = m_HeapIndices.insert({memoryType, HeapIndex(((DeviceBase&)m_Device).GetStdAllocator())}).first;
 
+    return it->second;
+}
+
+const MemoryDesc& HelperDeviceMemoryAllocator::GetBufferMemoryDesc(const BufferDesc& bufferDesc, MemoryLocation memoryLocation) {
+    auto it = m_BufferMemoryDescs.find({bufferDesc});
+    if (it == m_BufferMemoryDescs.end()) {
         MemoryDesc memoryDesc = {};
         m_NRI.GetBufferMemoryDesc(m_Device, bufferDesc, memoryLocation, memoryDesc);
 
-        if (memoryDesc.mustBeDedicated)
-            m_DedicatedBuffers.push_back(buffer);
-        else {
-            MemoryHeap& heap = FindOrCreateHeap(memoryDesc, resourceGroupDesc.preferredMemorySize);
+        it = m_BufferMemoryDescs.insert({{bufferDesc}, memoryDesc}).first;
+    }
 
-            uint64_t offset = Align(heap.size, memoryDesc.alignment);
+    return it->second;
+}
 
-            heap.buffers.push_back(buffer);
-            heap.bufferOffsets.push_back(offset);
-            heap.size = offset + memoryDesc.size;
+const MemoryDesc& HelperDeviceMemoryAllocator::GetTextureMemoryDesc(const TextureDesc& textureDesc, MemoryLocation memoryLocation) {
+    auto it = m_TextureMemoryDescs.find({textureDesc});
+    if (it == m_TextureMemoryDescs.end()) {
+        MemoryDesc memoryDesc = {};
+        m_NRI.GetTextureMemoryDesc(m_Device, textureDesc, memoryLocation, memoryDesc);
+
+        it = m_TextureMemoryDescs.insert({{textureDesc}, memoryDesc}).first;
+    }
+
+    return it->second;
+}
+
+uint64_t HelperDeviceMemoryAllocator::GetPlacementOffset(const MemoryHeap& heap, const MemoryDesc& memoryDesc, bool isTexture) const {
+    uint64_t offset = heap.size;
+
+    // Textures go after buffers, separated by "bufferTextureGranularity"
+    if (isTexture && heap.textures.empty()) {
+        const DeviceDesc& deviceDesc = m_NRI.GetDeviceDesc(m_Device);
+        offset = Align(offset, deviceDesc.bufferTextureGranularity);
+    }
+
+    return Align(offset, memoryDesc.alignment);
+}
+
+void HelperDeviceMemoryAllocator::PlaceResource(MemoryHeap& heap, const Resource& resource) {
+    uint64_t offset = GetPlacementOffset(heap, resource.memoryDesc, resource.texture != nullptr);
+
+    // The heap can be sub-allocated, placement offsets must stay valid relatively to its beginning
+    heap.alignment = std::max(heap.alignment, resource.memoryDesc.alignment);
+    if (resource.texture && !heap.buffers.empty())
+        heap.alignment = std::max(heap.alignment, m_NRI.GetDeviceDesc(m_Device).bufferTextureGranularity);
+
+    if (resource.texture) {
+        heap.textures.push_back(resource.texture);
+        heap.textureOffsets.push_back(offset);
+    } else {
+        heap.buffers.push_back(resource.buffer);
+        heap.bufferOffsets.push_back(offset);
+    }
+
+    // Re-key the heap in the free space index
+    HeapIndex& heapIndex = GetHeapIndex(heap.type);
+    uint32_t heapIndexInArray = uint32_t(&heap - m_Heaps.data());
+    uint64_t freeSpace = m_PreferredMemorySize > heap.size ? m_PreferredMemorySize - heap.size : 0;
+
+    auto range = heapIndex.heapsByFreeSpace.equal_range(freeSpace);
+    for (auto it = range.first; it != range.second; it++) {
+        if (it->second == heapIndexInArray) {
+            heapIndex.heapsByFreeSpace.erase(it);
+            break;
         }
     }
 
+    heap.wastedSize += offset - heap.size;
+    heap.size = offset + resource.memoryDesc.size;
+    heap.unaliasedSize = heap.size;
+
+    freeSpace = m_PreferredMemorySize > heap.size ? m_PreferredMemorySize - heap.size : 0;
+    heapIndex.heapsByFreeSpace.insert({freeSpace, heapIndexInArray});
+}
+
+void HelperDeviceMemoryAllocator::GroupByMemoryType(MemoryLocation memoryLocation, const nri::ResourceGroupDesc& resourceGroupDesc) {
+    m_PreferredMemorySize = resourceGroupDesc.preferredMemorySize ? resourceGroupDesc.preferredMemorySize : 256 * 1024 * 1024;
+
+    for (uint32_t i = 0; i < resourceGroupDesc.bufferNum; i++) {
+        Resource resource = {};
+        resource.buffer = resourceGroupDesc.buffers[i];
+        resource.index = i;
+
+        const BufferDesc& bufferDesc = m_NRI.GetBufferDesc(*resource.buffer);
+        resource.memoryDesc = GetBufferMemoryDesc(bufferDesc, memoryLocation);
+
+        if (resource.memoryDesc.mustBeDedicated)
+            m_DedicatedBuffers.push_back(resource.buffer);
+        else if (resourceGroupDesc.bufferLifetimes) {
+            resource.firstPass = resourceGroupDesc.bufferLifetimes[i].firstPass;
+            resource.lastPass = resourceGroupDesc.bufferLifetimes[i].lastPass;
+            m_TransientResources.push_back(resource);
+        } else if (resourceGroupDesc.bestFit)
+            m_Resources.push_back(resource);
+        else
+            PlaceResource(FindOrCreateHeap(resource), resource);
+    }
+
     for (uint32_t i = 0; i < resourceGroupDesc.textureNum; i++) {
-        Texture* texture = resourceGroupDesc.textures[i];
-        const TextureDesc& textureDesc = m_NRI.GetTextureDesc(*texture);
+        Resource resource = {};
+        resource.texture = resourceGroupDesc.textures[i];
+        resource.index = resourceGroupDesc.bufferNum + i;
+
+        const TextureDesc& textureDesc = m_NRI.GetTextureDesc(*resource.texture);
+        resource.memoryDesc = GetTextureMemoryDesc(textureDesc, memoryLocation);
+
+        if (resource.memoryDesc.mustBeDedicated)
+            m_DedicatedTextures.push_back(resource.texture);
+        else if (resourceGroupDesc.textureLifetimes) {
+            resource.firstPass = resourceGroupDesc.textureLifetimes[i].firstPass;
+            resource.lastPass = resourceGroupDesc.textureLifetimes[i].lastPass;
+            m_TransientResources.push_back(resource);
+        } else if (resourceGroupDesc.bestFit)
+            m_Resources.push_back(resource);
+        else
+            PlaceResource(FindOrCreateHeap(resource), resource);
+    }
 
-        MemoryDesc memoryDesc = {};
-        m_NRI.GetTextureMemoryDesc(m_Device, textureDesc, memoryLocation, memoryDesc);
+    auto sortByTypeAlignmentAndSize = [](const Resource& a, const Resource& b) {
+        if (a.memoryDesc.type != b.memoryDesc.type)
+            return a.memoryDesc.type < b.memoryDesc.type;
 
-        if (memoryDesc.mustBeDedicated)
-            m_DedicatedTextures.push_back(texture);
-        else {
-            MemoryHeap& heap = FindOrCreateHeap(memoryDesc, resourceGroupDesc.preferredMemorySize);
+        if ((a.texture != nullptr) != (b.texture != nullptr))
+            return b.texture != nullptr;
 
-            if (heap.textures.empty()) {
-                const DeviceDesc& deviceDesc = m_NRI.GetDeviceDesc(m_Device);
-                heap.size = Align(heap.size, deviceDesc.bufferTextureGranularity);
+        if (a.memoryDesc.alignment != b.memoryDesc.alignment)
+            return a.memoryDesc.alignment > b.memoryDesc.alignment;
+
+        return a.memoryDesc.size > b.memoryDesc.size;
+    };
+
+    // Buffers go before textures within a memory type (a single "bufferTextureGranularity" gap per heap),
+    // big alignments go first to minimize alignment padding
+    if (!m_Resources.empty()) {
+        std::sort(m_Resources.begin(), m_Resources.end(), sortByTypeAlignmentAndSize);
+
+        for (const Resource& resource : m_Resources)
+            PlaceResource(FindBestFitOrCreateHeap(resource), resource);
+
+        m_Resources.clear();
+    }
+
+    // Transient resources get a heap per memory type and resource kind (buffers and textures don't alias each other)
+    if (!m_TransientResources.empty()) {
+        std::sort(m_TransientResources.begin(), m_TransientResources.end(), sortByTypeAlignmentAndSize);
+
+        size_t groupBegin = 0;
+        for (size_t i = 1; i <= m_TransientResources.size(); i++) {
+            const Resource& first = m_TransientResources[groupBegin];
+            if (i == m_TransientResources.size() || m_TransientResources[i].memoryDesc.type != first.memoryDesc.type || (m_TransientResources[i].texture != nullptr) != (first.texture != nullptr)) {
+                PlaceTransientResources(m_TransientResources.data() + groupBegin, i - groupBegin);
+                groupBegin = i;
+            }
+        }
+
+        m_TransientResources.clear();
+    }
+}
+
+void HelperDeviceMemoryAllocator::PlaceTransientResources(Resource* resources, size_t resourceNum) {
+    const StdAllocator<uint8_t>& stdAllocator = ((DeviceBase&)m_Device).GetStdAllocator();
+
+    m_Heaps.push_back(MemoryHeap(resources[0].memoryDesc.type, stdAllocator));
+    MemoryHeap& heap = m_Heaps.back();
+
+    // Sweep over lifetimes: resources are placed in "firstPass" order (big ones first within a pass), memory of resources,
+    // which are dead by then, returns to a free list. Free ranges contain only released memory, i.e. reusing them means aliasing
+    std::sort(resources, resources + resourceNum, [](const Resource& a, const Resource& b) {
+        if (a.firstPass != b.firstPass)
+            return a.firstPass < b.firstPass;
+
+        return a.memoryDesc.size > b.memoryDesc.size;
+    });
+
+    Multimap<uint32_t, const Resource*> alive(stdAllocator); // by "lastPass"
+    Map<uint64_t, uint64_t> freeRanges(stdAllocator); // offset to size (coalesced)
+    Multimap<uint64_t, uint64_t> freeRangesBySize(stdAllocator); // size to offset (best fit)
+
+    auto removeFreeRange = [&](Map<uint64_t, uint64_t>::iterator it) {
+        auto range = freeRangesBySize.equal_range(it->second);
+        for (auto bySize = range.first; bySize != range.second; bySize++) {
+            if (bySize->second == it->first) {
+                freeRangesBySize.erase(bySize);
+                break;
+            }
+        }
+
+        return freeRanges.erase(it);
+    };
+
+    auto addFreeRange = [&](uint64_t offset, uint64_t size) {
+        if (!size)
+            return;
+
+        // Coalesce with neighbors
+        auto next = freeRanges.lower_bound(offset);
+        if (next != freeRanges.end() && next->first == offset + size) {
+            size += next->second;
+            next = removeFreeRange(next);
+        }
+
+        if (next != freeRanges.begin()) {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == offset) {
+                offset = prev->first;
+                size += prev->second;
+                removeFreeRange(prev);
+            }
+        }
+
+        freeRanges.insert({offset, size});
+        freeRangesBySize.insert({size, offset});
+    };
+
+    for (size_t i = 0; i < resourceNum; i++) {
+        Resource& resource = resources[i];
+        uint64_t size = resource.memoryDesc.size;
+        uint64_t alignment = resource.memoryDesc.alignment;
+
+        // Release dead resources
+        while (!alive.empty() && alive.begin()->first < resource.firstPass) {
+            const Resource* dead = alive.begin()->second;
+            addFreeRange(dead->offset, dead->memoryDesc.size);
+            alive.erase(alive.begin());
+        }
+
+        // Best fit among free ranges (alignment padding stays free)
+        auto freeRange = freeRanges.end();
+        for (auto it = freeRangesBySize.lower_bound(size); it != freeRangesBySize.end(); it++) {
+            if (Align(it->second, alignment) + size <= it->second + it->first) {
+                freeRange = freeRanges.find(it->second);
+                break;
+            }
+        }
+
+        // Otherwise grow the heap, extending the free range at the end (if any)
+        bool isAliased = freeRange != freeRanges.end();
+        if (!isAliased && !freeRanges.empty()) {
+            auto last = std::prev(freeRanges.end());
+            if (last->first + last->second == heap.size && Align(last->first, alignment) < heap.size) {
+                freeRange = last;
+                isAliased = true;
             }
+        }
+
+        uint64_t offset = 0;
+        if (isAliased) {
+            uint64_t rangeOffset = freeRange->first;
+            uint64_t rangeEnd = rangeOffset + freeRange->second;
+            removeFreeRange(freeRange);
+
+            offset = Align(rangeOffset, alignment);
+            addFreeRange(rangeOffset, offset - rangeOffset);
+            if (offset + size < rangeEnd)
+                addFreeRange(offset + size, rangeEnd - offset - size);
+        } else {
+            offset = Align(heap.size, alignment);
+            heap.wastedSize += offset - heap.size;
+        }
 
-            uint64_t offset = Align(heap.size, memoryDesc.alignment);
+        resource.offset = offset;
+        alive.insert({resource.lastPass, &resource});
+        heap.alignment = std::max(heap.alignment, resource.memoryDesc.alignment);
 
-            heap.textures.push_back(texture);
+        if (resource.texture) {
+            heap.textures.push_back(resource.texture);
             heap.textureOffsets.push_back(offset);
-            heap.size = offset + memoryDesc.size;
+        } else {
+            heap.buffers.push_back(resource.buffer);
+            heap.bufferOffsets.push_back(offset);
         }
+
+        if (isAliased)
+            heap.aliasingRanges.push_back({offset, size, resource.index});
+
+        heap.size = std::max(heap.size, offset + size);
+        heap.unaliasedSize = Align(heap.unaliasedSize, alignment) + size;
+    }
+}
+
+void HelperDeviceMemoryAllocator::FillReports(const ResourceGroupDesc& resourceGroupDesc) {
+    AllocationReport* allocationReports = resourceGroupDesc.allocationReports;
+    AliasingRange* aliasingRanges = resourceGroupDesc.aliasingRanges;
+
+    if (aliasingRanges) {
+        for (const MemoryHeap& heap : m_Heaps) {
+            for (const AliasingRange& aliasingRange : heap.aliasingRanges)
+                *aliasingRanges++ = aliasingRange;
+        }
+    }
+
+    if (!allocationReports)
+        return;
+
+    // Same order as allocations
+    for (const MemoryHeap& heap : m_Heaps) {
+        AllocationReport& allocationReport = *allocationReports++;
+        allocationReport = {};
+        allocationReport.size = heap.size;
+        allocationReport.unaliasedSize = heap.unaliasedSize;
+        allocationReport.wastedSize = heap.wastedSize;
+        allocationReport.bufferNum = (uint32_t)heap.buffers.size();
+        allocationReport.textureNum = (uint32_t)heap.textures.size();
+        allocationReport.aliasingRangeNum = (uint32_t)heap.aliasingRanges.size();
+    }
+
+    for (Buffer* buffer : m_DedicatedBuffers) {
+        const MemoryDesc& memoryDesc = GetBufferMemoryDesc(m_NRI.GetBufferDesc(*buffer), resourceGroupDesc.memoryLocation);
+
+        AllocationReport& allocationReport = *allocationReports++;
+        allocationReport = {};
+        allocationReport.size = memoryDesc.size;
+        allocationReport.unaliasedSize = memoryDesc.size;
+        allocationReport.bufferNum = 1;
+    }
+
+    for (Texture* texture : m_DedicatedTextures) {
+        const MemoryDesc& memoryDesc = GetTextureMemoryDesc(m_NRI.GetTextureDesc(*texture), resourceGroupDesc.memoryLocation);
+
+        AllocationReport& allocationReport = *allocationReports++;
+        allocationReport = {};
+        allocationReport.size = memoryDesc.size;
+        allocationReport.unaliasedSize = memoryDesc.size;
+        allocationReport.textureNum = 1;
     }
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 constexpr size_t LOCK_CACHELINE_SIZE = 64;
+constexpr uint32_t LOCK_SPIN_NUM = 256; // before parking
 
 // Found in sse2neon
 #if (defined(__arm__) || defined(__aarch64__) || defined(_M_ARM64) || defined(_M_ARM))
@@ -15,23 +16,63 @@ inline void _mm_pause() {
 #    include <xmmintrin.h>
 #endif
 
-// Very lightweight exclusive lock
+#if NRI_LOCK_STATISTICS
+// Aggregated by lock name
+struct LockCounters {
+    const char* name;
+    std::atomic_uint64_t acquireNum;
+    std::atomic_uint64_t contendedAcquireNum;
+    std::atomic_uint64_t spinNum;
+    std::atomic_uint64_t parkedTime; // ns
+    std::atomic_uint32_t lockNum;
+};
+
+LockCounters* GetLockCounters(const char* name);
+#endif
+
+void GetLockStatistics(nri::LockStatistics* lockStatistics, uint32_t& lockStatisticsNum);
+
+// Exclusive lock: lightweight if not contended, under contention spins for a while and then parks the thread
 struct alignas(LOCK_CACHELINE_SIZE) Lock {
-    inline Lock() {
-        m_Atomic.store(0, std::memory_order_relaxed);
+    inline Lock([[maybe_unused]] const char* name = nullptr) {
+        m_State.store(UNLOCKED, std::memory_order_relaxed);
+
+#if NRI_LOCK_STATISTICS
+        m_Counters = GetLockCounters(name);
+#endif
     }
 
     inline void Acquire() {
-        while (m_Atomic.exchange(1, std::memory_order_acquire))
-            _mm_pause();
+        uint32_t state = UNLOCKED;
+        bool isAcquired = m_State.compare_exchange_strong(state, LOCKED, std::memory_order_acquire, std::memory_order_relaxed);
+
+#if NRI_LOCK_STATISTICS
+        m_Counters->acquireNum.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+        if (!isAcquired)
+            AcquireContended();
     }
 
     inline void Release() {
-        m_Atomic.store(0, std::memory_order_release);
+        if (m_State.exchange(UNLOCKED, std::memory_order_release) == LOCKED_CONTENDED)
+            WakeOne();
     }
 
 private:
-    std::atomic_uint32_t m_Atomic;
+    void AcquireContended();
+    void WakeOne();
+
+    static constexpr uint32_t UNLOCKED = 0;
+    static constexpr uint32_t LOCKED = 1;
+    static constexpr uint32_t LOCKED_CONTENDED = 2; // there are (or may be) parked threads
+
+private:
+    std::atomic_uint32_t m_State;
+
+#if NRI_LOCK_STATISTICS
+    LockCounters* m_Counters = nullptr;
+#endif
 };
 
 struct ExclusiveScope {
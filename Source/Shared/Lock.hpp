@@ -0,0 +1,134 @@
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__)
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+#endif
+
+#if NRI_LOCK_STATISTICS
+constexpr uint32_t LOCK_COUNTERS_MAX_NUM = 64;
+
+static std::array<LockCounters, LOCK_COUNTERS_MAX_NUM> g_LockCounters = {};
+static uint32_t g_LockCountersNum = 0;
+static std::mutex g_LockCountersMutex;
+
+LockCounters* GetLockCounters(const char* name) {
+    if (!name)
+        name = "Unnamed";
+
+    std::lock_guard<std::mutex> lock(g_LockCountersMutex);
+
+    uint32_t i = 0;
+    for (; i < g_LockCountersNum; i++) {
+        if (g_LockCounters[i].name == name || !strcmp(g_LockCounters[i].name, name))
+            break;
+    }
+
+    if (i == LOCK_COUNTERS_MAX_NUM)
+        i = LOCK_COUNTERS_MAX_NUM - 1; // the last entry collects everything, which doesn't fit
+    else if (i == g_LockCountersNum) {
+        g_LockCounters[i].name = i == LOCK_COUNTERS_MAX_NUM - 1 ? "Other" : name;
+        g_LockCountersNum++;
+    }
+
+    g_LockCounters[i].lockNum.fetch_add(1, std::memory_order_relaxed);
+
+    return &g_LockCounters[i];
+}
+
+void GetLockStatistics(LockStatistics* lockStatistics, uint32_t& lockStatisticsNum) {
+    std::lock_guard<std::mutex> lock(g_LockCountersMutex);
+
+    if (!lockStatistics) {
+        lockStatisticsNum = g_LockCountersNum;
+        return;
+    }
+
+    lockStatisticsNum = std::min(lockStatisticsNum, g_LockCountersNum);
+
+    for (uint32_t i = 0; i < lockStatisticsNum; i++) {
+        const LockCounters& counters = g_LockCounters[i];
+
+        LockStatistics& out = lockStatistics[i];
+        out.name = counters.name;
+        out.acquireNum = counters.acquireNum.load(std::memory_order_relaxed);
+        out.contendedAcquireNum = counters.contendedAcquireNum.load(std::memory_order_relaxed);
+        out.spinNum = counters.spinNum.load(std::memory_order_relaxed);
+        out.parkedTime = counters.parkedTime.load(std::memory_order_relaxed);
+        out.lockNum = counters.lockNum.load(std::memory_order_relaxed);
+    }
+}
+#else
+void GetLockStatistics(LockStatistics*, uint32_t& lockStatisticsNum) {
+    lockStatisticsNum = 0;
+}
+#endif
+
+// Blocks while "*address == value" (spurious wake-ups are possible)
+static inline void ParkThread(std::atomic_uint32_t& address, uint32_t value) {
+#if defined(_WIN32)
+    WaitOnAddress(&address, &value, sizeof(value), INFINITE);
+#elif defined(__linux__)
+    syscall(SYS_futex, (uint32_t*)&address, FUTEX_WAIT_PRIVATE, value, nullptr, nullptr, 0);
+#else
+    MaybeUnused(value);
+    std::this_thread::yield();
+#endif
+}
+
+static inline void WakeThread(std::atomic_uint32_t& address) {
+#if defined(_WIN32)
+    WakeByAddressSingle(&address);
+#elif defined(__linux__)
+    syscall(SYS_futex, (uint32_t*)&address, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+    MaybeUnused(address);
+#endif
+}
+
+void Lock::AcquireContended() {
+#if NRI_LOCK_STATISTICS
+    m_Counters->contendedAcquireNum.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+    // Spin: the lock is expected to be released soon
+    uint32_t spinNum = 0;
+    bool isAcquired = false;
+
+    for (; spinNum < LOCK_SPIN_NUM && !isAcquired; spinNum++) {
+        _mm_pause();
+
+        uint32_t state = m_State.load(std::memory_order_relaxed);
+        if (state == LOCKED_CONTENDED)
+            break; // other threads are already parked, no chance
+
+        if (state == UNLOCKED)
+            isAcquired = m_State.compare_exchange_weak(state, LOCKED, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+#if NRI_LOCK_STATISTICS
+    m_Counters->spinNum.fetch_add(spinNum, std::memory_order_relaxed);
+#endif
+
+    if (isAcquired)
+        return;
+
+    // Park: "LOCKED_CONTENDED" makes the owner wake up a parked thread on release
+#if NRI_LOCK_STATISTICS
+    auto start = std::chrono::steady_clock::now();
+#endif
+
+    while (m_State.exchange(LOCKED_CONTENDED, std::memory_order_acquire) != UNLOCKED)
+        ParkThread(m_State, LOCKED_CONTENDED);
+
+#if NRI_LOCK_STATISTICS
+    auto parkedTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    m_Counters->parkedTime.fetch_add((uint64_t)parkedTime, std::memory_order_relaxed);
+#endif
+}
+
+void Lock::WakeOne() {
+    WakeThread(m_State);
+}
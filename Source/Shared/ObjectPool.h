@@ -0,0 +1,154 @@
+#pragma once
+
+constexpr size_t OBJECT_POOL_SLAB_SIZE = 64 * 1024;
+constexpr size_t OBJECT_POOL_CACHELINE_SIZE = 64;
+constexpr uint32_t OBJECT_POOL_CACHE_SIZE = 8;        // pools per thread
+constexpr uint32_t OBJECT_POOL_CACHE_BATCH_SIZE = 16; // slots moved between a thread cache and a pool at once
+
+struct ObjectPoolCacheEntry {
+    uint64_t poolId; // 0 if empty
+    uint32_t slotNum;
+    void* slots[OBJECT_POOL_CACHE_BATCH_SIZE * 2];
+};
+
+struct ObjectPoolCache {
+    ~ObjectPoolCache(); // returns slots to the pools on thread exit
+
+    ObjectPoolCacheEntry entries[OBJECT_POOL_CACHE_SIZE];
+    uint32_t nextEntry;
+};
+
+// Per-thread "pool -> free slots" cache, makes "Allocate" and "Destroy" lock-free most of the time. Created on the first use
+extern thread_local ObjectPoolCache* g_ObjectPoolCache TLS_MODEL_INITIAL_EXEC;
+
+// Picks an entry for a pool, which is not cached yet
+ObjectPoolCacheEntry& ReplaceObjectPoolCacheEntry(uint64_t poolId);
+
+// Type independent part, to which thread caches return slots
+class ObjectPoolBase {
+public:
+    ObjectPoolBase(const AllocationCallbacks& allocator);
+
+    inline uint64_t GetId() const {
+        return m_Id;
+    }
+
+    inline void PushSlots(void* const* slots, uint32_t slotNum) {
+        ExclusiveScope lock(m_Lock);
+
+        m_FreeSlots.insert(m_FreeSlots.end(), slots, slots + slotNum);
+    }
+
+protected:
+    // Must be called before the slabs get released, since thread caches can return slots at any time
+    void Unregister();
+
+protected:
+    Vector<void*> m_FreeSlots; // a stack of pointers: moving slots never touches their memory
+    Lock m_Lock{"ObjectPool"};
+    uint64_t m_Id = 0;
+};
+
+// Slab-based pool for frequently created and destroyed wrapper objects (descriptors, command buffers...). Slots are
+// cache line aligned (no false sharing between objects used by different threads), released slots are recycled
+// via a small per-thread cache in front of the locked free list of the pool. Slabs are released only with the pool.
+// Thread safe
+template <typename T>
+class ObjectPool : public ObjectPoolBase {
+public:
+    ObjectPool(const AllocationCallbacks& allocator)
+        : ObjectPoolBase(allocator)
+        , m_Allocator(allocator)
+        , m_Slabs(StdAllocator<uint8_t*>(allocator)) {
+    }
+
+    ~ObjectPool() {
+        Unregister();
+
+        for (uint8_t* slab : m_Slabs)
+            m_Allocator.Free(m_Allocator.userArg, slab);
+    }
+
+    template <typename... Args>
+    inline T* Allocate(Args&&... args) {
+        ObjectPoolCacheEntry& entry = GetCacheEntry();
+
+        if (!entry.slotNum && !AcquireSlots(entry))
+            return nullptr;
+
+        void* slot = entry.slots[--entry.slotNum];
+
+        return new (slot) T(std::forward<Args>(args)...);
+    }
+
+    inline void Destroy(T* object) {
+        if (!object)
+            return;
+
+        object->~T();
+
+        ObjectPoolCacheEntry& entry = GetCacheEntry();
+
+        // Keep the cache small, objects destroyed by one thread can be needed by another one. The older half goes back
+        if (entry.slotNum == OBJECT_POOL_CACHE_BATCH_SIZE * 2) {
+            PushSlots(entry.slots, OBJECT_POOL_CACHE_BATCH_SIZE);
+
+            memcpy(entry.slots, entry.slots + OBJECT_POOL_CACHE_BATCH_SIZE, OBJECT_POOL_CACHE_BATCH_SIZE * sizeof(void*));
+            entry.slotNum = OBJECT_POOL_CACHE_BATCH_SIZE;
+        }
+
+        entry.slots[entry.slotNum++] = object;
+    }
+
+private:
+    static constexpr size_t GetSlotSize() {
+        return (sizeof(T) + OBJECT_POOL_CACHELINE_SIZE - 1) & ~(OBJECT_POOL_CACHELINE_SIZE - 1);
+    }
+
+    inline ObjectPoolCacheEntry& GetCacheEntry() {
+        ObjectPoolCache* cache = g_ObjectPoolCache;
+        if (cache) {
+            for (ObjectPoolCacheEntry& entry : cache->entries) {
+                if (entry.poolId == m_Id)
+                    return entry;
+            }
+        }
+
+        return ReplaceObjectPoolCacheEntry(m_Id);
+    }
+
+    // Refills an empty cache entry
+    inline bool AcquireSlots(ObjectPoolCacheEntry& entry) {
+        ExclusiveScope lock(m_Lock);
+
+        if (m_FreeSlots.empty()) {
+            constexpr size_t slotSize = GetSlotSize();
+            constexpr size_t slotNum = std::max(OBJECT_POOL_SLAB_SIZE / slotSize, size_t(1));
+            constexpr size_t alignment = std::max(alignof(T), OBJECT_POOL_CACHELINE_SIZE);
+
+            uint8_t* slab = (uint8_t*)m_Allocator.Allocate(m_Allocator.userArg, slotSize * slotNum, alignment);
+            if (!slab)
+                return false;
+
+            // All slots can be free at once, i.e. returning slots never reallocates
+            m_Slabs.push_back(slab);
+            m_FreeSlots.reserve(m_Slabs.size() * slotNum);
+
+            // Popped in the address order
+            for (size_t i = slotNum; i-- > 0;)
+                m_FreeSlots.push_back(slab + i * slotSize);
+        }
+
+        uint32_t slotNum = (uint32_t)std::min(m_FreeSlots.size(), (size_t)OBJECT_POOL_CACHE_BATCH_SIZE);
+        memcpy(entry.slots, m_FreeSlots.data() + m_FreeSlots.size() - slotNum, slotNum * sizeof(void*));
+        m_FreeSlots.resize(m_FreeSlots.size() - slotNum);
+
+        entry.slotNum = slotNum;
+
+        return true;
+    }
+
+private:
+    AllocationCallbacks m_Allocator;
+    Vector<uint8_t*> m_Slabs;
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+constexpr float RESIDENCY_DEFAULT_BUDGET_USAGE = 0.9f;
+constexpr uint32_t RESIDENCY_DEFAULT_PROTECTED_FRAME_NUM = 3;
+
+struct ResidencyResource {
+    nri::ResidencyResourceDesc desc;
+    uint64_t size;
+    uint64_t lastUsedFrame;
+    bool isRegistered; // the ID is in use
+    bool isEvicted;    // the ID is kept reserved until unregistered
+};
+
+// Memory reported as evicted, but potentially not released yet
+struct ResidencyEviction {
+    uint64_t frame;
+    uint64_t size;
+};
+
+struct ResidencyManagerImpl {
+    inline ResidencyManagerImpl(nri::Device& device)
+        : m_Device(device)
+        , m_Resources(((nri::DeviceBase&)device).GetStdAllocator())
+        , m_FreeIds(((nri::DeviceBase&)device).GetStdAllocator())
+        , m_Candidates(((nri::DeviceBase&)device).GetStdAllocator())
+        , m_Evicted(((nri::DeviceBase&)device).GetStdAllocator())
+        , m_EvictedIds(((nri::DeviceBase&)device).GetStdAllocator())
+        , m_Evictions(((nri::DeviceBase&)device).GetStdAllocator()) {
+    }
+
+    inline nri::Device& GetDevice() const {
+        return m_Device;
+    }
+
+    nri::Result Create(const nri::ResidencyManagerDesc& residencyManagerDesc);
+    uint32_t RegisterResidencyResource(const nri::ResidencyResourceDesc& residencyResourceDesc);
+    void UnregisterResidencyResource(uint32_t id);
+    void MarkResidencyResourceUsed(uint32_t id);
+    nri::Result UpdateResidency();
+    void GetResidencyStatistics(nri::ResidencyStatistics& residencyStatistics) const;
+
+private:
+    nri::CoreInterface NRI = {};
+    nri::HelperInterface m_HelperAPI = {};
+    nri::ResidencyManagerDesc m_Desc = {};
+    nri::ResidencyStatistics m_Statistics = {};
+    nri::Device& m_Device;
+    Vector<ResidencyResource> m_Resources; // ID = index + 1
+    Vector<uint32_t> m_FreeIds;
+    Vector<uint32_t> m_Candidates; // indices, used in "UpdateResidency"
+    Vector<nri::ResidencyResourceDesc> m_Evicted;
+    Vector<uint32_t> m_EvictedIds;
+    Vector<ResidencyEviction> m_Evictions;
+    uint64_t m_Frame = 0;
+    mutable Lock m_Lock{"ResidencyManager"};
+};
@@ -0,0 +1,182 @@
+#include <algorithm>
+
+Result ResidencyManagerImpl::Create(const ResidencyManagerDesc& residencyManagerDesc) {
+    // Evicted memory is released only by the application, i.e. without the callback evictions would never free anything
+    if (!residencyManagerDesc.Callback)
+        return Result::INVALID_ARGUMENT;
+
+    DeviceBase& deviceBase = (DeviceBase&)m_Device;
+
+    Result result = deviceBase.FillFunctionTable(NRI);
+    if (result != Result::SUCCESS)
+        return result;
+
+    result = deviceBase.FillFunctionTable(m_HelperAPI);
+    if (result != Result::SUCCESS)
+        return result;
+
+    m_Desc = residencyManagerDesc;
+    if (m_Desc.budgetUsage == 0.0f)
+        m_Desc.budgetUsage = RESIDENCY_DEFAULT_BUDGET_USAGE;
+    if (m_Desc.protectedFrameNum == 0)
+        m_Desc.protectedFrameNum = RESIDENCY_DEFAULT_PROTECTED_FRAME_NUM;
+
+    return Result::SUCCESS;
+}
+
+uint32_t ResidencyManagerImpl::RegisterResidencyResource(const ResidencyResourceDesc& residencyResourceDesc) {
+    MemoryDesc memoryDesc = {};
+    if (residencyResourceDesc.buffer)
+        NRI.GetBufferMemoryDesc(m_Device, NRI.GetBufferDesc(*residencyResourceDesc.buffer), MemoryLocation::DEVICE, memoryDesc);
+    else if (residencyResourceDesc.texture)
+        NRI.GetTextureMemoryDesc(m_Device, NRI.GetTextureDesc(*residencyResourceDesc.texture), MemoryLocation::DEVICE, memoryDesc);
+    else
+        return 0;
+
+    ExclusiveScope lock(m_Lock);
+
+    uint32_t index = 0;
+    if (m_FreeIds.empty()) {
+        index = (uint32_t)m_Resources.size();
+        m_Resources.push_back({});
+    } else {
+        index = m_FreeIds.back() - 1;
+        m_FreeIds.pop_back();
+    }
+
+    ResidencyResource& resource = m_Resources[index];
+    resource.desc = residencyResourceDesc;
+    resource.size = memoryDesc.size;
+    resource.lastUsedFrame = m_Frame; // a newly registered resource is expected to be used soon
+    resource.isRegistered = true;
+    resource.isEvicted = false;
+
+    m_Statistics.registeredSize += resource.size;
+    m_Statistics.registeredResourceNum++;
+
+    return index + 1;
+}
+
+void ResidencyManagerImpl::UnregisterResidencyResource(uint32_t id) {
+    ExclusiveScope lock(m_Lock);
+
+    if (id == 0 || id > m_Resources.size())
+        return;
+
+    ResidencyResource& resource = m_Resources[id - 1];
+    if (!resource.isRegistered)
+        return;
+
+    resource.isRegistered = false;
+
+    // Already excluded from the statistics, if evicted
+    if (!resource.isEvicted) {
+        m_Statistics.registeredSize -= resource.size;
+        m_Statistics.registeredResourceNum--;
+    }
+
+    m_FreeIds.push_back(id);
+}
+
+void ResidencyManagerImpl::MarkResidencyResourceUsed(uint32_t id) {
+    ExclusiveScope lock(m_Lock);
+
+    if (id == 0 || id > m_Resources.size())
+        return;
+
+    ResidencyResource& resource = m_Resources[id - 1];
+    if (resource.isRegistered && !resource.isEvicted)
+        resource.lastUsedFrame = m_Frame;
+}
+
+Result ResidencyManagerImpl::UpdateResidency() {
+    VideoMemoryInfo videoMemoryInfo = {};
+    Result result = m_HelperAPI.QueryVideoMemoryInfo(m_Device, MemoryLocation::DEVICE, videoMemoryInfo);
+    if (result != Result::SUCCESS)
+        return result;
+
+    m_Evicted.clear();
+    m_EvictedIds.clear();
+
+    {
+        ExclusiveScope lock(m_Lock);
+
+        // Forget evictions, which memory is expected to be released and not reported in "usageSize" anymore
+        uint64_t pendingEvictionSize = 0;
+        size_t j = 0;
+        for (const ResidencyEviction& eviction : m_Evictions) {
+            if (eviction.frame + m_Desc.protectedFrameNum > m_Frame) {
+                pendingEvictionSize += eviction.size;
+                m_Evictions[j++] = eviction;
+            }
+        }
+        m_Evictions.resize(j);
+
+        // Evict if needed
+        uint64_t budgetSize = uint64_t(videoMemoryInfo.budgetSize * (double)m_Desc.budgetUsage);
+        uint64_t usageSize = videoMemoryInfo.usageSize > pendingEvictionSize ? videoMemoryInfo.usageSize - pendingEvictionSize : 0;
+        uint64_t evictedSize = 0;
+
+        if (usageSize > budgetSize) {
+            uint64_t excessSize = usageSize - budgetSize;
+
+            // Candidates: not used in the last "protectedFrameNum" frames
+            m_Candidates.clear();
+            for (uint32_t i = 0; i < (uint32_t)m_Resources.size(); i++) {
+                const ResidencyResource& resource = m_Resources[i];
+                if (resource.isRegistered && !resource.isEvicted && resource.lastUsedFrame + m_Desc.protectedFrameNum <= m_Frame)
+                    m_Candidates.push_back(i);
+            }
+
+            // Lowest priority first, then least recently used, then biggest
+            std::sort(m_Candidates.begin(), m_Candidates.end(), [&](uint32_t a, uint32_t b) {
+                const ResidencyResource& ra = m_Resources[a];
+                const ResidencyResource& rb = m_Resources[b];
+
+                if (ra.desc.priority != rb.desc.priority)
+                    return ra.desc.priority < rb.desc.priority;
+
+                if (ra.lastUsedFrame != rb.lastUsedFrame)
+                    return ra.lastUsedFrame < rb.lastUsedFrame;
+
+                return ra.size > rb.size;
+            });
+
+            for (uint32_t i = 0; i < (uint32_t)m_Candidates.size() && evictedSize < excessSize; i++) {
+                ResidencyResource& resource = m_Resources[m_Candidates[i]];
+                resource.isEvicted = true; // the ID gets recycled by "UnregisterResidencyResource"
+
+                m_Evicted.push_back(resource.desc);
+                m_EvictedIds.push_back(m_Candidates[i] + 1);
+
+                m_Statistics.registeredSize -= resource.size;
+                m_Statistics.registeredResourceNum--;
+
+                evictedSize += resource.size;
+            }
+
+            if (evictedSize)
+                m_Evictions.push_back({m_Frame, evictedSize});
+        }
+
+        m_Statistics.budgetSize = videoMemoryInfo.budgetSize;
+        m_Statistics.usageSize = videoMemoryInfo.usageSize;
+        m_Statistics.pendingEvictionSize = pendingEvictionSize + evictedSize;
+        m_Statistics.evictedSize = evictedSize;
+        m_Statistics.evictedResourceNum = (uint32_t)m_Evicted.size();
+
+        m_Frame++;
+    }
+
+    // Outside of the lock, since the application can re-register resources in the callback
+    if (!m_Evicted.empty())
+        m_Desc.Callback(m_Evicted.data(), m_EvictedIds.data(), (uint32_t)m_Evicted.size(), m_Desc.userArg);
+
+    return Result::SUCCESS;
+}
+
+void ResidencyManagerImpl::GetResidencyStatistics(ResidencyStatistics& residencyStatistics) const {
+    ExclusiveScope lock(m_Lock);
+
+    residencyStatistics = m_Statistics;
+}
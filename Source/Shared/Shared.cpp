@@ -1,22 +1,35 @@
 #ifdef _WIN32
 #    include <windows.h>
 #else
+#    include <fcntl.h>
+#    include <unistd.h>
+
 #    include <csignal>
 #    include <cstdarg>
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#    include <emmintrin.h>
+#endif
+
 #include "SharedExternal.h"
 
+#include "HelperDataDownload.h"
 #include "HelperDataUpload.h"
 #include "HelperDeviceMemoryAllocator.h"
 #include "HelperWaitIdle.h"
+#include "ResidencyManager.h"
 #include "Streamer.h"
 
 using namespace nri;
 
+#include "AllocationTracker.hpp"
+#include "HelperDataDownload.hpp"
 #include "HelperDataUpload.hpp"
 #include "HelperDeviceMemoryAllocator.hpp"
 #include "HelperWaitIdle.hpp"
+#include "Lock.hpp"
+#include "ResidencyManager.hpp"
 #include "Streamer.hpp"
 
 #include "SharedExternal.hpp"
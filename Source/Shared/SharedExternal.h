@@ -23,6 +23,7 @@ typedef uint32_t DXGI_FORMAT;
 #include "Extensions/NRILowLatency.h"
 #include "Extensions/NRIMeshShader.h"
 #include "Extensions/NRIRayTracing.h"
+#include "Extensions/NRIResidency.h"
 #include "Extensions/NRIResourceAllocator.h"
 #include "Extensions/NRIStreamer.h"
 #include "Extensions/NRISwapChain.h"
@@ -33,10 +34,12 @@ typedef uint32_t DXGI_FORMAT;
 #include "NRICompatibility.hlsli"
 
 typedef nri::AllocationCallbacks AllocationCallbacks;
+#include "AllocationTracker.h"
 #include "StdAllocator.h"
 
-#include "DeviceBase.h"
 #include "Lock.h"
+#include "DeviceBase.h"
+#include "ObjectPool.h"
 
 // Consts
 constexpr uint32_t NRI_NODE_MASK = 0x1;    // mGPU is not planned
@@ -165,6 +168,9 @@ nri::Format VKFormatToNRIFormat(uint32_t vkFormat);
 uint32_t NRIFormatToDXGIFormat(nri::Format format);
 uint32_t NRIFormatToVKFormat(nri::Format format);
 
+// Memory
+void CopyNonTemporal(void* dst, const void* src, size_t size); // for large copies into write-combined memory, falls back to "memcpy"
+
 // Misc
 inline nri::Vendor GetVendorFromID(uint32_t vendorID) {
     switch (vendorID) {
@@ -852,6 +852,230 @@ void nri::DeviceBase::ReportMessage(nri::Message messageType, const char* file,
         m_CallbackInterface.AbortExecution(m_CallbackInterface.userArg);
 }
 
+thread_local nri::ScratchArenaCacheEntry nri::g_ScratchArenaCache[nri::SCRATCH_ARENA_CACHE_SIZE] = {};
+static thread_local uint32_t g_ScratchArenaCacheIndex = 0;
+
+thread_local std::atomic_uint64_t g_ScratchStackAllocationNum TLS_MODEL_INITIAL_EXEC = 0;
+
+// Counters of alive threads + the sum of finished threads
+static std::vector<const std::atomic_uint64_t*> g_ScratchStackAllocationNums;
+static uint64_t g_FinishedScratchStackAllocationNum = 0;
+static std::mutex g_ScratchStackAllocationNumMutex;
+
+struct ScratchStackAllocationNumOwner {
+    ~ScratchStackAllocationNumOwner() {
+        std::lock_guard<std::mutex> lock(g_ScratchStackAllocationNumMutex);
+
+        g_FinishedScratchStackAllocationNum += g_ScratchStackAllocationNum.load(std::memory_order_relaxed);
+
+        auto it = std::find(g_ScratchStackAllocationNums.begin(), g_ScratchStackAllocationNums.end(), &g_ScratchStackAllocationNum);
+        if (it != g_ScratchStackAllocationNums.end())
+            g_ScratchStackAllocationNums.erase(it);
+    }
+};
+
+void RegisterScratchStackAllocationNum() {
+    [[maybe_unused]] static thread_local ScratchStackAllocationNumOwner owner; // unregisters the counter on thread exit
+
+    std::lock_guard<std::mutex> lock(g_ScratchStackAllocationNumMutex);
+    g_ScratchStackAllocationNums.push_back(&g_ScratchStackAllocationNum);
+}
+
+uint64_t GetScratchStackAllocationNum() {
+    std::lock_guard<std::mutex> lock(g_ScratchStackAllocationNumMutex);
+
+    uint64_t stackAllocationNum = g_FinishedScratchStackAllocationNum;
+    for (const std::atomic_uint64_t* counter : g_ScratchStackAllocationNums)
+        stackAllocationNum += counter->load(std::memory_order_relaxed);
+
+    return stackAllocationNum;
+}
+
+thread_local ObjectPoolCache* g_ObjectPoolCache TLS_MODEL_INITIAL_EXEC = nullptr;
+
+// Alive pools, thread caches can return slots only to them
+static std::vector<ObjectPoolBase*> g_ObjectPools;
+static uint64_t g_ObjectPoolId = 0;
+static std::mutex g_ObjectPoolsMutex;
+
+ObjectPoolBase::ObjectPoolBase(const AllocationCallbacks& allocator)
+    : m_FreeSlots(StdAllocator<void*>(allocator)) {
+    std::lock_guard<std::mutex> lock(g_ObjectPoolsMutex);
+
+    m_Id = ++g_ObjectPoolId; // 0 is reserved for empty cache entries
+    g_ObjectPools.push_back(this);
+}
+
+void ObjectPoolBase::Unregister() {
+    std::lock_guard<std::mutex> lock(g_ObjectPoolsMutex);
+
+    auto it = std::find(g_ObjectPools.begin(), g_ObjectPools.end(), this);
+    if (it != g_ObjectPools.end())
+        g_ObjectPools.erase(it);
+}
+
+// Returns the slots of an entry to its pool, if the pool is still alive, and empties the entry
+static void FlushObjectPoolCacheEntry(ObjectPoolCacheEntry& entry) {
+    if (entry.slotNum) {
+        std::lock_guard<std::mutex> lock(g_ObjectPoolsMutex);
+
+        for (ObjectPoolBase* pool : g_ObjectPools) {
+            if (pool->GetId() == entry.poolId) {
+                pool->PushSlots(entry.slots, entry.slotNum);
+                break;
+            }
+        }
+    }
+
+    entry.poolId = 0;
+    entry.slotNum = 0;
+}
+
+ObjectPoolCache::~ObjectPoolCache() {
+    for (ObjectPoolCacheEntry& entry : entries)
+        FlushObjectPoolCacheEntry(entry);
+
+    g_ObjectPoolCache = nullptr;
+}
+
+ObjectPoolCacheEntry& ReplaceObjectPoolCacheEntry(uint64_t poolId) {
+    static thread_local ObjectPoolCache cache = {};
+    g_ObjectPoolCache = &cache;
+
+    // Prefer an empty entry
+    ObjectPoolCacheEntry* entry = nullptr;
+    for (ObjectPoolCacheEntry& candidate : cache.entries) {
+        if (!candidate.slotNum) {
+            entry = &candidate;
+            break;
+        }
+    }
+
+    if (!entry) {
+        entry = &cache.entries[cache.nextEntry];
+        cache.nextEntry = (cache.nextEntry + 1) % OBJECT_POOL_CACHE_SIZE;
+    }
+
+    FlushObjectPoolCacheEntry(*entry);
+    entry->poolId = poolId;
+
+    return *entry;
+}
+
+uint64_t nri::GetDeviceId() {
+    static std::atomic_uint64_t id = 0;
+    return ++id; // 0 is reserved for empty cache entries
+}
+
+nri::DeviceBase::~DeviceBase() {
+    for (ScratchArena* arena : m_ScratchArenas)
+        Destroy(m_StdAllocator, arena);
+}
+
+ScratchArena* nri::DeviceBase::FindScratchArena(bool create) {
+    std::thread::id threadId = std::this_thread::get_id();
+    ScratchArena* scratchArena = nullptr;
+
+    {
+        ExclusiveScope lock(m_ScratchArenaLock);
+
+        for (ScratchArena* arena : m_ScratchArenas) {
+            if (arena->GetOwner() == threadId) {
+                scratchArena = arena;
+                break;
+            }
+        }
+
+        if (!scratchArena) {
+            if (!create)
+                return nullptr;
+
+            scratchArena = Allocate<ScratchArena>(m_StdAllocator, m_StdAllocator.GetInterface(), threadId);
+            m_ScratchArenas.push_back(scratchArena);
+        }
+    }
+
+    // Cache
+    ScratchArenaCacheEntry& entry = g_ScratchArenaCache[g_ScratchArenaCacheIndex];
+    g_ScratchArenaCacheIndex = (g_ScratchArenaCacheIndex + 1) % SCRATCH_ARENA_CACHE_SIZE;
+
+    entry.deviceId = m_Id;
+    entry.arena = scratchArena;
+
+    return scratchArena;
+}
+
+void nri::DeviceBase::OnCommandAllocatorReset() {
+    AllocationTracker* allocationTracker = GetAllocationTracker(m_StdAllocator.GetInterface());
+    if (allocationTracker)
+        allocationTracker->MaybeDump();
+
+    ScratchArena* scratchArena = nullptr;
+    for (const ScratchArenaCacheEntry& entry : g_ScratchArenaCache) {
+        if (entry.deviceId == m_Id) {
+            scratchArena = entry.arena;
+            break;
+        }
+    }
+
+    if (!scratchArena)
+        scratchArena = FindScratchArena(false);
+
+    if (scratchArena)
+        scratchArena->Trim();
+}
+
+void nri::DeviceBase::GetScratchMemoryStatistics(ScratchMemoryStatistics& scratchMemoryStatistics) const {
+    scratchMemoryStatistics = {};
+    scratchMemoryStatistics.stackAllocationNum = GetScratchStackAllocationNum();
+
+    ExclusiveScope lock(m_ScratchArenaLock);
+
+    for (const ScratchArena* arena : m_ScratchArenas) {
+        scratchMemoryStatistics.arenaAllocationNum += arena->GetArenaAllocationNum();
+        scratchMemoryStatistics.heapAllocationNum += arena->GetHeapAllocationNum();
+        scratchMemoryStatistics.arenaSize += arena->GetSize();
+    }
+
+    scratchMemoryStatistics.arenaNum = (uint32_t)m_ScratchArenas.size();
+}
+
+void CopyNonTemporal(void* dst, const void* src, size_t size) {
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+    // Head: reach 16-byte alignment of the destination
+    size_t headSize = std::min((16 - ((size_t)dst & 15)) & 15, size);
+    memcpy(dst, src, headSize);
+
+    uint8_t* d = (uint8_t*)dst + headSize;
+    const uint8_t* s = (const uint8_t*)src + headSize;
+    size -= headSize;
+
+    // Body: streaming stores bypass caches and fill write-combining buffers with whole cache lines
+    for (; size >= 64; size -= 64, d += 64, s += 64) {
+        __m128i a = _mm_loadu_si128((const __m128i*)s + 0);
+        __m128i b = _mm_loadu_si128((const __m128i*)s + 1);
+        __m128i c = _mm_loadu_si128((const __m128i*)s + 2);
+        __m128i e = _mm_loadu_si128((const __m128i*)s + 3);
+
+        _mm_stream_si128((__m128i*)d + 0, a);
+        _mm_stream_si128((__m128i*)d + 1, b);
+        _mm_stream_si128((__m128i*)d + 2, c);
+        _mm_stream_si128((__m128i*)d + 3, e);
+    }
+
+    for (; size >= 16; size -= 16, d += 16, s += 16)
+        _mm_stream_si128((__m128i*)d, _mm_loadu_si128((const __m128i*)s));
+
+    // Tail
+    memcpy(d, s, size);
+
+    // Make streaming stores globally visible
+    _mm_sfence();
+#else
+    memcpy(dst, src, size);
+#endif
+}
+
 void ConvertCharToWchar(const char* in, wchar_t* out, size_t outLength) {
     if (outLength == 0)
         return;
@@ -4,10 +4,21 @@
 
 #include <assert.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
+// For hot thread local variables: avoids a "__tls_get_addr" call per access in a shared library
+#if defined(__GNUC__) && !defined(_WIN32)
+#    define TLS_MODEL_INITIAL_EXEC __attribute__((tls_model("initial-exec")))
+#else
+#    define TLS_MODEL_INITIAL_EXEC
+#endif
+
 template <typename T>
 void StdAllocator_MaybeUnused([[maybe_unused]] const T& arg) {
 }
@@ -166,21 +177,175 @@ using String = std::basic_string<char, std::char_traits<char>, StdAllocator<char
 //================================================================================================================
 
 constexpr size_t MAX_STACK_ALLOC_SIZE = 32 * 1024;
+constexpr size_t SCRATCH_ARENA_BLOCK_SIZE = 256 * 1024;
 
 template <typename T>
-class Scratch {
+inline T Align(T x, size_t alignment);
+
+struct ScratchArenaBlock {
+    uint8_t* mem;
+    size_t size;
+};
+
+// A per-thread bump allocator serving "Scratch" requests, which don't fit into the stack. Allocations are released
+// in LIFO order (guaranteed by "Scratch" lifetimes), blocks are kept and coalesced into one by "Trim"
+class ScratchArena {
 public:
-    Scratch(const AllocationCallbacks& allocator, T* mem, size_t num)
+    ScratchArena(const AllocationCallbacks& allocator, std::thread::id owner)
         : m_Allocator(allocator)
+        , m_Blocks(StdAllocator<ScratchArenaBlock>(allocator))
+        , m_Owner(owner) {
+    }
+
+    ~ScratchArena() {
+        for (const ScratchArenaBlock& block : m_Blocks)
+            m_Allocator.Free(m_Allocator.userArg, block.mem);
+    }
+
+    inline std::thread::id GetOwner() const {
+        return m_Owner;
+    }
+
+    inline void* Allocate(size_t size, size_t alignment) {
+        while (m_BlockIndex < m_Blocks.size()) {
+            const ScratchArenaBlock& block = m_Blocks[m_BlockIndex];
+
+            uint8_t* mem = Align(block.mem + m_Offset, alignment);
+            if (mem + size <= block.mem + block.size) {
+                m_Offset = size_t(mem + size - block.mem);
+                m_LiveNum++;
+                Increment(m_ArenaAllocationNum);
+
+                return mem;
+            }
+
+            m_BlockIndex++;
+            m_Offset = 0;
+        }
+
+        // Grow
+        AllocationCategoryScope allocationCategoryScope(nri::AllocationCategory::SCRATCH);
+
+        size_t blockSize = std::max(SCRATCH_ARENA_BLOCK_SIZE, size + alignment);
+        uint8_t* mem = (uint8_t*)m_Allocator.Allocate(m_Allocator.userArg, blockSize, alignof(std::max_align_t));
+        if (!mem)
+            return nullptr;
+
+        m_Blocks.push_back({mem, blockSize});
+        m_BlockIndex = m_Blocks.size() - 1;
+        m_Offset = size_t(Align(mem, alignment) + size - mem);
+        m_LiveNum++;
+        m_Size.store(m_Size.load(std::memory_order_relaxed) + blockSize, std::memory_order_relaxed);
+        Increment(m_HeapAllocationNum);
+
+        return Align(mem, alignment);
+    }
+
+    inline void Free(void* memory) {
+        uint8_t* mem = (uint8_t*)memory;
+
+        for (size_t i = std::min(m_BlockIndex + 1, m_Blocks.size()); i-- > 0;) {
+            const ScratchArenaBlock& block = m_Blocks[i];
+            if (mem >= block.mem && mem < block.mem + block.size) {
+                m_BlockIndex = i;
+                m_Offset = size_t(mem - block.mem);
+                break;
+            }
+        }
+
+        assert(m_LiveNum);
+        m_LiveNum--;
+    }
+
+    // Coalesce blocks into one, big enough to serve the peak. Only if nothing is allocated
+    inline void Trim() {
+        if (m_LiveNum)
+            return;
+
+        m_BlockIndex = 0;
+        m_Offset = 0;
+
+        if (m_Blocks.size() < 2)
+            return;
+
+        AllocationCategoryScope allocationCategoryScope(nri::AllocationCategory::SCRATCH);
+
+        size_t size = 0;
+        for (const ScratchArenaBlock& block : m_Blocks) {
+            size += block.size;
+            m_Allocator.Free(m_Allocator.userArg, block.mem);
+        }
+        m_Blocks.clear();
+
+        uint8_t* mem = (uint8_t*)m_Allocator.Allocate(m_Allocator.userArg, size, alignof(std::max_align_t));
+        if (mem) {
+            m_Blocks.push_back({mem, size});
+            Increment(m_HeapAllocationNum);
+        } else
+            size = 0;
+
+        m_Size.store(size, std::memory_order_relaxed);
+    }
+
+    // Counters are written by the owner thread only, but can be read by any thread
+    inline uint64_t GetArenaAllocationNum() const {
+        return m_ArenaAllocationNum.load(std::memory_order_relaxed);
+    }
+
+    inline uint64_t GetHeapAllocationNum() const {
+        return m_HeapAllocationNum.load(std::memory_order_relaxed);
+    }
+
+    inline uint64_t GetSize() const {
+        return m_Size.load(std::memory_order_relaxed);
+    }
+
+private:
+    static inline void Increment(std::atomic_uint64_t& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+private:
+    AllocationCallbacks m_Allocator;
+    Vector<ScratchArenaBlock> m_Blocks;
+    std::thread::id m_Owner;
+    size_t m_BlockIndex = 0;
+    size_t m_Offset = 0;
+    size_t m_LiveNum = 0;
+    std::atomic_uint64_t m_ArenaAllocationNum = 0;
+    std::atomic_uint64_t m_HeapAllocationNum = 0;
+    std::atomic_uint64_t m_Size = 0;
+};
+
+// Stack allocations are counted per thread, without an arena lookup. The first one registers the counter of the thread
+extern thread_local std::atomic_uint64_t g_ScratchStackAllocationNum TLS_MODEL_INITIAL_EXEC;
+
+void RegisterScratchStackAllocationNum();
+uint64_t GetScratchStackAllocationNum(); // all threads, all devices
+
+template <typename T>
+class Scratch {
+public:
+    // "arena" is provided only if the request doesn't fit into the stack, "mem" otherwise
+    Scratch(ScratchArena* arena, T* mem, size_t num)
+        : m_Arena(arena)
         , m_Mem(mem)
         , m_Num(num) 
     {
-        m_IsHeap = (num * sizeof(T) + alignof(T)) > MAX_STACK_ALLOC_SIZE;
+        if (m_Arena)
+            m_Mem = (T*)m_Arena->Allocate(num * sizeof(T), alignof(T));
+        else {
+            uint64_t stackAllocationNum = g_ScratchStackAllocationNum.load(std::memory_order_relaxed) + 1;
+            g_ScratchStackAllocationNum.store(stackAllocationNum, std::memory_order_relaxed);
+
+            if (stackAllocationNum == 1)
+                RegisterScratchStackAllocationNum();
+        }
     }
 
     ~Scratch() {
-        if (m_IsHeap)
-            m_Allocator.Free(m_Allocator.userArg, m_Mem);
+        if (m_Arena && m_Mem)
+            m_Arena->Free(m_Mem);
     }
 
     inline operator T*() const {
@@ -193,15 +358,15 @@ public:
     }
 
 private:
-    const AllocationCallbacks& m_Allocator;
+    ScratchArena* m_Arena = nullptr;
     T* m_Mem = nullptr;
     size_t m_Num = 0;
-    bool m_IsHeap = false;
 };
 
+#define IsScratchOnStack(T, elementNum) (((elementNum) * sizeof(T) + alignof(T)) <= MAX_STACK_ALLOC_SIZE)
+
+// "device" must be a "DeviceBase". The arena is looked up only if the stack can't be used
 #define AllocateScratch(device, T, elementNum) \
-    { (device).GetStdAllocator().GetInterface(), \
-        ((elementNum) * sizeof(T) + alignof(T)) > MAX_STACK_ALLOC_SIZE \
-            ? (T*)(device).GetStdAllocator().GetInterface().Allocate((device).GetStdAllocator().GetInterface().userArg, (elementNum) * sizeof(T), alignof(T)) \
-            : (T*)Align((elementNum) ? (T*)alloca(((elementNum) * sizeof(T) + alignof(T))) : nullptr, alignof(T)), \
+    { IsScratchOnStack(T, elementNum) ? nullptr : &(device).GetScratchArena(), \
+        IsScratchOnStack(T, elementNum) && (elementNum) ? (T*)Align((T*)alloca(((elementNum) * sizeof(T) + alignof(T))), alignof(T)) : nullptr, \
         (elementNum) }
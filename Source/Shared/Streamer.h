@@ -1,13 +1,91 @@
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 struct BufferUpdateRequest {
-    nri::BufferUpdateRequestDesc desc;
+    nri::BufferUpdateRequestDesc desc; // "data = nullptr" if the data has been written in place
     uint64_t offset;
+    uint8_t* stagingMemory; // owned temporary memory for reservations, which don't fit into the current buffer
+    uint64_t id;            // non-zero for requests, which are not scheduled yet (budget mode)
+    uint64_t sequence;      // submission order (ring offsets don't follow it in budget mode)
 };
 
 struct TextureUpdateRequest {
-    nri::TextureUpdateRequestDesc desc;
+    nri::TextureUpdateRequestDesc desc; // "data = nullptr" if the data has been written in place
     uint64_t offset;
+    uint8_t* stagingMemory; // owned temporary memory for file requests, which don't fit into the current buffer
+    uint64_t id;            // non-zero for requests, which are not scheduled yet (budget mode)
+};
+
+struct ReadbackRequest {
+    nri::ReadbackRequestDesc desc;
+    uint64_t offset; // in the readback ring slot
+    uint64_t size;
+    uint32_t rowPitch;
+    uint32_t slicePitch;
+    nri::Buffer* buffer; // a dedicated buffer instead of the slot (D3D11 reads back a texture only to offset 0)
+    nri::Memory* memory;
+};
+
+// A readback ring slot: written by the GPU in one frame, read by the CPU when the slot comes around again (i.e. "frameInFlightNum + 1" frames later)
+struct ReadbackFrame {
+    inline ReadbackFrame(const StdAllocator<uint8_t>& allocator)
+        : requests(allocator) {
+    }
+
+    Vector<ReadbackRequest> requests;
+    nri::Buffer* buffer = nullptr;
+    nri::Memory* memory = nullptr;
+    uint64_t size = 0;
+};
+
+struct TextureRequestLayout {
+    uint32_t rowNum;
+    uint32_t sliceNum;
+    uint32_t alignedRowPitch;
+    uint32_t alignedSlicePitch;
+};
+
+struct FileReadJob {
+    const char* filePath;
+    uint64_t fileOffset;
+    uint8_t* dst;
+    uint64_t rowSize;
+    uint64_t srcRowPitch;
+    uint64_t srcSlicePitch;
+    uint64_t dstRowPitch;
+    uint64_t dstSlicePitch;
+    uint32_t rowNum;
+    uint32_t sliceNum;
+};
+
+// Reads files in background threads (or in place, if there are no threads)
+struct FileReader {
+    inline FileReader(const StdAllocator<uint8_t>& allocator)
+        : m_Jobs(allocator)
+        , m_Threads(allocator) {
+    }
+
+    ~FileReader();
+
+    void Start(uint32_t threadNum);
+    void Push(const FileReadJob& job);
+    bool Wait(); // returns "false" if any read since the previous call has failed
+
+private:
+    void WorkerThread();
+
+private:
+    Vector<FileReadJob> m_Jobs;
+    Vector<std::thread> m_Threads;
+    std::mutex m_Mutex;
+    std::condition_variable m_JobCondition;
+    std::condition_variable m_IdleCondition;
+    uint32_t m_ActiveJobNum = 0;
+    bool m_IsFailed = false;
+    bool m_IsExiting = false;
 };
 
 struct GarbageInFlight {
@@ -16,6 +94,117 @@ struct GarbageInFlight {
     uint32_t frameNum;
 };
 
+// Multi-producer append-only queue: a slot is reserved with an atomic compare-exchange once its segment exists, segments (of doubling size)
+// are allocated lazily, never move and are never freed until destruction. "Clear" and iteration require external synchronization with producers
+template <typename T>
+struct ConcurrentQueue {
+    static constexpr uint32_t FIRST_SEGMENT_SIZE_LOG2 = 8;
+    static constexpr uint32_t SEGMENT_MAX_NUM = 24;
+
+    inline ConcurrentQueue(const StdAllocator<uint8_t>& allocator)
+        : m_Allocator(allocator) {
+        for (std::atomic<T*>& segment : m_Segments)
+            segment.store(nullptr, std::memory_order_relaxed);
+
+        m_Num.store(0, std::memory_order_relaxed);
+    }
+
+    inline ~ConcurrentQueue() {
+        const AllocationCallbacks& allocationCallbacks = m_Allocator.GetInterface();
+
+        for (std::atomic<T*>& segment : m_Segments)
+            allocationCallbacks.Free(allocationCallbacks.userArg, segment.load(std::memory_order_relaxed));
+    }
+
+    // Returns "nullptr" if out of memory. A reserved slot must be written before the next "Clear" or iteration
+    inline T* Reserve() {
+        // The index is claimed only after its segment is allocated, i.e. a failed allocation leaves no holes
+        uint64_t index = m_Num.load(std::memory_order_relaxed);
+        uint64_t indexInSegment = 0;
+        T* segment = nullptr;
+        do {
+            uint32_t segmentIndex;
+            Locate(index, segmentIndex, indexInSegment);
+
+            segment = GetOrAllocateSegment(segmentIndex);
+            if (!segment)
+                return nullptr;
+        } while (!m_Num.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+
+        return segment + indexInSegment;
+    }
+
+    inline bool Push(const T& value) {
+        T* slot = Reserve();
+        if (!slot)
+            return false;
+
+        *slot = value;
+
+        return true;
+    }
+
+    inline size_t Size() const {
+        return (size_t)m_Num.load(std::memory_order_acquire);
+    }
+
+    inline T& operator[](size_t index) {
+        uint32_t segmentIndex;
+        uint64_t indexInSegment;
+        Locate(index, segmentIndex, indexInSegment);
+
+        return m_Segments[segmentIndex].load(std::memory_order_relaxed)[indexInSegment];
+    }
+
+    inline void Clear() {
+        m_Num.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static inline void Locate(uint64_t index, uint32_t& segmentIndex, uint64_t& indexInSegment) {
+        // Segment "i" holds "FIRST_SEGMENT_SIZE << i" elements
+        uint64_t n = (index >> FIRST_SEGMENT_SIZE_LOG2) + 1;
+
+#if defined(_MSC_VER)
+        unsigned long msb = 0;
+        _BitScanReverse64(&msb, n);
+        segmentIndex = (uint32_t)msb;
+#else
+        segmentIndex = 63 - (uint32_t)__builtin_clzll(n);
+#endif
+
+        indexInSegment = index - (((1ull << segmentIndex) - 1) << FIRST_SEGMENT_SIZE_LOG2);
+    }
+
+    T* GetOrAllocateSegment(uint32_t segmentIndex) {
+        if (segmentIndex >= SEGMENT_MAX_NUM)
+            return nullptr;
+
+        T* segment = m_Segments[segmentIndex].load(std::memory_order_acquire);
+        if (segment)
+            return segment;
+
+        const AllocationCallbacks& allocationCallbacks = m_Allocator.GetInterface();
+        size_t segmentSize = (sizeof(T) << FIRST_SEGMENT_SIZE_LOG2) << segmentIndex;
+        T* newSegment = (T*)allocationCallbacks.Allocate(allocationCallbacks.userArg, segmentSize, alignof(T));
+        if (!newSegment)
+            return nullptr;
+
+        if (m_Segments[segmentIndex].compare_exchange_strong(segment, newSegment, std::memory_order_acq_rel, std::memory_order_acquire))
+            return newSegment;
+
+        // Another thread has won the race
+        allocationCallbacks.Free(allocationCallbacks.userArg, newSegment);
+
+        return segment;
+    }
+
+private:
+    StdAllocator<uint8_t> m_Allocator;
+    std::array<std::atomic<T*>, SEGMENT_MAX_NUM> m_Segments;
+    std::atomic_uint64_t m_Num;
+};
+
 struct StreamerImpl {
     inline StreamerImpl(nri::Device& device, const nri::CoreInterface& NRI)
         : m_Device(device)
@@ -24,7 +213,18 @@ struct StreamerImpl {
         , m_BufferRequestsWithDst(((nri::DeviceBase&)device).GetStdAllocator())
         , m_TextureRequests(((nri::DeviceBase&)device).GetStdAllocator())
         , m_TextureRequestsWithDst(((nri::DeviceBase&)device).GetStdAllocator())
-        , m_GarbageInFlight(((nri::DeviceBase&)device).GetStdAllocator()) {
+        , m_PendingBufferRequests(((nri::DeviceBase&)device).GetStdAllocator())
+        , m_PendingTextureRequests(((nri::DeviceBase&)device).GetStdAllocator())
+        , m_PendingRequestIds(((nri::DeviceBase&)device).GetStdAllocator())
+        , m_GarbageInFlight(((nri::DeviceBase&)device).GetStdAllocator())
+        , m_ReadbackRequests(((nri::DeviceBase&)device).GetStdAllocator())
+        , m_ReadbackFrames(((nri::DeviceBase&)device).GetStdAllocator())
+        , m_FileReader(((nri::DeviceBase&)device).GetStdAllocator()) {
+        m_NextRequestId.store(1, std::memory_order_relaxed);
+        m_NextSequence.store(0, std::memory_order_relaxed);
+        m_ConstantDataOffset.store(0, std::memory_order_relaxed);
+        m_DynamicDataOffset.store(0, std::memory_order_relaxed);
+        m_DynamicBufferMappedMemory.store(nullptr, std::memory_order_relaxed);
     }
 
     inline nri::Buffer* GetDynamicBuffer() {
@@ -39,31 +239,78 @@ struct StreamerImpl {
         return m_Device;
     }
 
+    inline void GetStatistics(nri::StreamerStatistics& statistics) const {
+        statistics = m_Statistics;
+        statistics.dynamicBufferSize = m_DynamicBufferSize;
+        statistics.garbageInFlightNum = (uint32_t)m_GarbageInFlight.size();
+        statistics.pendingRequestNum = (uint32_t)m_PendingRequestIds.size();
+
+        for (const ReadbackFrame& readbackFrame : m_ReadbackFrames) {
+            statistics.readbackBufferSize += readbackFrame.size;
+            statistics.readbackRequestNum += (uint32_t)readbackFrame.requests.size();
+        }
+    }
+
     ~StreamerImpl();
 
     nri::Result Create(const nri::StreamerDesc& desc);
     uint32_t UpdateStreamerConstantBuffer(const void* data, uint32_t dataSize);
     uint64_t AddStreamerBufferUpdateRequest(const nri::BufferUpdateRequestDesc& bufferUpdateRequestDesc);
     uint64_t AddStreamerTextureUpdateRequest(const nri::TextureUpdateRequestDesc& textureUpdateRequestDesc);
+    nri::Result QueueStreamerBufferUpdateRequest(const nri::BufferUpdateRequestDesc& bufferUpdateRequestDesc, uint64_t& requestId);
+    nri::Result QueueStreamerTextureUpdateRequest(const nri::TextureUpdateRequestDesc& textureUpdateRequestDesc, uint64_t& requestId);
+    void* ReserveStreamerBufferUpdate(const nri::BufferUpdateRequestDesc& bufferUpdateRequestDesc, uint64_t& offset);
+    nri::Result AddStreamerReadbackRequest(const nri::ReadbackRequestDesc& readbackRequestDesc);
+    bool IsStreamerRequestComplete(uint64_t requestId) const;
     nri::Result CopyStreamerUpdateRequests();
     void CmdUploadStreamerUpdateRequests(nri::CommandBuffer& commandBuffer);
 
 private:
+    TextureRequestLayout GetTextureRequestLayout(const nri::TextureUpdateRequestDesc& textureUpdateRequestDesc) const;
+    uint8_t* ReserveMemory(uint64_t localOffset, uint64_t alignedSize, uint8_t*& stagingMemory);
+    void SchedulePendingRequests();
+    nri::Result ProcessReadbackRequests();
+    nri::Result ResizeDynamicBuffer(uint64_t size);
+    nri::Result CreateBufferWithMemory(uint64_t size, nri::BufferUsageBits usage, nri::MemoryLocation memoryLocation, nri::Buffer*& buffer, nri::Memory*& memory);
+    void DestroyBufferWithMemory(nri::Buffer* buffer, nri::Memory* memory);
+    void MergeBufferRequestsWithDst();
+    uint8_t* MapDynamicBuffer();
+    void UnmapDynamicBuffer();
+
     nri::Device& m_Device;
     const nri::CoreInterface& m_NRI;
     nri::StreamerDesc m_Desc = {};
-    Vector<BufferUpdateRequest> m_BufferRequests;
+    nri::StreamerStatistics m_Statistics = {};
+    ConcurrentQueue<BufferUpdateRequest> m_BufferRequests;
     Vector<BufferUpdateRequest> m_BufferRequestsWithDst;
-    Vector<TextureUpdateRequest> m_TextureRequests;
+    ConcurrentQueue<TextureUpdateRequest> m_TextureRequests;
     Vector<TextureUpdateRequest> m_TextureRequestsWithDst;
+    Vector<BufferUpdateRequest> m_PendingBufferRequests;
+    Vector<TextureUpdateRequest> m_PendingTextureRequests;
+    Vector<uint64_t> m_PendingRequestIds; // sorted
     Vector<GarbageInFlight> m_GarbageInFlight;
+    ConcurrentQueue<ReadbackRequest> m_ReadbackRequests;
+    Vector<ReadbackFrame> m_ReadbackFrames;
+    FileReader m_FileReader;
+    Lock m_ConstantBufferLock{"Streamer::ConstantBuffer"}; // "Map" & "Unmap" are not thread safe in all backends
+    Lock m_DynamicBufferLock{"Streamer::DynamicBuffer"};
     nri::Buffer* m_ConstantBuffer = nullptr;
     nri::Memory* m_ConstantBufferMemory = nullptr;
     nri::Buffer* m_DynamicBuffer = nullptr;
     nri::Memory* m_DynamicBufferMemory = nullptr;
-    uint32_t m_ConstantDataOffset = 0;
-    uint64_t m_DynamicDataOffset = 0;
+    std::atomic_uint64_t m_NextRequestId;
+    std::atomic_uint64_t m_NextSequence; // for buffer requests
+    uint64_t m_GatheredRequestId = 0; // all requests with lower or equal IDs are known to "CopyStreamerUpdateRequests"
+    std::atomic_uint32_t m_ConstantDataOffset;
+    std::atomic_uint64_t m_DynamicDataOffset;
+    std::atomic<uint8_t*> m_DynamicBufferMappedMemory; // the whole buffer, mapped on demand for reservations
     uint64_t m_DynamicDataOffsetBase = 0;
     uint64_t m_DynamicBufferSize = 0;
+    uint64_t m_HighWaterMark = 0;
+    uint32_t m_HighWaterMarkFrameNum = 0;
     uint32_t m_FrameIndex = 0;
-};
\ No newline at end of file
+    uint32_t m_ReadbackFrameIndex = 0;
+    bool m_IsPersistentMappingSupported = false; // the dynamic buffer can stay mapped between "CopyStreamerUpdateRequests" calls
+    bool m_IsTextureReadbackOffsetSupported = false; // otherwise each texture readback gets a dedicated buffer
+    ReadbackFrame* m_ReadbackFrameToRecord = nullptr; // gathered by "CopyStreamerUpdateRequests", recorded by "CmdUploadStreamerUpdateRequests"
+};
@@ -1,19 +1,204 @@
+#include <algorithm>
+
 constexpr uint64_t CHUNK_SIZE = 65536;
 
+#ifdef _WIN32
+
+typedef HANDLE FileHandle;
+
+static FileHandle OpenFileForReading(const char* path) {
+    HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    return handle == INVALID_HANDLE_VALUE ? nullptr : handle;
+}
+
+static bool ReadFileRegion(FileHandle file, uint64_t offset, uint8_t* dst, uint64_t size) {
+    while (size) {
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = (DWORD)offset;
+        overlapped.OffsetHigh = (DWORD)(offset >> 32);
+
+        DWORD bytesRead = 0;
+        DWORD bytesToRead = (DWORD)std::min(size, (uint64_t)(1u << 30));
+        if (!ReadFile(file, dst, bytesToRead, &bytesRead, &overlapped) || !bytesRead)
+            return false;
+
+        offset += bytesRead;
+        dst += bytesRead;
+        size -= bytesRead;
+    }
+
+    return true;
+}
+
+static void CloseFile(FileHandle file) {
+    CloseHandle(file);
+}
+
+#else
+
+typedef intptr_t FileHandle;
+
+static FileHandle OpenFileForReading(const char* path) {
+    int fd = open(path, O_RDONLY);
+
+    return fd < 0 ? 0 : (FileHandle)fd + 1; // 0 is reserved for "invalid"
+}
+
+static bool ReadFileRegion(FileHandle file, uint64_t offset, uint8_t* dst, uint64_t size) {
+    while (size) {
+        ssize_t bytesRead = pread((int)(file - 1), dst, (size_t)size, (off_t)offset);
+        if (bytesRead <= 0)
+            return false;
+
+        offset += bytesRead;
+        dst += bytesRead;
+        size -= bytesRead;
+    }
+
+    return true;
+}
+
+static void CloseFile(FileHandle file) {
+    close((int)(file - 1));
+}
+
+#endif
+
+static bool ExecuteFileReadJob(const FileReadJob& job) {
+    FileHandle file = OpenFileForReading(job.filePath);
+    if (!file)
+        return false;
+
+    bool isOk = true;
+    if (job.srcRowPitch == job.dstRowPitch && (job.sliceNum == 1 || job.srcSlicePitch == job.dstSlicePitch)) {
+        // Same layout: read everything at once
+        uint64_t size = (job.sliceNum - 1) * job.srcSlicePitch + (job.rowNum - 1) * job.srcRowPitch + job.rowSize;
+        isOk = ReadFileRegion(file, job.fileOffset, job.dst, size);
+    } else if (job.srcRowPitch == job.dstRowPitch) {
+        // Repack slices
+        uint64_t sliceSize = (job.rowNum - 1) * job.srcRowPitch + job.rowSize;
+        for (uint32_t z = 0; z < job.sliceNum && isOk; z++)
+            isOk = ReadFileRegion(file, job.fileOffset + z * job.srcSlicePitch, job.dst + z * job.dstSlicePitch, sliceSize);
+    } else {
+        // Repack rows
+        for (uint32_t z = 0; z < job.sliceNum && isOk; z++) {
+            for (uint32_t y = 0; y < job.rowNum && isOk; y++) {
+                uint64_t srcOffset = job.fileOffset + z * job.srcSlicePitch + y * job.srcRowPitch;
+                uint8_t* dst = job.dst + z * job.dstSlicePitch + y * job.dstRowPitch;
+                isOk = ReadFileRegion(file, srcOffset, dst, job.rowSize);
+            }
+        }
+    }
+
+    CloseFile(file);
+
+    return isOk;
+}
+
+FileReader::~FileReader() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_IsExiting = true;
+    }
+
+    m_JobCondition.notify_all();
+
+    for (std::thread& thread : m_Threads)
+        thread.join();
+}
+
+void FileReader::Start(uint32_t threadNum) {
+    m_Threads.reserve(threadNum);
+
+    for (uint32_t i = 0; i < threadNum; i++)
+        m_Threads.emplace_back(&FileReader::WorkerThread, this);
+}
+
+void FileReader::Push(const FileReadJob& job) {
+    if (m_Threads.empty()) {
+        bool isOk = ExecuteFileReadJob(job);
+        m_IsFailed |= !isOk;
+
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Jobs.push_back(job);
+    }
+
+    m_JobCondition.notify_one();
+}
+
+bool FileReader::Wait() {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_IdleCondition.wait(lock, [this] { return m_Jobs.empty() && !m_ActiveJobNum; });
+
+    bool isOk = !m_IsFailed;
+    m_IsFailed = false;
+
+    return isOk;
+}
+
+void FileReader::WorkerThread() {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    while (true) {
+        m_JobCondition.wait(lock, [this] { return m_IsExiting || !m_Jobs.empty(); });
+        if (m_IsExiting)
+            break;
+
+        FileReadJob job = m_Jobs.back();
+        m_Jobs.pop_back();
+        m_ActiveJobNum++;
+
+        lock.unlock();
+        bool isOk = ExecuteFileReadJob(job);
+        lock.lock();
+
+        m_IsFailed |= !isOk;
+        m_ActiveJobNum--;
+
+        if (m_Jobs.empty() && !m_ActiveJobNum)
+            m_IdleCondition.notify_all();
+    }
+}
+
 StreamerImpl::~StreamerImpl() {
-    for (GarbageInFlight& garbageInFlight : m_GarbageInFlight) {
-        m_NRI.DestroyBuffer(*garbageInFlight.buffer);
-        m_NRI.FreeMemory(*garbageInFlight.memory);
+    m_FileReader.Wait();
+
+    const AllocationCallbacks& allocationCallbacks = ((DeviceBase&)m_Device).GetStdAllocator().GetInterface();
+
+    size_t bufferRequestNum = m_BufferRequests.Size();
+    for (size_t i = 0; i < bufferRequestNum; i++)
+        allocationCallbacks.Free(allocationCallbacks.userArg, m_BufferRequests[i].stagingMemory);
+
+    size_t textureRequestNum = m_TextureRequests.Size();
+    for (size_t i = 0; i < textureRequestNum; i++)
+        allocationCallbacks.Free(allocationCallbacks.userArg, m_TextureRequests[i].stagingMemory);
+
+    UnmapDynamicBuffer();
+
+    // Readback buffers are created on demand
+    for (ReadbackFrame& readbackFrame : m_ReadbackFrames) {
+        for (const ReadbackRequest& request : readbackFrame.requests)
+            DestroyBufferWithMemory(request.buffer, request.memory);
+
+        DestroyBufferWithMemory(readbackFrame.buffer, readbackFrame.memory);
     }
 
-    m_NRI.DestroyBuffer(*m_ConstantBuffer);
-    m_NRI.DestroyBuffer(*m_DynamicBuffer);
+    for (GarbageInFlight& garbageInFlight : m_GarbageInFlight)
+        DestroyBufferWithMemory(garbageInFlight.buffer, garbageInFlight.memory);
 
-    m_NRI.FreeMemory(*m_ConstantBufferMemory);
-    m_NRI.FreeMemory(*m_DynamicBufferMemory);
+    // Both are optional
+    DestroyBufferWithMemory(m_ConstantBuffer, m_ConstantBufferMemory);
+    DestroyBufferWithMemory(m_DynamicBuffer, m_DynamicBufferMemory);
 }
 
 Result StreamerImpl::Create(const StreamerDesc& desc) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::STREAMER);
+
     if (desc.constantBufferSize) {
         // Create constant buffer
         BufferDesc bufferDesc = {};
@@ -31,6 +216,7 @@ Result StreamerImpl::Create(const StreamerDesc& desc) {
         AllocateMemoryDesc allocateMemoryDesc = {};
         allocateMemoryDesc.type = memoryDesc.type;
         allocateMemoryDesc.size = memoryDesc.size;
+        allocateMemoryDesc.alignment = memoryDesc.alignment;
 
         result = m_NRI.AllocateMemory(m_Device, allocateMemoryDesc, m_ConstantBufferMemory);
         if (result != Result::SUCCESS)
@@ -47,22 +233,38 @@ Result StreamerImpl::Create(const StreamerDesc& desc) {
     }
 
     m_Desc = desc;
+    m_FileReader.Start(desc.fileReadThreadNum);
+
+    // D3D11 can't keep a buffer mapped while the GPU reads it
+    const DeviceDesc& deviceDesc = m_NRI.GetDeviceDesc(m_Device);
+    m_IsPersistentMappingSupported = deviceDesc.graphicsAPI != GraphicsAPI::D3D11;
+    m_IsTextureReadbackOffsetSupported = deviceDesc.graphicsAPI != GraphicsAPI::D3D11;
+
+    m_ReadbackFrames.reserve(desc.frameInFlightNum + 1);
+    for (uint32_t i = 0; i < desc.frameInFlightNum + 1; i++)
+        m_ReadbackFrames.emplace_back(((DeviceBase&)m_Device).GetStdAllocator());
 
     return Result::SUCCESS;
 }
 
 uint32_t StreamerImpl::UpdateStreamerConstantBuffer(const void* data, uint32_t dataSize) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::STREAMER);
+
     const DeviceDesc& deviceDesc = m_NRI.GetDeviceDesc(m_Device);
     uint32_t alignedSize = Align(dataSize, deviceDesc.constantBufferOffsetAlignment);
 
-    // Update
-    if (m_ConstantDataOffset + alignedSize > m_Desc.constantBufferSize)
-        m_ConstantDataOffset = 0;
+    // Reserve
+    uint32_t offset = m_ConstantDataOffset.load(std::memory_order_relaxed);
+    uint32_t newOffset = 0;
+    do {
+        newOffset = offset + alignedSize > m_Desc.constantBufferSize ? alignedSize : offset + alignedSize;
+    } while (!m_ConstantDataOffset.compare_exchange_weak(offset, newOffset, std::memory_order_relaxed));
 
-    uint32_t offset = m_ConstantDataOffset;
-    m_ConstantDataOffset += alignedSize;
+    offset = newOffset - alignedSize;
 
     // Copy
+    ExclusiveScope lock(m_ConstantBufferLock);
+
     uint8_t* dest = (uint8_t*)m_NRI.MapBuffer(*m_ConstantBuffer, offset, alignedSize);
     if (dest) {
         memcpy(dest, data, dataSize);
@@ -73,41 +275,218 @@ uint32_t StreamerImpl::UpdateStreamerConstantBuffer(const void* data, uint32_t d
 }
 
 uint64_t StreamerImpl::AddStreamerBufferUpdateRequest(const BufferUpdateRequestDesc& bufferUpdateRequestDesc) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::STREAMER);
+
+    BufferUpdateRequest* slot = m_BufferRequests.Reserve();
+    if (!slot)
+        return STREAMER_INVALID_OFFSET;
+
+    uint64_t sequence = m_NextSequence.fetch_add(1, std::memory_order_relaxed);
     uint64_t alignedSize = Align(bufferUpdateRequestDesc.dataSize, 16);
+    uint64_t offset = m_DynamicDataOffset.fetch_add(alignedSize, std::memory_order_relaxed);
 
-    uint64_t offset = m_DynamicDataOffsetBase + m_DynamicDataOffset;
-    m_BufferRequests.push_back({bufferUpdateRequestDesc, m_DynamicDataOffset}); // store local offset
-    m_DynamicDataOffset += alignedSize;
+    BufferUpdateRequest request = {bufferUpdateRequestDesc, offset, nullptr, 0, sequence}; // store local offset
 
-    return offset;
+    // Start reading the file in the background straight into the ring buffer (or temporary memory)
+    if (!request.desc.data && request.desc.filePath && m_Desc.fileReadThreadNum) {
+        FileReadJob job = {};
+        job.filePath = request.desc.filePath;
+        job.fileOffset = request.desc.fileOffset;
+        job.dst = ReserveMemory(offset, alignedSize, request.stagingMemory);
+        job.rowSize = request.desc.dataSize;
+        job.rowNum = 1;
+        job.sliceNum = 1;
+
+        if (job.dst) {
+            m_FileReader.Push(job);
+
+            request.desc.data = request.stagingMemory;
+            request.desc.filePath = nullptr;
+        }
+    }
+
+    *slot = request;
+
+    return m_DynamicDataOffsetBase + offset;
 }
 
 uint64_t StreamerImpl::AddStreamerTextureUpdateRequest(const TextureUpdateRequestDesc& textureUpdateRequestDesc) {
-    const DeviceDesc& deviceDesc = m_NRI.GetDeviceDesc(m_Device);
-    const TextureDesc& textureDesc = m_NRI.GetTextureDesc(*textureUpdateRequestDesc.dstTexture);
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::STREAMER);
 
-    Dim_t h = textureUpdateRequestDesc.dstRegionDesc.height;
-    h = h == WHOLE_SIZE ? GetDimension(deviceDesc.graphicsAPI, textureDesc, 1, textureUpdateRequestDesc.dstRegionDesc.mipOffset) : h;
+    TextureUpdateRequest* slot = m_TextureRequests.Reserve();
+    if (!slot)
+        return STREAMER_INVALID_OFFSET;
 
-    Dim_t d = textureUpdateRequestDesc.dstRegionDesc.depth;
-    d = d == WHOLE_SIZE ? GetDimension(deviceDesc.graphicsAPI, textureDesc, 2, textureUpdateRequestDesc.dstRegionDesc.mipOffset) : d;
+    TextureRequestLayout layout = GetTextureRequestLayout(textureUpdateRequestDesc);
+    uint64_t alignedSize = (uint64_t)layout.alignedSlicePitch * layout.sliceNum;
+    uint64_t offset = m_DynamicDataOffset.fetch_add(alignedSize, std::memory_order_relaxed);
 
-    uint32_t alignedRowPitch = Align(textureUpdateRequestDesc.dataRowPitch, deviceDesc.uploadBufferTextureRowAlignment);
-    uint32_t alignedSlicePitch = Align(alignedRowPitch * h, deviceDesc.uploadBufferTextureSliceAlignment);
-    uint64_t alignedSize = alignedSlicePitch * d;
+    TextureUpdateRequest request = {textureUpdateRequestDesc, offset, nullptr, 0}; // store local offset
 
-    uint64_t offset = m_DynamicDataOffsetBase + m_DynamicDataOffset;
-    m_TextureRequests.push_back({textureUpdateRequestDesc, m_DynamicDataOffset}); // store local offset
-    m_DynamicDataOffset += alignedSize;
+    // Start reading the file in the background straight into the ring buffer (or temporary memory), repacking rows
+    if (!request.desc.data && request.desc.filePath && m_Desc.fileReadThreadNum) {
+        FileReadJob job = {};
+        job.filePath = request.desc.filePath;
+        job.fileOffset = request.desc.fileOffset;
+        job.dst = ReserveMemory(offset, alignedSize, request.stagingMemory);
+        job.rowSize = request.desc.dataRowPitch;
+        job.srcRowPitch = request.desc.dataRowPitch;
+        job.srcSlicePitch = request.desc.dataSlicePitch;
+        job.dstRowPitch = layout.alignedRowPitch;
+        job.dstSlicePitch = layout.alignedSlicePitch;
+        job.rowNum = layout.rowNum;
+        job.sliceNum = layout.sliceNum;
 
-    return offset;
+        if (job.dst) {
+            m_FileReader.Push(job);
+
+            request.desc.data = request.stagingMemory;
+            request.desc.filePath = nullptr;
+        }
+    }
+
+    *slot = request;
+
+    return m_DynamicDataOffsetBase + offset;
+}
+
+Result StreamerImpl::QueueStreamerBufferUpdateRequest(const BufferUpdateRequestDesc& bufferUpdateRequestDesc, uint64_t& requestId) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::STREAMER);
+
+    // Scheduling is postponed until "CopyStreamerUpdateRequests", the ring buffer offset is assigned there
+    requestId = 0;
+
+    BufferUpdateRequest* slot = m_BufferRequests.Reserve();
+    if (!slot)
+        return Result::OUT_OF_MEMORY;
+
+    uint64_t sequence = m_NextSequence.fetch_add(1, std::memory_order_relaxed);
+    requestId = m_NextRequestId.fetch_add(1, std::memory_order_relaxed);
+    *slot = {bufferUpdateRequestDesc, 0, nullptr, requestId, sequence};
+
+    return Result::SUCCESS;
+}
+
+Result StreamerImpl::QueueStreamerTextureUpdateRequest(const TextureUpdateRequestDesc& textureUpdateRequestDesc, uint64_t& requestId) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::STREAMER);
+
+    // Scheduling is postponed until "CopyStreamerUpdateRequests", the ring buffer offset is assigned there
+    requestId = 0;
+
+    TextureUpdateRequest* slot = m_TextureRequests.Reserve();
+    if (!slot)
+        return Result::OUT_OF_MEMORY;
+
+    requestId = m_NextRequestId.fetch_add(1, std::memory_order_relaxed);
+    *slot = {textureUpdateRequestDesc, 0, nullptr, requestId};
+
+    return Result::SUCCESS;
+}
+
+void* StreamerImpl::ReserveStreamerBufferUpdate(const BufferUpdateRequestDesc& bufferUpdateRequestDesc, uint64_t& offset) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::STREAMER);
+
+    uint64_t alignedSize = Align(bufferUpdateRequestDesc.dataSize, 16);
+    uint64_t localOffset = m_DynamicDataOffset.fetch_add(alignedSize, std::memory_order_relaxed);
+
+    uint64_t sequence = m_NextSequence.fetch_add(1, std::memory_order_relaxed);
+    BufferUpdateRequest request = {bufferUpdateRequestDesc, localOffset, nullptr, 0, sequence}; // store local offset
+    request.desc.filePath = nullptr;
+
+    uint8_t* data = ReserveMemory(localOffset, alignedSize, request.stagingMemory);
+    if (!data) {
+        offset = 0;
+        return nullptr;
+    }
+
+    request.desc.data = request.stagingMemory;
+
+    if (!m_BufferRequests.Push(request)) {
+        const AllocationCallbacks& allocationCallbacks = ((DeviceBase&)m_Device).GetStdAllocator().GetInterface();
+        allocationCallbacks.Free(allocationCallbacks.userArg, request.stagingMemory);
+
+        offset = 0;
+        return nullptr;
+    }
+
+    offset = m_DynamicDataOffsetBase + localOffset;
+
+    return data;
+}
+
+uint8_t* StreamerImpl::ReserveMemory(uint64_t localOffset, uint64_t alignedSize, uint8_t*& stagingMemory) {
+    stagingMemory = nullptr;
+
+    // Write in place, if the current buffer has enough capacity and can stay mapped until "CopyStreamerUpdateRequests"
+    if (m_IsPersistentMappingSupported && m_DynamicDataOffsetBase + localOffset + alignedSize <= m_DynamicBufferSize) {
+        uint8_t* data = MapDynamicBuffer();
+        if (data)
+            return data + m_DynamicDataOffsetBase + localOffset;
+    }
+
+    // Otherwise use temporary memory, which gets copied into the new buffer in "CopyStreamerUpdateRequests"
+    const AllocationCallbacks& allocationCallbacks = ((DeviceBase&)m_Device).GetStdAllocator().GetInterface();
+    stagingMemory = (uint8_t*)allocationCallbacks.Allocate(allocationCallbacks.userArg, (size_t)alignedSize, 16);
+
+    return stagingMemory;
+}
+
+Result StreamerImpl::AddStreamerReadbackRequest(const ReadbackRequestDesc& readbackRequestDesc) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::STREAMER);
+
+    ReadbackRequest request = {readbackRequestDesc, 0, 0, 0, 0, nullptr, nullptr}; // the offset is assigned in "CopyStreamerUpdateRequests"
+
+    if (readbackRequestDesc.srcTexture) {
+        const DeviceDesc& deviceDesc = m_NRI.GetDeviceDesc(m_Device);
+        const TextureDesc& textureDesc = m_NRI.GetTextureDesc(*readbackRequestDesc.srcTexture);
+        const TextureRegionDesc& regionDesc = readbackRequestDesc.srcRegionDesc;
+        const FormatProps& formatProps = GetFormatProps(textureDesc.format);
+
+        Dim_t w = regionDesc.width == WHOLE_SIZE ? GetDimension(deviceDesc.graphicsAPI, textureDesc, 0, regionDesc.mipOffset) : regionDesc.width;
+        Dim_t h = regionDesc.height == WHOLE_SIZE ? GetDimension(deviceDesc.graphicsAPI, textureDesc, 1, regionDesc.mipOffset) : regionDesc.height;
+        Dim_t d = regionDesc.depth == WHOLE_SIZE ? GetDimension(deviceDesc.graphicsAPI, textureDesc, 2, regionDesc.mipOffset) : regionDesc.depth;
+
+        uint32_t rowSize = (w + formatProps.blockWidth - 1) / formatProps.blockWidth * formatProps.stride;
+        uint32_t rowNum = (h + formatProps.blockHeight - 1) / formatProps.blockHeight;
+
+        request.rowPitch = Align(rowSize, deviceDesc.uploadBufferTextureRowAlignment);
+        request.slicePitch = Align(request.rowPitch * rowNum, deviceDesc.uploadBufferTextureSliceAlignment);
+        request.size = (uint64_t)request.slicePitch * d;
+    } else
+        request.size = readbackRequestDesc.dataSize;
+
+    return m_ReadbackRequests.Push(request) ? Result::SUCCESS : Result::OUT_OF_MEMORY;
+}
+
+bool StreamerImpl::IsStreamerRequestComplete(uint64_t requestId) const {
+    if (requestId > m_GatheredRequestId)
+        return false;
+
+    return !std::binary_search(m_PendingRequestIds.begin(), m_PendingRequestIds.end(), requestId);
 }
 
 Result StreamerImpl::CopyStreamerUpdateRequests() {
-    if (!m_DynamicDataOffset)
-        return Result::SUCCESS;
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::STREAMER);
+
+    // All "Add" calls must be completed (i.e. synchronized with this call) by now, background reads must be finished
+    bool isFileReadOk = m_FileReader.Wait();
+
+    SchedulePendingRequests();
+
+    Result result = ProcessReadbackRequests();
+    if (result != Result::SUCCESS)
+        return result;
 
-    // Process garbage
+    uint64_t dynamicDataOffset = m_DynamicDataOffset.load(std::memory_order_acquire);
+
+    // Telemetry
+    m_Statistics.streamedSize = dynamicDataOffset;
+    m_Statistics.peakStreamedSize = std::max(m_Statistics.peakStreamedSize, dynamicDataOffset);
+
+    m_HighWaterMark = std::max(m_HighWaterMark, dynamicDataOffset);
+    m_HighWaterMarkFrameNum++;
+
+    // Process garbage (idle frames count too)
     for (size_t i = 0; i < m_GarbageInFlight.size(); i++) {
         GarbageInFlight& garbageInFlight = m_GarbageInFlight[i];
         if (garbageInFlight.frameNum < m_Desc.frameInFlightNum)
@@ -121,55 +500,72 @@ Result StreamerImpl::CopyStreamerUpdateRequests() {
         }
     }
 
-    // Grow
-    if (m_DynamicDataOffsetBase + m_DynamicDataOffset > m_DynamicBufferSize) {
-        m_DynamicBufferSize = Align(m_DynamicDataOffset, CHUNK_SIZE) * (m_Desc.frameInFlightNum + 1);
-
-        // Add the current buffer to the garbage collector immediately, but keep it alive for some frames
-        if (m_DynamicBuffer)
-            m_GarbageInFlight.push_back({m_DynamicBuffer, m_DynamicBufferMemory, 0});
+    // Current data is placed at "m_DynamicDataOffsetBase" (returned offsets already include it)
+    uint64_t minSize = Align(m_DynamicDataOffsetBase + dynamicDataOffset, CHUNK_SIZE);
 
-        { // Create new dynamic buffer & allocate memory
-            BufferDesc bufferDesc = {};
-            bufferDesc.size = m_DynamicBufferSize;
-            bufferDesc.usage = m_Desc.dynamicBufferUsageBits;
+    // Shrink to fit the high-water mark (evaluated before the early out, otherwise idle frames never trigger it)
+    if (m_Desc.shrinkFrameNum && m_HighWaterMarkFrameNum >= m_Desc.shrinkFrameNum) {
+        uint64_t size = std::max(Align(m_HighWaterMark, CHUNK_SIZE) * (m_Desc.frameInFlightNum + 1), minSize);
+        size = std::max(size, CHUNK_SIZE);
 
-            Result result = m_NRI.CreateBuffer(m_Device, bufferDesc, m_DynamicBuffer);
+        if (size < m_DynamicBufferSize) {
+            Result result = ResizeDynamicBuffer(size);
             if (result != Result::SUCCESS)
                 return result;
 
-            MemoryDesc memoryDesc = {};
-            m_NRI.GetBufferMemoryDesc(m_Device, bufferDesc, m_Desc.dynamicBufferMemoryLocation, memoryDesc);
+            m_Statistics.shrinkNum++;
+        }
 
-            AllocateMemoryDesc allocateMemoryDesc = {};
-            allocateMemoryDesc.type = memoryDesc.type;
-            allocateMemoryDesc.size = memoryDesc.size;
+        m_HighWaterMark = 0;
+        m_HighWaterMarkFrameNum = 0;
+    }
 
-            result = m_NRI.AllocateMemory(m_Device, allocateMemoryDesc, m_DynamicBufferMemory);
-            if (result != Result::SUCCESS)
-                return result;
-        }
+    if (!dynamicDataOffset)
+        return Result::SUCCESS;
 
-        { // Bind to memory
-            BufferMemoryBindingDesc memoryBindingDesc = {};
-            memoryBindingDesc.buffer = m_DynamicBuffer;
-            memoryBindingDesc.memory = m_DynamicBufferMemory;
+    // Grow
+    if (minSize > m_DynamicBufferSize) {
+        uint64_t size = std::max(Align(dynamicDataOffset, CHUNK_SIZE) * (m_Desc.frameInFlightNum + 1), minSize);
 
-            Result result = m_NRI.BindBufferMemory(m_Device, &memoryBindingDesc, 1);
-            if (result != Result::SUCCESS)
-                return result;
-        }
+        Result result = ResizeDynamicBuffer(size);
+        if (result != Result::SUCCESS)
+            return result;
+
+        m_Statistics.growNum++;
     }
 
     // Concatenate & copy to the internal buffer, gather requests with destinations
-    uint8_t* data = (uint8_t*)m_NRI.MapBuffer(*m_DynamicBuffer, m_DynamicDataOffsetBase, m_DynamicDataOffset);
+    uint8_t* data = MapDynamicBuffer();
     if (data) {
-        const DeviceDesc& deviceDesc = m_NRI.GetDeviceDesc(m_Device);
+        const AllocationCallbacks& allocationCallbacks = ((DeviceBase&)m_Device).GetStdAllocator().GetInterface();
+        data += m_DynamicDataOffsetBase;
 
         // Buffers
-        for (BufferUpdateRequest& request : m_BufferRequests) {
+        size_t bufferRequestNum = m_BufferRequests.Size();
+        for (size_t i = 0; i < bufferRequestNum; i++) {
+            BufferUpdateRequest& request = m_BufferRequests[i];
+            if (request.id)
+                continue;
+
             uint8_t* dst = data + request.offset;
-            memcpy(dst, request.desc.data, request.desc.dataSize);
+            if (request.desc.data)
+                memcpy(dst, request.desc.data, request.desc.dataSize);
+            else if (request.desc.filePath) {
+                FileReadJob job = {};
+                job.filePath = request.desc.filePath;
+                job.fileOffset = request.desc.fileOffset;
+                job.dst = dst;
+                job.rowSize = request.desc.dataSize;
+                job.rowNum = 1;
+                job.sliceNum = 1;
+
+                m_FileReader.Push(job);
+            }
+
+            if (request.stagingMemory) {
+                allocationCallbacks.Free(allocationCallbacks.userArg, request.stagingMemory);
+                request.stagingMemory = nullptr;
+            }
 
             if (request.desc.dstBuffer) {
                 request.offset += m_DynamicDataOffsetBase; // convert to global offset
@@ -178,25 +574,43 @@ Result StreamerImpl::CopyStreamerUpdateRequests() {
         }
 
         // Textures
-        for (TextureUpdateRequest& request : m_TextureRequests) {
-            uint8_t* dst = data + request.offset;
-            const TextureDesc& textureDesc = m_NRI.GetTextureDesc(*request.desc.dstTexture);
-
-            Dim_t h = request.desc.dstRegionDesc.height;
-            h = h == WHOLE_SIZE ? GetDimension(deviceDesc.graphicsAPI, textureDesc, 1, request.desc.dstRegionDesc.mipOffset) : h;
+        size_t textureRequestNum = m_TextureRequests.Size();
+        for (size_t i = 0; i < textureRequestNum; i++) {
+            TextureUpdateRequest& request = m_TextureRequests[i];
+            if (request.id)
+                continue;
 
-            Dim_t d = request.desc.dstRegionDesc.depth;
-            d = d == WHOLE_SIZE ? GetDimension(deviceDesc.graphicsAPI, textureDesc, 2, request.desc.dstRegionDesc.mipOffset) : d;
+            uint8_t* dst = data + request.offset;
+            TextureRequestLayout layout = GetTextureRequestLayout(request.desc);
 
-            uint32_t alignedRowPitch = Align(request.desc.dataRowPitch, deviceDesc.uploadBufferTextureRowAlignment);
-            uint32_t alignedSlicePitch = Align(alignedRowPitch * h, deviceDesc.uploadBufferTextureSliceAlignment);
+            if (request.stagingMemory) {
+                // Already repacked
+                memcpy(dst, request.stagingMemory, (size_t)layout.alignedSlicePitch * layout.sliceNum);
 
-            for (uint32_t z = 0; z < d; z++) {
-                for (uint32_t y = 0; y < h; y++) {
-                    uint8_t* dstRow = dst + z * alignedSlicePitch + y * alignedRowPitch;
-                    const uint8_t* srcRow = (uint8_t*)request.desc.data + z * request.desc.dataSlicePitch + y * request.desc.dataRowPitch;
-                    memcpy(dstRow, srcRow, request.desc.dataRowPitch);
+                allocationCallbacks.Free(allocationCallbacks.userArg, request.stagingMemory);
+                request.stagingMemory = nullptr;
+            } else if (request.desc.data) {
+                for (uint32_t z = 0; z < layout.sliceNum; z++) {
+                    for (uint32_t y = 0; y < layout.rowNum; y++) {
+                        uint8_t* dstRow = dst + z * layout.alignedSlicePitch + y * layout.alignedRowPitch;
+                        const uint8_t* srcRow = (uint8_t*)request.desc.data + z * request.desc.dataSlicePitch + y * request.desc.dataRowPitch;
+                        memcpy(dstRow, srcRow, request.desc.dataRowPitch);
+                    }
                 }
+            } else if (request.desc.filePath) {
+                FileReadJob job = {};
+                job.filePath = request.desc.filePath;
+                job.fileOffset = request.desc.fileOffset;
+                job.dst = dst;
+                job.rowSize = request.desc.dataRowPitch;
+                job.srcRowPitch = request.desc.dataRowPitch;
+                job.srcSlicePitch = request.desc.dataSlicePitch;
+                job.dstRowPitch = layout.alignedRowPitch;
+                job.dstSlicePitch = layout.alignedSlicePitch;
+                job.rowNum = layout.rowNum;
+                job.sliceNum = layout.sliceNum;
+
+                m_FileReader.Push(job);
             }
 
             if (request.desc.dstTexture) {
@@ -205,27 +619,433 @@ Result StreamerImpl::CopyStreamerUpdateRequests() {
             }
         }
 
-        m_NRI.UnmapBuffer(*m_DynamicBuffer);
+        // Files, which have not been read in background, are read directly into the mapped buffer
+        isFileReadOk = m_FileReader.Wait() && isFileReadOk;
+
+        UnmapDynamicBuffer();
     } else
         return Result::FAILURE;
 
+    // Merge copies to the same destination
+    MergeBufferRequestsWithDst();
+
     // Cleanup
-    m_BufferRequests.clear();
-    m_TextureRequests.clear();
+    m_BufferRequests.Clear();
+    m_TextureRequests.Clear();
 
     m_FrameIndex = (m_FrameIndex + 1) % (m_Desc.frameInFlightNum + 1);
 
     if (m_FrameIndex == 0)
         m_DynamicDataOffsetBase = 0;
     else
-        m_DynamicDataOffsetBase += m_DynamicDataOffset;
+        m_DynamicDataOffsetBase += dynamicDataOffset;
 
-    m_DynamicDataOffset = 0;
+    m_DynamicDataOffset.store(0, std::memory_order_relaxed);
+
+    RETURN_ON_FAILURE(&(DeviceBase&)m_Device, isFileReadOk, Result::FAILURE, "Failed to read a file");
 
     return Result::SUCCESS;
 }
 
+TextureRequestLayout StreamerImpl::GetTextureRequestLayout(const TextureUpdateRequestDesc& textureUpdateRequestDesc) const {
+    const DeviceDesc& deviceDesc = m_NRI.GetDeviceDesc(m_Device);
+    const TextureDesc& textureDesc = m_NRI.GetTextureDesc(*textureUpdateRequestDesc.dstTexture);
+
+    Dim_t h = textureUpdateRequestDesc.dstRegionDesc.height;
+    h = h == WHOLE_SIZE ? GetDimension(deviceDesc.graphicsAPI, textureDesc, 1, textureUpdateRequestDesc.dstRegionDesc.mipOffset) : h;
+
+    Dim_t d = textureUpdateRequestDesc.dstRegionDesc.depth;
+    d = d == WHOLE_SIZE ? GetDimension(deviceDesc.graphicsAPI, textureDesc, 2, textureUpdateRequestDesc.dstRegionDesc.mipOffset) : d;
+
+    TextureRequestLayout layout = {};
+    layout.rowNum = h;
+    layout.sliceNum = d;
+    layout.alignedRowPitch = Align(textureUpdateRequestDesc.dataRowPitch, deviceDesc.uploadBufferTextureRowAlignment);
+    layout.alignedSlicePitch = Align(layout.alignedRowPitch * h, deviceDesc.uploadBufferTextureSliceAlignment);
+
+    return layout;
+}
+
+Result StreamerImpl::ProcessReadbackRequests() {
+    // The slot has been written "frameInFlightNum + 1" frames ago, i.e. the GPU is done with it
+    ReadbackFrame& readbackFrame = m_ReadbackFrames[m_ReadbackFrameIndex];
+    m_ReadbackFrameIndex = (m_ReadbackFrameIndex + 1) % (m_Desc.frameInFlightNum + 1);
+    m_ReadbackFrameToRecord = nullptr;
+
+    // Deliver
+    if (!readbackFrame.requests.empty()) {
+        const uint8_t* slotData = nullptr;
+        Result result = Result::SUCCESS;
+
+        for (const ReadbackRequest& request : readbackFrame.requests) {
+            const uint8_t* data = nullptr;
+            if (request.buffer)
+                data = (uint8_t*)m_NRI.MapBuffer(*request.buffer, 0, WHOLE_SIZE);
+            else {
+                if (!slotData)
+                    slotData = (uint8_t*)m_NRI.MapBuffer(*readbackFrame.buffer, 0, WHOLE_SIZE);
+
+                data = slotData ? slotData + request.offset : nullptr;
+            }
+
+            if (data && request.desc.Callback)
+                request.desc.Callback(data, request.size, request.rowPitch, request.slicePitch, request.desc.userArg);
+            else if (!data)
+                result = Result::FAILURE;
+
+            if (request.buffer) {
+                if (data)
+                    m_NRI.UnmapBuffer(*request.buffer);
+
+                DestroyBufferWithMemory(request.buffer, request.memory);
+            }
+        }
+
+        if (slotData)
+            m_NRI.UnmapBuffer(*readbackFrame.buffer);
+
+        readbackFrame.requests.clear();
+
+        if (result != Result::SUCCESS)
+            return result;
+    }
+
+    // Gather new requests
+    size_t readbackRequestNum = m_ReadbackRequests.Size();
+    if (!readbackRequestNum)
+        return Result::SUCCESS;
+
+    const DeviceDesc& deviceDesc = m_NRI.GetDeviceDesc(m_Device);
+
+    Result result = Result::SUCCESS;
+    uint64_t size = 0;
+    for (size_t i = 0; i < readbackRequestNum && result == Result::SUCCESS; i++) {
+        ReadbackRequest request = m_ReadbackRequests[i];
+
+        if (request.desc.srcTexture && !m_IsTextureReadbackOffsetSupported)
+            result = CreateBufferWithMemory(request.size, BufferUsageBits::NONE, MemoryLocation::HOST_READBACK, request.buffer, request.memory);
+        else {
+            // Texture copies require aligned offsets
+            request.offset = Align(size, request.desc.srcTexture ? deviceDesc.uploadBufferTextureSliceAlignment : 16);
+            size = request.offset + request.size;
+        }
+
+        readbackFrame.requests.push_back(request);
+    }
+
+    m_ReadbackRequests.Clear();
+
+    // Grow (the slot is not in use by the GPU)
+    if (result == Result::SUCCESS && size > readbackFrame.size) {
+        DestroyBufferWithMemory(readbackFrame.buffer, readbackFrame.memory);
+
+        readbackFrame.buffer = nullptr;
+        readbackFrame.memory = nullptr;
+        readbackFrame.size = 0;
+
+        uint64_t alignedSize = Align(size, CHUNK_SIZE);
+        result = CreateBufferWithMemory(alignedSize, BufferUsageBits::NONE, MemoryLocation::HOST_READBACK, readbackFrame.buffer, readbackFrame.memory);
+        if (result == Result::SUCCESS)
+            readbackFrame.size = alignedSize;
+    }
+
+    if (result != Result::SUCCESS) {
+        for (const ReadbackRequest& request : readbackFrame.requests)
+            DestroyBufferWithMemory(request.buffer, request.memory);
+
+        readbackFrame.requests.clear();
+
+        return result;
+    }
+
+    m_ReadbackFrameToRecord = &readbackFrame;
+
+    return Result::SUCCESS;
+}
+
+void StreamerImpl::SchedulePendingRequests() {
+    m_GatheredRequestId = m_NextRequestId.load(std::memory_order_relaxed) - 1;
+
+    // Gather new requests
+    size_t bufferRequestNum = m_BufferRequests.Size();
+    for (size_t i = 0; i < bufferRequestNum; i++) {
+        const BufferUpdateRequest& request = m_BufferRequests[i];
+        if (request.id)
+            m_PendingBufferRequests.push_back(request);
+    }
+
+    size_t textureRequestNum = m_TextureRequests.Size();
+    for (size_t i = 0; i < textureRequestNum; i++) {
+        const TextureUpdateRequest& request = m_TextureRequests[i];
+        if (request.id)
+            m_PendingTextureRequests.push_back(request);
+    }
+
+    // Sort by priority, preserving submission order for equal priorities. Last elements go first
+    std::sort(m_PendingBufferRequests.begin(), m_PendingBufferRequests.end(), [](const BufferUpdateRequest& a, const BufferUpdateRequest& b) {
+        if (a.desc.priority != b.desc.priority)
+            return a.desc.priority < b.desc.priority;
+
+        return a.id > b.id;
+    });
+
+    std::sort(m_PendingTextureRequests.begin(), m_PendingTextureRequests.end(), [](const TextureUpdateRequest& a, const TextureUpdateRequest& b) {
+        if (a.desc.priority != b.desc.priority)
+            return a.desc.priority < b.desc.priority;
+
+        return a.id > b.id;
+    });
+
+    // Schedule in priority order until the budget (if any) is exhausted. Immediate requests are accounted, at least one request goes to avoid stalling
+    uint64_t usedSize = m_DynamicDataOffset.load(std::memory_order_relaxed);
+    while (!m_PendingBufferRequests.empty() || !m_PendingTextureRequests.empty()) {
+        bool isBuffer = !m_PendingBufferRequests.empty();
+        if (isBuffer && !m_PendingTextureRequests.empty()) {
+            const BufferUpdateRequest& buffer = m_PendingBufferRequests.back();
+            const TextureUpdateRequest& texture = m_PendingTextureRequests.back();
+
+            isBuffer = buffer.desc.priority > texture.desc.priority || (buffer.desc.priority == texture.desc.priority && buffer.id < texture.id);
+        }
+
+        uint64_t alignedSize = 0;
+        if (isBuffer)
+            alignedSize = Align(m_PendingBufferRequests.back().desc.dataSize, 16);
+        else {
+            TextureRequestLayout layout = GetTextureRequestLayout(m_PendingTextureRequests.back().desc);
+            alignedSize = (uint64_t)layout.alignedSlicePitch * layout.sliceNum;
+        }
+
+        if (m_Desc.frameBudgetSize && usedSize && usedSize + alignedSize > m_Desc.frameBudgetSize)
+            break;
+
+        // Out of memory: the rest stays pending
+        BufferUpdateRequest* bufferSlot = isBuffer ? m_BufferRequests.Reserve() : nullptr;
+        TextureUpdateRequest* textureSlot = isBuffer ? nullptr : m_TextureRequests.Reserve();
+        if (!bufferSlot && !textureSlot)
+            break;
+
+        uint64_t offset = m_DynamicDataOffset.fetch_add(alignedSize, std::memory_order_relaxed);
+        usedSize += alignedSize;
+
+        if (isBuffer) {
+            *bufferSlot = m_PendingBufferRequests.back();
+            bufferSlot->offset = offset;
+            bufferSlot->id = 0;
+
+            m_PendingBufferRequests.pop_back();
+        } else {
+            *textureSlot = m_PendingTextureRequests.back();
+            textureSlot->offset = offset;
+            textureSlot->id = 0;
+
+            m_PendingTextureRequests.pop_back();
+        }
+    }
+
+    // Update pending IDs
+    m_PendingRequestIds.clear();
+
+    for (const BufferUpdateRequest& request : m_PendingBufferRequests)
+        m_PendingRequestIds.push_back(request.id);
+
+    for (const TextureUpdateRequest& request : m_PendingTextureRequests)
+        m_PendingRequestIds.push_back(request.id);
+
+    std::sort(m_PendingRequestIds.begin(), m_PendingRequestIds.end());
+}
+
+Result StreamerImpl::ResizeDynamicBuffer(uint64_t size) {
+    // The new buffer is committed only if it's fully ready, otherwise the current one is kept as is
+    Buffer* newBuffer = nullptr;
+    Memory* newMemory = nullptr;
+
+    Result result = CreateBufferWithMemory(size, m_Desc.dynamicBufferUsageBits, m_Desc.dynamicBufferMemoryLocation, newBuffer, newMemory);
+    if (result != Result::SUCCESS)
+        return result;
+
+    // Data, written in place, lives in the current buffer
+    uint8_t* oldData = m_DynamicBufferMappedMemory.load(std::memory_order_relaxed);
+    uint8_t* newData = nullptr;
+    if (oldData) {
+        newData = (uint8_t*)m_NRI.MapBuffer(*newBuffer, 0, WHOLE_SIZE);
+        if (!newData) {
+            DestroyBufferWithMemory(newBuffer, newMemory);
+
+            return Result::FAILURE;
+        }
+    }
+
+    // Add the current buffer to the garbage collector immediately, but keep it alive for some frames
+    Buffer* oldBuffer = m_DynamicBuffer;
+    if (m_DynamicBuffer)
+        m_GarbageInFlight.push_back({m_DynamicBuffer, m_DynamicBufferMemory, 0});
+
+    m_DynamicBuffer = newBuffer;
+    m_DynamicBufferMemory = newMemory;
+    m_DynamicBufferSize = size;
+    m_DynamicBufferMappedMemory.store(newData, std::memory_order_relaxed);
+
+    // Move data, written in place, to the new buffer
+    if (oldData) {
+        size_t bufferRequestNum = m_BufferRequests.Size();
+        for (size_t i = 0; i < bufferRequestNum; i++) {
+            const BufferUpdateRequest& request = m_BufferRequests[i];
+            if (!request.id && !request.desc.data && !request.desc.filePath) {
+                uint64_t offset = m_DynamicDataOffsetBase + request.offset;
+                memcpy(newData + offset, oldData + offset, request.desc.dataSize);
+            }
+        }
+
+        size_t textureRequestNum = m_TextureRequests.Size();
+        for (size_t i = 0; i < textureRequestNum; i++) {
+            const TextureUpdateRequest& request = m_TextureRequests[i];
+            if (!request.id && !request.desc.data && !request.desc.filePath) {
+                TextureRequestLayout layout = GetTextureRequestLayout(request.desc);
+                uint64_t offset = m_DynamicDataOffsetBase + request.offset;
+                memcpy(newData + offset, oldData + offset, (size_t)layout.alignedSlicePitch * layout.sliceNum);
+            }
+        }
+
+        m_NRI.UnmapBuffer(*oldBuffer);
+    }
+
+    return Result::SUCCESS;
+}
+
+Result StreamerImpl::CreateBufferWithMemory(uint64_t size, BufferUsageBits usage, MemoryLocation memoryLocation, Buffer*& buffer, Memory*& memory) {
+    buffer = nullptr;
+    memory = nullptr;
+
+    BufferDesc bufferDesc = {};
+    bufferDesc.size = size;
+    bufferDesc.usage = usage;
+
+    Result result = m_NRI.CreateBuffer(m_Device, bufferDesc, buffer);
+    if (result == Result::SUCCESS) {
+        MemoryDesc memoryDesc = {};
+        m_NRI.GetBufferMemoryDesc(m_Device, bufferDesc, memoryLocation, memoryDesc);
+
+        AllocateMemoryDesc allocateMemoryDesc = {};
+        allocateMemoryDesc.type = memoryDesc.type;
+        allocateMemoryDesc.size = memoryDesc.size;
+        allocateMemoryDesc.alignment = memoryDesc.alignment;
+
+        result = m_NRI.AllocateMemory(m_Device, allocateMemoryDesc, memory);
+    }
+
+    if (result == Result::SUCCESS) {
+        BufferMemoryBindingDesc memoryBindingDesc = {};
+        memoryBindingDesc.buffer = buffer;
+        memoryBindingDesc.memory = memory;
+
+        result = m_NRI.BindBufferMemory(m_Device, &memoryBindingDesc, 1);
+    }
+
+    // Nothing is left behind on failure
+    if (result != Result::SUCCESS) {
+        DestroyBufferWithMemory(buffer, memory);
+
+        buffer = nullptr;
+        memory = nullptr;
+    }
+
+    return result;
+}
+
+void StreamerImpl::DestroyBufferWithMemory(Buffer* buffer, Memory* memory) {
+    if (buffer)
+        m_NRI.DestroyBuffer(*buffer);
+    if (memory)
+        m_NRI.FreeMemory(*memory);
+}
+
+void StreamerImpl::MergeBufferRequestsWithDst() {
+    m_Statistics.bufferCopyRequestNum = (uint32_t)m_BufferRequestsWithDst.size();
+
+    // Group by destination, sort by destination offset. Stable sorting preserves submission order for equal offsets
+    std::stable_sort(m_BufferRequestsWithDst.begin(), m_BufferRequestsWithDst.end(), [](const BufferUpdateRequest& a, const BufferUpdateRequest& b) {
+        if (a.desc.dstBuffer != b.desc.dstBuffer)
+            return a.desc.dstBuffer < b.desc.dstBuffer;
+
+        return a.desc.dstBufferOffset < b.desc.dstBufferOffset;
+    });
+
+    size_t mergedNum = 0;
+    for (size_t groupBegin = 0; groupBegin < m_BufferRequestsWithDst.size();) {
+        const Buffer* dstBuffer = m_BufferRequestsWithDst[groupBegin].desc.dstBuffer;
+
+        // Find the group end and check for overlapping destination ranges
+        bool isOverlapped = false;
+        uint64_t dstEnd = 0;
+        size_t groupEnd = groupBegin;
+        for (; groupEnd < m_BufferRequestsWithDst.size() && m_BufferRequestsWithDst[groupEnd].desc.dstBuffer == dstBuffer; groupEnd++) {
+            const BufferUpdateRequest& request = m_BufferRequestsWithDst[groupEnd];
+            isOverlapped |= request.desc.dstBufferOffset < dstEnd;
+            dstEnd = std::max(dstEnd, request.desc.dstBufferOffset + request.desc.dataSize);
+        }
+
+        // The order of overlapping copies matters. Restore submission order (not ring offsets, which follow priorities in budget mode) and don't merge
+        if (isOverlapped) {
+            std::sort(m_BufferRequestsWithDst.begin() + groupBegin, m_BufferRequestsWithDst.begin() + groupEnd, [](const BufferUpdateRequest& a, const BufferUpdateRequest& b) {
+                return a.sequence < b.sequence;
+            });
+
+            for (size_t i = groupBegin; i < groupEnd; i++)
+                m_BufferRequestsWithDst[mergedNum++] = m_BufferRequestsWithDst[i];
+        } else {
+            // Merge requests contiguous in both source and destination
+            for (size_t i = groupBegin; i < groupEnd; i++) {
+                const BufferUpdateRequest& request = m_BufferRequestsWithDst[i];
+
+                if (i != groupBegin) {
+                    BufferUpdateRequest& prev = m_BufferRequestsWithDst[mergedNum - 1];
+                    bool isSrcContiguous = prev.offset + prev.desc.dataSize == request.offset;
+                    bool isDstContiguous = prev.desc.dstBufferOffset + prev.desc.dataSize == request.desc.dstBufferOffset;
+
+                    if (isSrcContiguous && isDstContiguous) {
+                        prev.desc.dataSize += request.desc.dataSize;
+                        continue;
+                    }
+                }
+
+                m_BufferRequestsWithDst[mergedNum++] = request;
+            }
+        }
+
+        groupBegin = groupEnd;
+    }
+
+    m_BufferRequestsWithDst.resize(mergedNum);
+    m_Statistics.bufferCopyNum = (uint32_t)mergedNum;
+}
+
+uint8_t* StreamerImpl::MapDynamicBuffer() {
+    uint8_t* data = m_DynamicBufferMappedMemory.load(std::memory_order_acquire);
+    if (data)
+        return data;
+
+    ExclusiveScope lock(m_DynamicBufferLock);
+
+    data = m_DynamicBufferMappedMemory.load(std::memory_order_relaxed);
+    if (!data && m_DynamicBuffer) {
+        data = (uint8_t*)m_NRI.MapBuffer(*m_DynamicBuffer, 0, WHOLE_SIZE);
+        m_DynamicBufferMappedMemory.store(data, std::memory_order_release);
+    }
+
+    return data;
+}
+
+void StreamerImpl::UnmapDynamicBuffer() {
+    // Must be unmapped before use on the device (D3D11, where in place writes are not used for this reason)
+    if (m_DynamicBufferMappedMemory.load(std::memory_order_relaxed)) {
+        m_NRI.UnmapBuffer(*m_DynamicBuffer);
+        m_DynamicBufferMappedMemory.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
 void StreamerImpl::CmdUploadStreamerUpdateRequests(CommandBuffer& commandBuffer) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::STREAMER);
+
     // Buffers
     for (const BufferUpdateRequest& request : m_BufferRequestsWithDst)
         m_NRI.CmdCopyBuffer(commandBuffer, *request.desc.dstBuffer, request.desc.dstBufferOffset, *m_DynamicBuffer, request.offset, request.desc.dataSize);
@@ -240,7 +1060,24 @@ void StreamerImpl::CmdUploadStreamerUpdateRequests(CommandBuffer& commandBuffer)
         m_NRI.CmdUploadBufferToTexture(commandBuffer, *request.desc.dstTexture, request.desc.dstRegionDesc, *m_DynamicBuffer, dataLayout);
     }
 
+    // Readbacks
+    if (m_ReadbackFrameToRecord) {
+        for (const ReadbackRequest& request : m_ReadbackFrameToRecord->requests) {
+            if (request.desc.srcTexture) {
+                TextureDataLayoutDesc dataLayout = {};
+                dataLayout.offset = request.offset;
+                dataLayout.rowPitch = request.rowPitch;
+                dataLayout.slicePitch = request.slicePitch;
+
+                Buffer* buffer = request.buffer ? request.buffer : m_ReadbackFrameToRecord->buffer;
+                m_NRI.CmdReadbackTextureToBuffer(commandBuffer, *buffer, dataLayout, *request.desc.srcTexture, request.desc.srcRegionDesc);
+            } else
+                m_NRI.CmdCopyBuffer(commandBuffer, *m_ReadbackFrameToRecord->buffer, request.offset, *request.desc.srcBuffer, request.desc.srcBufferOffset, request.size);
+        }
+    }
+
     // Cleanup
     m_BufferRequestsWithDst.clear();
     m_TextureRequestsWithDst.clear();
+    m_ReadbackFrameToRecord = nullptr;
 }
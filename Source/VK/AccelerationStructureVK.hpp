@@ -82,7 +82,9 @@ inline void AccelerationStructureVK::SetDebugName(const char* name) {
 }
 
 inline Result AccelerationStructureVK::CreateDescriptor(Descriptor*& descriptor) const {
-    DescriptorVK* descriptorImpl = Allocate<DescriptorVK>(m_Device.GetStdAllocator(), m_Device);
+    DescriptorVK* descriptorImpl = m_Device.GetDescriptorObjectPool().Allocate(m_Device);
+    if (!descriptorImpl)
+        return Result::OUT_OF_MEMORY;
 
     Result result = descriptorImpl->Create(m_Handle);
 
@@ -91,7 +93,7 @@ inline Result AccelerationStructureVK::CreateDescriptor(Descriptor*& descriptor)
         return Result::SUCCESS;
     }
 
-    Destroy(m_Device.GetStdAllocator(), descriptorImpl);
+    m_Device.GetDescriptorObjectPool().Destroy(descriptorImpl);
 
     return Result::SUCCESS;
 }
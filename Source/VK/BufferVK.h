@@ -20,6 +20,10 @@ struct BufferVK {
         return m_DeviceAddress;
     }
 
+    inline VmaAllocation_T* GetVmaAllocation() const {
+        return m_VmaAllocation;
+    }
+
     inline DeviceVK& GetDevice() const {
         return m_Device;
     }
@@ -35,6 +39,7 @@ struct BufferVK {
     Result Create(const AllocateBufferDesc& bufferDesc);
     void FinishMemoryBinding(MemoryVK& memory, uint64_t memoryOffset);
     void DestroyVma();
+    void FinishRelocation(VkBuffer handle);
 
     //================================================================================================================
     // NRI
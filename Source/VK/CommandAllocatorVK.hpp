@@ -45,7 +45,12 @@ NRI_INLINE Result CommandAllocatorVK::CreateCommandBuffer(CommandBuffer*& comman
     VkResult result = vk.AllocateCommandBuffers(m_Device, &info, &commandBufferHandle);
     RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vkAllocateCommandBuffers returned %d", (int32_t)result);
 
-    CommandBufferVK* commandBufferImpl = Allocate<CommandBufferVK>(m_Device.GetStdAllocator(), m_Device);
+    CommandBufferVK* commandBufferImpl = m_Device.GetCommandBufferObjectPool().Allocate(m_Device);
+    if (!commandBufferImpl) {
+        vk.FreeCommandBuffers(m_Device, m_Handle, 1, &commandBufferHandle);
+        return Result::OUT_OF_MEMORY;
+    }
+
     commandBufferImpl->Create(m_Handle, commandBufferHandle, m_Type);
 
     commandBuffer = (CommandBuffer*)commandBufferImpl;
@@ -57,4 +62,6 @@ NRI_INLINE void CommandAllocatorVK::Reset() {
     const auto& vk = m_Device.GetDispatchTable();
     VkResult result = vk.ResetCommandPool(m_Device, m_Handle, (VkCommandPoolResetFlags)0);
     RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, ReturnVoid(), "vkResetCommandPool returned %d", (int32_t)result);
+
+    m_Device.OnCommandAllocatorReset();
 }
@@ -2,6 +2,8 @@
 
 #pragma once
 
+struct HelperDataUpload;
+
 namespace nri {
 
 struct DeviceVK;
@@ -11,6 +13,8 @@ struct CommandQueueVK {
         : m_Device(device) {
     }
 
+    ~CommandQueueVK();
+
     inline operator VkQueue() const {
         return m_Handle;
     }
@@ -40,14 +44,17 @@ struct CommandQueueVK {
     void SetDebugName(const char* name);
     void Submit(const QueueSubmitDesc& queueSubmitDesc, const SwapChain* swapChain);
     Result UploadData(const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum);
+    Result DownloadData(const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDownloadDescNum, const BufferDownloadDesc* bufferDownloadDescs, uint32_t bufferDownloadDescNum);
     Result WaitForIdle();
 
 private:
     DeviceVK& m_Device;
+    HelperDataUpload* m_DataUploader = nullptr; // lazily created for the blocking "UploadData"
+    Lock m_DataUploaderLock{"CommandQueueVK::DataUploader"};
     VkQueue m_Handle = VK_NULL_HANDLE;
     uint32_t m_FamilyIndex = INVALID_FAMILY_INDEX;
     CommandQueueType m_Type = CommandQueueType(-1);
-    Lock m_Lock;
+    Lock m_Lock{"CommandQueueVK"};
 };
 
 } // namespace nri
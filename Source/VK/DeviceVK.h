@@ -4,7 +4,11 @@
 
 namespace nri {
 
+struct BufferVK;
+struct CommandBufferVK;
 struct CommandQueueVK;
+struct DescriptorVK;
+struct TextureVK;
 
 struct IsSupported {
     uint32_t descriptorIndexing : 1;
@@ -20,6 +24,19 @@ struct IsSupported {
     uint32_t customBorderColor : 1;
 };
 
+// A resource listed in "DefragmentationDesc", pointed to by the user data of its allocation
+struct DefragmentationResourceVK {
+    BufferVK* buffer;
+    TextureVK* texture;
+    uint32_t index;
+};
+
+struct DefragmentationRelocationVK {
+    DefragmentationResourceVK* resource;
+    uint64_t handle; // the new native object
+    uint64_t size;
+};
+
 struct DeviceVK final : public DeviceBase {
     inline operator VkDevice() const {
         return m_Device;
@@ -57,6 +74,18 @@ struct DeviceVK final : public DeviceBase {
         return m_Vma;
     }
 
+    inline bool IsMemorySubAllocationEnabled() const {
+        return m_IsMemorySubAllocationEnabled;
+    }
+
+    inline ObjectPool<DescriptorVK>& GetDescriptorObjectPool() {
+        return m_DescriptorObjectPool;
+    }
+
+    inline ObjectPool<CommandBufferVK>& GetCommandBufferObjectPool() {
+        return m_CommandBufferObjectPool;
+    }
+
     template <typename Implementation, typename Interface, typename... Args>
     inline Result CreateImplementation(Interface*& entity, const Args&... args) {
         Implementation* impl = Allocate<Implementation>(GetStdAllocator(), *this);
@@ -71,6 +100,26 @@ struct DeviceVK final : public DeviceBase {
         return result;
     }
 
+    // Same as above, but for frequently created and destroyed objects
+    template <typename Implementation, typename Interface, typename... Args>
+    inline Result CreateImplementation(ObjectPool<Implementation>& objectPool, Interface*& entity, const Args&... args) {
+        Implementation* impl = objectPool.Allocate(*this);
+        if (!impl) {
+            entity = nullptr;
+            return Result::OUT_OF_MEMORY;
+        }
+
+        Result result = impl->Create(args...);
+
+        if (result != Result::SUCCESS) {
+            objectPool.Destroy(impl);
+            entity = nullptr;
+        } else
+            entity = (Interface*)impl;
+
+        return result;
+    }
+
     DeviceVK(const CallbackInterface& callbacks, const StdAllocator<uint8_t>& stdAllocator);
     ~DeviceVK();
 
@@ -86,6 +135,10 @@ struct DeviceVK final : public DeviceBase {
     void SetDebugNameToTrivialObject(VkObjectType objectType, uint64_t handle, const char* name);
     Result CreateVma();
     void DestroyVma();
+    Result BeginDefragmentation(const DefragmentationDesc& defragmentationDesc);
+    Result BeginDefragmentationPass(CommandBufferVK& commandBuffer);
+    Result EndDefragmentationPass(DefragmentationReport& defragmentationReport);
+    void EndDefragmentation();
 
     //================================================================================================================
     // DeviceBase
@@ -101,6 +154,7 @@ struct DeviceVK final : public DeviceBase {
     Result FillFunctionTable(LowLatencyInterface& table) const override;
     Result FillFunctionTable(MeshShaderInterface& table) const override;
     Result FillFunctionTable(RayTracingInterface& table) const override;
+    Result FillFunctionTable(ResidencyInterface& table) const override;
     Result FillFunctionTable(StreamerInterface& table) const override;
     Result FillFunctionTable(SwapChainInterface& table) const override;
     Result FillFunctionTable(ResourceAllocatorInterface& table) const override;
@@ -123,6 +177,7 @@ private:
     void FilterInstanceLayers(Vector<const char*>& layers);
     void ProcessInstanceExtensions(Vector<const char*>& desiredInstanceExts);
     void ProcessDeviceExtensions(Vector<const char*>& desiredDeviceExts, bool disableRayTracing);
+    void DiscardDefragmentationPass();
     void FillFamilyIndices(bool isWrapper, const DeviceCreationVKDesc& deviceCreationVKDesc);
     void ReportDeviceGroupInfo();
     void GetAdapterDesc();
@@ -153,11 +208,23 @@ private:
     VkInstance m_Instance = VK_NULL_HANDLE;
     VkAllocationCallbacks* m_AllocationCallbackPtr = nullptr;
     VkDebugUtilsMessengerEXT m_Messenger = VK_NULL_HANDLE;
+    Vector<DefragmentationResourceVK> m_DefragmentationResources;
+    Vector<DefragmentationRelocationVK> m_DefragmentationRelocations; // of the current pass
+    Vector<uint32_t> m_RelocatedBuffers;
+    Vector<uint32_t> m_RelocatedTextures;
+    ObjectPool<DescriptorVK> m_DescriptorObjectPool;
+    ObjectPool<CommandBufferVK> m_CommandBufferObjectPool;
     VmaAllocator_T* m_Vma = nullptr;
+    VmaDefragmentationContext_T* m_VmaDefragmentation = nullptr;
+    VmaDefragmentationMove* m_VmaDefragmentationMoves = nullptr; // owned by VMA, valid until the pass ends
+    uint32_t m_VmaDefragmentationMoveNum = 0;
     uint32_t m_NumActiveFamilyIndices = 0;
     uint32_t m_MinorVersion = 0;
     bool m_OwnsNativeObjects = true;
-    Lock m_Lock;
+    bool m_IsMemorySubAllocationEnabled = false;
+    bool m_IsDefragmentationPassStarted = false;
+    Lock m_Lock{"DeviceVK"};
+    Lock m_VmaLock{"DeviceVK::Vma"};
 };
 
 } // namespace nri
@@ -271,7 +271,13 @@ void DeviceVK::ProcessDeviceExtensions(Vector<const char*>& desiredDeviceExts, b
 }
 
 DeviceVK::DeviceVK(const CallbackInterface& callbacks, const StdAllocator<uint8_t>& stdAllocator)
-    : DeviceBase(callbacks, stdAllocator) {
+    : DeviceBase(callbacks, stdAllocator)
+    , m_DefragmentationResources(GetStdAllocator())
+    , m_DefragmentationRelocations(GetStdAllocator())
+    , m_RelocatedBuffers(GetStdAllocator())
+    , m_RelocatedTextures(GetStdAllocator())
+    , m_DescriptorObjectPool(GetStdAllocator().GetInterface())
+    , m_CommandBufferObjectPool(GetStdAllocator().GetInterface()) {
     m_AllocationCallbacks.pUserData = &GetStdAllocator();
     m_AllocationCallbacks.pfnAllocation = vkAllocateHostMemory;
     m_AllocationCallbacks.pfnReallocation = vkReallocateHostMemory;
@@ -286,11 +292,13 @@ DeviceVK::~DeviceVK() {
     if (m_Device == VK_NULL_HANDLE)
         return;
 
-    DestroyVma();
-
+    // Queues go first, since they own resources (data uploaders)
     for (uint32_t i = 0; i < m_CommandQueues.size(); i++)
         Destroy(GetStdAllocator(), m_CommandQueues[i]);
 
+    EndDefragmentation();
+    DestroyVma();
+
     if (m_Messenger) {
         typedef PFN_vkDestroyDebugUtilsMessengerEXT Func;
         Func destroyCallback = (Func)m_VK.GetInstanceProcAddr(m_Instance, "vkDestroyDebugUtilsMessengerEXT");
@@ -359,6 +367,7 @@ void DeviceVK::GetAdapterDesc() {
 
 Result DeviceVK::Create(const DeviceCreationDesc& deviceCreationDesc, const DeviceCreationVKDesc& deviceCreationVKDesc, bool isWrapper) {
     m_OwnsNativeObjects = !isWrapper;
+    m_IsMemorySubAllocationEnabled = deviceCreationDesc.enableVKMemorySubAllocation;
     m_SPIRVBindingOffsets = isWrapper ? deviceCreationVKDesc.spirvBindingOffsets : deviceCreationDesc.spirvBindingOffsets;
 
     if (!isWrapper && !deviceCreationDesc.disable3rdPartyAllocationCallbacks)
@@ -1788,7 +1797,7 @@ NRI_INLINE Result DeviceVK::BindBufferMemory(const BufferMemoryBindingDesc* memo
         info = {VK_STRUCTURE_TYPE_BIND_BUFFER_MEMORY_INFO};
         info.buffer = bufferImpl.GetHandle();
         info.memory = memoryImpl.GetHandle();
-        info.memoryOffset = memoryBindingDesc.offset;
+        info.memoryOffset = memoryImpl.GetOffset() + memoryBindingDesc.offset;
     }
 
     VkResult result = m_VK.BindBufferMemory2(m_Device, memoryBindingDescNum, infos);
@@ -1800,7 +1809,7 @@ NRI_INLINE Result DeviceVK::BindBufferMemory(const BufferMemoryBindingDesc* memo
         BufferVK& bufferImpl = *(BufferVK*)memoryBindingDesc.buffer;
         MemoryVK& memoryImpl = *(MemoryVK*)memoryBindingDesc.memory;
 
-        bufferImpl.FinishMemoryBinding(memoryImpl, memoryBindingDesc.offset);
+        bufferImpl.FinishMemoryBinding(memoryImpl, memoryImpl.GetOffset() + memoryBindingDesc.offset);
     }
 
     return Result::SUCCESS;
@@ -1826,7 +1835,7 @@ NRI_INLINE Result DeviceVK::BindTextureMemory(const TextureMemoryBindingDesc* me
         info = {VK_STRUCTURE_TYPE_BIND_IMAGE_MEMORY_INFO};
         info.image = textureImpl.GetHandle();
         info.memory = memoryImpl.GetHandle();
-        info.memoryOffset = memoryBindingDesc.offset;
+        info.memoryOffset = memoryImpl.GetOffset() + memoryBindingDesc.offset;
     }
 
     VkResult result = m_VK.BindImageMemory2(m_Device, memoryBindingDescNum, infos);
@@ -19,8 +19,10 @@
 #include "SwapChainVK.h"
 #include "TextureVK.h"
 
+#include "HelperDataDownload.h"
 #include "HelperDataUpload.h"
 #include "HelperDeviceMemoryAllocator.h"
+#include "ResidencyManager.h"
 #include "Streamer.h"
 
 using namespace nri;
@@ -295,6 +297,8 @@ static void NRI_CALL SetDescriptorPoolDebugName(DescriptorPool& descriptorPool,
 }
 
 static Result NRI_CALL AllocateDescriptorSets(DescriptorPool& descriptorPool, const PipelineLayout& pipelineLayout, uint32_t setIndex, DescriptorSet** descriptorSets, uint32_t instanceNum, uint32_t variableDescriptorNum) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     return ((DescriptorPoolVK&)descriptorPool).AllocateDescriptorSets(pipelineLayout, setIndex, descriptorSets, instanceNum, variableDescriptorNum);
 }
 
@@ -375,6 +379,8 @@ static Result NRI_CALL CreateCommandAllocator(const CommandQueue& commandQueue,
 }
 
 static Result NRI_CALL CreateDescriptorPool(Device& device, const DescriptorPoolDesc& descriptorPoolDesc, DescriptorPool*& descriptorPool) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     return ((DeviceVK&)device).CreateImplementation<DescriptorPoolVK>(descriptorPool, descriptorPoolDesc);
 }
 
@@ -387,38 +393,56 @@ static Result NRI_CALL CreateTexture(Device& device, const TextureDesc& textureD
 }
 
 static Result NRI_CALL CreateBufferView(const BufferViewDesc& bufferViewDesc, Descriptor*& bufferView) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     DeviceVK& device = ((const BufferVK*)bufferViewDesc.buffer)->GetDevice();
-    return device.CreateImplementation<DescriptorVK>(bufferView, bufferViewDesc);
+    return device.CreateImplementation(device.GetDescriptorObjectPool(), bufferView, bufferViewDesc);
 }
 
 static Result NRI_CALL CreateTexture1DView(const Texture1DViewDesc& textureViewDesc, Descriptor*& textureView) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     DeviceVK& device = ((const TextureVK*)textureViewDesc.texture)->GetDevice();
-    return device.CreateImplementation<DescriptorVK>(textureView, textureViewDesc);
+    return device.CreateImplementation(device.GetDescriptorObjectPool(), textureView, textureViewDesc);
 }
 
 static Result NRI_CALL CreateTexture2DView(const Texture2DViewDesc& textureViewDesc, Descriptor*& textureView) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     DeviceVK& device = ((const TextureVK*)textureViewDesc.texture)->GetDevice();
-    return device.CreateImplementation<DescriptorVK>(textureView, textureViewDesc);
+    return device.CreateImplementation(device.GetDescriptorObjectPool(), textureView, textureViewDesc);
 }
 
 static Result NRI_CALL CreateTexture3DView(const Texture3DViewDesc& textureViewDesc, Descriptor*& textureView) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     DeviceVK& device = ((const TextureVK*)textureViewDesc.texture)->GetDevice();
-    return device.CreateImplementation<DescriptorVK>(textureView, textureViewDesc);
+    return device.CreateImplementation(device.GetDescriptorObjectPool(), textureView, textureViewDesc);
 }
 
 static Result NRI_CALL CreateSampler(Device& device, const SamplerDesc& samplerDesc, Descriptor*& sampler) {
-    return ((DeviceVK&)device).CreateImplementation<DescriptorVK>(sampler, samplerDesc);
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
+    DeviceVK& deviceVK = (DeviceVK&)device;
+
+    return deviceVK.CreateImplementation(deviceVK.GetDescriptorObjectPool(), sampler, samplerDesc);
 }
 
 static Result NRI_CALL CreatePipelineLayout(Device& device, const PipelineLayoutDesc& pipelineLayoutDesc, PipelineLayout*& pipelineLayout) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::PIPELINE);
+
     return ((DeviceVK&)device).CreateImplementation<PipelineLayoutVK>(pipelineLayout, pipelineLayoutDesc);
 }
 
 static Result NRI_CALL CreateGraphicsPipeline(Device& device, const GraphicsPipelineDesc& graphicsPipelineDesc, Pipeline*& pipeline) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::PIPELINE);
+
     return ((DeviceVK&)device).CreateImplementation<PipelineVK>(pipeline, graphicsPipelineDesc);
 }
 
 static Result NRI_CALL CreateComputePipeline(Device& device, const ComputePipelineDesc& computePipelineDesc, Pipeline*& pipeline) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::PIPELINE);
+
     return ((DeviceVK&)device).CreateImplementation<PipelineVK>(pipeline, computePipelineDesc);
 }
 
@@ -431,7 +455,8 @@ static Result NRI_CALL CreateFence(Device& device, uint64_t initialValue, Fence*
 }
 
 static void NRI_CALL DestroyCommandBuffer(CommandBuffer& commandBuffer) {
-    Destroy((CommandBufferVK*)&commandBuffer);
+    CommandBufferVK& commandBufferVK = (CommandBufferVK&)commandBuffer;
+    commandBufferVK.GetDevice().GetCommandBufferObjectPool().Destroy(&commandBufferVK);
 }
 
 static void NRI_CALL DestroyCommandAllocator(CommandAllocator& commandAllocator) {
@@ -451,7 +476,8 @@ static void NRI_CALL DestroyTexture(Texture& texture) {
 }
 
 static void NRI_CALL DestroyDescriptor(Descriptor& descriptor) {
-    Destroy((DescriptorVK*)&descriptor);
+    DescriptorVK& descriptorVK = (DescriptorVK&)descriptor;
+    descriptorVK.GetDevice().GetDescriptorObjectPool().Destroy(&descriptorVK);
 }
 
 static void NRI_CALL DestroyPipelineLayout(PipelineLayout& pipelineLayout) {
@@ -662,6 +688,33 @@ static Result NRI_CALL UploadData(CommandQueue& commandQueue, const TextureUploa
     return ((CommandQueueVK&)commandQueue).UploadData(textureUploadDescs, textureUploadDescNum, bufferUploadDescs, bufferUploadDescNum);
 }
 
+static Result NRI_CALL DownloadData(CommandQueue& commandQueue, const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDownloadDescNum, const BufferDownloadDesc* bufferDownloadDescs, uint32_t bufferDownloadDescNum) {
+    return ((CommandQueueVK&)commandQueue).DownloadData(textureDownloadDescs, textureDownloadDescNum, bufferDownloadDescs, bufferDownloadDescNum);
+}
+
+static Result NRI_CALL CreateDataUploader(CommandQueue& commandQueue, const DataUploaderDesc& dataUploaderDesc, DataUploader*& dataUploader) {
+    DeviceVK& device = ((CommandQueueVK&)commandQueue).GetDevice();
+    HelperDataUpload* impl = Allocate<HelperDataUpload>(device.GetStdAllocator(), device.GetCoreInterface(), (Device&)device, commandQueue, dataUploaderDesc);
+    Result result = impl->Create();
+
+    if (result != Result::SUCCESS) {
+        Destroy(device.GetStdAllocator(), impl);
+        dataUploader = nullptr;
+    } else
+        dataUploader = (DataUploader*)impl;
+
+    return result;
+}
+
+static void NRI_CALL DestroyDataUploader(DataUploader& dataUploader) {
+    Destroy(((DeviceBase&)((HelperDataUpload&)dataUploader).GetDevice()).GetStdAllocator(), (HelperDataUpload*)&dataUploader);
+}
+
+static Result NRI_CALL UploadDataAsync(DataUploader& dataUploader, const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs,
+    uint32_t bufferUploadDescNum, UploadTicket& uploadTicket) {
+    return ((HelperDataUpload&)dataUploader).UploadDataAsync(textureUploadDescs, textureUploadDescNum, bufferUploadDescs, bufferUploadDescNum, uploadTicket);
+}
+
 static Result NRI_CALL WaitForIdle(CommandQueue& commandQueue) {
     if (!(&commandQueue))
         return Result::SUCCESS;
@@ -687,12 +740,31 @@ static Result NRI_CALL QueryVideoMemoryInfo(const Device& device, MemoryLocation
     return ((DeviceVK&)device).QueryVideoMemoryInfo(memoryLocation, videoMemoryInfo);
 }
 
+static void NRI_CALL GetScratchMemoryStatistics(const Device& device, ScratchMemoryStatistics& scratchMemoryStatistics) {
+    ((DeviceVK&)device).GetScratchMemoryStatistics(scratchMemoryStatistics);
+}
+
+static Result NRI_CALL GetAllocationStatistics(const Device& device, AllocationCategory allocationCategory, AllocationStatistics& allocationStatistics) {
+    return ((DeviceVK&)device).GetAllocationStatistics(allocationCategory, allocationStatistics);
+}
+
+static Result NRI_CALL GetCommandStatistics(const Device&, CommandStatistics&, PipelineCommandStatistics*, uint32_t&) {
+    return Result::UNSUPPORTED;
+}
+
 Result DeviceVK::FillFunctionTable(HelperInterface& table) const {
     table.CalculateAllocationNumber = ::CalculateAllocationNumber;
     table.AllocateAndBindMemory = ::AllocateAndBindMemory;
     table.UploadData = ::UploadData;
+    table.DownloadData = ::DownloadData;
+    table.CreateDataUploader = ::CreateDataUploader;
+    table.DestroyDataUploader = ::DestroyDataUploader;
+    table.UploadDataAsync = ::UploadDataAsync;
     table.WaitForIdle = ::WaitForIdle;
     table.QueryVideoMemoryInfo = ::QueryVideoMemoryInfo;
+    table.GetScratchMemoryStatistics = ::GetScratchMemoryStatistics;
+    table.GetAllocationStatistics = ::GetAllocationStatistics;
+    table.GetCommandStatistics = ::GetCommandStatistics;
 
     return Result::SUCCESS;
 }
@@ -781,6 +853,8 @@ static void NRI_CALL SetAccelerationStructureDebugName(AccelerationStructure& ac
 }
 
 static Result NRI_CALL CreateAccelerationStructureDescriptor(const AccelerationStructure& accelerationStructure, Descriptor*& descriptor) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     return ((AccelerationStructureVK&)accelerationStructure).CreateDescriptor(descriptor);
 }
 
@@ -825,6 +899,8 @@ static void NRI_CALL GetAccelerationStructureMemoryDesc(const Device& device, co
 }
 
 static Result NRI_CALL CreateRayTracingPipeline(Device& device, const RayTracingPipelineDesc& pipelineDesc, Pipeline*& pipeline) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::PIPELINE);
+
     return ((DeviceVK&)device).CreateImplementation<PipelineVK>(pipeline, pipelineDesc);
 }
 
@@ -874,6 +950,61 @@ Result DeviceVK::FillFunctionTable(RayTracingInterface& table) const {
 
 #pragma endregion
 
+//============================================================================================================================================================================================
+#pragma region[  Residency  ]
+
+static Result CreateResidencyManager(Device& device, const ResidencyManagerDesc& residencyManagerDesc, ResidencyManager*& residencyManager) {
+    DeviceVK& deviceVK = (DeviceVK&)device;
+    ResidencyManagerImpl* impl = Allocate<ResidencyManagerImpl>(deviceVK.GetStdAllocator(), device);
+    Result result = impl->Create(residencyManagerDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceVK.GetStdAllocator(), impl);
+        residencyManager = nullptr;
+    } else
+        residencyManager = (ResidencyManager*)impl;
+
+    return result;
+}
+
+static void DestroyResidencyManager(ResidencyManager& residencyManager) {
+    Destroy(((DeviceBase&)((ResidencyManagerImpl&)residencyManager).GetDevice()).GetStdAllocator(), (ResidencyManagerImpl*)&residencyManager);
+}
+
+static uint32_t RegisterResidencyResource(ResidencyManager& residencyManager, const ResidencyResourceDesc& residencyResourceDesc) {
+    return ((ResidencyManagerImpl&)residencyManager).RegisterResidencyResource(residencyResourceDesc);
+}
+
+static void UnregisterResidencyResource(ResidencyManager& residencyManager, uint32_t id) {
+    ((ResidencyManagerImpl&)residencyManager).UnregisterResidencyResource(id);
+}
+
+static void MarkResidencyResourceUsed(ResidencyManager& residencyManager, uint32_t id) {
+    ((ResidencyManagerImpl&)residencyManager).MarkResidencyResourceUsed(id);
+}
+
+static Result UpdateResidency(ResidencyManager& residencyManager) {
+    return ((ResidencyManagerImpl&)residencyManager).UpdateResidency();
+}
+
+static void GetResidencyStatistics(const ResidencyManager& residencyManager, ResidencyStatistics& residencyStatistics) {
+    ((const ResidencyManagerImpl&)residencyManager).GetResidencyStatistics(residencyStatistics);
+}
+
+Result DeviceVK::FillFunctionTable(ResidencyInterface& table) const {
+    table.CreateResidencyManager = ::CreateResidencyManager;
+    table.DestroyResidencyManager = ::DestroyResidencyManager;
+    table.RegisterResidencyResource = ::RegisterResidencyResource;
+    table.UnregisterResidencyResource = ::UnregisterResidencyResource;
+    table.MarkResidencyResourceUsed = ::MarkResidencyResourceUsed;
+    table.UpdateResidency = ::UpdateResidency;
+    table.GetResidencyStatistics = ::GetResidencyStatistics;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
 //============================================================================================================================================================================================
 #pragma region[  ResourceAllocator  ]
 
@@ -889,10 +1020,30 @@ static Result AllocateAccelerationStructure(Device& device, const AllocateAccele
     return ((DeviceVK&)device).CreateImplementation<AccelerationStructureVK>(accelerationStructure, accelerationStructureDesc);
 }
 
+static Result BeginDefragmentation(Device& device, const DefragmentationDesc& defragmentationDesc) {
+    return ((DeviceVK&)device).BeginDefragmentation(defragmentationDesc);
+}
+
+static Result BeginDefragmentationPass(Device& device, CommandBuffer& commandBuffer) {
+    return ((DeviceVK&)device).BeginDefragmentationPass((CommandBufferVK&)commandBuffer);
+}
+
+static Result EndDefragmentationPass(Device& device, DefragmentationReport& defragmentationReport) {
+    return ((DeviceVK&)device).EndDefragmentationPass(defragmentationReport);
+}
+
+static void EndDefragmentation(Device& device) {
+    ((DeviceVK&)device).EndDefragmentation();
+}
+
 Result DeviceVK::FillFunctionTable(ResourceAllocatorInterface& table) const {
     table.AllocateBuffer = ::AllocateBuffer;
     table.AllocateTexture = ::AllocateTexture;
     table.AllocateAccelerationStructure = ::AllocateAccelerationStructure;
+    table.BeginDefragmentation = ::BeginDefragmentation;
+    table.BeginDefragmentationPass = ::BeginDefragmentationPass;
+    table.EndDefragmentationPass = ::EndDefragmentationPass;
+    table.EndDefragmentation = ::EndDefragmentation;
 
     return Result::SUCCESS;
 }
@@ -936,6 +1087,26 @@ static uint64_t AddStreamerTextureUpdateRequest(Streamer& streamer, const Textur
     return ((StreamerImpl&)streamer).AddStreamerTextureUpdateRequest(textureUpdateRequestDesc);
 }
 
+static Result QueueStreamerBufferUpdateRequest(Streamer& streamer, const BufferUpdateRequestDesc& bufferUpdateRequestDesc, uint64_t& requestId) {
+    return ((StreamerImpl&)streamer).QueueStreamerBufferUpdateRequest(bufferUpdateRequestDesc, requestId);
+}
+
+static Result QueueStreamerTextureUpdateRequest(Streamer& streamer, const TextureUpdateRequestDesc& textureUpdateRequestDesc, uint64_t& requestId) {
+    return ((StreamerImpl&)streamer).QueueStreamerTextureUpdateRequest(textureUpdateRequestDesc, requestId);
+}
+
+static void* ReserveStreamerBufferUpdate(Streamer& streamer, const BufferUpdateRequestDesc& bufferUpdateRequestDesc, uint64_t& offset) {
+    return ((StreamerImpl&)streamer).ReserveStreamerBufferUpdate(bufferUpdateRequestDesc, offset);
+}
+
+static Result AddStreamerReadbackRequest(Streamer& streamer, const ReadbackRequestDesc& readbackRequestDesc) {
+    return ((StreamerImpl&)streamer).AddStreamerReadbackRequest(readbackRequestDesc);
+}
+
+static bool IsStreamerRequestComplete(const Streamer& streamer, uint64_t requestId) {
+    return ((StreamerImpl&)streamer).IsStreamerRequestComplete(requestId);
+}
+
 static Result CopyStreamerUpdateRequests(Streamer& streamer) {
     return ((StreamerImpl&)streamer).CopyStreamerUpdateRequests();
 }
@@ -948,6 +1119,10 @@ static void CmdUploadStreamerUpdateRequests(CommandBuffer& commandBuffer, Stream
     ((StreamerImpl&)streamer).CmdUploadStreamerUpdateRequests(commandBuffer);
 }
 
+static void GetStreamerStatistics(const Streamer& streamer, StreamerStatistics& streamerStatistics) {
+    ((StreamerImpl&)streamer).GetStatistics(streamerStatistics);
+}
+
 Result DeviceVK::FillFunctionTable(StreamerInterface& table) const {
     table.CreateStreamer = ::CreateStreamer;
     table.DestroyStreamer = ::DestroyStreamer;
@@ -955,9 +1130,15 @@ Result DeviceVK::FillFunctionTable(StreamerInterface& table) const {
     table.GetStreamerDynamicBuffer = ::GetStreamerDynamicBuffer;
     table.AddStreamerBufferUpdateRequest = ::AddStreamerBufferUpdateRequest;
     table.AddStreamerTextureUpdateRequest = ::AddStreamerTextureUpdateRequest;
+    table.QueueStreamerBufferUpdateRequest = ::QueueStreamerBufferUpdateRequest;
+    table.QueueStreamerTextureUpdateRequest = ::QueueStreamerTextureUpdateRequest;
+    table.ReserveStreamerBufferUpdate = ::ReserveStreamerBufferUpdate;
+    table.AddStreamerReadbackRequest = ::AddStreamerReadbackRequest;
+    table.IsStreamerRequestComplete = ::IsStreamerRequestComplete;
     table.UpdateStreamerConstantBuffer = ::UpdateStreamerConstantBuffer;
     table.CopyStreamerUpdateRequests = ::CopyStreamerUpdateRequests;
     table.CmdUploadStreamerUpdateRequests = ::CmdUploadStreamerUpdateRequests;
+    table.GetStreamerStatistics = ::GetStreamerStatistics;
 
     return Result::SUCCESS;
 }
@@ -1029,10 +1210,14 @@ static Result NRI_CALL CreateCommandAllocatorVK(Device& device, const CommandAll
 }
 
 static Result NRI_CALL CreateCommandBufferVK(Device& device, const CommandBufferVKDesc& commandBufferDesc, CommandBuffer*& commandBuffer) {
-    return ((DeviceVK&)device).CreateImplementation<CommandBufferVK>(commandBuffer, commandBufferDesc);
+    DeviceVK& deviceVK = (DeviceVK&)device;
+
+    return deviceVK.CreateImplementation(deviceVK.GetCommandBufferObjectPool(), commandBuffer, commandBufferDesc);
 }
 
 static Result NRI_CALL CreateDescriptorPoolVK(Device& device, const DescriptorPoolVKDesc& descriptorPoolDesc, DescriptorPool*& descriptorPool) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::DESCRIPTOR);
+
     return ((DeviceVK&)device).CreateImplementation<DescriptorPoolVK>(descriptorPool, descriptorPoolDesc);
 }
 
@@ -1049,10 +1234,14 @@ static Result NRI_CALL CreateMemoryVK(Device& device, const MemoryVKDesc& memory
 }
 
 static Result NRI_CALL CreateGraphicsPipelineVK(Device& device, VKNonDispatchableHandle vkPipeline, Pipeline*& pipeline) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::PIPELINE);
+
     return ((DeviceVK&)device).CreateImplementation<PipelineVK>(pipeline, VK_PIPELINE_BIND_POINT_GRAPHICS, vkPipeline);
 }
 
 static Result NRI_CALL CreateComputePipelineVK(Device& device, VKNonDispatchableHandle vkPipeline, Pipeline*& pipeline) {
+    AllocationCategoryScope allocationCategoryScope(AllocationCategory::PIPELINE);
+
     return ((DeviceVK&)device).CreateImplementation<PipelineVK>(pipeline, VK_PIPELINE_BIND_POINT_COMPUTE, vkPipeline);
 }
 
@@ -31,12 +31,18 @@ struct MemoryVK {
         return m_MappedMemory;
     }
 
+    inline uint64_t GetOffset() const {
+        return m_Offset;
+    }
+
     ~MemoryVK();
 
     Result Create(const MemoryVKDesc& memoryDesc);
     Result Create(const AllocateMemoryDesc& allocateMemoryDesc);
     Result CreateDedicated(const BufferVK& buffer);
     Result CreateDedicated(const TextureVK& texture);
+    Result CreateVma(const AllocateMemoryDesc& allocateMemoryDesc);
+    void DestroyVma();
 
     //================================================================================================================
     // NRI
@@ -47,7 +53,9 @@ struct MemoryVK {
 private:
     DeviceVK& m_Device;
     VkDeviceMemory m_Handle = VK_NULL_HANDLE;
-    uint8_t* m_MappedMemory = nullptr;
+    VmaAllocation_T* m_VmaAllocation = nullptr;
+    uint8_t* m_MappedMemory = nullptr; // points to the beginning of "m_Handle"
+    uint64_t m_Offset = 0; // in "m_Handle", if sub-allocated
     MemoryType m_Type = std::numeric_limits<MemoryType>::max();
     float m_Priority = 0.0f;
     bool m_OwnsNativeObjects = true;
@@ -1,7 +1,12 @@
 // © 2021 NVIDIA Corporation
 
+constexpr uint64_t SUB_ALLOCATION_SIZE_MAX = VMA_PREFERRED_BLOCK_SIZE / 16;
+constexpr uint64_t SUB_ALLOCATION_ALIGNMENT_DEFAULT = 64 * 1024; // if "AllocateMemoryDesc::alignment" is not provided
+
 MemoryVK::~MemoryVK() {
-    if (m_OwnsNativeObjects) {
+    if (m_VmaAllocation)
+        DestroyVma();
+    else if (m_OwnsNativeObjects) {
         const auto& vk = m_Device.GetDispatchTable();
         vk.FreeMemory(m_Device, m_Handle, m_Device.GetAllocationCallbacks());
     }
@@ -38,6 +43,9 @@ Result MemoryVK::Create(const AllocateMemoryDesc& allocateMemoryDesc) {
     if (memoryTypeInfo.mustBeDedicated)
         return Result::SUCCESS; // dedicated allocation occurs on memory binding
 
+    if (m_Device.IsMemorySubAllocationEnabled() && allocateMemoryDesc.size <= SUB_ALLOCATION_SIZE_MAX)
+        return CreateVma(allocateMemoryDesc);
+
     VkMemoryPriorityAllocateInfoEXT priorityInfo = {VK_STRUCTURE_TYPE_MEMORY_PRIORITY_ALLOCATE_INFO_EXT};
     priorityInfo.priority = m_Priority;
 
@@ -133,5 +141,7 @@ Result MemoryVK::CreateDedicated(const TextureVK& texture) {
 }
 
 NRI_INLINE void MemoryVK::SetDebugName(const char* name) {
-    m_Device.SetDebugNameToTrivialObject(VK_OBJECT_TYPE_DEVICE_MEMORY, (uint64_t)m_Handle, name);
+    // A sub-allocation doesn't own the memory block
+    if (!m_VmaAllocation)
+        m_Device.SetDebugNameToTrivialObject(VK_OBJECT_TYPE_DEVICE_MEMORY, (uint64_t)m_Handle, name);
 }
@@ -6,6 +6,8 @@
 #include "memalloc/vk_mem_alloc.h"
 
 Result DeviceVK::CreateVma() {
+    ExclusiveScope lock(m_VmaLock); // lazy creation can be triggered by concurrent "Allocate*" calls
+
     if (m_Vma)
         return Result::SUCCESS;
 
@@ -157,6 +159,352 @@ Result AccelerationStructureVK::Create(const AllocateAccelerationStructureDesc&
     return result;
 }
 
+Result MemoryVK::CreateVma(const AllocateMemoryDesc& allocateMemoryDesc) {
+    Result nriResult = m_Device.CreateVma();
+    if (nriResult != Result::SUCCESS)
+        return nriResult;
+
+    MemoryTypeInfo memoryTypeInfo = Unpack(allocateMemoryDesc.type);
+
+    // Resources get bound at offsets relative to the memory object, which can't know their alignments unless told
+    VkMemoryRequirements memoryRequirements = {};
+    memoryRequirements.size = allocateMemoryDesc.size;
+    memoryRequirements.alignment = allocateMemoryDesc.alignment ? allocateMemoryDesc.alignment : SUB_ALLOCATION_ALIGNMENT_DEFAULT;
+    memoryRequirements.memoryTypeBits = 1u << memoryTypeInfo.index;
+
+    VmaAllocationCreateInfo allocationCreateInfo = {};
+    allocationCreateInfo.flags = VMA_ALLOCATION_CREATE_CAN_ALIAS_BIT;
+    allocationCreateInfo.priority = m_Priority;
+
+    if (IsHostVisibleMemory(memoryTypeInfo.location))
+        allocationCreateInfo.flags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VmaAllocationInfo allocationInfo = {};
+    VkResult result = vmaAllocateMemory(m_Device.GetVma(), &memoryRequirements, &allocationCreateInfo, &m_VmaAllocation, &allocationInfo);
+    RETURN_ON_FAILURE(&m_Device, result == VK_SUCCESS, GetReturnCode(result), "vmaAllocateMemory returned %d", (int32_t)result);
+
+    m_Handle = allocationInfo.deviceMemory;
+    m_Offset = allocationInfo.offset;
+
+    if (allocationInfo.pMappedData)
+        m_MappedMemory = (uint8_t*)allocationInfo.pMappedData - allocationInfo.offset;
+
+    return Result::SUCCESS;
+}
+
+Result DeviceVK::BeginDefragmentation(const DefragmentationDesc& defragmentationDesc) {
+    RETURN_ON_FAILURE(this, !m_VmaDefragmentation, Result::FAILURE, "Defragmentation is already in progress");
+
+    Result nriResult = CreateVma();
+    if (nriResult != Result::SUCCESS)
+        return nriResult;
+
+    // Only listed resources can be relocated (acceleration structures reference their storage buffers, so they can't)
+    m_DefragmentationResources.clear();
+    m_DefragmentationResources.reserve(defragmentationDesc.bufferNum + defragmentationDesc.textureNum);
+
+    for (uint32_t i = 0; i < defragmentationDesc.bufferNum; i++) {
+        BufferVK* buffer = (BufferVK*)defragmentationDesc.buffers[i];
+        if (buffer->GetVmaAllocation() && !(buffer->GetDesc().usage & BufferUsageBits::ACCELERATION_STRUCTURE_STORAGE))
+            m_DefragmentationResources.push_back({buffer, nullptr, i});
+    }
+
+    for (uint32_t i = 0; i < defragmentationDesc.textureNum; i++) {
+        TextureVK* texture = (TextureVK*)defragmentationDesc.textures[i];
+        if (texture->GetVmaAllocation())
+            m_DefragmentationResources.push_back({nullptr, texture, i});
+    }
+
+    // Allocations without user data get ignored in passes
+    for (DefragmentationResourceVK& resource : m_DefragmentationResources) {
+        VmaAllocation allocation = resource.buffer ? resource.buffer->GetVmaAllocation() : resource.texture->GetVmaAllocation();
+        vmaSetAllocationUserData(m_Vma, allocation, &resource);
+    }
+
+    VmaDefragmentationInfo defragmentationInfo = {};
+    defragmentationInfo.flags = VMA_DEFRAGMENTATION_FLAG_ALGORITHM_BALANCED_BIT;
+    defragmentationInfo.maxBytesPerPass = defragmentationDesc.maxBytesPerPass;
+    defragmentationInfo.maxAllocationsPerPass = defragmentationDesc.maxAllocationsPerPass;
+
+    VkResult result = vmaBeginDefragmentation(m_Vma, &defragmentationInfo, &m_VmaDefragmentation);
+    if (result != VK_SUCCESS) {
+        EndDefragmentation();
+        RETURN_ON_FAILURE(this, false, GetReturnCode(result), "vmaBeginDefragmentation returned %d", (int32_t)result);
+    }
+
+    return Result::SUCCESS;
+}
+
+Result DeviceVK::BeginDefragmentationPass(CommandBufferVK& commandBuffer) {
+    RETURN_ON_FAILURE(this, m_VmaDefragmentation, Result::FAILURE, "'BeginDefragmentation' has not been called");
+    RETURN_ON_FAILURE(this, !m_IsDefragmentationPassStarted, Result::FAILURE, "'EndDefragmentationPass' has not been called");
+
+    VmaDefragmentationPassMoveInfo passInfo = {};
+    VkResult result = vmaBeginDefragmentationPass(m_Vma, m_VmaDefragmentation, &passInfo);
+    RETURN_ON_FAILURE(this, result == VK_SUCCESS || result == VK_INCOMPLETE, GetReturnCode(result), "vmaBeginDefragmentationPass returned %d", (int32_t)result);
+
+    m_IsDefragmentationPassStarted = true;
+    m_VmaDefragmentationMoves = result == VK_INCOMPLETE ? passInfo.pMoves : nullptr; // "VK_SUCCESS" means "nothing to move"
+    m_VmaDefragmentationMoveNum = result == VK_INCOMPLETE ? passInfo.moveCount : 0;
+    m_DefragmentationRelocations.clear();
+
+    // Recreate resources at new places (a move is committed only if a copy gets recorded)
+    for (uint32_t i = 0; i < m_VmaDefragmentationMoveNum; i++)
+        m_VmaDefragmentationMoves[i].operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+
+    const auto& vk = GetDispatchTable();
+    uint32_t textureNum = 0;
+    Mip_t mipNumMax = 0;
+
+    for (uint32_t i = 0; i < m_VmaDefragmentationMoveNum; i++) {
+        VmaDefragmentationMove& move = m_VmaDefragmentationMoves[i];
+
+        VmaAllocationInfo allocationInfo = {};
+        vmaGetAllocationInfo(m_Vma, move.srcAllocation, &allocationInfo);
+
+        DefragmentationResourceVK* resource = (DefragmentationResourceVK*)allocationInfo.pUserData;
+        if (!resource)
+            continue;
+
+        uint64_t handle = 0;
+        if (resource->buffer) {
+            VkBufferCreateInfo bufferCreateInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+            FillCreateInfo(resource->buffer->GetDesc(), bufferCreateInfo);
+
+            VkBuffer buffer = VK_NULL_HANDLE;
+            result = vk.CreateBuffer(m_Device, &bufferCreateInfo, m_AllocationCallbackPtr, &buffer);
+            if (result == VK_SUCCESS) {
+                result = vmaBindBufferMemory(m_Vma, move.dstTmpAllocation, buffer);
+                if (result != VK_SUCCESS)
+                    vk.DestroyBuffer(m_Device, buffer, m_AllocationCallbackPtr);
+            }
+
+            if (result != VK_SUCCESS) {
+                DiscardDefragmentationPass();
+                RETURN_ON_FAILURE(this, false, GetReturnCode(result), "Buffer relocation failed, result = %d", (int32_t)result);
+            }
+
+            handle = (uint64_t)buffer;
+        } else {
+            VkImageCreateInfo imageCreateInfo = {VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+            FillCreateInfo(resource->texture->GetDesc(), imageCreateInfo);
+
+            VkImage image = VK_NULL_HANDLE;
+            result = vk.CreateImage(m_Device, &imageCreateInfo, m_AllocationCallbackPtr, &image);
+            if (result == VK_SUCCESS) {
+                result = vmaBindImageMemory(m_Vma, move.dstTmpAllocation, image);
+                if (result != VK_SUCCESS)
+                    vk.DestroyImage(m_Device, image, m_AllocationCallbackPtr);
+            }
+
+            if (result != VK_SUCCESS) {
+                DiscardDefragmentationPass();
+                RETURN_ON_FAILURE(this, false, GetReturnCode(result), "Texture relocation failed, result = %d", (int32_t)result);
+            }
+
+            handle = (uint64_t)image;
+            mipNumMax = std::max(mipNumMax, resource->texture->GetDesc().mipNum);
+            textureNum++;
+        }
+
+        move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_COPY;
+        m_DefragmentationRelocations.push_back({resource, handle, allocationInfo.size});
+    }
+
+    if (m_DefragmentationRelocations.empty())
+        return Result::SUCCESS;
+
+    // Barriers before
+    VkMemoryBarrier2 memoryBarrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+    memoryBarrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    memoryBarrier.srcAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT;
+    memoryBarrier.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+
+    Scratch<VkImageMemoryBarrier2> textureBarriers = AllocateScratch(*this, VkImageMemoryBarrier2, textureNum * 2);
+    uint32_t textureBarrierNum = 0;
+
+    for (const DefragmentationRelocationVK& relocation : m_DefragmentationRelocations) {
+        const TextureVK* texture = relocation.resource->texture;
+        if (!texture)
+            continue;
+
+        VkImageMemoryBarrier2 barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2};
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.subresourceRange = {texture->GetImageAspectFlags(), 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS};
+
+        VkImageMemoryBarrier2& src = textureBarriers[textureBarrierNum++];
+        src = barrier;
+        src.srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        src.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+        src.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+        src.oldLayout = GetImageLayout(Layout::SHADER_RESOURCE);
+        src.newLayout = IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        src.image = texture->GetHandle();
+
+        VkImageMemoryBarrier2& dst = textureBarriers[textureBarrierNum++];
+        dst = barrier;
+        dst.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+        dst.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        dst.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        dst.newLayout = IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        dst.image = (VkImage)relocation.handle;
+    }
+
+    VkDependencyInfo dependencyInfo = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+    dependencyInfo.memoryBarrierCount = 1;
+    dependencyInfo.pMemoryBarriers = &memoryBarrier;
+    dependencyInfo.imageMemoryBarrierCount = textureBarrierNum;
+    dependencyInfo.pImageMemoryBarriers = textureBarriers;
+
+    vk.CmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+    // Copies
+    Scratch<VkImageCopy> regions = AllocateScratch(*this, VkImageCopy, mipNumMax);
+
+    for (const DefragmentationRelocationVK& relocation : m_DefragmentationRelocations) {
+        if (relocation.resource->buffer) {
+            const BufferVK& buffer = *relocation.resource->buffer;
+            const VkBufferCopy region = {0, 0, buffer.GetDesc().size};
+
+            vk.CmdCopyBuffer(commandBuffer, buffer.GetHandle(), (VkBuffer)relocation.handle, 1, &region);
+        } else {
+            const TextureVK& texture = *relocation.resource->texture;
+            const TextureDesc& textureDesc = texture.GetDesc();
+
+            for (Mip_t i = 0; i < textureDesc.mipNum; i++) {
+                regions[i].srcSubresource = {texture.GetImageAspectFlags(), i, 0, textureDesc.layerNum};
+                regions[i].dstSubresource = regions[i].srcSubresource;
+                regions[i].srcOffset = {};
+                regions[i].dstOffset = {};
+                regions[i].extent = {texture.GetSize(0, i), texture.GetSize(1, i), texture.GetSize(2, i)};
+            }
+
+            vk.CmdCopyImage(commandBuffer, texture.GetHandle(), IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, (VkImage)relocation.handle, IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, textureDesc.mipNum, regions);
+        }
+    }
+
+    // Barriers after (new textures return to "SHADER_RESOURCE")
+    memoryBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    memoryBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    memoryBarrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+    textureBarrierNum = 0;
+    for (uint32_t i = 1; i < textureNum * 2; i += 2) {
+        VkImageMemoryBarrier2& barrier = textureBarriers[textureBarrierNum++];
+        barrier = textureBarriers[i];
+        barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+        barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+        barrier.oldLayout = IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = GetImageLayout(Layout::SHADER_RESOURCE);
+    }
+
+    dependencyInfo.imageMemoryBarrierCount = textureBarrierNum;
+
+    vk.CmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+    return Result::SUCCESS;
+}
+
+Result DeviceVK::EndDefragmentationPass(DefragmentationReport& defragmentationReport) {
+    defragmentationReport = {};
+
+    RETURN_ON_FAILURE(this, m_IsDefragmentationPassStarted, Result::FAILURE, "'BeginDefragmentationPass' has not been called");
+
+    m_IsDefragmentationPassStarted = false;
+    m_RelocatedBuffers.clear();
+    m_RelocatedTextures.clear();
+
+    if (!m_VmaDefragmentationMoves) {
+        defragmentationReport.isFinished = true;
+        return Result::SUCCESS;
+    }
+
+    // Commit moves
+    VmaDefragmentationPassMoveInfo passInfo = {};
+    passInfo.moveCount = m_VmaDefragmentationMoveNum;
+    passInfo.pMoves = m_VmaDefragmentationMoves;
+
+    VkResult result = vmaEndDefragmentationPass(m_Vma, m_VmaDefragmentation, &passInfo);
+
+    m_VmaDefragmentationMoves = nullptr;
+    m_VmaDefragmentationMoveNum = 0;
+
+    // Replace native objects, allocations point to new places now
+    for (const DefragmentationRelocationVK& relocation : m_DefragmentationRelocations) {
+        DefragmentationResourceVK& resource = *relocation.resource;
+        if (resource.buffer) {
+            resource.buffer->FinishRelocation((VkBuffer)relocation.handle);
+            m_RelocatedBuffers.push_back(resource.index);
+        } else {
+            resource.texture->FinishRelocation((VkImage)relocation.handle);
+            m_RelocatedTextures.push_back(resource.index);
+        }
+
+        defragmentationReport.movedSize += relocation.size;
+    }
+
+    m_DefragmentationRelocations.clear();
+
+    defragmentationReport.relocatedBuffers = m_RelocatedBuffers.data();
+    defragmentationReport.relocatedTextures = m_RelocatedTextures.data();
+    defragmentationReport.relocatedBufferNum = (uint32_t)m_RelocatedBuffers.size();
+    defragmentationReport.relocatedTextureNum = (uint32_t)m_RelocatedTextures.size();
+    defragmentationReport.isFinished = result == VK_SUCCESS;
+
+    RETURN_ON_FAILURE(this, result == VK_SUCCESS || result == VK_INCOMPLETE, GetReturnCode(result), "vmaEndDefragmentationPass returned %d", (int32_t)result);
+
+    return Result::SUCCESS;
+}
+
+void DeviceVK::DiscardDefragmentationPass() {
+    const auto& vk = GetDispatchTable();
+    for (const DefragmentationRelocationVK& relocation : m_DefragmentationRelocations) {
+        if (relocation.resource->buffer)
+            vk.DestroyBuffer(m_Device, (VkBuffer)relocation.handle, m_AllocationCallbackPtr);
+        else
+            vk.DestroyImage(m_Device, (VkImage)relocation.handle, m_AllocationCallbackPtr);
+    }
+
+    for (uint32_t i = 0; i < m_VmaDefragmentationMoveNum; i++)
+        m_VmaDefragmentationMoves[i].operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+
+    m_DefragmentationRelocations.clear();
+}
+
+void DeviceVK::EndDefragmentation() {
+    if (m_VmaDefragmentation) {
+        // An unfinished pass gets discarded
+        if (m_VmaDefragmentationMoves) {
+            DiscardDefragmentationPass();
+
+            VmaDefragmentationPassMoveInfo passInfo = {};
+            passInfo.moveCount = m_VmaDefragmentationMoveNum;
+            passInfo.pMoves = m_VmaDefragmentationMoves;
+
+            vmaEndDefragmentationPass(m_Vma, m_VmaDefragmentation, &passInfo);
+        }
+
+        vmaEndDefragmentation(m_Vma, m_VmaDefragmentation, nullptr);
+    }
+
+    for (DefragmentationResourceVK& resource : m_DefragmentationResources) {
+        VmaAllocation allocation = resource.buffer ? resource.buffer->GetVmaAllocation() : resource.texture->GetVmaAllocation();
+        vmaSetAllocationUserData(m_Vma, allocation, nullptr);
+    }
+
+    m_DefragmentationResources.clear();
+    m_DefragmentationRelocations.clear();
+    m_VmaDefragmentation = nullptr;
+    m_VmaDefragmentationMoves = nullptr;
+    m_VmaDefragmentationMoveNum = 0;
+    m_IsDefragmentationPassStarted = false;
+}
+
 void DeviceVK::DestroyVma() {
     if (m_Vma)
         vmaDestroyAllocator(m_Vma);
@@ -171,3 +519,42 @@ void TextureVK::DestroyVma() {
     CHECK(m_VmaAllocation, "Not a VMA allocation");
     vmaDestroyImage(m_Device.GetVma(), m_Handle, m_VmaAllocation);
 }
+
+void MemoryVK::DestroyVma() {
+    CHECK(m_VmaAllocation, "Not a VMA allocation");
+    vmaFreeMemory(m_Device.GetVma(), m_VmaAllocation);
+}
+
+void BufferVK::FinishRelocation(VkBuffer handle) {
+    const auto& vk = m_Device.GetDispatchTable();
+    vk.DestroyBuffer(m_Device, m_Handle, m_Device.GetAllocationCallbacks());
+
+    m_Handle = handle;
+
+    // Mapped memory
+    if (m_MappedMemory) {
+        VmaAllocationInfo allocationInfo = {};
+        vmaGetAllocationInfo(m_Device.GetVma(), m_VmaAllocation, &allocationInfo);
+
+        m_MappedMemory = (uint8_t*)allocationInfo.pMappedData - allocationInfo.offset;
+        m_MappedMemoryOffset = allocationInfo.offset;
+
+        if (m_NonCoherentDeviceMemory)
+            m_NonCoherentDeviceMemory = allocationInfo.deviceMemory;
+    }
+
+    // Device address
+    if (m_Device.m_IsSupported.deviceAddress) {
+        VkBufferDeviceAddressInfo bufferDeviceAddressInfo = {VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO};
+        bufferDeviceAddressInfo.buffer = m_Handle;
+
+        m_DeviceAddress = vk.GetBufferDeviceAddress(m_Device, &bufferDeviceAddressInfo);
+    }
+}
+
+void TextureVK::FinishRelocation(VkImage handle) {
+    const auto& vk = m_Device.GetDispatchTable();
+    vk.DestroyImage(m_Device, m_Handle, m_Device.GetAllocationCallbacks());
+
+    m_Handle = handle;
+}
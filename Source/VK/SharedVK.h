@@ -54,5 +54,7 @@ constexpr uint32_t INVALID_FAMILY_INDEX = uint32_t(-1);
 
 struct VmaAllocator_T;
 struct VmaAllocation_T;
+struct VmaDefragmentationContext_T;
+struct VmaDefragmentationMove;
 
 #include "DeviceVK.h"
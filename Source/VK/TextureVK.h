@@ -15,6 +15,10 @@ struct TextureVK {
         return m_Handle;
     }
 
+    inline VmaAllocation_T* GetVmaAllocation() const {
+        return m_VmaAllocation;
+    }
+
     inline DeviceVK& GetDevice() const {
         return m_Device;
     }
@@ -38,6 +42,7 @@ struct TextureVK {
     Result Create(const AllocateTextureDesc& textureDesc);
     VkImageAspectFlags GetImageAspectFlags() const;
     void DestroyVma();
+    void FinishRelocation(VkImage handle);
 
     //================================================================================================================
     // NRI
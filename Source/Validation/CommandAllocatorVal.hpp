@@ -10,11 +10,13 @@ NRI_INLINE Result CommandAllocatorVal::CreateCommandBuffer(CommandBuffer*& comma
     const Result result = GetCoreInterface().CreateCommandBuffer(*GetImpl(), commandBufferImpl);
 
     if (result == Result::SUCCESS)
-        commandBuffer = (CommandBuffer*)Allocate<CommandBufferVal>(m_Device.GetStdAllocator(), m_Device, commandBufferImpl, false);
+        commandBuffer = (CommandBuffer*)m_Device.GetCommandBufferObjectPool().Allocate(m_Device, commandBufferImpl, false);
 
     return result;
 }
 
 NRI_INLINE void CommandAllocatorVal::Reset() {
     GetCoreInterface().ResetCommandAllocator(*GetImpl());
+
+    m_Device.OnCommandAllocatorReset();
 }
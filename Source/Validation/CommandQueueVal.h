@@ -19,7 +19,9 @@ struct CommandQueueVal : public DeviceObjectVal<CommandQueue> {
     void Submit(const QueueSubmitDesc& queueSubmitDesc, const SwapChain* swapChain);
 
     Result WaitForIdle();
-    Result UploadData(const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum);
+    Result UploadData(const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum,
+        DataUploader* dataUploaderImpl = nullptr, UploadTicket* uploadTicket = nullptr); // asynchronous, if "dataUploaderImpl" is provided
+    Result DownloadData(const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDownloadDescNum, const BufferDownloadDesc* bufferDownloadDescs, uint32_t bufferDownloadDescNum);
 
 private:
     void ProcessValidationCommands(const CommandBufferVal* const* commandBuffers, uint32_t commandBufferNum);
@@ -47,6 +47,39 @@ static bool ValidateBufferUploadDesc(DeviceVal& device, uint32_t i, const Buffer
     return true;
 }
 
+static bool ValidateTextureDownloadDesc(DeviceVal& device, uint32_t i, const TextureDownloadDesc& textureDownloadDesc) {
+    RETURN_ON_FAILURE(&device, textureDownloadDesc.texture != nullptr, false, "'textureDownloadDescs[%u].texture' is NULL", i);
+    RETURN_ON_FAILURE(&device, textureDownloadDesc.data != nullptr, false, "'textureDownloadDescs[%u].data' is NULL", i);
+    RETURN_ON_FAILURE(&device, textureDownloadDesc.before.layout < Layout::MAX_NUM, false, "'textureDownloadDescs[%u].before.layout' is invalid", i);
+
+    const TextureVal& textureVal = *(TextureVal*)textureDownloadDesc.texture;
+    const TextureDesc& textureDesc = textureVal.GetDesc();
+
+    RETURN_ON_FAILURE(&device, textureVal.IsBoundToMemory(), false, "'textureDownloadDescs[%u].texture' is not bound to memory", i);
+    RETURN_ON_FAILURE(&device, textureDownloadDesc.region.mipOffset < textureDesc.mipNum, false, "'textureDownloadDescs[%u].region.mipOffset' is out of bounds", i);
+    RETURN_ON_FAILURE(&device, textureDownloadDesc.region.layerOffset < textureDesc.layerNum, false, "'textureDownloadDescs[%u].region.layerOffset' is out of bounds", i);
+
+    return true;
+}
+
+static bool ValidateBufferDownloadDesc(DeviceVal& device, uint32_t i, const BufferDownloadDesc& bufferDownloadDesc) {
+    if (bufferDownloadDesc.dataSize == 0) {
+        REPORT_WARNING(&device, "'bufferDownloadDescs[%u].dataSize' is 0 (nothing to download)", i);
+        return true;
+    }
+
+    RETURN_ON_FAILURE(&device, bufferDownloadDesc.buffer != nullptr, false, "'bufferDownloadDescs[%u].buffer' is invalid", i);
+    RETURN_ON_FAILURE(&device, bufferDownloadDesc.data != nullptr, false, "'bufferDownloadDescs[%u].data' is invalid", i);
+
+    const BufferVal& bufferVal = *(BufferVal*)bufferDownloadDesc.buffer;
+    const uint64_t rangeEnd = bufferDownloadDesc.bufferOffset + bufferDownloadDesc.dataSize;
+
+    RETURN_ON_FAILURE(&device, bufferVal.IsBoundToMemory(), false, "'bufferDownloadDescs[%u].buffer' is not bound to memory", i);
+    RETURN_ON_FAILURE(&device, rangeEnd <= bufferVal.GetDesc().size, false, "'bufferDownloadDescs[%u].bufferOffset + bufferDownloadDescs[%u].dataSize' is out of bounds", i, i);
+
+    return true;
+}
+
 NRI_INLINE void CommandQueueVal::SetDebugName(const char* name) {
     m_Name = name;
     GetCoreInterface().SetCommandQueueDebugName(*GetImpl(), name);
@@ -83,7 +116,8 @@ NRI_INLINE void CommandQueueVal::Submit(const QueueSubmitDesc& queueSubmitDesc,
         GetCoreInterface().QueueSubmit(*GetImpl(), queueSubmitDescImpl);
 }
 
-NRI_INLINE Result CommandQueueVal::UploadData(const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum) {
+NRI_INLINE Result CommandQueueVal::UploadData(const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs, uint32_t bufferUploadDescNum,
+    DataUploader* dataUploaderImpl, UploadTicket* uploadTicket) {
     RETURN_ON_FAILURE(&m_Device, textureUploadDescNum == 0 || textureUploadDescs != nullptr, Result::INVALID_ARGUMENT, "'textureUploadDescs' is NULL");
     RETURN_ON_FAILURE(&m_Device, bufferUploadDescNum == 0 || bufferUploadDescs != nullptr, Result::INVALID_ARGUMENT, "'bufferUploadDescs' is NULL");
 
@@ -109,9 +143,41 @@ NRI_INLINE Result CommandQueueVal::UploadData(const TextureUploadDesc* textureUp
         bufferUploadDescsImpl[i].buffer = bufferVal->GetImpl();
     }
 
+    if (dataUploaderImpl)
+        return GetHelperInterface().UploadDataAsync(*dataUploaderImpl, textureUploadDescsImpl, textureUploadDescNum, bufferUploadDescsImpl, bufferUploadDescNum, *uploadTicket);
+
     return GetHelperInterface().UploadData(*GetImpl(), textureUploadDescsImpl, textureUploadDescNum, bufferUploadDescsImpl, bufferUploadDescNum);
 }
 
+NRI_INLINE Result CommandQueueVal::DownloadData(const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDownloadDescNum, const BufferDownloadDesc* bufferDownloadDescs, uint32_t bufferDownloadDescNum) {
+    RETURN_ON_FAILURE(&m_Device, textureDownloadDescNum == 0 || textureDownloadDescs != nullptr, Result::INVALID_ARGUMENT, "'textureDownloadDescs' is NULL");
+    RETURN_ON_FAILURE(&m_Device, bufferDownloadDescNum == 0 || bufferDownloadDescs != nullptr, Result::INVALID_ARGUMENT, "'bufferDownloadDescs' is NULL");
+
+    Scratch<TextureDownloadDesc> textureDownloadDescsImpl = AllocateScratch(m_Device, TextureDownloadDesc, textureDownloadDescNum);
+    for (uint32_t i = 0; i < textureDownloadDescNum; i++) {
+        if (!ValidateTextureDownloadDesc(m_Device, i, textureDownloadDescs[i]))
+            return Result::INVALID_ARGUMENT;
+
+        const TextureVal* textureVal = (TextureVal*)textureDownloadDescs[i].texture;
+
+        textureDownloadDescsImpl[i] = textureDownloadDescs[i];
+        textureDownloadDescsImpl[i].texture = textureVal->GetImpl();
+    }
+
+    Scratch<BufferDownloadDesc> bufferDownloadDescsImpl = AllocateScratch(m_Device, BufferDownloadDesc, bufferDownloadDescNum);
+    for (uint32_t i = 0; i < bufferDownloadDescNum; i++) {
+        if (!ValidateBufferDownloadDesc(m_Device, i, bufferDownloadDescs[i]))
+            return Result::INVALID_ARGUMENT;
+
+        const BufferVal* bufferVal = (BufferVal*)bufferDownloadDescs[i].buffer;
+
+        bufferDownloadDescsImpl[i] = bufferDownloadDescs[i];
+        bufferDownloadDescsImpl[i].buffer = bufferVal ? bufferVal->GetImpl() : nullptr;
+    }
+
+    return GetHelperInterface().DownloadData(*GetImpl(), textureDownloadDescsImpl, textureDownloadDescNum, bufferDownloadDescsImpl, bufferDownloadDescNum);
+}
+
 NRI_INLINE Result CommandQueueVal::WaitForIdle() {
     return GetHelperInterface().WaitForIdle(*GetImpl());
 }
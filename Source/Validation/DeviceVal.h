@@ -4,7 +4,11 @@
 
 namespace nri {
 
+struct BufferVal;
+struct CommandBufferVal;
 struct CommandQueueVal;
+struct DescriptorVal;
+struct TextureVal;
 
 struct IsExtSupported {
     uint32_t lowLatency : 1;
@@ -72,6 +76,22 @@ struct DeviceVal final : public DeviceBase {
         return m_Lock;
     }
 
+    inline ObjectPool<BufferVal>& GetBufferObjectPool() {
+        return m_BufferObjectPool;
+    }
+
+    inline ObjectPool<TextureVal>& GetTextureObjectPool() {
+        return m_TextureObjectPool;
+    }
+
+    inline ObjectPool<DescriptorVal>& GetDescriptorObjectPool() {
+        return m_DescriptorObjectPool;
+    }
+
+    inline ObjectPool<CommandBufferVal>& GetCommandBufferObjectPool() {
+        return m_CommandBufferObjectPool;
+    }
+
     bool Create();
     void RegisterMemoryType(MemoryType memoryType, MemoryLocation memoryLocation);
 
@@ -90,6 +110,7 @@ struct DeviceVal final : public DeviceBase {
     Result FillFunctionTable(MeshShaderInterface& table) const override;
     Result FillFunctionTable(ResourceAllocatorInterface& table) const override;
     Result FillFunctionTable(RayTracingInterface& table) const override;
+    Result FillFunctionTable(ResidencyInterface& table) const override;
     Result FillFunctionTable(StreamerInterface& table) const override;
     Result FillFunctionTable(SwapChainInterface& table) const override;
     Result FillFunctionTable(WrapperD3D11Interface& table) const override;
@@ -116,6 +137,10 @@ struct DeviceVal final : public DeviceBase {
     Result CreatePipeline(const RayTracingPipelineDesc& pipelineDesc, Pipeline*& pipeline);
     Result AllocateBuffer(const AllocateBufferDesc& bufferDesc, Buffer*& buffer);
     Result AllocateTexture(const AllocateTextureDesc& textureDesc, Texture*& texture);
+    Result BeginDefragmentation(const DefragmentationDesc& defragmentationDesc);
+    Result BeginDefragmentationPass(CommandBuffer& commandBuffer);
+    Result EndDefragmentationPass(DefragmentationReport& defragmentationReport);
+    void EndDefragmentation();
     Result CreateQueryPool(const QueryPoolDesc& queryPoolDesc, QueryPool*& queryPool);
     Result CreateQueryPool(const QueryPoolVKDesc& queryPoolVKDesc, QueryPool*& queryPool);
     Result CreateSwapChain(const SwapChainDesc& swapChainDesc, SwapChain*& swapChain);
@@ -161,6 +186,8 @@ struct DeviceVal final : public DeviceBase {
     Result BindBufferMemory(const BufferMemoryBindingDesc* memoryBindingDescs, uint32_t memoryBindingDescNum);
     Result BindTextureMemory(const TextureMemoryBindingDesc* memoryBindingDescs, uint32_t memoryBindingDescNum);
     Result QueryVideoMemoryInfo(MemoryLocation memoryLocation, VideoMemoryInfo& videoMemoryInfo) const;
+    void GetScratchMemoryStatistics(ScratchMemoryStatistics& scratchMemoryStatistics) const;
+    Result GetCommandStatistics(CommandStatistics& commandStatistics, PipelineCommandStatistics* pipelineCommandStatistics, uint32_t& pipelineCommandStatisticsNum) const;
     Result AllocateAndBindMemory(const ResourceGroupDesc& resourceGroupDesc, Memory** allocations);
     Result BindAccelerationStructureMemory(const AccelerationStructureMemoryBindingDesc* memoryBindingDescs, uint32_t memoryBindingDescNum);
     uint32_t CalculateAllocationNumber(const ResourceGroupDesc& resourceGroupDesc);
@@ -182,13 +209,17 @@ private:
     WrapperVKInterface m_WrapperVKAPI = {};
     std::array<CommandQueueVal*, (size_t)CommandQueueType::MAX_NUM> m_CommandQueues = {};
     UnorderedMap<MemoryType, MemoryLocation> m_MemoryTypeMap;
+    ObjectPool<BufferVal> m_BufferObjectPool;
+    ObjectPool<TextureVal> m_TextureObjectPool;
+    ObjectPool<DescriptorVal> m_DescriptorObjectPool;
+    ObjectPool<CommandBufferVal> m_CommandBufferObjectPool;
 
     union {
         uint32_t m_IsExtSupportedStorage = 0;
         IsExtSupported m_IsExtSupported;
     };
 
-    Lock m_Lock;
+    Lock m_Lock{"DeviceVal"};
 };
 
 } // namespace nri
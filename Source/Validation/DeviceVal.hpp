@@ -41,7 +41,11 @@ DeviceVal::DeviceVal(const CallbackInterface& callbacks, const StdAllocator<uint
     : DeviceBase(callbacks, stdAllocator)
     , m_Device(*(Device*)&device)
     , m_Name(GetStdAllocator())
-    , m_MemoryTypeMap(GetStdAllocator()) {
+    , m_MemoryTypeMap(GetStdAllocator())
+    , m_BufferObjectPool(GetStdAllocator().GetInterface())
+    , m_TextureObjectPool(GetStdAllocator().GetInterface())
+    , m_DescriptorObjectPool(GetStdAllocator().GetInterface())
+    , m_CommandBufferObjectPool(GetStdAllocator().GetInterface()) {
 }
 
 DeviceVal::~DeviceVal() {
@@ -168,7 +172,7 @@ NRI_INLINE Result DeviceVal::CreateBuffer(const BufferDesc& bufferDesc, Buffer*&
     Result result = m_CoreAPI.CreateBuffer(m_Device, bufferDesc, bufferImpl);
 
     if (result == Result::SUCCESS)
-        buffer = (Buffer*)Allocate<BufferVal>(GetStdAllocator(), *this, bufferImpl, false);
+        buffer = (Buffer*)m_BufferObjectPool.Allocate(*this, bufferImpl, false);
 
     return result;
 }
@@ -180,7 +184,7 @@ NRI_INLINE Result DeviceVal::AllocateBuffer(const AllocateBufferDesc& bufferDesc
     Result result = m_ResourceAllocatorAPI.AllocateBuffer(m_Device, bufferDesc, bufferImpl);
 
     if (result == Result::SUCCESS)
-        buffer = (Buffer*)Allocate<BufferVal>(GetStdAllocator(), *this, bufferImpl, true);
+        buffer = (Buffer*)m_BufferObjectPool.Allocate(*this, bufferImpl, true);
 
     return result;
 }
@@ -196,7 +200,7 @@ NRI_INLINE Result DeviceVal::CreateTexture(const TextureDesc& textureDesc, Textu
     Result result = m_CoreAPI.CreateTexture(m_Device, textureDesc, textureImpl);
 
     if (result == Result::SUCCESS)
-        texture = (Texture*)Allocate<TextureVal>(GetStdAllocator(), *this, textureImpl, false);
+        texture = (Texture*)m_TextureObjectPool.Allocate(*this, textureImpl, false);
 
     return result;
 }
@@ -212,11 +216,48 @@ NRI_INLINE Result DeviceVal::AllocateTexture(const AllocateTextureDesc& textureD
     Result result = m_ResourceAllocatorAPI.AllocateTexture(m_Device, textureDesc, textureImpl);
 
     if (result == Result::SUCCESS)
-        texture = (Texture*)Allocate<TextureVal>(GetStdAllocator(), *this, textureImpl, true);
+        texture = (Texture*)m_TextureObjectPool.Allocate(*this, textureImpl, true);
 
     return result;
 }
 
+NRI_INLINE Result DeviceVal::BeginDefragmentation(const DefragmentationDesc& defragmentationDesc) {
+    RETURN_ON_FAILURE(this, defragmentationDesc.bufferNum == 0 || defragmentationDesc.buffers != nullptr, Result::INVALID_ARGUMENT, "'buffers' is NULL");
+    RETURN_ON_FAILURE(this, defragmentationDesc.textureNum == 0 || defragmentationDesc.textures != nullptr, Result::INVALID_ARGUMENT, "'textures' is NULL");
+
+    Scratch<Buffer*> buffersImpl = AllocateScratch(*this, Buffer*, defragmentationDesc.bufferNum);
+    for (uint32_t i = 0; i < defragmentationDesc.bufferNum; i++) {
+        RETURN_ON_FAILURE(this, defragmentationDesc.buffers[i] != nullptr, Result::INVALID_ARGUMENT, "'buffers[%u]' is NULL", i);
+        buffersImpl[i] = NRI_GET_IMPL(Buffer, defragmentationDesc.buffers[i]);
+    }
+
+    Scratch<Texture*> texturesImpl = AllocateScratch(*this, Texture*, defragmentationDesc.textureNum);
+    for (uint32_t i = 0; i < defragmentationDesc.textureNum; i++) {
+        RETURN_ON_FAILURE(this, defragmentationDesc.textures[i] != nullptr, Result::INVALID_ARGUMENT, "'textures[%u]' is NULL", i);
+        texturesImpl[i] = NRI_GET_IMPL(Texture, defragmentationDesc.textures[i]);
+    }
+
+    auto defragmentationDescImpl = defragmentationDesc;
+    defragmentationDescImpl.buffers = buffersImpl;
+    defragmentationDescImpl.textures = texturesImpl;
+
+    return m_ResourceAllocatorAPI.BeginDefragmentation(m_Device, defragmentationDescImpl);
+}
+
+NRI_INLINE Result DeviceVal::BeginDefragmentationPass(CommandBuffer& commandBuffer) {
+    CommandBuffer* commandBufferImpl = NRI_GET_IMPL(CommandBuffer, &commandBuffer);
+
+    return m_ResourceAllocatorAPI.BeginDefragmentationPass(m_Device, *commandBufferImpl);
+}
+
+NRI_INLINE Result DeviceVal::EndDefragmentationPass(DefragmentationReport& defragmentationReport) {
+    return m_ResourceAllocatorAPI.EndDefragmentationPass(m_Device, defragmentationReport);
+}
+
+NRI_INLINE void DeviceVal::EndDefragmentation() {
+    m_ResourceAllocatorAPI.EndDefragmentation(m_Device);
+}
+
 NRI_INLINE Result DeviceVal::CreateDescriptor(const BufferViewDesc& bufferViewDesc, Descriptor*& bufferView) {
     RETURN_ON_FAILURE(this, bufferViewDesc.buffer != nullptr, Result::INVALID_ARGUMENT, "'buffer' is NULL");
     RETURN_ON_FAILURE(this, bufferViewDesc.format < Format::MAX_NUM, Result::INVALID_ARGUMENT, "'format' is invalid");
@@ -232,7 +273,7 @@ NRI_INLINE Result DeviceVal::CreateDescriptor(const BufferViewDesc& bufferViewDe
     Result result = m_CoreAPI.CreateBufferView(bufferViewDescImpl, descriptorImpl);
 
     if (result == Result::SUCCESS)
-        bufferView = (Descriptor*)Allocate<DescriptorVal>(GetStdAllocator(), *this, descriptorImpl, bufferViewDesc);
+        bufferView = (Descriptor*)m_DescriptorObjectPool.Allocate(*this, descriptorImpl, bufferViewDesc);
 
     return result;
 }
@@ -257,7 +298,7 @@ NRI_INLINE Result DeviceVal::CreateDescriptor(const Texture1DViewDesc& textureVi
     Result result = m_CoreAPI.CreateTexture1DView(textureViewDescImpl, descriptorImpl);
 
     if (result == Result::SUCCESS)
-        textureView = (Descriptor*)Allocate<DescriptorVal>(GetStdAllocator(), *this, descriptorImpl, textureViewDesc);
+        textureView = (Descriptor*)m_DescriptorObjectPool.Allocate(*this, descriptorImpl, textureViewDesc);
 
     return result;
 }
@@ -282,7 +323,7 @@ NRI_INLINE Result DeviceVal::CreateDescriptor(const Texture2DViewDesc& textureVi
     Result result = m_CoreAPI.CreateTexture2DView(textureViewDescImpl, descriptorImpl);
 
     if (result == Result::SUCCESS)
-        textureView = (Descriptor*)Allocate<DescriptorVal>(GetStdAllocator(), *this, descriptorImpl, textureViewDesc);
+        textureView = (Descriptor*)m_DescriptorObjectPool.Allocate(*this, descriptorImpl, textureViewDesc);
 
     return result;
 }
@@ -307,7 +348,7 @@ NRI_INLINE Result DeviceVal::CreateDescriptor(const Texture3DViewDesc& textureVi
     Result result = m_CoreAPI.CreateTexture3DView(textureViewDescImpl, descriptorImpl);
 
     if (result == Result::SUCCESS)
-        textureView = (Descriptor*)Allocate<DescriptorVal>(GetStdAllocator(), *this, descriptorImpl, textureViewDesc);
+        textureView = (Descriptor*)m_DescriptorObjectPool.Allocate(*this, descriptorImpl, textureViewDesc);
 
     return result;
 }
@@ -332,7 +373,7 @@ NRI_INLINE Result DeviceVal::CreateDescriptor(const SamplerDesc& samplerDesc, De
     Result result = m_CoreAPI.CreateSampler(m_Device, samplerDesc, samplerImpl);
 
     if (result == Result::SUCCESS)
-        sampler = (Descriptor*)Allocate<DescriptorVal>(GetStdAllocator(), *this, samplerImpl);
+        sampler = (Descriptor*)m_DescriptorObjectPool.Allocate(*this, samplerImpl);
 
     return result;
 }
@@ -530,7 +571,7 @@ NRI_INLINE Result DeviceVal::CreateFence(uint64_t initialValue, Fence*& fence) {
 
 NRI_INLINE void DeviceVal::DestroyCommandBuffer(CommandBuffer& commandBuffer) {
     m_CoreAPI.DestroyCommandBuffer(*NRI_GET_IMPL(CommandBuffer, &commandBuffer));
-    Destroy(GetStdAllocator(), (CommandBufferVal*)&commandBuffer);
+    m_CommandBufferObjectPool.Destroy((CommandBufferVal*)&commandBuffer);
 }
 
 NRI_INLINE void DeviceVal::DestroyCommandAllocator(CommandAllocator& commandAllocator) {
@@ -545,17 +586,17 @@ NRI_INLINE void DeviceVal::DestroyDescriptorPool(DescriptorPool& descriptorPool)
 
 NRI_INLINE void DeviceVal::DestroyBuffer(Buffer& buffer) {
     m_CoreAPI.DestroyBuffer(*NRI_GET_IMPL(Buffer, &buffer));
-    Destroy(GetStdAllocator(), (BufferVal*)&buffer);
+    m_BufferObjectPool.Destroy((BufferVal*)&buffer);
 }
 
 NRI_INLINE void DeviceVal::DestroyTexture(Texture& texture) {
     m_CoreAPI.DestroyTexture(*NRI_GET_IMPL(Texture, &texture));
-    Destroy(GetStdAllocator(), (TextureVal*)&texture);
+    m_TextureObjectPool.Destroy((TextureVal*)&texture);
 }
 
 NRI_INLINE void DeviceVal::DestroyDescriptor(Descriptor& descriptor) {
     m_CoreAPI.DestroyDescriptor(*NRI_GET_IMPL(Descriptor, &descriptor));
-    Destroy(GetStdAllocator(), (DescriptorVal*)&descriptor);
+    m_DescriptorObjectPool.Destroy((DescriptorVal*)&descriptor);
 }
 
 NRI_INLINE void DeviceVal::DestroyPipelineLayout(PipelineLayout& pipelineLayout) {
@@ -581,6 +622,7 @@ NRI_INLINE void DeviceVal::DestroyFence(Fence& fence) {
 NRI_INLINE Result DeviceVal::AllocateMemory(const AllocateMemoryDesc& allocateMemoryDesc, Memory*& memory) {
     RETURN_ON_FAILURE(this, allocateMemoryDesc.size > 0, Result::INVALID_ARGUMENT, "'size' is 0");
     RETURN_ON_FAILURE(this, allocateMemoryDesc.priority >= -1.0f && allocateMemoryDesc.priority <= 1.0f, Result::INVALID_ARGUMENT, "'priority' outside of [-1; 1] range");
+    RETURN_ON_FAILURE(this, (allocateMemoryDesc.alignment & (allocateMemoryDesc.alignment - 1)) == 0, Result::INVALID_ARGUMENT, "'alignment' must be 0 or a power of 2");
 
     std::unordered_map<MemoryType, MemoryLocation>::iterator it;
     std::unordered_map<MemoryType, MemoryLocation>::iterator end;
@@ -748,7 +790,7 @@ NRI_INLINE Result DeviceVal::CreateCommandBuffer(const CommandBufferVKDesc& comm
     Result result = m_WrapperVKAPI.CreateCommandBufferVK(m_Device, commandBufferVKDesc, commandBufferImpl);
 
     if (result == Result::SUCCESS)
-        commandBuffer = (CommandBuffer*)Allocate<CommandBufferVal>(GetStdAllocator(), *this, commandBufferImpl, true);
+        commandBuffer = (CommandBuffer*)m_CommandBufferObjectPool.Allocate(*this, commandBufferImpl, true);
 
     return result;
 }
@@ -774,7 +816,7 @@ NRI_INLINE Result DeviceVal::CreateBuffer(const BufferVKDesc& bufferDesc, Buffer
     Result result = m_WrapperVKAPI.CreateBufferVK(m_Device, bufferDesc, bufferImpl);
 
     if (result == Result::SUCCESS)
-        buffer = (Buffer*)Allocate<BufferVal>(GetStdAllocator(), *this, bufferImpl, true);
+        buffer = (Buffer*)m_BufferObjectPool.Allocate(*this, bufferImpl, true);
 
     return result;
 }
@@ -790,7 +832,7 @@ NRI_INLINE Result DeviceVal::CreateTexture(const TextureVKDesc& textureVKDesc, T
     Result result = m_WrapperVKAPI.CreateTextureVK(m_Device, textureVKDesc, textureImpl);
 
     if (result == Result::SUCCESS)
-        texture = (Texture*)Allocate<TextureVal>(GetStdAllocator(), *this, textureImpl, true);
+        texture = (Texture*)m_TextureObjectPool.Allocate(*this, textureImpl, true);
 
     return result;
 }
@@ -871,7 +913,7 @@ NRI_INLINE Result DeviceVal::CreateCommandBuffer(const CommandBufferD3D11Desc& c
     Result result = m_WrapperD3D11API.CreateCommandBufferD3D11(m_Device, commandBufferDesc, commandBufferImpl);
 
     if (result == Result::SUCCESS)
-        commandBuffer = (CommandBuffer*)Allocate<CommandBufferVal>(GetStdAllocator(), *this, commandBufferImpl, true);
+        commandBuffer = (CommandBuffer*)m_CommandBufferObjectPool.Allocate(*this, commandBufferImpl, true);
 
     return result;
 }
@@ -883,7 +925,7 @@ NRI_INLINE Result DeviceVal::CreateBuffer(const BufferD3D11Desc& bufferDesc, Buf
     Result result = m_WrapperD3D11API.CreateBufferD3D11(m_Device, bufferDesc, bufferImpl);
 
     if (result == Result::SUCCESS)
-        buffer = (Buffer*)Allocate<BufferVal>(GetStdAllocator(), *this, bufferImpl, true);
+        buffer = (Buffer*)m_BufferObjectPool.Allocate(*this, bufferImpl, true);
 
     return result;
 }
@@ -895,7 +937,7 @@ NRI_INLINE Result DeviceVal::CreateTexture(const TextureD3D11Desc& textureDesc,
     Result result = m_WrapperD3D11API.CreateTextureD3D11(m_Device, textureDesc, textureImpl);
 
     if (result == Result::SUCCESS)
-        texture = (Texture*)Allocate<TextureVal>(GetStdAllocator(), *this, textureImpl, true);
+        texture = (Texture*)m_TextureObjectPool.Allocate(*this, textureImpl, true);
 
     return result;
 }
@@ -912,7 +954,7 @@ NRI_INLINE Result DeviceVal::CreateCommandBuffer(const CommandBufferD3D12Desc& c
     Result result = m_WrapperD3D12API.CreateCommandBufferD3D12(m_Device, commandBufferDesc, commandBufferImpl);
 
     if (result == Result::SUCCESS)
-        commandBuffer = (CommandBuffer*)Allocate<CommandBufferVal>(GetStdAllocator(), *this, commandBufferImpl, true);
+        commandBuffer = (CommandBuffer*)m_CommandBufferObjectPool.Allocate(*this, commandBufferImpl, true);
 
     return result;
 }
@@ -936,7 +978,7 @@ NRI_INLINE Result DeviceVal::CreateBuffer(const BufferD3D12Desc& bufferDesc, Buf
     Result result = m_WrapperD3D12API.CreateBufferD3D12(m_Device, bufferDesc, bufferImpl);
 
     if (result == Result::SUCCESS)
-        buffer = (Buffer*)Allocate<BufferVal>(GetStdAllocator(), *this, bufferImpl, true);
+        buffer = (Buffer*)m_BufferObjectPool.Allocate(*this, bufferImpl, true);
 
     return result;
 }
@@ -948,7 +990,7 @@ NRI_INLINE Result DeviceVal::CreateTexture(const TextureD3D12Desc& textureDesc,
     Result result = m_WrapperD3D12API.CreateTextureD3D12(m_Device, textureDesc, textureImpl);
 
     if (result == Result::SUCCESS)
-        texture = (Texture*)Allocate<TextureVal>(GetStdAllocator(), *this, textureImpl, true);
+        texture = (Texture*)m_TextureObjectPool.Allocate(*this, textureImpl, true);
 
     return result;
 }
@@ -991,6 +1033,7 @@ NRI_INLINE uint32_t DeviceVal::CalculateAllocationNumber(const ResourceGroupDesc
     Scratch<Buffer*> buffersImpl = AllocateScratch(*this, Buffer*, resourceGroupDesc.bufferNum);
     for (uint32_t i = 0; i < resourceGroupDesc.bufferNum; i++) {
         RETURN_ON_FAILURE(this, resourceGroupDesc.buffers[i] != nullptr, 0, "'buffers[%u]' is NULL", i);
+        RETURN_ON_FAILURE(this, !resourceGroupDesc.bufferLifetimes || resourceGroupDesc.bufferLifetimes[i].firstPass <= resourceGroupDesc.bufferLifetimes[i].lastPass, 0, "'bufferLifetimes[%u]' is invalid", i);
 
         BufferVal& bufferVal = *(BufferVal*)resourceGroupDesc.buffers[i];
         buffersImpl[i] = bufferVal.GetImpl();
@@ -999,6 +1042,7 @@ NRI_INLINE uint32_t DeviceVal::CalculateAllocationNumber(const ResourceGroupDesc
     Scratch<Texture*> texturesImpl = AllocateScratch(*this, Texture*, resourceGroupDesc.textureNum);
     for (uint32_t i = 0; i < resourceGroupDesc.textureNum; i++) {
         RETURN_ON_FAILURE(this, resourceGroupDesc.textures[i] != nullptr, 0, "'textures[%u]' is NULL", i);
+        RETURN_ON_FAILURE(this, !resourceGroupDesc.textureLifetimes || resourceGroupDesc.textureLifetimes[i].firstPass <= resourceGroupDesc.textureLifetimes[i].lastPass, 0, "'textureLifetimes[%u]' is invalid", i);
 
         TextureVal& textureVal = *(TextureVal*)resourceGroupDesc.textures[i];
         texturesImpl[i] = textureVal.GetImpl();
@@ -1020,6 +1064,7 @@ NRI_INLINE Result DeviceVal::AllocateAndBindMemory(const ResourceGroupDesc& reso
     Scratch<Buffer*> buffersImpl = AllocateScratch(*this, Buffer*, resourceGroupDesc.bufferNum);
     for (uint32_t i = 0; i < resourceGroupDesc.bufferNum; i++) {
         RETURN_ON_FAILURE(this, resourceGroupDesc.buffers[i] != nullptr, Result::INVALID_ARGUMENT, "'buffers[%u]' is NULL", i);
+        RETURN_ON_FAILURE(this, !resourceGroupDesc.bufferLifetimes || resourceGroupDesc.bufferLifetimes[i].firstPass <= resourceGroupDesc.bufferLifetimes[i].lastPass, Result::INVALID_ARGUMENT, "'bufferLifetimes[%u]' is invalid", i);
 
         BufferVal& bufferVal = *(BufferVal*)resourceGroupDesc.buffers[i];
         buffersImpl[i] = bufferVal.GetImpl();
@@ -1028,6 +1073,7 @@ NRI_INLINE Result DeviceVal::AllocateAndBindMemory(const ResourceGroupDesc& reso
     Scratch<Texture*> texturesImpl = AllocateScratch(*this, Texture*, resourceGroupDesc.textureNum);
     for (uint32_t i = 0; i < resourceGroupDesc.textureNum; i++) {
         RETURN_ON_FAILURE(this, resourceGroupDesc.textures[i] != nullptr, Result::INVALID_ARGUMENT, "'textures[%u]' is NULL", i);
+        RETURN_ON_FAILURE(this, !resourceGroupDesc.textureLifetimes || resourceGroupDesc.textureLifetimes[i].firstPass <= resourceGroupDesc.textureLifetimes[i].lastPass, Result::INVALID_ARGUMENT, "'textureLifetimes[%u]' is invalid", i);
 
         TextureVal& textureVal = *(TextureVal*)resourceGroupDesc.textures[i];
         texturesImpl[i] = textureVal.GetImpl();
@@ -1063,6 +1109,23 @@ NRI_INLINE Result DeviceVal::QueryVideoMemoryInfo(MemoryLocation memoryLocation,
     return m_HelperAPI.QueryVideoMemoryInfo(m_Device, memoryLocation, videoMemoryInfo);
 }
 
+NRI_INLINE Result DeviceVal::GetCommandStatistics(CommandStatistics& commandStatistics, PipelineCommandStatistics* pipelineCommandStatistics, uint32_t& pipelineCommandStatisticsNum) const {
+    return m_HelperAPI.GetCommandStatistics(m_Device, commandStatistics, pipelineCommandStatistics, pipelineCommandStatisticsNum);
+}
+
+NRI_INLINE void DeviceVal::GetScratchMemoryStatistics(ScratchMemoryStatistics& scratchMemoryStatistics) const {
+    // Validation arenas + implementation arenas ("stackAllocationNum" is already shared)
+    DeviceBase::GetScratchMemoryStatistics(scratchMemoryStatistics);
+
+    ScratchMemoryStatistics implStatistics = {};
+    m_HelperAPI.GetScratchMemoryStatistics(m_Device, implStatistics);
+
+    scratchMemoryStatistics.arenaAllocationNum += implStatistics.arenaAllocationNum;
+    scratchMemoryStatistics.heapAllocationNum += implStatistics.heapAllocationNum;
+    scratchMemoryStatistics.arenaSize += implStatistics.arenaSize;
+    scratchMemoryStatistics.arenaNum += implStatistics.arenaNum;
+}
+
 NRI_INLINE Result DeviceVal::CreatePipeline(const RayTracingPipelineDesc& pipelineDesc, Pipeline*& pipeline) {
     RETURN_ON_FAILURE(this, pipelineDesc.pipelineLayout != nullptr, Result::INVALID_ARGUMENT, "'pipelineLayout' is NULL");
     RETURN_ON_FAILURE(this, pipelineDesc.shaderLibrary != nullptr, Result::INVALID_ARGUMENT, "'shaderLibrary' is NULL");
@@ -19,6 +19,8 @@
 #include "SwapChainVal.h"
 #include "TextureVal.h"
 
+#include "ResidencyManager.h"
+
 using namespace nri;
 
 #include "AccelerationStructureVal.hpp"
@@ -669,6 +671,61 @@ static Result NRI_CALL UploadData(CommandQueue& commandQueue, const TextureUploa
     return ((CommandQueueVal&)commandQueue).UploadData(textureUploadDescs, textureUploadDescNum, bufferUploadDescs, bufferUploadDescNum);
 }
 
+static Result NRI_CALL DownloadData(CommandQueue& commandQueue, const TextureDownloadDesc* textureDownloadDescs, uint32_t textureDownloadDescNum, const BufferDownloadDesc* bufferDownloadDescs, uint32_t bufferDownloadDescNum) {
+    return ((CommandQueueVal&)commandQueue).DownloadData(textureDownloadDescs, textureDownloadDescNum, bufferDownloadDescs, bufferDownloadDescNum);
+}
+
+struct DataUploaderVal : DeviceObjectVal<DataUploader> {
+    inline DataUploaderVal(DeviceVal& device, DataUploader* impl, CommandQueueVal& commandQueue)
+        : DeviceObjectVal(device, impl)
+        , commandQueue(commandQueue) {
+    }
+
+    CommandQueueVal& commandQueue;
+    FenceVal* fence = nullptr;
+};
+
+static Result NRI_CALL CreateDataUploader(CommandQueue& commandQueue, const DataUploaderDesc& dataUploaderDesc, DataUploader*& dataUploader) {
+    CommandQueueVal& commandQueueVal = (CommandQueueVal&)commandQueue;
+    DeviceVal& deviceVal = commandQueueVal.GetDevice();
+
+    DataUploader* impl = nullptr;
+    Result result = commandQueueVal.GetHelperInterface().CreateDataUploader(*commandQueueVal.GetImpl(), dataUploaderDesc, impl);
+
+    if (result == Result::SUCCESS)
+        dataUploader = (DataUploader*)Allocate<DataUploaderVal>(deviceVal.GetStdAllocator(), deviceVal, impl, commandQueueVal);
+
+    return result;
+}
+
+static void NRI_CALL DestroyDataUploader(DataUploader& dataUploader) {
+    DataUploaderVal& dataUploaderVal = (DataUploaderVal&)dataUploader;
+    DeviceVal& deviceVal = dataUploaderVal.GetDevice();
+
+    dataUploaderVal.commandQueue.GetHelperInterface().DestroyDataUploader(*dataUploaderVal.GetImpl());
+
+    Destroy(deviceVal.GetStdAllocator(), dataUploaderVal.fence);
+    Destroy(deviceVal.GetStdAllocator(), &dataUploaderVal);
+}
+
+static Result NRI_CALL UploadDataAsync(DataUploader& dataUploader, const TextureUploadDesc* textureUploadDescs, uint32_t textureUploadDescNum, const BufferUploadDesc* bufferUploadDescs,
+    uint32_t bufferUploadDescNum, UploadTicket& uploadTicket) {
+    DataUploaderVal& dataUploaderVal = (DataUploaderVal&)dataUploader;
+    DeviceVal& deviceVal = dataUploaderVal.GetDevice();
+
+    Result result = dataUploaderVal.commandQueue.UploadData(textureUploadDescs, textureUploadDescNum, bufferUploadDescs, bufferUploadDescNum, dataUploaderVal.GetImpl(), &uploadTicket);
+
+    // The fence is owned by the uploader, wrap it once
+    if (uploadTicket.fence) {
+        if (!dataUploaderVal.fence)
+            dataUploaderVal.fence = Allocate<FenceVal>(deviceVal.GetStdAllocator(), deviceVal, uploadTicket.fence);
+
+        uploadTicket.fence = (Fence*)dataUploaderVal.fence;
+    }
+
+    return result;
+}
+
 static Result NRI_CALL WaitForIdle(CommandQueue& commandQueue) {
     if (!(&commandQueue))
         return Result::SUCCESS;
@@ -688,12 +745,31 @@ static Result NRI_CALL QueryVideoMemoryInfo(const Device& device, MemoryLocation
     return ((DeviceVal&)device).QueryVideoMemoryInfo(memoryLocation, videoMemoryInfo);
 }
 
+static void NRI_CALL GetScratchMemoryStatistics(const Device& device, ScratchMemoryStatistics& scratchMemoryStatistics) {
+    ((DeviceVal&)device).GetScratchMemoryStatistics(scratchMemoryStatistics);
+}
+
+static Result NRI_CALL GetAllocationStatistics(const Device& device, AllocationCategory allocationCategory, AllocationStatistics& allocationStatistics) {
+    return ((DeviceVal&)device).GetAllocationStatistics(allocationCategory, allocationStatistics);
+}
+
+static Result NRI_CALL GetCommandStatistics(const Device& device, CommandStatistics& commandStatistics, PipelineCommandStatistics* pipelineCommandStatistics, uint32_t& pipelineCommandStatisticsNum) {
+    return ((DeviceVal&)device).GetCommandStatistics(commandStatistics, pipelineCommandStatistics, pipelineCommandStatisticsNum);
+}
+
 Result DeviceVal::FillFunctionTable(HelperInterface& table) const {
     table.CalculateAllocationNumber = ::CalculateAllocationNumber;
     table.AllocateAndBindMemory = ::AllocateAndBindMemory;
     table.UploadData = ::UploadData;
+    table.DownloadData = ::DownloadData;
+    table.CreateDataUploader = ::CreateDataUploader;
+    table.DestroyDataUploader = ::DestroyDataUploader;
+    table.UploadDataAsync = ::UploadDataAsync;
     table.WaitForIdle = ::WaitForIdle;
     table.QueryVideoMemoryInfo = ::QueryVideoMemoryInfo;
+    table.GetScratchMemoryStatistics = ::GetScratchMemoryStatistics;
+    table.GetAllocationStatistics = ::GetAllocationStatistics;
+    table.GetCommandStatistics = ::GetCommandStatistics;
 
     return Result::SUCCESS;
 }
@@ -890,6 +966,67 @@ Result DeviceVal::FillFunctionTable(RayTracingInterface& table) const {
 
 #pragma endregion
 
+//============================================================================================================================================================================================
+#pragma region[  Residency  ]
+
+static Result CreateResidencyManager(Device& device, const ResidencyManagerDesc& residencyManagerDesc, ResidencyManager*& residencyManager) {
+    DeviceVal& deviceVal = (DeviceVal&)device;
+    RETURN_ON_FAILURE(&deviceVal, residencyManagerDesc.Callback, Result::INVALID_ARGUMENT, "'residencyManagerDesc.Callback' is NULL");
+
+    ResidencyManagerImpl* impl = Allocate<ResidencyManagerImpl>(deviceVal.GetStdAllocator(), device);
+    Result result = impl->Create(residencyManagerDesc);
+
+    if (result != Result::SUCCESS) {
+        Destroy(deviceVal.GetStdAllocator(), impl);
+        residencyManager = nullptr;
+    } else
+        residencyManager = (ResidencyManager*)impl;
+
+    return result;
+}
+
+static void DestroyResidencyManager(ResidencyManager& residencyManager) {
+    Destroy(((DeviceBase&)((ResidencyManagerImpl&)residencyManager).GetDevice()).GetStdAllocator(), (ResidencyManagerImpl*)&residencyManager);
+}
+
+static uint32_t RegisterResidencyResource(ResidencyManager& residencyManager, const ResidencyResourceDesc& residencyResourceDesc) {
+    DeviceVal& deviceVal = (DeviceVal&)((ResidencyManagerImpl&)residencyManager).GetDevice();
+    RETURN_ON_FAILURE(&deviceVal, (residencyResourceDesc.buffer != nullptr) != (residencyResourceDesc.texture != nullptr), 0, "'buffer' or 'texture' must be provided");
+    RETURN_ON_FAILURE(&deviceVal, residencyResourceDesc.priority >= -1.0f && residencyResourceDesc.priority <= 1.0f, 0, "'priority' must be in [-1; 1]");
+
+    return ((ResidencyManagerImpl&)residencyManager).RegisterResidencyResource(residencyResourceDesc);
+}
+
+static void UnregisterResidencyResource(ResidencyManager& residencyManager, uint32_t id) {
+    ((ResidencyManagerImpl&)residencyManager).UnregisterResidencyResource(id);
+}
+
+static void MarkResidencyResourceUsed(ResidencyManager& residencyManager, uint32_t id) {
+    ((ResidencyManagerImpl&)residencyManager).MarkResidencyResourceUsed(id);
+}
+
+static Result UpdateResidency(ResidencyManager& residencyManager) {
+    return ((ResidencyManagerImpl&)residencyManager).UpdateResidency();
+}
+
+static void GetResidencyStatistics(const ResidencyManager& residencyManager, ResidencyStatistics& residencyStatistics) {
+    ((const ResidencyManagerImpl&)residencyManager).GetResidencyStatistics(residencyStatistics);
+}
+
+Result DeviceVal::FillFunctionTable(ResidencyInterface& table) const {
+    table.CreateResidencyManager = ::CreateResidencyManager;
+    table.DestroyResidencyManager = ::DestroyResidencyManager;
+    table.RegisterResidencyResource = ::RegisterResidencyResource;
+    table.UnregisterResidencyResource = ::UnregisterResidencyResource;
+    table.MarkResidencyResourceUsed = ::MarkResidencyResourceUsed;
+    table.UpdateResidency = ::UpdateResidency;
+    table.GetResidencyStatistics = ::GetResidencyStatistics;
+
+    return Result::SUCCESS;
+}
+
+#pragma endregion
+
 //============================================================================================================================================================================================
 #pragma region[  ResourceAllocator  ]
 
@@ -905,10 +1042,30 @@ static Result AllocateAccelerationStructure(Device& device, const AllocateAccele
     return ((DeviceVal&)device).AllocateAccelerationStructure(acelerationStructureDesc, accelerationStructure);
 }
 
+static Result BeginDefragmentation(Device& device, const DefragmentationDesc& defragmentationDesc) {
+    return ((DeviceVal&)device).BeginDefragmentation(defragmentationDesc);
+}
+
+static Result BeginDefragmentationPass(Device& device, CommandBuffer& commandBuffer) {
+    return ((DeviceVal&)device).BeginDefragmentationPass(commandBuffer);
+}
+
+static Result EndDefragmentationPass(Device& device, DefragmentationReport& defragmentationReport) {
+    return ((DeviceVal&)device).EndDefragmentationPass(defragmentationReport);
+}
+
+static void EndDefragmentation(Device& device) {
+    ((DeviceVal&)device).EndDefragmentation();
+}
+
 Result DeviceVal::FillFunctionTable(ResourceAllocatorInterface& table) const {
     table.AllocateBuffer = ::AllocateBuffer;
     table.AllocateTexture = ::AllocateTexture;
     table.AllocateAccelerationStructure = ::AllocateAccelerationStructure;
+    table.BeginDefragmentation = ::BeginDefragmentation;
+    table.BeginDefragmentationPass = ::BeginDefragmentationPass;
+    table.EndDefragmentationPass = ::EndDefragmentationPass;
+    table.EndDefragmentation = ::EndDefragmentation;
 
     return Result::SUCCESS;
 }
@@ -925,7 +1082,7 @@ struct StreamerVal : DeviceObjectVal<Streamer> {
 
     BufferVal* constantBuffer = nullptr;
     BufferVal* dynamicBuffer = nullptr;
-    bool isDynamicBufferValid = false;
+    std::atomic_bool isDynamicBufferValid = false;
 };
 
 static Result CreateStreamer(Device& device, const StreamerDesc& streamerDesc, Streamer*& streamer) {
@@ -982,6 +1139,8 @@ static uint64_t AddStreamerBufferUpdateRequest(Streamer& streamer, const BufferU
 
     if (!bufferUpdateRequestDesc.dataSize)
         REPORT_WARNING(&deviceVal, "'bufferUpdateRequestDesc.dataSize = 0'");
+    if (!bufferUpdateRequestDesc.data && !bufferUpdateRequestDesc.filePath)
+        REPORT_ERROR(&deviceVal, "'bufferUpdateRequestDesc.data' and 'bufferUpdateRequestDesc.filePath' are NULL");
 
     BufferUpdateRequestDesc bufferUpdateRequestDescImpl = bufferUpdateRequestDesc;
     bufferUpdateRequestDescImpl.dstBuffer = NRI_GET_IMPL(Buffer, bufferUpdateRequestDesc.dstBuffer);
@@ -1000,6 +1159,8 @@ static uint64_t AddStreamerTextureUpdateRequest(Streamer& streamer, const Textur
         REPORT_WARNING(&deviceVal, "'textureUpdateRequestDesc.dataRowPitch = 0'");
     if (!textureUpdateRequestDesc.dataSlicePitch)
         REPORT_WARNING(&deviceVal, "'textureUpdateRequestDesc.dataSlicePitch = 0'");
+    if (!textureUpdateRequestDesc.data && !textureUpdateRequestDesc.filePath)
+        REPORT_ERROR(&deviceVal, "'textureUpdateRequestDesc.data' and 'textureUpdateRequestDesc.filePath' are NULL");
 
     TextureUpdateRequestDesc textureUpdateRequestDescImpl = textureUpdateRequestDesc;
     textureUpdateRequestDescImpl.dstTexture = NRI_GET_IMPL(Texture, textureUpdateRequestDesc.dstTexture);
@@ -1007,6 +1168,81 @@ static uint64_t AddStreamerTextureUpdateRequest(Streamer& streamer, const Textur
     return streamerVal.GetStreamerInterface().AddStreamerTextureUpdateRequest(*NRI_GET_IMPL(Streamer, &streamer), textureUpdateRequestDescImpl);
 }
 
+static Result QueueStreamerBufferUpdateRequest(Streamer& streamer, const BufferUpdateRequestDesc& bufferUpdateRequestDesc, uint64_t& requestId) {
+    DeviceVal& deviceVal = GetDeviceVal(streamer);
+    StreamerVal& streamerVal = (StreamerVal&)streamer;
+    streamerVal.isDynamicBufferValid = false;
+
+    RETURN_ON_FAILURE(&deviceVal, bufferUpdateRequestDesc.dstBuffer, Result::INVALID_ARGUMENT, "'bufferUpdateRequestDesc.dstBuffer' is NULL");
+    RETURN_ON_FAILURE(&deviceVal, bufferUpdateRequestDesc.data || bufferUpdateRequestDesc.filePath, Result::INVALID_ARGUMENT, "'bufferUpdateRequestDesc.data' and 'bufferUpdateRequestDesc.filePath' are NULL");
+
+    if (!bufferUpdateRequestDesc.dataSize)
+        REPORT_WARNING(&deviceVal, "'bufferUpdateRequestDesc.dataSize = 0'");
+
+    BufferUpdateRequestDesc bufferUpdateRequestDescImpl = bufferUpdateRequestDesc;
+    bufferUpdateRequestDescImpl.dstBuffer = NRI_GET_IMPL(Buffer, bufferUpdateRequestDesc.dstBuffer);
+
+    return streamerVal.GetStreamerInterface().QueueStreamerBufferUpdateRequest(*NRI_GET_IMPL(Streamer, &streamer), bufferUpdateRequestDescImpl, requestId);
+}
+
+static Result QueueStreamerTextureUpdateRequest(Streamer& streamer, const TextureUpdateRequestDesc& textureUpdateRequestDesc, uint64_t& requestId) {
+    DeviceVal& deviceVal = GetDeviceVal(streamer);
+    StreamerVal& streamerVal = (StreamerVal&)streamer;
+    streamerVal.isDynamicBufferValid = false;
+
+    RETURN_ON_FAILURE(&deviceVal, textureUpdateRequestDesc.dstTexture, Result::INVALID_ARGUMENT, "'textureUpdateRequestDesc.dstTexture' is NULL");
+    RETURN_ON_FAILURE(&deviceVal, textureUpdateRequestDesc.data || textureUpdateRequestDesc.filePath, Result::INVALID_ARGUMENT, "'textureUpdateRequestDesc.data' and 'textureUpdateRequestDesc.filePath' are NULL");
+
+    if (!textureUpdateRequestDesc.dataRowPitch)
+        REPORT_WARNING(&deviceVal, "'textureUpdateRequestDesc.dataRowPitch = 0'");
+    if (!textureUpdateRequestDesc.dataSlicePitch)
+        REPORT_WARNING(&deviceVal, "'textureUpdateRequestDesc.dataSlicePitch = 0'");
+
+    TextureUpdateRequestDesc textureUpdateRequestDescImpl = textureUpdateRequestDesc;
+    textureUpdateRequestDescImpl.dstTexture = NRI_GET_IMPL(Texture, textureUpdateRequestDesc.dstTexture);
+
+    return streamerVal.GetStreamerInterface().QueueStreamerTextureUpdateRequest(*NRI_GET_IMPL(Streamer, &streamer), textureUpdateRequestDescImpl, requestId);
+}
+
+static void* ReserveStreamerBufferUpdate(Streamer& streamer, const BufferUpdateRequestDesc& bufferUpdateRequestDesc, uint64_t& offset) {
+    DeviceVal& deviceVal = GetDeviceVal(streamer);
+    StreamerVal& streamerVal = (StreamerVal&)streamer;
+    streamerVal.isDynamicBufferValid = false;
+
+    if (!bufferUpdateRequestDesc.dataSize)
+        REPORT_WARNING(&deviceVal, "'bufferUpdateRequestDesc.dataSize = 0'");
+    if (bufferUpdateRequestDesc.data || bufferUpdateRequestDesc.filePath)
+        REPORT_WARNING(&deviceVal, "'bufferUpdateRequestDesc.data' and 'bufferUpdateRequestDesc.filePath' are ignored");
+
+    BufferUpdateRequestDesc bufferUpdateRequestDescImpl = bufferUpdateRequestDesc;
+    bufferUpdateRequestDescImpl.dstBuffer = NRI_GET_IMPL(Buffer, bufferUpdateRequestDesc.dstBuffer);
+
+    return streamerVal.GetStreamerInterface().ReserveStreamerBufferUpdate(*NRI_GET_IMPL(Streamer, &streamer), bufferUpdateRequestDescImpl, offset);
+}
+
+static Result AddStreamerReadbackRequest(Streamer& streamer, const ReadbackRequestDesc& readbackRequestDesc) {
+    DeviceVal& deviceVal = GetDeviceVal(streamer);
+    StreamerVal& streamerVal = (StreamerVal&)streamer;
+
+    RETURN_ON_FAILURE(&deviceVal, !readbackRequestDesc.srcBuffer != !readbackRequestDesc.srcTexture, Result::INVALID_ARGUMENT, "exactly one of 'readbackRequestDesc.srcBuffer' and 'readbackRequestDesc.srcTexture' must be provided");
+    if (readbackRequestDesc.srcBuffer && !readbackRequestDesc.dataSize)
+        REPORT_WARNING(&deviceVal, "'readbackRequestDesc.dataSize = 0'");
+    if (!readbackRequestDesc.Callback)
+        REPORT_WARNING(&deviceVal, "'readbackRequestDesc.Callback' is NULL");
+
+    ReadbackRequestDesc readbackRequestDescImpl = readbackRequestDesc;
+    readbackRequestDescImpl.srcBuffer = NRI_GET_IMPL(Buffer, readbackRequestDesc.srcBuffer);
+    readbackRequestDescImpl.srcTexture = NRI_GET_IMPL(Texture, readbackRequestDesc.srcTexture);
+
+    return streamerVal.GetStreamerInterface().AddStreamerReadbackRequest(*NRI_GET_IMPL(Streamer, &streamer), readbackRequestDescImpl);
+}
+
+static bool IsStreamerRequestComplete(const Streamer& streamer, uint64_t requestId) {
+    const StreamerVal& streamerVal = (StreamerVal&)streamer;
+
+    return streamerVal.GetStreamerInterface().IsStreamerRequestComplete(*NRI_GET_IMPL(Streamer, &streamer), requestId);
+}
+
 static Result CopyStreamerUpdateRequests(Streamer& streamer) {
     StreamerVal& streamerVal = (StreamerVal&)streamer;
     streamerVal.isDynamicBufferValid = true;
@@ -1040,6 +1276,12 @@ static void CmdUploadStreamerUpdateRequests(CommandBuffer& commandBuffer, Stream
     streamerVal.GetStreamerInterface().CmdUploadStreamerUpdateRequests(*NRI_GET_IMPL(CommandBuffer, &commandBuffer), *NRI_GET_IMPL(Streamer, &streamer));
 }
 
+static void GetStreamerStatistics(const Streamer& streamer, StreamerStatistics& streamerStatistics) {
+    const StreamerVal& streamerVal = (StreamerVal&)streamer;
+
+    streamerVal.GetStreamerInterface().GetStreamerStatistics(*NRI_GET_IMPL(Streamer, &streamer), streamerStatistics);
+}
+
 Result DeviceVal::FillFunctionTable(StreamerInterface& table) const {
     table.CreateStreamer = ::CreateStreamer;
     table.DestroyStreamer = ::DestroyStreamer;
@@ -1047,9 +1289,15 @@ Result DeviceVal::FillFunctionTable(StreamerInterface& table) const {
     table.GetStreamerDynamicBuffer = ::GetStreamerDynamicBuffer;
     table.AddStreamerBufferUpdateRequest = ::AddStreamerBufferUpdateRequest;
     table.AddStreamerTextureUpdateRequest = ::AddStreamerTextureUpdateRequest;
+    table.QueueStreamerBufferUpdateRequest = ::QueueStreamerBufferUpdateRequest;
+    table.QueueStreamerTextureUpdateRequest = ::QueueStreamerTextureUpdateRequest;
+    table.ReserveStreamerBufferUpdate = ::ReserveStreamerBufferUpdate;
+    table.AddStreamerReadbackRequest = ::AddStreamerReadbackRequest;
+    table.IsStreamerRequestComplete = ::IsStreamerRequestComplete;
     table.UpdateStreamerConstantBuffer = ::UpdateStreamerConstantBuffer;
     table.CopyStreamerUpdateRequests = ::CopyStreamerUpdateRequests;
     table.CmdUploadStreamerUpdateRequests = ::CmdUploadStreamerUpdateRequests;
+    table.GetStreamerStatistics = ::GetStreamerStatistics;
 
     return Result::SUCCESS;
 }
@@ -5,6 +5,7 @@ pub const Device = struct {
     core_interface: CoreInterface,
     swap_chain_interface: SwapChainInterface,
     streamer_interface: StreamerInterface,
+    residency_interface: ResidencyInterface,
     helper_interface: HelperInterface,
 
     pub fn init(desc: DeviceCreationDesc) !Device {
@@ -19,6 +20,7 @@ pub const Device = struct {
             .core_interface = undefined,
             .swap_chain_interface = undefined,
             .streamer_interface = undefined,
+            .residency_interface = undefined,
             .helper_interface = undefined,
         };
 
@@ -34,6 +36,10 @@ pub const Device = struct {
             return error.QueryFailed;
         }
 
+        if (nriGetInterface(raw, "NriResidencyInterface", @sizeOf(ResidencyInterface), &self.residency_interface) != .success) {
+            return error.QueryFailed;
+        }
+
         if (nriGetInterface(raw, "NriHelperInterface", @sizeOf(HelperInterface), &self.helper_interface) != .success) {
             return error.QueryFailed;
         }
@@ -99,6 +105,51 @@ pub const Device = struct {
         ));
     }
 
+    /// Read back resources into host memory (not for streaming!)
+    pub inline fn downloadData(
+        self: Device,
+        command_queue: *CommandQueue,
+        texture_download_descs: []const TextureDownloadDesc,
+        buffer_download_descs: []const BufferDownloadDesc,
+    ) !void {
+        try check(self.helper_interface.DownloadData(
+            command_queue,
+            texture_download_descs.ptr,
+            @intCast(texture_download_descs.len),
+            buffer_download_descs.ptr,
+            @intCast(buffer_download_descs.len),
+        ));
+    }
+
+    pub inline fn createDataUploader(self: Device, command_queue: *CommandQueue, desc: *const DataUploaderDesc) !*DataUploader {
+        var temp_uploader: ?*DataUploader = null;
+        try check(self.helper_interface.CreateDataUploader(command_queue, desc, &temp_uploader));
+        return temp_uploader orelse unreachable;
+    }
+
+    pub inline fn destroyDataUploader(self: Device, data_uploader: *DataUploader) void {
+        self.helper_interface.DestroyDataUploader(data_uploader);
+    }
+
+    /// Non-blocking: wait on the returned ticket only when the resources are needed
+    pub inline fn uploadDataAsync(
+        self: Device,
+        data_uploader: *DataUploader,
+        texture_upload_descs: []const TextureUploadDesc,
+        buffer_upload_descs: []const BufferUploadDesc,
+    ) !UploadTicket {
+        var ticket: UploadTicket = .{};
+        try check(self.helper_interface.UploadDataAsync(
+            data_uploader,
+            texture_upload_descs.ptr,
+            @intCast(texture_upload_descs.len),
+            buffer_upload_descs.ptr,
+            @intCast(buffer_upload_descs.len),
+            &ticket,
+        ));
+        return ticket;
+    }
+
     pub inline fn waitForIdle(self: Device, command_queue: *CommandQueue) !void {
         try check(self.helper_interface.WaitForIdle(command_queue));
     }
@@ -668,6 +719,25 @@ pub const Device = struct {
         return out_info;
     }
 
+    pub inline fn getScratchMemoryStatistics(self: Device) ScratchMemoryStatistics {
+        var out_statistics: ScratchMemoryStatistics = undefined;
+        self.helper_interface.GetScratchMemoryStatistics(self.internal_device, &out_statistics);
+        return out_statistics;
+    }
+
+    pub inline fn getAllocationStatistics(self: Device, allocation_category: AllocationCategory) !AllocationStatistics {
+        var out_statistics: AllocationStatistics = undefined;
+        try check(self.helper_interface.GetAllocationStatistics(self.internal_device, allocation_category, &out_statistics));
+        return out_statistics;
+    }
+
+    pub inline fn getCommandStatistics(self: Device, out_pipeline_statistics: []PipelineCommandStatistics) !CommandStatistics {
+        var out_statistics: CommandStatistics = undefined;
+        var pipeline_statistics_num: u32 = @intCast(out_pipeline_statistics.len);
+        try check(self.helper_interface.GetCommandStatistics(self.internal_device, &out_statistics, out_pipeline_statistics.ptr, &pipeline_statistics_num));
+        return out_statistics;
+    }
+
     pub inline fn createStreamer(self: Device, desc: *const StreamerDesc) !*Streamer {
         var temp_streamer: ?*Streamer = null;
         try check(self.streamer_interface.CreateStreamer(self.internal_device, desc, &temp_streamer));
@@ -694,16 +764,61 @@ pub const Device = struct {
         self: Device,
         streamer: *Streamer,
         desc: *const BufferUpdateRequestDesc,
-    ) u64 {
-        return self.streamer_interface.AddStreamerBufferUpdateRequest(streamer, desc);
+    ) !u64 {
+        const offset = self.streamer_interface.AddStreamerBufferUpdateRequest(streamer, desc);
+        if (offset == STREAMER_INVALID_OFFSET) return error.OutOfMemory;
+        return offset;
     }
 
     pub inline fn addStreamerTextureUpdateRequest(
         self: Device,
         streamer: *Streamer,
         desc: *const TextureUpdateRequestDesc,
-    ) u64 {
-        return self.streamer_interface.AddStreamerTextureUpdateRequest(streamer, desc);
+    ) !u64 {
+        const offset = self.streamer_interface.AddStreamerTextureUpdateRequest(streamer, desc);
+        if (offset == STREAMER_INVALID_OFFSET) return error.OutOfMemory;
+        return offset;
+    }
+
+    pub inline fn queueStreamerBufferUpdateRequest(
+        self: Device,
+        streamer: *Streamer,
+        desc: *const BufferUpdateRequestDesc,
+    ) !u64 {
+        var request_id: u64 = 0;
+        try check(self.streamer_interface.QueueStreamerBufferUpdateRequest(streamer, desc, &request_id));
+        return request_id;
+    }
+
+    pub inline fn queueStreamerTextureUpdateRequest(
+        self: Device,
+        streamer: *Streamer,
+        desc: *const TextureUpdateRequestDesc,
+    ) !u64 {
+        var request_id: u64 = 0;
+        try check(self.streamer_interface.QueueStreamerTextureUpdateRequest(streamer, desc, &request_id));
+        return request_id;
+    }
+
+    pub inline fn reserveStreamerBufferUpdate(
+        self: Device,
+        streamer: *Streamer,
+        desc: *const BufferUpdateRequestDesc,
+        offset: *u64,
+    ) ?*anyopaque {
+        return self.streamer_interface.ReserveStreamerBufferUpdate(streamer, desc, offset);
+    }
+
+    pub inline fn addStreamerReadbackRequest(
+        self: Device,
+        streamer: *Streamer,
+        desc: *const ReadbackRequestDesc,
+    ) !void {
+        try check(self.streamer_interface.AddStreamerReadbackRequest(streamer, desc));
+    }
+
+    pub inline fn isStreamerRequestComplete(self: Device, streamer: *const Streamer, request_id: u64) bool {
+        return self.streamer_interface.IsStreamerRequestComplete(streamer, request_id);
     }
 
     pub inline fn updateStreamerConstantBuffer(
@@ -722,6 +837,44 @@ pub const Device = struct {
     pub inline fn uploadStreamerUpdateRequests(self: Device, command_buffer: *CommandBuffer, streamer: *Streamer) void {
         self.streamer_interface.CmdUploadStreamerUpdateRequests(command_buffer, streamer);
     }
+
+    pub inline fn getStreamerStatistics(self: Device, streamer: *const Streamer) StreamerStatistics {
+        var statistics: StreamerStatistics = .{};
+        self.streamer_interface.GetStreamerStatistics(streamer, &statistics);
+        return statistics;
+    }
+
+    pub inline fn createResidencyManager(self: Device, desc: *const ResidencyManagerDesc) !*ResidencyManager {
+        var temp_manager: ?*ResidencyManager = null;
+        try check(self.residency_interface.CreateResidencyManager(self.internal_device, desc, &temp_manager));
+        return temp_manager orelse unreachable;
+    }
+
+    pub inline fn destroyResidencyManager(self: Device, manager: *ResidencyManager) void {
+        self.residency_interface.DestroyResidencyManager(manager);
+    }
+
+    pub inline fn registerResidencyResource(self: Device, manager: *ResidencyManager, desc: *const ResidencyResourceDesc) u32 {
+        return self.residency_interface.RegisterResidencyResource(manager, desc);
+    }
+
+    pub inline fn unregisterResidencyResource(self: Device, manager: *ResidencyManager, id: u32) void {
+        self.residency_interface.UnregisterResidencyResource(manager, id);
+    }
+
+    pub inline fn markResidencyResourceUsed(self: Device, manager: *ResidencyManager, id: u32) void {
+        self.residency_interface.MarkResidencyResourceUsed(manager, id);
+    }
+
+    pub inline fn updateResidency(self: Device, manager: *ResidencyManager) !void {
+        try check(self.residency_interface.UpdateResidency(manager));
+    }
+
+    pub inline fn getResidencyStatistics(self: Device, manager: *const ResidencyManager) ResidencyStatistics {
+        var statistics: ResidencyStatistics = .{};
+        self.residency_interface.GetResidencyStatistics(manager, &statistics);
+        return statistics;
+    }
 };
 
 pub const Fence = opaque {};
@@ -751,6 +904,7 @@ pub const ONE_VIEWPORT: u32 = 0;
 pub const WHOLE_SIZE: dimension = 0;
 pub const REMAINING_MIPS: mip = 0;
 pub const REMAINING_LAYERS: dimension = 0;
+pub const STREAMER_INVALID_OFFSET: u64 = 0xFFFFFFFFFFFFFFFF;
 pub const Result = enum(u8) {
     success = 0,
     failure = 1,
@@ -1712,6 +1866,7 @@ pub const AllocateMemoryDesc = extern struct {
     size: u64 = 0,
     type: memory_kind = 0,
     priority: f32 = 0,
+    alignment: u32 = 0,
 };
 pub const BufferMemoryBindingDesc = extern struct {
     memory: ?*Memory = null,
@@ -2160,6 +2315,12 @@ pub const VKExtensions = extern struct {
     deviceExtensions: [*c]const [*c]const u8 = null,
     deviceExtensionNum: u32 = 0,
 };
+pub const NONETimingModel = extern struct {
+    drawTime: u32 = 0,
+    dispatchTime: u32 = 0,
+    barrierTime: u32 = 0,
+    copyByteTime: f32 = 0,
+};
 pub const DeviceCreationDesc = extern struct {
     adapter_desc: ?*const AdapterDesc = null,
     callback_interface: CallbackInterface = .{},
@@ -2169,10 +2330,17 @@ pub const DeviceCreationDesc = extern struct {
     graphics_api: GraphicsAPI = .vk,
     shader_ext_register: u32 = 0,
     shader_ext_space: u32 = 0,
+    allocation_statistics_dump_period: u32 = 0,
+    none_timing_model: ?*const NONETimingModel = null,
+    none_command_statistics_path: [*c]const u8 = null,
     enable_validation: bool = false,
     enable_graphics_api_validation: bool = false,
     enable_d3d12_draw_parameters_emulation: bool = false,
     enable_d3d11_command_buffer_emulation: bool = false,
+    enable_vk_memory_sub_allocation: bool = false,
+    enable_allocation_tracking: bool = false,
+    enable_none_host_memory: bool = false,
+    enable_none_command_profiling: bool = false,
     disable_vk_ray_tracing: bool = true,
     disable3rd_party_allocation_callbacks: bool = true,
 };
@@ -2243,21 +2411,57 @@ pub const StreamerDesc = extern struct {
     dynamic_buffer_memory_location: MemoryLocation = .host_upload,
     dynamic_buffer_usage_flags: BufferUsageFlags = .{},
     frame_in_flight_num: u32 = 0,
+
+    shrink_frame_num: u32 = 0,
+
+    frame_budget_size: u64 = 0,
+
+    file_read_thread_num: u32 = 0,
 };
 
 pub const BufferUpdateRequestDesc = extern struct {
     data: ?*const anyopaque = null,
     dataSize: u64 = 0,
+    filePath: ?[*:0]const u8 = null,
+    fileOffset: u64 = 0,
     dstBuffer: ?*const Buffer = null,
     dstBufferOffset: u64 = 0,
+    priority: u32 = 0,
 };
 
 pub const TextureUpdateRequestDesc = extern struct {
     data: ?*const anyopaque = null,
     dataRowPitch: u32 = 0,
     dataSlicePitch: u32 = 0,
+    filePath: ?[*:0]const u8 = null,
+    fileOffset: u64 = 0,
     dstTexture: ?*const Texture = null,
     dstRegionDesc: TextureRegionDesc = .{},
+    priority: u32 = 0,
+};
+
+pub const ReadbackRequestDesc = extern struct {
+    srcBuffer: ?*const Buffer = null,
+    srcBufferOffset: u64 = 0,
+    dataSize: u64 = 0,
+    srcTexture: ?*const Texture = null,
+    srcRegionDesc: TextureRegionDesc = .{},
+    Callback: ?*const fn (?*const anyopaque, u64, u32, u32, ?*anyopaque) callconv(.C) void = null,
+    userArg: ?*anyopaque = null,
+};
+
+pub const StreamerStatistics = extern struct {
+    streamedSize: u64 = 0,
+    peakStreamedSize: u64 = 0,
+    dynamicBufferSize: u64 = 0,
+    growNum: u32 = 0,
+    shrinkNum: u32 = 0,
+    garbageInFlightNum: u32 = 0,
+    pendingRequestNum: u32 = 0,
+    readbackBufferSize: u64 = 0,
+    readbackRequestNum: u32 = 0,
+    bufferCopyRequestNum: u32 = 0,
+    bufferCopyNum: u32 = 0,
 };
 
 pub const StreamerInterface = extern struct {
@@ -2267,9 +2471,52 @@ pub const StreamerInterface = extern struct {
     GetStreamerDynamicBuffer: *const fn (*Streamer) callconv(.C) ?*Buffer,
     AddStreamerBufferUpdateRequest: *const fn (*Streamer, *const BufferUpdateRequestDesc) callconv(.C) u64,
     AddStreamerTextureUpdateRequest: *const fn (*Streamer, *const TextureUpdateRequestDesc) callconv(.C) u64,
+    QueueStreamerBufferUpdateRequest: *const fn (*Streamer, *const BufferUpdateRequestDesc, *u64) callconv(.C) Result,
+    QueueStreamerTextureUpdateRequest: *const fn (*Streamer, *const TextureUpdateRequestDesc, *u64) callconv(.C) Result,
+    ReserveStreamerBufferUpdate: *const fn (*Streamer, *const BufferUpdateRequestDesc, *u64) callconv(.C) ?*anyopaque,
+    AddStreamerReadbackRequest: *const fn (*Streamer, *const ReadbackRequestDesc) callconv(.C) Result,
+    IsStreamerRequestComplete: *const fn (*const Streamer, u64) callconv(.C) bool,
     UpdateStreamerConstantBuffer: *const fn (*Streamer, ?*const anyopaque, u32) callconv(.C) u32,
     CopyStreamerUpdateRequests: *const fn (*Streamer) callconv(.C) Result,
     CmdUploadStreamerUpdateRequests: *const fn (*CommandBuffer, *Streamer) callconv(.C) void,
+    GetStreamerStatistics: *const fn (*const Streamer, *StreamerStatistics) callconv(.C) void,
+};
+
+// residency ext
+pub const ResidencyManager = opaque {};
+
+pub const ResidencyResourceDesc = extern struct {
+    buffer: ?*Buffer = null,
+    texture: ?*Texture = null,
+    priority: f32 = 0,
+    userArg: ?*anyopaque = null,
+};
+
+pub const ResidencyManagerDesc = extern struct {
+    Callback: *const fn ([*]const ResidencyResourceDesc, [*]const u32, u32, ?*anyopaque) callconv(.C) void, // required
+    userArg: ?*anyopaque = null,
+    budgetUsage: f32 = 0,
+    protectedFrameNum: u32 = 0,
+};
+
+pub const ResidencyStatistics = extern struct {
+    budgetSize: u64 = 0,
+    usageSize: u64 = 0,
+    registeredSize: u64 = 0,
+    pendingEvictionSize: u64 = 0,
+    evictedSize: u64 = 0,
+    registeredResourceNum: u32 = 0,
+    evictedResourceNum: u32 = 0,
+};
+
+pub const ResidencyInterface = extern struct {
+    CreateResidencyManager: *const fn (*RawDevice, *const ResidencyManagerDesc, *?*ResidencyManager) callconv(.C) Result,
+    DestroyResidencyManager: *const fn (*ResidencyManager) callconv(.C) void,
+    RegisterResidencyResource: *const fn (*ResidencyManager, *const ResidencyResourceDesc) callconv(.C) u32,
+    UnregisterResidencyResource: *const fn (*ResidencyManager, u32) callconv(.C) void,
+    MarkResidencyResourceUsed: *const fn (*ResidencyManager, u32) callconv(.C) void,
+    UpdateResidency: *const fn (*ResidencyManager) callconv(.C) Result,
+    GetResidencyStatistics: *const fn (*const ResidencyManager, *ResidencyStatistics) callconv(.C) void,
 };
 
 // helper
@@ -2279,6 +2526,117 @@ pub const VideoMemoryInfo = extern struct {
     usageSize: u64 = 0,
 };
 
+pub const ScratchMemoryStatistics = extern struct {
+    stackAllocationNum: u64 = 0,
+    arenaAllocationNum: u64 = 0,
+    heapAllocationNum: u64 = 0,
+    arenaSize: u64 = 0,
+    arenaNum: u32 = 0,
+};
+
+pub const AllocationCategory = enum(u8) {
+    device = 0,
+    descriptor = 1,
+    pipeline = 2,
+    validation = 3,
+    scratch = 4,
+    streamer = 5,
+};
+
+pub const LockStatistics = extern struct {
+    name: [*c]const u8 = null,
+    acquireNum: u64 = 0,
+    contendedAcquireNum: u64 = 0,
+    spinNum: u64 = 0,
+    parkedTime: u64 = 0,
+    lockNum: u32 = 0,
+};
+pub const getLockStatistics = nriGetLockStatistics;
+extern fn nriGetLockStatistics(lockStatistics: ?[*]LockStatistics, lockStatisticsNum: *u32) void;
+
+pub const AllocationStatistics = extern struct {
+    liveSize: u64 = 0,
+    peakSize: u64 = 0,
+    totalNum: u64 = 0,
+    liveNum: u32 = 0,
+    peakNum: u32 = 0,
+};
+
+pub const CommandType = enum(u8) {
+    set_descriptor_pool = 0,
+    set_descriptor_set = 1,
+    set_pipeline_layout = 2,
+    set_pipeline = 3,
+    set_root_constants = 4,
+    set_root_descriptor = 5,
+    barrier = 6,
+    set_index_buffer = 7,
+    set_vertex_buffers = 8,
+    set_viewports = 9,
+    set_scissors = 10,
+    set_stencil_reference = 11,
+    set_depth_bounds = 12,
+    set_blend_constants = 13,
+    set_sample_locations = 14,
+    set_shading_rate = 15,
+    set_depth_bias = 16,
+    begin_rendering = 17,
+    clear_attachments = 18,
+    draw = 19,
+    draw_indexed = 20,
+    draw_indirect = 21,
+    draw_indexed_indirect = 22,
+    end_rendering = 23,
+    dispatch = 24,
+    dispatch_indirect = 25,
+    copy_buffer = 26,
+    copy_texture = 27,
+    upload_buffer_to_texture = 28,
+    readback_texture_to_buffer = 29,
+    clear_storage_buffer = 30,
+    clear_storage_texture = 31,
+    resolve_texture = 32,
+    reset_queries = 33,
+    begin_query = 34,
+    end_query = 35,
+    copy_queries = 36,
+    begin_annotation = 37,
+    end_annotation = 38,
+    draw_mesh_tasks = 39,
+    draw_mesh_tasks_indirect = 40,
+    build_top_level_acceleration_structure = 41,
+    build_bottom_level_acceleration_structure = 42,
+    update_top_level_acceleration_structure = 43,
+    update_bottom_level_acceleration_structure = 44,
+    dispatch_rays = 45,
+    dispatch_rays_indirect = 46,
+    copy_acceleration_structure = 47,
+    write_acceleration_structure_size = 48,
+};
+
+pub const CommandStatistics = extern struct {
+    commandNum: [49]u64 = [_]u64{0} ** 49,
+    submitNum: u64 = 0,
+    commandBufferNum: u64 = 0,
+    globalBarrierNum: u64 = 0,
+    bufferBarrierNum: u64 = 0,
+    textureBarrierNum: u64 = 0,
+    copiedSize: u64 = 0,
+    descriptorSetNum: u64 = 0,
+    stateChangeNum: u64 = 0,
+    redundantPipelineNum: u64 = 0,
+    drawNum: u64 = 0,
+    dispatchNum: u64 = 0,
+    pipelineNum: u32 = 0,
+};
+
+pub const PipelineCommandStatistics = extern struct {
+    name: [64]u8 = [_]u8{0} ** 64,
+    bindNum: u64 = 0,
+    drawNum: u64 = 0,
+    dispatchNum: u64 = 0,
+};
+
 pub const TextureSubresourceUploadDesc = extern struct {
     slices: ?*const anyopaque = null,
     sliceNum: u32 = 0,
@@ -2316,6 +2674,72 @@ pub const BufferUploadDesc = extern struct {
     }
 };
 
+pub const TextureDownloadDesc = extern struct {
+    texture: *const Texture,
+    region: TextureRegionDesc = .{},
+    data: ?*anyopaque = null,
+    data_row_pitch: u32 = 0,
+    data_slice_pitch: u32 = 0,
+    before: AccessLayoutStage = .{},
+    planes: PlaneFlags = .{},
+};
+
+pub const BufferDownloadDesc = extern struct {
+    data: ?[*]u8 = null,
+    data_size: u64 = 0,
+    buffer: *const Buffer,
+    buffer_offset: u64 = 0,
+    before: AccessStage = .{},
+
+    pub fn init(desc: struct {
+        data: []u8,
+        buffer: *const Buffer,
+        buffer_offset: u64 = 0,
+        before: AccessStage,
+    }) BufferDownloadDesc {
+        return .{
+            .data = desc.data.ptr,
+            .data_size = desc.data.len,
+            .buffer = desc.buffer,
+            .buffer_offset = desc.buffer_offset,
+            .before = desc.before,
+        };
+    }
+};
+
+pub const DataUploader = opaque {};
+
+pub const DataUploaderDesc = extern struct {
+    staging_buffer_size: u64 = 0,
+    ParallelFor: ?*const fn (u32, *const fn (u32, ?*anyopaque) callconv(.C) void, ?*anyopaque, ?*anyopaque) callconv(.C) void = null,
+    user_arg: ?*anyopaque = null,
+};
+
+pub const UploadTicket = extern struct {
+    fence: ?*Fence = null,
+    value: u64 = 0,
+};
+
+pub const ResourceLifetime = extern struct {
+    first_pass: u32 = 0,
+    last_pass: u32 = 0,
+};
+
+pub const AliasingRange = extern struct {
+    offset: u64 = 0,
+    size: u64 = 0,
+    resource: u32 = 0,
+};
+
+pub const AllocationReport = extern struct {
+    size: u64 = 0,
+    unaliased_size: u64 = 0,
+    wasted_size: u64 = 0,
+    buffer_num: u32 = 0,
+    texture_num: u32 = 0,
+    aliasing_range_num: u32 = 0,
+};
+
 pub const ResourceGroupDesc = extern struct {
     memory_location: MemoryLocation = .device,
     textures: ?[*]const *const Texture = null,
@@ -2323,6 +2747,11 @@ pub const ResourceGroupDesc = extern struct {
     buffers: ?[*]const *const Buffer = null,
     buffer_num: u32 = 0,
     preferred_memory_size: u64 = 0, // default goes to 256 Mb
+    best_fit: bool = false,
+    allocation_reports: ?[*]AllocationReport = null,
+    buffer_lifetimes: ?[*]const ResourceLifetime = null,
+    texture_lifetimes: ?[*]const ResourceLifetime = null,
+    aliasing_ranges: ?[*]AliasingRange = null,
 };
 
 pub const FormatProps = packed struct {
@@ -2353,6 +2782,13 @@ pub const HelperInterface = extern struct {
     CalculateAllocationNumber: *const fn (*RawDevice, *const ResourceGroupDesc) callconv(.C) u32,
     AllocateAndBindMemory: *const fn (*RawDevice, *const ResourceGroupDesc, [*]*Memory) callconv(.C) Result,
     UploadData: *const fn (*CommandQueue, [*]const TextureUploadDesc, u32, [*]const BufferUploadDesc, u32) callconv(.C) Result,
+    DownloadData: *const fn (*CommandQueue, [*]const TextureDownloadDesc, u32, [*]const BufferDownloadDesc, u32) callconv(.C) Result,
+    CreateDataUploader: *const fn (*CommandQueue, *const DataUploaderDesc, *?*DataUploader) callconv(.C) Result,
+    DestroyDataUploader: *const fn (*DataUploader) callconv(.C) void,
+    UploadDataAsync: *const fn (*DataUploader, [*]const TextureUploadDesc, u32, [*]const BufferUploadDesc, u32, *UploadTicket) callconv(.C) Result,
     WaitForIdle: *const fn (*CommandQueue) callconv(.C) Result,
     QueryVideoMemoryInfo: *const fn (*RawDevice, MemoryLocation, *VideoMemoryInfo) callconv(.C) Result,
+    GetScratchMemoryStatistics: *const fn (*const RawDevice, *ScratchMemoryStatistics) callconv(.C) void,
+    GetAllocationStatistics: *const fn (*const RawDevice, AllocationCategory, *AllocationStatistics) callconv(.C) Result,
+    GetCommandStatistics: *const fn (*const RawDevice, *CommandStatistics, ?[*]PipelineCommandStatistics, *u32) callconv(.C) Result,
 };